@@ -0,0 +1,1010 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <fstream>
+#include <cstdio>
+#include "../src/OxygenMath.hpp"
+
+using namespace OxygenMath;
+void benchGemm();
+void benchScalarPolicy();
+void benchMixedPrecision();
+void benchSplitComplex();
+void benchBlockedLU();
+void benchBatchedMatrix();
+void benchSymmetricFactorization();
+void benchQR();
+void benchSymmetricEigen();
+void benchSVD();
+void benchGeneralEigenvalues();
+void benchSparseMatrix();
+void benchKrylovSolvers();
+void benchRelaxation();
+void benchThreadPool();
+void benchExpressionReductions();
+void benchElementwiseMath();
+void benchMatrixViews();
+void benchAliasAssignment();
+void benchBinaryMatrixFile();
+void benchMatrixMarket();
+int main()
+{
+    std::vector<std::function<void()>> bench_functions{benchGemm, benchScalarPolicy, benchMixedPrecision, benchSplitComplex, benchBlockedLU, benchBatchedMatrix, benchSymmetricFactorization, benchQR, benchSymmetricEigen, benchSVD, benchGeneralEigenvalues, benchSparseMatrix, benchKrylovSolvers, benchRelaxation, benchThreadPool, benchExpressionReductions, benchElementwiseMath, benchMatrixViews, benchAliasAssignment, benchBinaryMatrixFile, benchMatrixMarket};
+    for (const auto &func : bench_functions)
+    {
+        func();
+    }
+    return 0;
+}
+
+// 以秒为单位返回 func 的最短运行时间
+static double timeIt(const std::function<void()> &func, int repeat)
+{
+    double best = 1e30;
+    for (int r = 0; r < repeat; ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+void benchGemm()
+{
+    std::cout << "=========GEMM Benchmark=========" << std::endl;
+    std::cout << std::setw(8) << "n" << std::setw(18) << "elementwise GF/s" << std::setw(14) << "gemm GF/s" << std::endl;
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    for (size_t n : {64, 128, 256, 512, 1024})
+    {
+        MatrixXf A(n, n), B(n, n), C(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+            {
+                A(i, j) = dis(gen);
+                B(i, j) = dis(gen);
+            }
+        const double flops = 2.0 * n * n * n;
+        const int repeat = n <= 256 ? 5 : 2;
+
+        // 旧的求值方式：每个元素单独通过 MatrixMul::operator()(i, j) 计算点积
+        double naive = 1e30;
+        if (n <= 512)
+        {
+            naive = timeIt([&]()
+                           {
+                               auto product = A * B;
+                               for (size_t i = 0; i < n; ++i)
+                                   for (size_t j = 0; j < n; ++j)
+                                       C(i, j) = product(i, j); },
+                           repeat);
+        }
+        double blocked = timeIt([&]()
+                                { C = A * B; },
+                                repeat);
+
+        std::cout << std::setw(8) << n << std::setw(18);
+        if (n <= 512)
+            std::cout << flops / naive * 1e-9;
+        else
+            std::cout << "-";
+        std::cout << std::setw(14) << flops / blocked * 1e-9 << std::endl;
+    }
+    std::cout << "=========GEMM Benchmark End=========" << std::endl;
+}
+
+// 逐元素 c = sqrt(a / b)，内层循环只有除法与开方
+template <typename T>
+static double timeDivSqrt(const std::vector<T> &a, const std::vector<T> &b, std::vector<T> &c)
+{
+    return timeIt([&]()
+                  {
+                      const size_t n = a.size();
+                      for (size_t i = 0; i < n; ++i)
+                          c[i] = sqrt(a[i] / b[i]); },
+                  5);
+}
+
+template <typename T>
+static double timeLU(size_t n)
+{
+    std::mt19937 gen(2);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    MatrixX<T> A(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            A(i, j) = T(dis(gen));
+    return timeIt([&]()
+                  { LinAlg::luDecomposition(A); },
+                  3);
+}
+
+void benchScalarPolicy()
+{
+    std::cout << "=========Scalar Policy Benchmark=========" << std::endl;
+    const size_t n = 1 << 20;
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dis(1.0, 2.0);
+    std::vector<double> ad(n), bd(n), cd(n);
+    std::vector<Real> ar(n), br(n), cr(n);
+    std::vector<RealIEEE> ai(n), bi(n), ci(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ad[i] = dis(gen);
+        bd[i] = dis(gen);
+        ar[i] = ad[i];
+        ai[i] = ad[i];
+        br[i] = bd[i];
+        bi[i] = bd[i];
+    }
+    const double tDouble = timeIt([&]()
+                                  {
+                                      for (size_t i = 0; i < n; ++i)
+                                          cd[i] = std::sqrt(ad[i] / bd[i]); },
+                                  5);
+    const double tReal = timeDivSqrt(ar, br, cr);
+    const double tIEEE = timeDivSqrt(ai, bi, ci);
+    std::cout << "sqrt(a / b), " << n << " elements (ns/element)" << std::endl;
+    std::cout << "  double   : " << tDouble / n * 1e9 << std::endl;
+    std::cout << "  Real     : " << tReal / n * 1e9 << std::endl;
+    std::cout << "  RealIEEE : " << tIEEE / n * 1e9 << std::endl;
+
+    const size_t luSize = 300;
+    std::cout << "LU decomposition " << luSize << "x" << luSize << " (ms)" << std::endl;
+    std::cout << "  Real     : " << timeLU<Real>(luSize) * 1e3 << std::endl;
+    std::cout << "  RealIEEE : " << timeLU<RealIEEE>(luSize) * 1e3 << std::endl;
+    std::cout << "=========Scalar Policy Benchmark End=========" << std::endl;
+}
+void benchMixedPrecision()
+{
+    std::cout << "=========Mixed Precision Benchmark=========" << std::endl;
+    std::cout << std::setw(8) << "n" << std::setw(16) << "gemm f64 GF/s" << std::setw(16) << "gemm f32 GF/s"
+              << std::setw(14) << "LU f64 ms" << std::setw(16) << "mixed f32 ms" << std::endl;
+    std::mt19937 gen(4);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (size_t n : {128, 256, 512})
+    {
+        MatrixXf A(n, n), C(n, n);
+        VectorXf b(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            b[i] = dis(gen);
+            for (size_t j = 0; j < n; ++j)
+                A(i, j) = dis(gen);
+        }
+        MatrixX<Real32> A32(A.cast<Real32>()), C32(n, n);
+        const double flops = 2.0 * n * n * n;
+        const double t64 = timeIt([&]()
+                                  { C = A * A; },
+                                  3);
+        const double t32 = timeIt([&]()
+                                  { C32 = A32 * A32; },
+                                  3);
+        const double tLU = timeIt([&]()
+                                  { LinAlg::solve(LinAlg::luDecomposition(A), b); },
+                                  2);
+        const double tMixed = timeIt([&]()
+                                     { LinAlg::mixedPrecisionSolve(A, b); },
+                                     2);
+        std::cout << std::setw(8) << n << std::setw(16) << flops / t64 * 1e-9 << std::setw(16) << flops / t32 * 1e-9
+                  << std::setw(14) << tLU * 1e3 << std::setw(16) << tMixed * 1e3 << std::endl;
+    }
+    std::cout << "=========Mixed Precision Benchmark End=========" << std::endl;
+}
+void benchSplitComplex()
+{
+    std::cout << "=========Split Complex Benchmark=========" << std::endl;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    const size_t n = 1 << 18;
+    VectorXc a(n), b(n), c(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i] = Complex(dis(gen), dis(gen));
+        b[i] = Complex(dis(gen), dis(gen));
+    }
+    SplitVectorXc sa(a), sb(b), sc;
+    std::cout << n << " elements (ns/element)   interleaved      split" << std::endl;
+    const double mulI = timeIt([&]()
+                               { for (size_t i = 0; i < n; ++i) c[i] = a[i] * b[i]; },
+                               5);
+    const double mulS = timeIt([&]()
+                               { sc = hadamard(sa, sb); },
+                               5);
+    std::cout << "  a * b  " << std::setw(22) << mulI / n * 1e9 << std::setw(11) << mulS / n * 1e9 << std::endl;
+    const double expI = timeIt([&]()
+                               { for (size_t i = 0; i < n; ++i) c[i] = exp(a[i]); },
+                               5);
+    const double expS = timeIt([&]()
+                               { sc = exp(sa); },
+                               5);
+    std::cout << "  exp(a) " << std::setw(22) << expI / n * 1e9 << std::setw(11) << expS / n * 1e9 << std::endl;
+    const double logI = timeIt([&]()
+                               { for (size_t i = 0; i < n; ++i) c[i] = log(ComplexIEEE(a[i])).real; },
+                               5);
+    const double logS = timeIt([&]()
+                               { sc = log(sa); },
+                               5);
+    std::cout << "  log(a) " << std::setw(22) << logI / n * 1e9 << std::setw(11) << logS / n * 1e9 << std::endl;
+
+    const size_t m = 256;
+    MatrixXc A(m, m), B(m, m), C(m, m);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < m; ++j)
+        {
+            A(i, j) = Complex(dis(gen), dis(gen));
+            B(i, j) = Complex(dis(gen), dis(gen));
+        }
+    SplitMatrixXc sA(A), sB(B), sC;
+    const double flops = 8.0 * m * m * m;
+    const double gemmI = timeIt([&]()
+                                { C = A * B; },
+                                2);
+    const double gemmS = timeIt([&]()
+                                { sC = sA * sB; },
+                                3);
+    std::cout << "complex GEMM " << m << " (GF/s) " << std::setw(11) << flops / gemmI * 1e-9 << std::setw(11) << flops / gemmS * 1e-9 << std::endl;
+    std::cout << "=========Split Complex Benchmark End=========" << std::endl;
+}
+
+void benchBlockedLU()
+{
+    std::cout << "=========Blocked LU Benchmark=========" << std::endl;
+    std::cout << std::setw(8) << "n" << std::setw(14) << "luFactor GF/s" << std::setw(16) << "inverse GF/s" << std::endl;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (size_t n : {128, 256, 512, 1024})
+    {
+        MatrixXf A(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                A(i, j) = dis(gen);
+        const int repeat = n <= 256 ? 5 : 2;
+        const double tFactor = timeIt([&]()
+                                      { LinAlg::luFactor(A); },
+                                      repeat);
+        const double tInverse = timeIt([&]()
+                                       { LinAlg::inverse(A); },
+                                       repeat);
+        std::cout << std::setw(8) << n << std::setw(14) << 2.0 / 3.0 * n * n * n / tFactor * 1e-9
+                  << std::setw(16) << 2.0 * n * n * n / tInverse * 1e-9 << std::endl;
+    }
+
+    // 复用同一分解求解多个右端项：直接替换与先求逆再相乘
+    const size_t n = 512, m = 256;
+    MatrixXf A(n, n), B(n, m), X(n, m);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+            A(i, j) = dis(gen);
+        for (size_t j = 0; j < m; ++j)
+            B(i, j) = dis(gen);
+    }
+    const auto lu = LinAlg::luFactor(A);
+    const double tSolve = timeIt([&]()
+                                 { X = LinAlg::solve(lu, B); },
+                                 3);
+    const double tInvMul = timeIt([&]()
+                                  { X = LinAlg::inverse(lu) * B; },
+                                  3);
+    std::cout << "n = " << n << ", " << m << " right-hand sides: solve " << tSolve * 1e3 << " ms, inverse * B "
+              << tInvMul * 1e3 << " ms" << std::endl;
+    std::cout << "=========Blocked LU Benchmark End=========" << std::endl;
+}
+
+template <size_t N>
+static void benchBatchedSize(size_t count, std::mt19937 &gen)
+{
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    std::vector<MatrixNM<Real, N, N>> mats(count), invs(count);
+    BatchedMatrix<double, N, N> batch(count), batchInv(count);
+    BatchedMatrix<float, N, N> batch32(count), batchInv32(count);
+    for (size_t k = 0; k < count; ++k)
+    {
+        for (size_t i = 0; i < N; ++i)
+            for (size_t j = 0; j < N; ++j)
+                mats[k](i, j) = dis(gen) + (i == j ? 2.0 : 0.0);
+        batch.set(k, mats[k]);
+        batch32.set(k, mats[k]);
+    }
+    const double tLoop = timeIt([&]()
+                                {
+                                    for (size_t k = 0; k < count; ++k)
+                                        invs[k] = LinAlg::inverse(mats[k]); },
+                                3);
+    const double tBatched = timeIt([&]()
+                                   { LinAlg::inverse(batch, batchInv); },
+                                   3);
+    const double tBatched32 = timeIt([&]()
+                                     { LinAlg::inverse(batch32, batchInv32); },
+                                     3);
+    std::cout << std::setw(6) << N << "x" << N << std::setw(14) << tLoop / count * 1e9 << std::setw(14)
+              << tBatched / count * 1e9 << std::setw(14) << tBatched32 / count * 1e9 << std::endl;
+}
+
+void benchBatchedMatrix()
+{
+    std::cout << "=========Batched Matrix Benchmark=========" << std::endl;
+    const size_t count = 1 << 20;
+    std::mt19937 gen(6);
+    std::cout << count << " inverses (ns/matrix), " << parallelThreads() << " threads" << std::endl;
+    std::cout << std::setw(8) << "size" << std::setw(14) << "per-matrix" << std::setw(14) << "batched f64" << std::setw(14) << "batched f32" << std::endl;
+    benchBatchedSize<3>(count, gen);
+    benchBatchedSize<4>(count, gen);
+    std::cout << "=========Batched Matrix Benchmark End=========" << std::endl;
+}
+
+void benchSymmetricFactorization()
+{
+    std::cout << "=========Symmetric Factorization Benchmark=========" << std::endl;
+    std::cout << std::setw(8) << "n" << std::setw(14) << "LU ms" << std::setw(14) << "Cholesky ms" << std::setw(14) << "LDLT ms" << std::endl;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (size_t n : {128, 256, 512, 1024})
+    {
+        MatrixXf A(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j <= i; ++j)
+            {
+                const double v = dis(gen) + (i == j ? double(n) : 0.0);
+                A(i, j) = v;
+                A(j, i) = v;
+            }
+        const int repeat = n <= 256 ? 5 : 2;
+        const double tLU = timeIt([&]()
+                                  { LinAlg::luFactor(A); },
+                                  repeat);
+        const double tChol = timeIt([&]()
+                                    { LinAlg::cholesky(A); },
+                                    repeat);
+        const double tLDLT = timeIt([&]()
+                                    { LinAlg::ldlt(A); },
+                                    repeat);
+        std::cout << std::setw(8) << n << std::setw(14) << tLU * 1e3 << std::setw(14) << tChol * 1e3 << std::setw(14) << tLDLT * 1e3 << std::endl;
+    }
+    std::cout << "=========Symmetric Factorization Benchmark End=========" << std::endl;
+}
+void benchQR()
+{
+    std::cout << "=========QR Benchmark=========" << std::endl;
+    std::cout << std::setw(8) << "m" << std::setw(8) << "n" << std::setw(14) << "QR ms" << std::setw(12) << "GFLOPS" << std::setw(16) << "lstsq ms" << std::endl;
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (size_t n : {128, 256, 512, 1024})
+    {
+        const size_t m = 2 * n;
+        MatrixXf A(m, n);
+        VectorXf b(m);
+        for (size_t i = 0; i < m; ++i)
+        {
+            for (size_t j = 0; j < n; ++j)
+                A(i, j) = dis(gen);
+            b[i] = dis(gen);
+        }
+        const int repeat = n <= 256 ? 5 : 2;
+        const double tQR = timeIt([&]()
+                                  { LinAlg::qr(A); },
+                                  repeat);
+        const auto f = LinAlg::qr(A);
+        const double tSolve = timeIt([&]()
+                                     { LinAlg::leastSquares(f, b); },
+                                     repeat);
+        const double flops = 2.0 * m * n * n - 2.0 * n * n * n / 3.0;
+        std::cout << std::setw(8) << m << std::setw(8) << n << std::setw(14) << tQR * 1e3 << std::setw(12) << flops / tQR * 1e-9 << std::setw(16) << tSolve * 1e3 << std::endl;
+    }
+    std::cout << "=========QR Benchmark End=========" << std::endl;
+}
+void benchSymmetricEigen()
+{
+    std::cout << "=========Symmetric Eigen Benchmark=========" << std::endl;
+    std::mt19937 gen(13);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    // 3x3 惯性张量（Jacobi）
+    const size_t count = 100000;
+    std::vector<MatrixNM<Real, 3, 3>> tensors(count);
+    for (auto &T : tensors)
+        for (size_t i = 0; i < 3; ++i)
+            for (size_t j = 0; j <= i; ++j)
+            {
+                const double v = dis(gen) + (i == j ? 3.0 : 0.0);
+                T(i, j) = v;
+                T(j, i) = v;
+            }
+    double sink = 0;
+    const double t3 = timeIt([&]()
+                             {
+                                 for (const auto &T : tensors)
+                                     sink += LinAlg::symmetricEigen(T).eigenvalues[0].data;
+                             },
+                             3);
+    std::cout << "3x3 eigendecomposition: " << t3 / count * 1e9 << " ns each (" << (sink != 0) << ")" << std::endl;
+
+    std::cout << std::setw(8) << "n" << std::setw(16) << "values ms" << std::setw(16) << "vectors ms" << std::endl;
+    for (size_t n : {128, 256, 512, 1024})
+    {
+        MatrixXf A(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j <= i; ++j)
+            {
+                const double v = dis(gen);
+                A(i, j) = v;
+                A(j, i) = v;
+            }
+        const int repeat = n <= 256 ? 5 : 2;
+        const double tValues = timeIt([&]()
+                                      { LinAlg::symmetricEigenvalues(A); },
+                                      repeat);
+        const double tVectors = timeIt([&]()
+                                       { LinAlg::symmetricEigen(A); },
+                                       repeat);
+        std::cout << std::setw(8) << n << std::setw(16) << tValues * 1e3 << std::setw(16) << tVectors * 1e3 << std::endl;
+    }
+    std::cout << "=========Symmetric Eigen Benchmark End=========" << std::endl;
+}
+void benchSVD()
+{
+    std::cout << "=========SVD Benchmark=========" << std::endl;
+    std::cout << std::setw(8) << "m" << std::setw(8) << "n" << std::setw(16) << "values ms" << std::setw(14) << "full ms" << std::setw(18) << "randomized ms" << std::endl;
+    std::mt19937 gen(19);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (size_t n : {128, 256, 512})
+    {
+        const size_t m = 4 * n;
+        MatrixXf A(m, n);
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < n; ++j)
+                A(i, j) = dis(gen);
+        const int repeat = n <= 256 ? 3 : 1;
+        const double tValues = timeIt([&]()
+                                      { LinAlg::singularValues(A); },
+                                      repeat);
+        const double tFull = timeIt([&]()
+                                    { LinAlg::svd(A); },
+                                    repeat);
+        // 只求前 10 个奇异三元组
+        const double tRandom = timeIt([&]()
+                                      { LinAlg::randomizedSVD(A, 10); },
+                                      repeat);
+        std::cout << std::setw(8) << m << std::setw(8) << n << std::setw(16) << tValues * 1e3 << std::setw(14) << tFull * 1e3 << std::setw(18) << tRandom * 1e3 << std::endl;
+    }
+    std::cout << "=========SVD Benchmark End=========" << std::endl;
+}
+void benchGeneralEigenvalues()
+{
+    std::cout << "=========General Eigenvalues Benchmark=========" << std::endl;
+    std::cout << std::setw(8) << "n" << std::setw(14) << "ms" << std::endl;
+    std::mt19937 gen(31);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (size_t n : {64, 128, 256, 512})
+    {
+        MatrixXf A(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                A(i, j) = dis(gen);
+        const double t = timeIt([&]()
+                                { LinAlg::eigenvalues(A); },
+                                n <= 256 ? 5 : 2);
+        std::cout << std::setw(8) << n << std::setw(14) << t * 1e3 << std::endl;
+    }
+    std::cout << "=========General Eigenvalues Benchmark End=========" << std::endl;
+}
+
+// 三维 7 点 Laplace 的 SpMV：带宽受限，按每秒读写的字节数报告
+void benchSparseMatrix()
+{
+    std::cout << "=========Sparse Matrix Benchmark=========" << std::endl;
+    std::cout << std::setw(10) << "rows" << std::setw(12) << "nnz" << std::setw(14) << "assemble ms" << std::setw(12) << "A*x ms"
+              << std::setw(12) << "A^T*x ms" << std::setw(12) << "A*x GB/s" << std::endl;
+    for (size_t g : {32, 64, 100})
+    {
+        const size_t n = g * g * g;
+        std::vector<Triplet<Real>> triplets;
+        triplets.reserve(7 * n);
+        for (size_t i = 0; i < g; ++i)
+            for (size_t j = 0; j < g; ++j)
+                for (size_t k = 0; k < g; ++k)
+                {
+                    const size_t r = (i * g + j) * g + k;
+                    triplets.push_back(Triplet<Real>(r, r, 6.0));
+                    if (i > 0)
+                        triplets.push_back(Triplet<Real>(r, r - g * g, -1.0));
+                    if (i + 1 < g)
+                        triplets.push_back(Triplet<Real>(r, r + g * g, -1.0));
+                    if (j > 0)
+                        triplets.push_back(Triplet<Real>(r, r - g, -1.0));
+                    if (j + 1 < g)
+                        triplets.push_back(Triplet<Real>(r, r + g, -1.0));
+                    if (k > 0)
+                        triplets.push_back(Triplet<Real>(r, r - 1, -1.0));
+                    if (k + 1 < g)
+                        triplets.push_back(Triplet<Real>(r, r + 1, -1.0));
+                }
+        SparseMatrixXf A;
+        const double ta = timeIt([&]()
+                                 { A = SparseMatrixXf(n, n, triplets); },
+                                 3);
+        VectorXf x(n), y(n);
+        for (size_t i = 0; i < n; ++i)
+            x[i] = 1.0 / double(i + 1);
+        const int repeat = n <= 300000 ? 50 : 10;
+        const double tm = timeIt([&]()
+                                 { A.multiply(x, y); },
+                                 repeat);
+        const double tt = timeIt([&]()
+                                 { A.transposeMultiply(x, y); },
+                                 repeat);
+        // 数值与内层索引各读一次，外层指针、x 与 y 各一次
+        const double bytes = 12.0 * A.nonZeros() + 8.0 * (n + 1) + 16.0 * n;
+        std::cout << std::setw(10) << n << std::setw(12) << A.nonZeros() << std::setw(14) << ta * 1e3 << std::setw(12) << tm * 1e3
+                  << std::setw(12) << tt * 1e3 << std::setw(12) << bytes / tm * 1e-9 << std::endl;
+    }
+    std::cout << "=========Sparse Matrix Benchmark End=========" << std::endl;
+}
+
+// 二维 g×g 网格上的 -Δu + c * ∂u/∂x 五点差分矩阵
+static SparseMatrixXf benchGridOperator(size_t g, double c)
+{
+    std::vector<Triplet<Real>> triplets;
+    triplets.reserve(5 * g * g);
+    for (size_t i = 0; i < g; ++i)
+        for (size_t j = 0; j < g; ++j)
+        {
+            const size_t r = i * g + j;
+            triplets.push_back(Triplet<Real>(r, r, 4.0));
+            if (i > 0)
+                triplets.push_back(Triplet<Real>(r, r - g, -1.0));
+            if (i + 1 < g)
+                triplets.push_back(Triplet<Real>(r, r + g, -1.0));
+            if (j > 0)
+                triplets.push_back(Triplet<Real>(r, r - 1, -1.0 - c));
+            if (j + 1 < g)
+                triplets.push_back(Triplet<Real>(r, r + 1, -1.0 + c));
+        }
+    return SparseMatrixXf(g * g, g * g, triplets);
+}
+
+void benchKrylovSolvers()
+{
+    std::cout << "=========Krylov Solvers Benchmark=========" << std::endl;
+    std::cout << std::setw(24) << "solver" << std::setw(10) << "rows" << std::setw(8) << "iters" << std::setw(12) << "ms" << std::endl;
+    const size_t g = 256, n = g * g;
+    const SparseMatrixXf L = benchGridOperator(g, 0.0), C = benchGridOperator(g, 0.4);
+    VectorXf b(n), x(n);
+    for (size_t i = 0; i < n; ++i)
+        b[i] = std::sin(0.01 * double(i));
+    LinAlg::KrylovWorkspace<Real> workspace;
+    auto run = [&](const char *name, const std::function<LinAlg::IterativeResult()> &solve)
+    {
+        LinAlg::IterativeResult result{0, 0.0, false};
+        const double t = timeIt([&]()
+                                {
+                                    std::fill(x.data(), x.data() + n, Real(0.0));
+                                    result = solve(); },
+                                3);
+        std::cout << std::setw(24) << name << std::setw(10) << n << std::setw(8) << result.iterations << std::setw(12) << t * 1e3
+                  << (result.converged ? "" : "  (not converged)") << std::endl;
+    };
+    const LinAlg::IC0Preconditioner<Real> ic(L);
+    const LinAlg::ILU0Preconditioner<Real> ilu(C);
+    run("CG", [&]()
+        { return LinAlg::conjugateGradient(L, b, x, LinAlg::IdentityPreconditioner(), workspace, 5000, 1e-8); });
+    run("CG + IC(0)", [&]()
+        { return LinAlg::conjugateGradient(L, b, x, ic, workspace, 5000, 1e-8); });
+    run("BiCGSTAB + ILU(0)", [&]()
+        { return LinAlg::bicgstab(C, b, x, ilu, workspace, 5000, 1e-8); });
+    run("GMRES(30) + ILU(0)", [&]()
+        { return LinAlg::gmres(C, b, x, ilu, workspace, 5000, 1e-8, 30); });
+    std::cout << "=========Krylov Solvers Benchmark End=========" << std::endl;
+}
+
+void benchRelaxation()
+{
+    std::cout << "=========Relaxation Benchmark=========" << std::endl;
+    std::cout << std::setw(28) << "method" << std::setw(10) << "rows" << std::setw(14) << "ms / sweep" << std::endl;
+    std::mt19937 gen(37);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    // 稠密：固定扫描次数，比较 gaussSeidel 与 sor(ω = 1)
+    const size_t d = 1000, sweeps = 20;
+    MatrixXf D(d, d);
+    for (size_t i = 0; i < d; ++i)
+        for (size_t j = 0; j < d; ++j)
+            D(i, j) = dis(gen) + (i == j ? 2.0 * d : 0.0);
+    VectorXf db(d), dx(d);
+    for (size_t i = 0; i < d; ++i)
+        db[i] = dis(gen);
+    const double tg = timeIt([&]()
+                             { LinAlg::gaussSeidel(D, db, VectorXf(d), sweeps, Real(0.0)); },
+                             3);
+    const double ts = timeIt([&]()
+                             {
+                                 std::fill(dx.data(), dx.data() + d, Real(0.0));
+                                 LinAlg::sor(D, db, dx, 1.0, sweeps, 0.0); },
+                             3);
+    std::cout << std::setw(28) << "gaussSeidel (dense)" << std::setw(10) << d << std::setw(14) << tg * 1e3 / sweeps << std::endl;
+    std::cout << std::setw(28) << "sor (dense)" << std::setw(10) << d << std::setw(14) << ts * 1e3 / sweeps << std::endl;
+
+    // 稀疏：二维 5 点 Laplace，自然顺序与红黑顺序
+    const size_t g = 512, n = g * g;
+    const SparseMatrixXf L = benchGridOperator(g, 0.0);
+    const LinAlg::MatrixColoring coloring = LinAlg::colorRows(L);
+    VectorXf b(n), x(n);
+    for (size_t i = 0; i < n; ++i)
+        b[i] = dis(gen);
+    const double tn = timeIt([&]()
+                             { LinAlg::sor(L, b, x, 1.5, sweeps, 0.0); },
+                             3);
+    const double tr = timeIt([&]()
+                             { LinAlg::multicolorGaussSeidel(L, coloring, b, x, 1.5, sweeps, 0.0); },
+                             3);
+    std::cout << std::setw(28) << "sor (CSR)" << std::setw(10) << n << std::setw(14) << tn * 1e3 / sweeps << std::endl;
+    std::cout << std::setw(28) << "red-black sor (CSR)" << std::setw(10) << n << std::setw(14) << tr * 1e3 / sweeps << std::endl;
+    std::cout << "=========Relaxation Benchmark End=========" << std::endl;
+}
+
+// 线程池：空任务的调度开销，以及逐元素赋值、GEMM、点积在单线程与全部线程下的耗时
+void benchThreadPool()
+{
+    std::cout << "=========Thread Pool Benchmark=========" << std::endl;
+    const size_t threads = parallelThreads();
+    std::mt19937 gen(41);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    const double tEmpty = timeIt([&]()
+                                 {
+                                     for (int r = 0; r < 1000; ++r)
+                                         parallelFor(0, threads, 1, [](size_t, size_t) {}); },
+                                 3);
+    std::cout << "parallelFor dispatch (" << threads << " threads): " << tEmpty * 1e3 << " us" << std::endl;
+
+    const size_t n = 1024;
+    MatrixXf A(n, n), B(n, n), C(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+        {
+            A(i, j) = dis(gen);
+            B(i, j) = dis(gen);
+        }
+    VectorXf x(1 << 22), y(1 << 22);
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = dis(gen);
+        y[i] = dis(gen);
+    }
+    std::cout << std::setw(10) << "threads" << std::setw(16) << "A+2B ms" << std::setw(16) << "A*B ms" << std::setw(16) << "dot ms" << std::endl;
+    for (size_t t : {size_t(1), threads})
+    {
+        setParallelThreads(t);
+        const double ta = timeIt([&]()
+                                 { C = A + B * Real(2.0); },
+                                 5);
+        const double tg = timeIt([&]()
+                                 { C = A * B; },
+                                 3);
+        Real d;
+        const double td = timeIt([&]()
+                                 { d = x.dot(y); },
+                                 5);
+        std::cout << std::setw(10) << t << std::setw(16) << ta * 1e3 << std::setw(16) << tg * 1e3 << std::setw(16) << td * 1e3 << std::endl;
+        if (t == threads)
+            break;
+    }
+    setParallelThreads(0);
+    std::cout << "=========Thread Pool Benchmark End=========" << std::endl;
+}
+
+void benchExpressionReductions()
+{
+    std::cout << "=========Expression Reduction Benchmark=========" << std::endl;
+    std::mt19937 gen(43);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    const size_t n = 1024;
+    MatrixXf A(n, n), B(n, n), D(n, n), C(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+        {
+            A(i, j) = dis(gen);
+            B(i, j) = dis(gen);
+            D(i, j) = dis(gen);
+        }
+
+    // 融合的数据包循环与逐元素求值（转置表达式不能线性访问）对比
+    const double tLinear = timeIt([&]()
+                                  { C = A + 2.0 * B - D; },
+                                  10);
+    const MatrixXf At = A.transpose(), Bt = B.transpose(), Dt = D.transpose();
+    const double tCoeff = timeIt([&]()
+                                 { C = At.transpose() + 2.0 * Bt.transpose() - Dt.transpose(); },
+                                 10);
+    std::cout << "C = A + 2B - D (" << n << "x" << n << "): fused " << tLinear * 1e3 << " ms, per element " << tCoeff * 1e3 << " ms" << std::endl;
+
+    // 融合归约与先求值再归约对比
+    Real r;
+    const double tFused = timeIt([&]()
+                                 { r = (A - B).norm(); },
+                                 10);
+    const double tTemp = timeIt([&]()
+                                {
+                                    const MatrixXf T = A - B;
+                                    r = T.norm(); },
+                                10);
+    std::cout << "||A - B||_F: fused " << tFused * 1e3 << " ms, with temporary " << tTemp * 1e3 << " ms" << std::endl;
+    const double tMax = timeIt([&]()
+                               { r = (A + B).maxCoeff(); },
+                               10);
+    const double tDot = timeIt([&]()
+                               { r = (A - B).dot(D); },
+                               10);
+    std::cout << "max(A + B): " << tMax * 1e3 << " ms, (A - B).dot(D): " << tDot * 1e3 << " ms" << std::endl;
+    std::cout << "=========Expression Reduction Benchmark End=========" << std::endl;
+}
+
+void benchElementwiseMath()
+{
+    std::cout << "=========Elementwise Math Benchmark=========" << std::endl;
+    std::mt19937 gen(47);
+    std::uniform_real_distribution<double> dis(-5.0, 5.0);
+    const size_t n = 1024;
+    MatrixXf A(n, n), C(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            A(i, j) = dis(gen);
+
+    std::cout << std::setw(10) << "function" << std::setw(16) << "lazy ms" << std::setw(16) << "std:: loop ms" << std::endl;
+    auto row = [&](const char *name, const std::function<void()> &lazy, double (*ref)(double))
+    {
+        const double tLazy = timeIt(lazy, 5);
+        const double tRef = timeIt([&]()
+                                   {
+                                       for (size_t i = 0; i < n; ++i)
+                                           for (size_t j = 0; j < n; ++j)
+                                               C(i, j) = Real(ref(A(i, j).data)); },
+                                   5);
+        std::cout << std::setw(10) << name << std::setw(16) << tLazy * 1e3 << std::setw(16) << tRef * 1e3 << std::endl;
+    };
+    row("exp", [&]()
+        { C = exp(A); },
+        [](double x)
+        { return std::exp(x); });
+    row("sin", [&]()
+        { C = sin(A); },
+        [](double x)
+        { return std::sin(x); });
+    row("tanh", [&]()
+        { C = tanh(A); },
+        [](double x)
+        { return std::tanh(x); });
+
+    // 激活函数与归约融合：不生成中间矩阵
+    Real s;
+    const double tFused = timeIt([&]()
+                                 { s = tanh(A * 0.5).sum(); },
+                                 5);
+    std::cout << "tanh(0.5 A).sum(): " << tFused * 1e3 << " ms" << std::endl;
+    std::cout << "=========Elementwise Math Benchmark End=========" << std::endl;
+}
+void benchMatrixViews()
+{
+    std::cout << "=========Matrix View Benchmark=========" << std::endl;
+    std::mt19937 gen(53);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    const size_t n = 1024, m = 512;
+    MatrixXf A(n, n), B(n, n), C(m, m);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+        {
+            A(i, j) = dis(gen);
+            B(i, j) = dis(gen);
+        }
+
+    // 先把子块拷贝到独立矩阵再运算，对比直接在视图上运算
+    auto copyBlock = [&](const MatrixXf &src, size_t i0, size_t j0)
+    {
+        MatrixXf out(m, m);
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < m; ++j)
+                out(i, j) = src(i0 + i, j0 + j);
+        return out;
+    };
+    std::cout << std::setw(22) << "operation" << std::setw(14) << "view ms" << std::setw(14) << "copy ms" << std::endl;
+    const double tGemmView = timeIt([&]()
+                                    { C = A.block(100, 200, m, m) * B.block(300, 50, m, m); },
+                                    3);
+    const double tGemmCopy = timeIt([&]()
+                                    { C = copyBlock(A, 100, 200) * copyBlock(B, 300, 50); },
+                                    3);
+    std::cout << std::setw(22) << "block * block" << std::setw(14) << tGemmView * 1e3 << std::setw(14) << tGemmCopy * 1e3 << std::endl;
+
+    const double tAxpyView = timeIt([&]()
+                                    { C = A.block(100, 200, m, m) * 2.0 + B.block(300, 50, m, m); },
+                                    5);
+    const double tAxpyCopy = timeIt([&]()
+                                    { C = copyBlock(A, 100, 200) * 2.0 + copyBlock(B, 300, 50); },
+                                    5);
+    std::cout << std::setw(22) << "2 block + block" << std::setw(14) << tAxpyView * 1e3 << std::setw(14) << tAxpyCopy * 1e3 << std::endl;
+
+    Real s;
+    const double tNormView = timeIt([&]()
+                                    { s = A.block(100, 200, m, m).norm(); },
+                                    5);
+    const double tNormCopy = timeIt([&]()
+                                    { s = copyBlock(A, 100, 200).norm(); },
+                                    5);
+    std::cout << std::setw(22) << "block.norm()" << std::setw(14) << tNormView * 1e3 << std::setw(14) << tNormCopy * 1e3 << std::endl;
+    std::cout << "=========Matrix View Benchmark End=========" << std::endl;
+}
+void benchAliasAssignment()
+{
+    std::cout << "=========Alias Assignment Benchmark=========" << std::endl;
+    std::mt19937 gen(59);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    std::cout << std::setw(8) << "n" << std::setw(24) << "operation" << std::setw(14) << "in-place ms" << std::setw(14) << "temp ms" << std::endl;
+    for (size_t n : {64, 256, 1024})
+    {
+        MatrixXf A(n, n), B(n, n), C(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+            {
+                A(i, j) = dis(gen);
+                B(i, j) = dis(gen);
+            }
+        const int repeat = n <= 256 ? 20 : 3;
+
+        // 对照：旧的赋值方式，每次求值到新分配的矩阵再移入
+        const double tAdd = timeIt([&]()
+                                   { C = A + B; },
+                                   repeat);
+        const double tAddTemp = timeIt([&]()
+                                       {
+                                           MatrixXf tmp(A + B);
+                                           C = std::move(tmp); },
+                                       repeat);
+        std::cout << std::setw(8) << n << std::setw(24) << "C = A + B" << std::setw(14) << tAdd * 1e3 << std::setw(14) << tAddTemp * 1e3 << std::endl;
+
+        const double tAcc = timeIt([&]()
+                                   { C += A * B; },
+                                   repeat);
+        const double tAccTemp = timeIt([&]()
+                                       { C = C + (A * B).eval(); },
+                                       repeat);
+        std::cout << std::setw(8) << n << std::setw(24) << "C += A * B" << std::setw(14) << tAcc * 1e3 << std::setw(14) << tAccTemp * 1e3 << std::endl;
+
+        // 目标参与乘法：暂存区复用，不再每次分配
+        const double tSelf = timeIt([&]()
+                                    { C = C * B; },
+                                    repeat);
+        const double tSelfTemp = timeIt([&]()
+                                        {
+                                            MatrixXf tmp(C * B);
+                                            C = std::move(tmp); },
+                                        repeat);
+        std::cout << std::setw(8) << n << std::setw(24) << "C = C * B" << std::setw(14) << tSelf * 1e3 << std::setw(14) << tSelfTemp * 1e3 << std::endl;
+    }
+    std::cout << "=========Alias Assignment Benchmark End=========" << std::endl;
+}
+void benchBinaryMatrixFile()
+{
+    std::cout << "=========Binary Matrix File Benchmark=========" << std::endl;
+    std::mt19937 gen(61);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    const size_t n = 2048;
+    const std::string textPath = "oxygenmath_bench_matrix.txt", binaryPath = "oxygenmath_bench_matrix.bin";
+    MatrixXf A(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            A(i, j) = dis(gen);
+
+    // 对照：逐个元素以文本写出、解析后拷贝进矩阵
+    const double tTextWrite = timeIt([&]()
+                                     {
+                                         std::ofstream out(textPath);
+                                         out << std::setprecision(17) << n << ' ' << n << '\n';
+                                         for (size_t i = 0; i < n; ++i)
+                                         {
+                                             for (size_t j = 0; j < n; ++j)
+                                                 out << A(i, j).data << ' ';
+                                             out << '\n';
+                                         } },
+                                     1);
+    const double tBinaryWrite = timeIt([&]()
+                                       { saveBinary(binaryPath, A); },
+                                       3);
+    Real s;
+    const double tTextLoad = timeIt([&]()
+                                    {
+                                        std::ifstream in(textPath);
+                                        size_t r, c;
+                                        in >> r >> c;
+                                        MatrixXf B(r, c);
+                                        for (size_t i = 0; i < r; ++i)
+                                            for (size_t j = 0; j < c; ++j)
+                                                in >> B(i, j).data;
+                                        s = B(r - 1, c - 1); },
+                                    1);
+    const double tCopyLoad = timeIt([&]()
+                                    {
+                                        const MatrixXf B = loadBinary<Real>(binaryPath);
+                                        s = B(n - 1, n - 1); },
+                                    3);
+    // 只建立映射并读取一个元素，数据页按需载入
+    const double tMap = timeIt([&]()
+                               {
+                                   const MappedMatrixFile file(binaryPath);
+                                   s = file.view<Real>()(n - 1, n - 1); },
+                               5);
+    const double tMapSum = timeIt([&]()
+                                  {
+                                      const MappedMatrixFile file(binaryPath);
+                                      s = file.view<Real>().sum(); },
+                                  3);
+    std::cout << n << "x" << n << " doubles (" << n * n * 8 / (1 << 20) << " MiB)" << std::endl;
+    std::cout << "text write: " << tTextWrite * 1e3 << " ms, binary write: " << tBinaryWrite * 1e3 << " ms" << std::endl;
+    std::cout << "text parse: " << tTextLoad * 1e3 << " ms, binary copy load: " << tCopyLoad * 1e3
+              << " ms, mmap view: " << tMap * 1e3 << " ms, mmap view + sum: " << tMapSum * 1e3 << " ms" << std::endl;
+    std::remove(textPath.c_str());
+    std::remove(binaryPath.c_str());
+    std::cout << "=========Binary Matrix File Benchmark End=========" << std::endl;
+}
+
+void benchMatrixMarket()
+{
+    std::cout << "=========Matrix Market Benchmark=========" << std::endl;
+    std::mt19937 gen(67);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    const size_t n = 200000, nnz = 2000000;
+    const std::string path = "oxygenmath_bench_matrix.mtx";
+    std::vector<Triplet<Real>> triplets;
+    triplets.reserve(nnz);
+    for (size_t k = 0; k < nnz; ++k)
+        triplets.push_back(Triplet<Real>(gen() % n, gen() % n, Real(dis(gen))));
+    const SparseMatrix<Real> S(n, n, triplets);
+
+    const double tWrite = timeIt([&]()
+                                 { writeMatrixMarket(path, S); },
+                                 3);
+    // 对照：单线程 istream 逐个读取条目后组装
+    size_t count = 0;
+    const double tNaive = timeIt([&]()
+                                 {
+                                     std::ifstream in(path);
+                                     std::string line;
+                                     std::getline(in, line);
+                                     size_t r, c, e;
+                                     in >> r >> c >> e;
+                                     std::vector<Triplet<Real>> t(e);
+                                     for (size_t k = 0; k < e; ++k)
+                                     {
+                                         in >> t[k].row >> t[k].col >> t[k].value.data;
+                                         --t[k].row;
+                                         --t[k].col;
+                                     }
+                                     count = SparseMatrix<Real>(r, c, t).nonZeros(); },
+                                 1);
+    const double tRead = timeIt([&]()
+                                { count = readMatrixMarketSparse<Real>(path).nonZeros(); },
+                                3);
+
+    const size_t m = 1000;
+    MatrixXf A(m, m);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < m; ++j)
+            A(i, j) = dis(gen);
+    const double tDenseWrite = timeIt([&]()
+                                      { writeMatrixMarket(path, A); },
+                                      3);
+    Real s;
+    const double tDenseRead = timeIt([&]()
+                                     { s = readMatrixMarketDense<Real>(path)(m - 1, m - 1); },
+                                     3);
+    std::cout << n << "x" << n << " sparse, " << count << " nonzeros, " << parallelThreads() << " threads" << std::endl;
+    std::cout << "write: " << tWrite * 1e3 << " ms, istream read: " << tNaive * 1e3 << " ms, chunked read: " << tRead * 1e3
+              << " ms (" << tNaive / tRead << "x)" << std::endl;
+    std::cout << m << "x" << m << " dense array: write " << tDenseWrite * 1e3 << " ms, read " << tDenseRead * 1e3 << " ms" << std::endl;
+    std::remove(path.c_str());
+    std::cout << "=========Matrix Market Benchmark End=========" << std::endl;
+}
@@ -7,20 +7,22 @@ namespace OxygenMath
      * @param num 底数。
      * @return 实数的平方根
      */
-    Real sqrt(const Real &num)
+    template <typename F, typename P>
+    BasicReal<F, P> sqrt(const BasicReal<F, P> &num)
     {
-        if (num.data < 0.0)
+        if (P::checked && num.data < F(0))
             throw std::domain_error("Square root of negative number");
-        return Real(std::sqrt(num.data));
+        return BasicReal<F, P>(std::sqrt(num.data));
     }
     /**
      * @brief 计算实数的绝对值
      * @param num 底数
      * @return 实数的绝对值
      */
-    inline Real abs(const Real &num)
+    template <typename F, typename P>
+    inline BasicReal<F, P> abs(const BasicReal<F, P> &num)
     {
-        return Real(std::abs(num.data));
+        return BasicReal<F, P>(std::abs(num.data));
     }
 
     /**
@@ -29,11 +31,22 @@ namespace OxygenMath
      * @param b 第二个实数
      */
 
-    void swap(Real &a, Real &b)
+    template <typename F, typename P>
+    inline void swap(BasicReal<F, P> &a, BasicReal<F, P> &b)
     {
         std::swap(a.data, b.data);
     }
 
+    /**
+     * @brief 交换两个复数的值
+     */
+    template <typename F, typename P>
+    inline void swap(BasicComplex<F, P> &a, BasicComplex<F, P> &b)
+    {
+        std::swap(a.real, b.real);
+        std::swap(a.imag, b.imag);
+    }
+
     /////////////////////////////////////////////////////////////
     // 三角函数                                             start
     /////////////////////////////////////////////////////////////
@@ -42,87 +55,96 @@ namespace OxygenMath
      * @param angle 弧度制角度
      * @return 实数的余弦值
      */
-    inline Real cos(const Real &angle)
+    template <typename F, typename P>
+    inline BasicReal<F, P> cos(const BasicReal<F, P> &angle)
     {
-        return Real(std::cos(angle.data));
+        return BasicReal<F, P>(std::cos(angle.data));
     }
     /**
      * @brief 计算实数的正弦值
      * @param angle 弧度制角度
      * @return 实数的正弦值
      */
-    inline Real sin(const Real &angle)
+    template <typename F, typename P>
+    inline BasicReal<F, P> sin(const BasicReal<F, P> &angle)
     {
-        return Real(std::sin(angle.data));
+        return BasicReal<F, P>(std::sin(angle.data));
     }
     /**
      * @brief 计算实数的正切值
      * @param angle 弧度制角度
      * @return 实数的正切值
      */
-    Real tan(const Real &angle)
+    template <typename F, typename P>
+    BasicReal<F, P> tan(const BasicReal<F, P> &angle)
     {
-        if (std::cos(angle.data) == 0.0)
+        if (P::checked && std::cos(angle.data) == F(0))
             throw std::domain_error("Tangent undefined for angle with cos = 0");
-        return Real(std::tan(angle.data));
+        return BasicReal<F, P>(std::tan(angle.data));
     }
     /**
      * @brief 计算实数的反余弦值
      * @param value 输入值，必须在[-1, 1]范围内
      * @return 实数的反余弦值
      */
-    Real acos(const Real &value)
+    template <typename F, typename P>
+    BasicReal<F, P> acos(const BasicReal<F, P> &value)
     {
-        if (value.data < -1.0 || value.data > 1.0)
+        if (P::checked && (value.data < F(-1) || value.data > F(1)))
             throw std::domain_error("acos undefined for value outside [-1, 1]");
-        return Real(std::acos(value.data));
+        return BasicReal<F, P>(std::acos(value.data));
     }
     /**
      * @brief 计算实数的反正弦值
      * @param value 输入值，必须在[-1, 1]范围内
      * @return 实数的反正弦值
      */
-    Real asin(const Real &value)
+    template <typename F, typename P>
+    BasicReal<F, P> asin(const BasicReal<F, P> &value)
     {
-        if (value.data < -1.0 || value.data > 1.0)
+        if (P::checked && (value.data < F(-1) || value.data > F(1)))
             throw std::domain_error("asin undefined for value outside [-1, 1]");
-        return Real(std::asin(value.data));
+        return BasicReal<F, P>(std::asin(value.data));
     }
     /**
      * @brief 计算实数的反正切值
      * @param value 输入值
      * @return 实数的反正切值
      */
-    inline Real atan(const Real &value)
+    template <typename F, typename P>
+    inline BasicReal<F, P> atan(const BasicReal<F, P> &value)
     {
-        return Real(std::atan(value.data));
+        return BasicReal<F, P>(std::atan(value.data));
     }
     /**
      * @brief 计算实数的双曲正弦值
      * @param value 输入值
      * @return 实数的双曲正弦值
      */
-    inline Real sinh(const Real &value)
+    template <typename F, typename P>
+    inline BasicReal<F, P> sinh(const BasicReal<F, P> &value)
     {
-        return Real(std::sinh(value.data));
+        return BasicReal<F, P>(std::sinh(value.data));
     }
     /**
      * @brief 计算实数的双曲余弦值
      * @param value 输入值
      * @return 实数的双曲余弦值
      */
-    inline Real cosh(const Real &value)
+    template <typename F, typename P>
+    inline BasicReal<F, P> cosh(const BasicReal<F, P> &value)
     {
-        return Real(std::cosh(value.data));
+        return BasicReal<F, P>(std::cosh(value.data));
     }
     /**
      * @brief 计算实数的双曲正切值
      * @param value 输入值
      * @return 实数的双曲正切值
      */
-    inline Real tanh(const Real &value)
+    template <typename F, typename P>
+    inline BasicReal<F, P> tanh(const BasicReal<F, P> &value)
     {
-        return Real(std::tanh(value.data));
+        return BasicReal<F, P>(std::tanh(value.data));
     }
     /////////////////////////////////////////////////////////////
     // 三角函数                                               end
@@ -133,31 +155,34 @@ namespace OxygenMath
      * @param exponent 指数
      * @return 实数的指数值
      */
-    inline Real exp(const Real &exponent)
+    template <typename F, typename P>
+    inline BasicReal<F, P> exp(const BasicReal<F, P> &exponent)
     {
-        return Real(std::exp(exponent.data));
+        return BasicReal<F, P>(std::exp(exponent.data));
     }
     /**
      * @brief 计算实数的对数值
      * @param value 输入值，必须大于0
      * @return 实数的对数值
      */
-    Real log(const Real &value)
+    template <typename F, typename P>
+    BasicReal<F, P> log(const BasicReal<F, P> &value)
     {
-        if (value.data <= 0.0)
+        if (P::checked && value.data <= F(0))
             throw std::domain_error("Logarithm undefined for non-positive values");
-        return Real(std::log(value.data));
+        return BasicReal<F, P>(std::log(value.data));
     }
     /**
      * @brief 计算实数的自然对数值
      * @param value 输入值，必须大于0
      * @return 实数的自然对数值
      */
-    Real log10(const Real &value)
+    template <typename F, typename P>
+    BasicReal<F, P> log10(const BasicReal<F, P> &value)
     {
-        if (value.data <= 0.0)
+        if (P::checked && value.data <= F(0))
             throw std::domain_error("Logarithm undefined for non-positive values");
-        return Real(std::log10(value.data));
+        return BasicReal<F, P>(std::log10(value.data));
     }
 
     /**
@@ -165,25 +190,28 @@ namespace OxygenMath
      * @param num 复数
      * @return 复数的平方根
      */
-    Complex sqrt(const Complex &num)
+    template <typename F, typename P>
+    BasicComplex<F, P> sqrt(const BasicComplex<F, P> &num)
     {
-        double r = std::sqrt(std::sqrt(num.real * num.real + num.imag * num.imag));
-        double theta = std::atan2(num.imag, num.real) / 2.0;
-        return Complex(r * std::cos(theta), r * std::sin(theta));
+        F r = std::sqrt(std::sqrt(num.real * num.real + num.imag * num.imag));
+        F theta = std::atan2(num.imag, num.real) / F(2);
+        return BasicComplex<F, P>(r * std::cos(theta), r * std::sin(theta));
     }
 
-    Complex exp(const Complex &num)
+    template <typename F, typename P>
+    BasicComplex<F, P> exp(const BasicComplex<F, P> &num)
     {
-        double r = std::exp(num.real);
-        double theta = num.imag;
-        return Complex(r * std::cos(theta), r * std::sin(theta));
+        F r = std::exp(num.real);
+        F theta = num.imag;
+        return BasicComplex<F, P>(r * std::cos(theta), r * std::sin(theta));
     }
 
-    Complex log(const Complex &num)
+    template <typename F, typename P>
+    BasicComplex<F, P> log(const BasicComplex<F, P> &num)
     {
-        if (num.real <= 0.0)
+        if (P::checked && num.real <= F(0))
             throw std::domain_error("Logarithm undefined for non-positive values");
-        return Complex(std::log(std::sqrt(num.real * num.real + num.imag * num.imag)), std::atan2(num.imag, num.real));
+        return BasicComplex<F, P>(std::log(std::sqrt(num.real * num.real + num.imag * num.imag)), std::atan2(num.imag, num.real));
     }
 
 }
\ No newline at end of file
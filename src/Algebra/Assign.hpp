@@ -0,0 +1,949 @@
+/**
+ * @file Assign.hpp
+ * @brief 表达式求值：把矩阵表达式写入一块行主序的目标内存。
+ * @details 一般表达式通过与表达式树同构的求值器（Evaluator）逐元素求值；
+ *          叶子都是按行连续存储的实数矩阵/向量/视图的逐元素表达式（加、减、数乘、exp 等逐元素函数）改用线性访问求值器
+ *          （LinearEvaluator），以 SIMD 数据包为单位融合成一个循环：目标与所有叶子都连续时按一维下标遍历，
+ *          否则（视图、行跨度不等于列数的目标）逐行遍历；
+ *          矩阵乘法节点整体求值，操作数都能直接访问底层内存（矩阵、向量、视图或它们的转置）
+ *          且元素为实数时，转交 Gemm.hpp 中的分块 GEMM 内核。
+ *          元素个数达到 ParallelAssignThreshold 时，逐元素求值按行分块交给线程池并行执行，
+ *          求值器在所有线程间共享（乘法节点等子表达式仍只求值一次）。
+ *          对矩阵、向量、视图赋值时（assignTo）先做别名分析：表达式不会读到已被改写的元素时直接写入目标，
+ *          例如 A = B + C、A = A * 2.0 + B；只有目标自身参与乘法或转置（A = A * B、A = A.transpose()）、
+ *          或与目标错位重叠的视图参与运算时，才先求值到线程局部的可复用暂存区再拷贝。
+ */
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include "NumberField.hpp"
+#include "MatrixExpr.hpp"
+#include "Simd.hpp"
+#include "Gemm.hpp"
+#include "DenseStorage.hpp"
+#include "../Parallel/ParallelFor.hpp"
+
+namespace OxygenMath
+{
+    template <typename T, size_t Rows, size_t Cols>
+    class MatrixNM;
+
+    template <typename T, size_t N>
+    class VectorN;
+
+    template <typename T>
+    class MatrixView;
+
+    namespace internal
+    {
+        /**
+         * @brief 标量类型对应的底层浮点类型，value 为 true 时可按该浮点类型数组访问
+         */
+        template <typename T>
+        struct RawScalar
+        {
+            static constexpr bool value = false;
+        };
+
+        template <typename F, typename P>
+        struct RawScalar<BasicReal<F, P>>
+        {
+            static_assert(sizeof(BasicReal<F, P>) == sizeof(F) && std::is_standard_layout<BasicReal<F, P>>::value,
+                          "BasicReal must be layout compatible with its underlying floating-point type");
+            static constexpr bool value = std::is_same<F, double>::value || std::is_same<F, float>::value;
+            using type = F;
+            using Policy = P;
+        };
+
+        /**
+         * @brief 直接访问特征：元素 (i, j) 位于 data(e)[i * rowStride(e) + j * colStride(e)]
+         */
+        template <typename E>
+        struct DirectAccess
+        {
+            static constexpr bool value = false;
+        };
+
+        template <typename T, size_t Rows, size_t Cols>
+        struct DirectAccess<MatrixNM<T, Rows, Cols>>
+        {
+            static constexpr bool value = true;
+            using Scalar = T;
+            static const T *data(const MatrixNM<T, Rows, Cols> &m) { return m.data(); }
+            static size_t rowStride(const MatrixNM<T, Rows, Cols> &m) { return m.cols(); }
+            static size_t colStride(const MatrixNM<T, Rows, Cols> &) { return 1; }
+        };
+
+        // 向量无论行列方向，第 i 个元素都位于 data()[i]
+        template <typename T, size_t N>
+        struct DirectAccess<VectorN<T, N>>
+        {
+            static constexpr bool value = true;
+            using Scalar = T;
+            static const T *data(const VectorN<T, N> &v) { return v.data(); }
+            static size_t rowStride(const VectorN<T, N> &) { return 1; }
+            static size_t colStride(const VectorN<T, N> &) { return 1; }
+        };
+
+        // 视图：行跨度为 stride()，列跨度为 1
+        template <typename T>
+        struct DirectAccess<MatrixView<T>>
+        {
+            static constexpr bool value = true;
+            using Scalar = typename std::remove_const<T>::type;
+            static const Scalar *data(const MatrixView<T> &v) { return v.data(); }
+            static size_t rowStride(const MatrixView<T> &v) { return v.stride(); }
+            static size_t colStride(const MatrixView<T> &) { return 1; }
+        };
+
+        template <typename Mat, bool = DirectAccess<Mat>::value>
+        struct TransposeAccess
+        {
+            static constexpr bool value = false;
+        };
+
+        template <typename Mat>
+        struct TransposeAccess<Mat, true>
+        {
+            static constexpr bool value = true;
+            using Scalar = typename DirectAccess<Mat>::Scalar;
+            static const Scalar *data(const MatrixTranspose<Mat> &t) { return DirectAccess<Mat>::data(t.mat); }
+            static size_t rowStride(const MatrixTranspose<Mat> &t) { return DirectAccess<Mat>::colStride(t.mat); }
+            static size_t colStride(const MatrixTranspose<Mat> &t) { return DirectAccess<Mat>::rowStride(t.mat); }
+        };
+
+        // 转置只交换步长，不拷贝数据
+        template <typename Mat>
+        struct DirectAccess<MatrixTranspose<Mat>> : TransposeAccess<Mat>
+        {
+        };
+
+        /**
+         * @brief 判断乘法节点能否交给 GEMM 内核
+         */
+        template <typename T, typename Lhs, typename Rhs>
+        struct CanUseGemm
+        {
+            template <typename E, bool = DirectAccess<E>::value>
+            struct ScalarIs : std::false_type
+            {
+            };
+            template <typename E>
+            struct ScalarIs<E, true> : std::is_same<typename DirectAccess<E>::Scalar, T>
+            {
+            };
+
+            static constexpr bool value = RawScalar<T>::value && ScalarIs<Lhs>::value && ScalarIs<Rhs>::value;
+        };
+
+        /**
+         * @brief 乘法操作数：能直接访问内存的按引用使用，其余先求值到临时矩阵（只求值一次）
+         */
+        template <typename E, bool = DirectAccess<E>::value>
+        struct ProductOperand
+        {
+            using type = E;
+            const E &value;
+            explicit ProductOperand(const E &e) : value(e) {}
+        };
+
+        template <typename E>
+        struct ProductOperand<E, false>
+        {
+            using type = typename ExprTraits<E>::PlainObject;
+            const type value;
+            explicit ProductOperand(const E &e) : value(e) {}
+        };
+
+        /**
+         * @brief 表达式求值器
+         * @details 与表达式树同构。赋值时先由表达式构造求值器，再逐元素调用 coeff(i, j)：
+         *          - 普通对象及其转置直接读内存，不做越界检查；
+         *          - 乘法节点在构造求值器时整体求值到临时矩阵，外层节点读取该临时矩阵，
+         *            因此 A * B + C、(A * B).transpose() 中的乘积只计算一次。
+         *          未特化的表达式类型退化为调用 operator()(i, j)。
+         */
+        template <typename E, typename Enable = void>
+        struct Evaluator
+        {
+            const E &expr;
+            explicit Evaluator(const E &e) : expr(e) {}
+            auto coeff(size_t i, size_t j) const -> decltype(expr(i, j)) { return expr(i, j); }
+        };
+
+        template <typename E>
+        struct Evaluator<E, typename std::enable_if<DirectAccess<E>::value>::type>
+        {
+            using Scalar = typename DirectAccess<E>::Scalar;
+            const Scalar *ptr;
+            size_t rowStride, colStride;
+            explicit Evaluator(const E &e)
+                : ptr(DirectAccess<E>::data(e)), rowStride(DirectAccess<E>::rowStride(e)),
+                  colStride(DirectAccess<E>::colStride(e)) {}
+            const Scalar &coeff(size_t i, size_t j) const { return ptr[i * rowStride + j * colStride]; }
+        };
+
+        template <typename Lhs, typename Rhs>
+        struct Evaluator<MatrixAdd<Lhs, Rhs>>
+        {
+            Evaluator<Lhs> lhs;
+            Evaluator<Rhs> rhs;
+            explicit Evaluator(const MatrixAdd<Lhs, Rhs> &e) : lhs(e.lhs), rhs(e.rhs) {}
+            auto coeff(size_t i, size_t j) const -> decltype(lhs.coeff(i, j) + rhs.coeff(i, j))
+            {
+                return lhs.coeff(i, j) + rhs.coeff(i, j);
+            }
+        };
+
+        template <typename Lhs, typename Rhs>
+        struct Evaluator<MatrixSub<Lhs, Rhs>>
+        {
+            Evaluator<Lhs> lhs;
+            Evaluator<Rhs> rhs;
+            explicit Evaluator(const MatrixSub<Lhs, Rhs> &e) : lhs(e.lhs), rhs(e.rhs) {}
+            auto coeff(size_t i, size_t j) const -> decltype(lhs.coeff(i, j) - rhs.coeff(i, j))
+            {
+                return lhs.coeff(i, j) - rhs.coeff(i, j);
+            }
+        };
+
+        template <typename Mat, typename S>
+        struct Evaluator<MatrixScalarMul<Mat, S>>
+        {
+            Evaluator<Mat> mat;
+            const S scalar;
+            explicit Evaluator(const MatrixScalarMul<Mat, S> &e) : mat(e.mat), scalar(e.scalar) {}
+            auto coeff(size_t i, size_t j) const -> decltype(mat.coeff(i, j) * scalar)
+            {
+                return mat.coeff(i, j) * scalar;
+            }
+        };
+
+        template <typename S, typename Mat>
+        struct Evaluator<ScalarMatrixMul<S, Mat>>
+        {
+            const S scalar;
+            Evaluator<Mat> mat;
+            explicit Evaluator(const ScalarMatrixMul<S, Mat> &e) : scalar(e.scalar), mat(e.mat) {}
+            auto coeff(size_t i, size_t j) const -> decltype(scalar * mat.coeff(i, j))
+            {
+                return scalar * mat.coeff(i, j);
+            }
+        };
+
+        template <typename Mat>
+        struct Evaluator<MatrixTranspose<Mat>, typename std::enable_if<!DirectAccess<MatrixTranspose<Mat>>::value>::type>
+        {
+            Evaluator<Mat> mat;
+            explicit Evaluator(const MatrixTranspose<Mat> &e) : mat(e.mat) {}
+            auto coeff(size_t i, size_t j) const -> decltype(mat.coeff(j, i)) { return mat.coeff(j, i); }
+        };
+
+        template <typename Mat, typename S>
+        struct Evaluator<MatrixCast<Mat, S>>
+        {
+            Evaluator<Mat> mat;
+            explicit Evaluator(const MatrixCast<Mat, S> &e) : mat(e.mat) {}
+            S coeff(size_t i, size_t j) const { return S(mat.coeff(i, j)); }
+        };
+
+        template <typename Mat, typename Op>
+        struct Evaluator<MatrixUnaryOp<Mat, Op>>
+        {
+            Evaluator<Mat> mat;
+            explicit Evaluator(const MatrixUnaryOp<Mat, Op> &e) : mat(e.mat) {}
+            auto coeff(size_t i, size_t j) const -> decltype(Op::apply(mat.coeff(i, j))) { return Op::apply(mat.coeff(i, j)); }
+        };
+
+        template <typename Lhs, typename Rhs>
+        struct Evaluator<MatrixMul<Lhs, Rhs>>
+        {
+            using Plain = typename ExprTraits<MatrixMul<Lhs, Rhs>>::PlainObject;
+            const Plain result;
+            explicit Evaluator(const MatrixMul<Lhs, Rhs> &e) : result(e) {}
+            auto coeff(size_t i, size_t j) const -> decltype(result(i, j)) { return result(i, j); }
+        };
+
+        /**
+         * @brief 线性访问求值器：按行主序的一维下标 k 读取表达式的元素
+         * @details 所有叶子的每一行都连续存储（矩阵、向量、视图）、元素为同一种实数类型时 value 为 true。
+         *          元素 (i, j) 由 coeff(i, j) 读取，packet(i, j) 一次读取同一行的 Packet<F>::size 个元素；
+         *          contiguous(r, c) 为 true 时所有叶子的行首尾相接，第 k 个元素等于底层浮点数组的第 k 项
+         *          经过逐元素运算的结果，可以用一维下标的 coeff(k)、packet(k) 跨行读取。
+         *          因此 C = A + 2.0 * B - D 这样的表达式可以编译成一个融合的向量循环。
+         *          乘法节点整体求值到临时矩阵后作为叶子参与运算。
+         */
+        template <typename E, typename Enable = void>
+        struct LinearEvaluator
+        {
+            static constexpr bool value = false;
+        };
+
+        // 叶子：直接读取底层浮点数组，元素 (i, j) 位于 ptr[i * stride + j]
+        template <typename T>
+        struct LinearLeaf
+        {
+            static constexpr bool value = true;
+            using Scalar = T;
+            using F = typename RawScalar<T>::type;
+            using P = simd::Packet<F>;
+            const F *ptr;
+            size_t stride;
+            LinearLeaf(const T *data, size_t stride) : ptr(reinterpret_cast<const F *>(data)), stride(stride) {}
+            F coeff(size_t k) const { return ptr[k]; }
+            typename P::type packet(size_t k) const { return P::loadu(ptr + k); }
+            F coeff(size_t i, size_t j) const { return ptr[i * stride + j]; }
+            typename P::type packet(size_t i, size_t j) const { return P::loadu(ptr + i * stride + j); }
+            bool contiguous(size_t r, size_t c) const { return r <= 1 || stride == c; }
+        };
+
+        template <typename T, size_t Rows, size_t Cols>
+        struct LinearEvaluator<MatrixNM<T, Rows, Cols>, typename std::enable_if<RawScalar<T>::value>::type>
+            : LinearLeaf<T>
+        {
+            explicit LinearEvaluator(const MatrixNM<T, Rows, Cols> &m) : LinearLeaf<T>(m.data(), m.cols()) {}
+        };
+
+        // 向量按下标连续存储：行向量只有第 0 行，列向量只有第 0 列，行跨度取 1 即可
+        template <typename T, size_t N>
+        struct LinearEvaluator<VectorN<T, N>, typename std::enable_if<RawScalar<T>::value>::type>
+            : LinearLeaf<T>
+        {
+            explicit LinearEvaluator(const VectorN<T, N> &v) : LinearLeaf<T>(v.data(), 1) {}
+        };
+
+        template <typename T>
+        struct LinearEvaluator<MatrixView<T>, typename std::enable_if<RawScalar<typename std::remove_const<T>::type>::value>::type>
+            : LinearLeaf<typename std::remove_const<T>::type>
+        {
+            explicit LinearEvaluator(const MatrixView<T> &v)
+                : LinearLeaf<typename std::remove_const<T>::type>(v.data(), v.stride()) {}
+        };
+
+        // 两个操作数都可线性访问且元素类型相同
+        template <typename Lhs, typename Rhs, bool = LinearEvaluator<Lhs>::value && LinearEvaluator<Rhs>::value>
+        struct LinearPair : std::false_type
+        {
+        };
+
+        template <typename Lhs, typename Rhs>
+        struct LinearPair<Lhs, Rhs, true>
+            : std::is_same<typename LinearEvaluator<Lhs>::Scalar, typename LinearEvaluator<Rhs>::Scalar>
+        {
+        };
+
+        // 数乘的标量：算术类型或与矩阵元素相同的实数类型，换成底层浮点数后结果与逐元素求值一致
+        template <typename T, typename S, typename Enable = void>
+        struct LinearScalar
+        {
+            static constexpr bool value = false;
+        };
+
+        template <typename T, typename S>
+        struct LinearScalar<T, S, typename std::enable_if<std::is_arithmetic<S>::value>::type>
+        {
+            static constexpr bool value = true;
+            static typename RawScalar<T>::type get(const S &s) { return static_cast<typename RawScalar<T>::type>(s); }
+        };
+
+        template <typename T>
+        struct LinearScalar<T, T>
+        {
+            static constexpr bool value = true;
+            static typename RawScalar<T>::type get(const T &s) { return s.data; }
+        };
+
+        template <typename Mat, typename S, bool = LinearEvaluator<Mat>::value>
+        struct LinearScaled : std::false_type
+        {
+        };
+
+        template <typename Mat, typename S>
+        struct LinearScaled<Mat, S, true>
+            : std::integral_constant<bool, LinearScalar<typename LinearEvaluator<Mat>::Scalar, S>::value>
+        {
+        };
+
+        template <typename Lhs, typename Rhs>
+        struct LinearEvaluator<MatrixAdd<Lhs, Rhs>, typename std::enable_if<LinearPair<Lhs, Rhs>::value>::type>
+        {
+            static constexpr bool value = true;
+            using Scalar = typename LinearEvaluator<Lhs>::Scalar;
+            using F = typename LinearEvaluator<Lhs>::F;
+            using P = simd::Packet<F>;
+            LinearEvaluator<Lhs> lhs;
+            LinearEvaluator<Rhs> rhs;
+            explicit LinearEvaluator(const MatrixAdd<Lhs, Rhs> &e) : lhs(e.lhs), rhs(e.rhs) {}
+            F coeff(size_t k) const { return lhs.coeff(k) + rhs.coeff(k); }
+            typename P::type packet(size_t k) const { return P::add(lhs.packet(k), rhs.packet(k)); }
+            F coeff(size_t i, size_t j) const { return lhs.coeff(i, j) + rhs.coeff(i, j); }
+            typename P::type packet(size_t i, size_t j) const { return P::add(lhs.packet(i, j), rhs.packet(i, j)); }
+            bool contiguous(size_t r, size_t c) const { return lhs.contiguous(r, c) && rhs.contiguous(r, c); }
+        };
+
+        template <typename Lhs, typename Rhs>
+        struct LinearEvaluator<MatrixSub<Lhs, Rhs>, typename std::enable_if<LinearPair<Lhs, Rhs>::value>::type>
+        {
+            static constexpr bool value = true;
+            using Scalar = typename LinearEvaluator<Lhs>::Scalar;
+            using F = typename LinearEvaluator<Lhs>::F;
+            using P = simd::Packet<F>;
+            LinearEvaluator<Lhs> lhs;
+            LinearEvaluator<Rhs> rhs;
+            explicit LinearEvaluator(const MatrixSub<Lhs, Rhs> &e) : lhs(e.lhs), rhs(e.rhs) {}
+            F coeff(size_t k) const { return lhs.coeff(k) - rhs.coeff(k); }
+            typename P::type packet(size_t k) const { return P::sub(lhs.packet(k), rhs.packet(k)); }
+            F coeff(size_t i, size_t j) const { return lhs.coeff(i, j) - rhs.coeff(i, j); }
+            typename P::type packet(size_t i, size_t j) const { return P::sub(lhs.packet(i, j), rhs.packet(i, j)); }
+            bool contiguous(size_t r, size_t c) const { return lhs.contiguous(r, c) && rhs.contiguous(r, c); }
+        };
+
+        template <typename Mat, typename S>
+        struct LinearEvaluator<MatrixScalarMul<Mat, S>, typename std::enable_if<LinearScaled<Mat, S>::value>::type>
+        {
+            static constexpr bool value = true;
+            using Scalar = typename LinearEvaluator<Mat>::Scalar;
+            using F = typename LinearEvaluator<Mat>::F;
+            using P = simd::Packet<F>;
+            LinearEvaluator<Mat> mat;
+            const F scalar;
+            explicit LinearEvaluator(const MatrixScalarMul<Mat, S> &e)
+                : mat(e.mat), scalar(LinearScalar<Scalar, S>::get(e.scalar)) {}
+            F coeff(size_t k) const { return mat.coeff(k) * scalar; }
+            typename P::type packet(size_t k) const { return P::mul(mat.packet(k), P::set1(scalar)); }
+            F coeff(size_t i, size_t j) const { return mat.coeff(i, j) * scalar; }
+            typename P::type packet(size_t i, size_t j) const { return P::mul(mat.packet(i, j), P::set1(scalar)); }
+            bool contiguous(size_t r, size_t c) const { return mat.contiguous(r, c); }
+        };
+
+        template <typename S, typename Mat>
+        struct LinearEvaluator<ScalarMatrixMul<S, Mat>, typename std::enable_if<LinearScaled<Mat, S>::value>::type>
+        {
+            static constexpr bool value = true;
+            using Scalar = typename LinearEvaluator<Mat>::Scalar;
+            using F = typename LinearEvaluator<Mat>::F;
+            using P = simd::Packet<F>;
+            const F scalar;
+            LinearEvaluator<Mat> mat;
+            explicit LinearEvaluator(const ScalarMatrixMul<S, Mat> &e)
+                : scalar(LinearScalar<Scalar, S>::get(e.scalar)), mat(e.mat) {}
+            F coeff(size_t k) const { return scalar * mat.coeff(k); }
+            typename P::type packet(size_t k) const { return P::mul(P::set1(scalar), mat.packet(k)); }
+            F coeff(size_t i, size_t j) const { return scalar * mat.coeff(i, j); }
+            typename P::type packet(size_t i, size_t j) const { return P::mul(P::set1(scalar), mat.packet(i, j)); }
+            bool contiguous(size_t r, size_t c) const { return mat.contiguous(r, c); }
+        };
+
+        // 逐元素函数：数据包与尾部元素使用同一个多项式内核（Op::packet），结果与逐元素求值一致
+        template <typename Mat, typename Op>
+        struct LinearEvaluator<MatrixUnaryOp<Mat, Op>, typename std::enable_if<LinearEvaluator<Mat>::value>::type>
+        {
+            static constexpr bool value = true;
+            using Scalar = typename LinearEvaluator<Mat>::Scalar;
+            using F = typename LinearEvaluator<Mat>::F;
+            using P = simd::Packet<F>;
+            static constexpr bool checked = RawScalar<Scalar>::Policy::checked;
+            LinearEvaluator<Mat> mat;
+            explicit LinearEvaluator(const MatrixUnaryOp<Mat, Op> &e) : mat(e.mat) {}
+            F coeff(size_t k) const { return Op::template packet<simd::ScalarPacket<F>, checked>(mat.coeff(k)); }
+            typename P::type packet(size_t k) const { return Op::template packet<P, checked>(mat.packet(k)); }
+            F coeff(size_t i, size_t j) const
+            {
+                return Op::template packet<simd::ScalarPacket<F>, checked>(mat.coeff(i, j));
+            }
+            typename P::type packet(size_t i, size_t j) const { return Op::template packet<P, checked>(mat.packet(i, j)); }
+            bool contiguous(size_t r, size_t c) const { return mat.contiguous(r, c); }
+        };
+
+        // 乘法节点：整体求值一次，结果作为连续存储的叶子
+        template <typename Lhs, typename Rhs>
+        struct LinearEvaluator<MatrixMul<Lhs, Rhs>,
+                               typename std::enable_if<RawScalar<typename ExprTraits<MatrixMul<Lhs, Rhs>>::Scalar>::value>::type>
+        {
+            using Plain = typename ExprTraits<MatrixMul<Lhs, Rhs>>::PlainObject;
+            static constexpr bool value = true;
+            using Scalar = typename ExprTraits<MatrixMul<Lhs, Rhs>>::Scalar;
+            using F = typename RawScalar<Scalar>::type;
+            using P = simd::Packet<F>;
+            const Plain result;
+            const F *ptr;
+            explicit LinearEvaluator(const MatrixMul<Lhs, Rhs> &e)
+                : result(e), ptr(reinterpret_cast<const F *>(result.data())) {}
+            LinearEvaluator(const LinearEvaluator &other)
+                : result(other.result), ptr(reinterpret_cast<const F *>(result.data())) {}
+            F coeff(size_t k) const { return ptr[k]; }
+            typename P::type packet(size_t k) const { return P::loadu(ptr + k); }
+            F coeff(size_t i, size_t j) const { return ptr[i * result.cols() + j]; }
+            typename P::type packet(size_t i, size_t j) const { return P::loadu(ptr + i * result.cols() + j); }
+            bool contiguous(size_t, size_t) const { return true; }
+        };
+
+        // 表达式可按线性下标写入元素类型为 T 的目标
+        template <typename T, typename Expr, bool = LinearEvaluator<Expr>::value>
+        struct LinearAssign : std::false_type
+        {
+        };
+
+        template <typename T, typename Expr>
+        struct LinearAssign<T, Expr, true> : std::is_same<typename LinearEvaluator<Expr>::Scalar, T>
+        {
+        };
+
+        // 逐元素求值时，元素个数达到该值才分给多个线程
+        constexpr size_t ParallelAssignThreshold = 1 << 16;
+
+        // 归约（点积等）每块至少处理的元素个数
+        constexpr size_t ParallelReduceGrain = 1 << 15;
+
+        template <typename T, typename Expr, bool Linear = LinearAssign<T, Expr>::value>
+        struct AssignKernel
+        {
+            // 逐元素求值，规模较大时按行并行
+            static void run(T *dst, size_t ld, const Expr &expr)
+            {
+                const size_t r = expr.rows(), c = expr.cols();
+                Evaluator<Expr> ev(expr);
+                auto rows = [&](size_t i0, size_t i1)
+                {
+                    for (size_t i = i0; i < i1; ++i)
+                        for (size_t j = 0; j < c; ++j)
+                            dst[i * ld + j] = ev.coeff(i, j);
+                };
+                if (r * c < ParallelAssignThreshold || r == 1)
+                    rows(0, r);
+                else
+                    parallelFor(0, r, std::max<size_t>(1, ParallelAssignThreshold / 4 / std::max<size_t>(c, 1)), rows);
+            }
+        };
+
+        template <typename T, typename Expr>
+        struct AssignKernel<T, Expr, true>
+        {
+            // 目标与叶子都连续时按一维下标以数据包为单位求值，规模较大时按连续区间并行；否则逐行求值
+            static void run(T *dst, size_t ld, const Expr &expr)
+            {
+                const size_t r = expr.rows(), c = expr.cols();
+                typedef typename LinearEvaluator<Expr>::F F;
+                typedef simd::Packet<F> P;
+                LinearEvaluator<Expr> ev(expr);
+                F *out = reinterpret_cast<F *>(dst);
+                if ((ld != c && r > 1) || !ev.contiguous(r, c))
+                {
+                    const size_t packetEnd = c / P::size * P::size;
+                    auto rows = [&](size_t i0, size_t i1)
+                    {
+                        for (size_t i = i0; i < i1; ++i)
+                        {
+                            F *row = out + i * ld;
+                            size_t j = 0;
+                            for (; j < packetEnd; j += P::size)
+                                P::storeu(row + j, ev.packet(i, j));
+                            for (; j < c; ++j)
+                                row[j] = ev.coeff(i, j);
+                        }
+                    };
+                    if (r * c < ParallelAssignThreshold || r == 1)
+                        rows(0, r);
+                    else
+                        parallelFor(0, r, std::max<size_t>(1, ParallelAssignThreshold / 4 / std::max<size_t>(c, 1)), rows);
+                    return;
+                }
+                auto range = [&](size_t k0, size_t k1)
+                {
+                    // 整包部分按长度取整，尾部不足一包，GCC 不会把 k + P::size 的回绕当作可能的迭代次数
+                    const size_t packetEnd = k0 + (k1 - k0) / P::size * P::size;
+                    size_t k = k0;
+                    for (; k < packetEnd; k += P::size)
+                        P::storeu(out + k, ev.packet(k));
+                    for (; k < k1; ++k)
+                        out[k] = ev.coeff(k);
+                };
+                const size_t n = r * c;
+                if (n < ParallelAssignThreshold)
+                    range(0, n);
+                else
+                    parallelFor(0, n, ParallelAssignThreshold / 4, range);
+            }
+        };
+
+        /**
+         * @brief 通用求值：把表达式写入 dst（行跨度 ld）
+         * @details 可线性访问的逐元素表达式走融合的数据包循环，其余表达式逐元素求值；规模较大时并行。
+         */
+        template <typename T, typename Expr>
+        void evaluateTo(T *dst, size_t ld, const Expr &expr)
+        {
+            AssignKernel<T, Expr>::run(dst, ld, expr);
+        }
+
+        template <typename T, typename Lhs, typename Rhs, bool UseGemm = CanUseGemm<T, Lhs, Rhs>::value>
+        struct ProductKernel
+        {
+            // 非实数元素：i-k-j 顺序的三重循环，每个操作数元素只读取一次
+            static void run(T *dst, size_t ld, const Lhs &lhs, const Rhs &rhs)
+            {
+                const size_t m = lhs.rows(), n = rhs.cols(), k = lhs.cols();
+                Evaluator<Lhs> a(lhs);
+                Evaluator<Rhs> b(rhs);
+                for (size_t i = 0; i < m; ++i)
+                {
+                    T *c = dst + i * ld;
+                    for (size_t j = 0; j < n; ++j)
+                        c[j] = T::zero();
+                    for (size_t p = 0; p < k; ++p)
+                    {
+                        const T aip = a.coeff(i, p);
+                        for (size_t j = 0; j < n; ++j)
+                            c[j] += aip * b.coeff(p, j);
+                    }
+                }
+            }
+
+            // dst += lhs * rhs（subtract 为 true 时 dst -= lhs * rhs）
+            static void accumulate(T *dst, size_t ld, const Lhs &lhs, const Rhs &rhs, bool subtract)
+            {
+                const size_t m = lhs.rows(), n = rhs.cols(), k = lhs.cols();
+                Evaluator<Lhs> a(lhs);
+                Evaluator<Rhs> b(rhs);
+                for (size_t i = 0; i < m; ++i)
+                {
+                    T *c = dst + i * ld;
+                    for (size_t p = 0; p < k; ++p)
+                    {
+                        const T aip = subtract ? T::zero() - a.coeff(i, p) : T(a.coeff(i, p));
+                        for (size_t j = 0; j < n; ++j)
+                            c[j] += aip * b.coeff(p, j);
+                    }
+                }
+            }
+        };
+
+        template <typename T, typename Lhs, typename Rhs>
+        struct ProductKernel<T, Lhs, Rhs, true>
+        {
+            static void run(T *dst, size_t ld, const Lhs &lhs, const Rhs &rhs)
+            {
+                multiply(dst, ld, lhs, rhs, 1, 0);
+            }
+
+            // beta = 1：乘积直接累加到 dst，不经过临时矩阵
+            static void accumulate(T *dst, size_t ld, const Lhs &lhs, const Rhs &rhs, bool subtract)
+            {
+                multiply(dst, ld, lhs, rhs, subtract ? -1 : 1, 1);
+            }
+
+            // dst = alpha * lhs * rhs + beta * dst
+            static void multiply(T *dst, size_t ld, const Lhs &lhs, const Rhs &rhs, int alpha, int beta)
+            {
+                typedef typename RawScalar<T>::type F;
+                typedef DirectAccess<Lhs> LA;
+                typedef DirectAccess<Rhs> RA;
+                gemm<F>(lhs.rows(), rhs.cols(), lhs.cols(), F(alpha),
+                        reinterpret_cast<const F *>(LA::data(lhs)), LA::rowStride(lhs), LA::colStride(lhs),
+                        reinterpret_cast<const F *>(RA::data(rhs)), RA::rowStride(rhs), RA::colStride(rhs),
+                        F(beta), reinterpret_cast<F *>(dst), ld);
+            }
+        };
+
+        /**
+         * @brief 乘法节点求值：先把非普通对象的操作数各求值一次，
+         *        满足条件时走分块 GEMM，否则使用 i-k-j 三重循环
+         * @note dst 不得与直接访问内存的操作数重叠，调用方通过 assignTo 的别名分析保证
+         */
+        template <typename T, typename Lhs, typename Rhs>
+        void evaluateTo(T *dst, size_t ld, const MatrixMul<Lhs, Rhs> &expr)
+        {
+            ProductOperand<Lhs> lhs(expr.lhs);
+            ProductOperand<Rhs> rhs(expr.rhs);
+            ProductKernel<T, typename ProductOperand<Lhs>::type, typename ProductOperand<Rhs>::type>::run(
+                dst, ld, lhs.value, rhs.value);
+        }
+
+        /**
+         * @brief 别名分析中的目标存储：[begin, end) 为覆盖的地址范围，data、ld 为首地址与行跨度
+         */
+        struct AliasTarget
+        {
+            const void *begin;
+            const void *end;
+            const void *data;
+            size_t ld;
+        };
+
+        inline bool overlaps(const void *b0, const void *e0, const void *b1, const void *e1)
+        {
+            const std::less<const void *> less;
+            return less(b0, e1) && less(b1, e0);
+        }
+
+        /**
+         * @brief 别名分析：写入目标的过程中，表达式是否可能读到已被改写的元素
+         * @details unsafe(e, target, elementwise) 按表达式树递归：
+         *          - 叶子的存储与目标不重叠时安全；elementwise 为 true（从根到叶子只经过逐元素节点）时，
+         *            与目标首地址、行跨度都相同的叶子也安全，因为元素 (i, j) 在写入之前只被读取一次；
+         *          - 转置节点以下按 elementwise = false 检查；
+         *          - 嵌套的乘法节点在构造求值器时已求值到独立的临时矩阵，总是安全。
+         *          未特化的表达式类型无法确定读取的存储，按不安全处理。
+         */
+        template <typename E, typename Enable = void>
+        struct AliasCheck
+        {
+            static bool unsafe(const E &, const AliasTarget &, bool) { return true; }
+        };
+
+        // 叶子：矩阵、向量、视图
+        template <typename E>
+        struct AliasLeaf
+        {
+            static bool unsafe(const E &e, const AliasTarget &target, bool elementwise)
+            {
+                const size_t r = e.rows(), c = e.cols();
+                if (r == 0 || c == 0)
+                    return false;
+                typedef DirectAccess<E> A;
+                const typename A::Scalar *p = A::data(e);
+                const size_t ld = A::rowStride(e);
+                if (!overlaps(p, p + (r - 1) * ld + (c - 1) * A::colStride(e) + 1, target.begin, target.end))
+                    return false;
+                return !(elementwise && p == target.data && (r == 1 || ld == target.ld));
+            }
+        };
+
+        template <typename T, size_t Rows, size_t Cols>
+        struct AliasCheck<MatrixNM<T, Rows, Cols>> : AliasLeaf<MatrixNM<T, Rows, Cols>>
+        {
+        };
+
+        template <typename T, size_t N>
+        struct AliasCheck<VectorN<T, N>> : AliasLeaf<VectorN<T, N>>
+        {
+        };
+
+        template <typename T>
+        struct AliasCheck<MatrixView<T>> : AliasLeaf<MatrixView<T>>
+        {
+        };
+
+        template <typename Lhs, typename Rhs>
+        struct AliasCheck<MatrixAdd<Lhs, Rhs>>
+        {
+            static bool unsafe(const MatrixAdd<Lhs, Rhs> &e, const AliasTarget &target, bool elementwise)
+            {
+                return AliasCheck<Lhs>::unsafe(e.lhs, target, elementwise) || AliasCheck<Rhs>::unsafe(e.rhs, target, elementwise);
+            }
+        };
+
+        template <typename Lhs, typename Rhs>
+        struct AliasCheck<MatrixSub<Lhs, Rhs>>
+        {
+            static bool unsafe(const MatrixSub<Lhs, Rhs> &e, const AliasTarget &target, bool elementwise)
+            {
+                return AliasCheck<Lhs>::unsafe(e.lhs, target, elementwise) || AliasCheck<Rhs>::unsafe(e.rhs, target, elementwise);
+            }
+        };
+
+        template <typename Mat, typename S>
+        struct AliasCheck<MatrixScalarMul<Mat, S>>
+        {
+            static bool unsafe(const MatrixScalarMul<Mat, S> &e, const AliasTarget &target, bool elementwise)
+            {
+                return AliasCheck<Mat>::unsafe(e.mat, target, elementwise);
+            }
+        };
+
+        template <typename S, typename Mat>
+        struct AliasCheck<ScalarMatrixMul<S, Mat>>
+        {
+            static bool unsafe(const ScalarMatrixMul<S, Mat> &e, const AliasTarget &target, bool elementwise)
+            {
+                return AliasCheck<Mat>::unsafe(e.mat, target, elementwise);
+            }
+        };
+
+        template <typename Mat, typename S>
+        struct AliasCheck<MatrixCast<Mat, S>>
+        {
+            static bool unsafe(const MatrixCast<Mat, S> &e, const AliasTarget &target, bool elementwise)
+            {
+                return AliasCheck<Mat>::unsafe(e.mat, target, elementwise);
+            }
+        };
+
+        template <typename Mat, typename Op>
+        struct AliasCheck<MatrixUnaryOp<Mat, Op>>
+        {
+            static bool unsafe(const MatrixUnaryOp<Mat, Op> &e, const AliasTarget &target, bool elementwise)
+            {
+                return AliasCheck<Mat>::unsafe(e.mat, target, elementwise);
+            }
+        };
+
+        template <typename Mat>
+        struct AliasCheck<MatrixTranspose<Mat>>
+        {
+            static bool unsafe(const MatrixTranspose<Mat> &e, const AliasTarget &target, bool)
+            {
+                return AliasCheck<Mat>::unsafe(e.mat, target, false);
+            }
+        };
+
+        template <typename Lhs, typename Rhs>
+        struct AliasCheck<MatrixMul<Lhs, Rhs>>
+        {
+            static bool unsafe(const MatrixMul<Lhs, Rhs> &, const AliasTarget &, bool) { return false; }
+        };
+
+        // 乘法操作数：直接访问内存的在写入目标的同时被读取，其余先求值到临时矩阵
+        template <typename E>
+        bool productOperandAliases(const E &e, const AliasTarget &target)
+        {
+            return DirectAccess<E>::value && AliasCheck<E>::unsafe(e, target, false);
+        }
+
+        template <typename Expr>
+        bool aliases(const Expr &expr, const AliasTarget &target)
+        {
+            return AliasCheck<Expr>::unsafe(expr, target, true);
+        }
+
+        // 根节点是乘法时结果直接写入目标（见 evaluateTo），只需检查操作数
+        template <typename Lhs, typename Rhs>
+        bool aliases(const MatrixMul<Lhs, Rhs> &expr, const AliasTarget &target)
+        {
+            return productOperandAliases(expr.lhs, target) || productOperandAliases(expr.rhs, target);
+        }
+
+        template <typename T>
+        AliasTarget aliasTarget(const T *dst, size_t ld, size_t r, size_t c)
+        {
+            return AliasTarget{dst, r == 0 || c == 0 ? dst : dst + (r - 1) * ld + c, dst, ld};
+        }
+
+        /**
+         * @brief 线程局部的可复用暂存区，别名赋值需要的临时缓冲区从这里租用
+         * @details 每个线程、每种元素类型保留一块缓冲区（只增不减），稳定运行后别名赋值不再分配内存。
+         *          租用期间缓冲区从线程的槽位中取出，析构时放回；同一线程嵌套租用时槽位为空，另行分配。
+         */
+        template <typename T>
+        class ScratchBuffer
+        {
+        private:
+            typedef DynamicStorage<T, Dynamic, 1> Storage;
+            Storage m_storage;
+
+            static Storage &slot()
+            {
+                static thread_local Storage storage;
+                return storage;
+            }
+
+        public:
+            explicit ScratchBuffer(size_t size)
+            {
+                m_storage.swap(slot());
+                if (m_storage.size() < size)
+                    Storage(size, 1).swap(m_storage);
+            }
+
+            ~ScratchBuffer()
+            {
+                if (slot().size() < m_storage.size())
+                    slot().swap(m_storage);
+            }
+
+            ScratchBuffer(const ScratchBuffer &) = delete;
+            ScratchBuffer &operator=(const ScratchBuffer &) = delete;
+
+            T *data() { return m_storage.data(); }
+        };
+
+        /**
+         * @brief 赋值：把表达式写入与它尺寸相同、行跨度为 ld 的目标 dst
+         * @details 别名分析表明安全时直接写入目标，否则先求值到暂存区再逐行拷贝。
+         *          直接写入时，求值中途抛出异常（如 CheckedArithmetic 的溢出）会使目标只被改写了一部分。
+         */
+        template <typename T, typename Expr>
+        void assignTo(T *dst, size_t ld, const Expr &expr)
+        {
+            const size_t r = expr.rows(), c = expr.cols();
+            if (!aliases(expr, aliasTarget(dst, ld, r, c)))
+            {
+                evaluateTo(dst, ld, expr);
+                return;
+            }
+            ScratchBuffer<T> tmp(r * c);
+            evaluateTo(tmp.data(), c, expr);
+            for (size_t i = 0; i < r; ++i)
+                std::copy(tmp.data() + i * c, tmp.data() + (i + 1) * c, dst + i * ld);
+        }
+
+        /**
+         * @brief 复合赋值 +=、-=，由 MatrixBase 的运算符调用
+         * @details 一般表达式改写成 dst = dst ± expr，由别名分析确认后原地求值；
+         *          乘积在操作数不引用目标时直接累加到目标（实数元素时为 beta = 1 的 GEMM）。
+         */
+        template <typename Dst>
+        struct CompoundAssign
+        {
+            template <typename Expr>
+            static Dst &add(Dst &dst, const Expr &expr) { return dst = MatrixAdd<Dst, Expr>(dst, expr); }
+
+            template <typename Expr>
+            static Dst &sub(Dst &dst, const Expr &expr) { return dst = MatrixSub<Dst, Expr>(dst, expr); }
+
+            template <typename Lhs, typename Rhs>
+            static Dst &add(Dst &dst, const MatrixMul<Lhs, Rhs> &expr) { return accumulate(dst, expr, false); }
+
+            template <typename Lhs, typename Rhs>
+            static Dst &sub(Dst &dst, const MatrixMul<Lhs, Rhs> &expr) { return accumulate(dst, expr, true); }
+
+        private:
+            template <typename Lhs, typename Rhs>
+            static Dst &accumulate(Dst &dst, const MatrixMul<Lhs, Rhs> &expr, bool subtract)
+            {
+                typedef typename DirectAccess<Dst>::Scalar T;
+                if (!(dst.rows() == expr.rows() && dst.cols() == expr.cols()))
+                    throw std::invalid_argument("Compound assignment requires an expression of the same dimensions");
+                T *data = dst.data();
+                const size_t ld = DirectAccess<Dst>::rowStride(dst);
+                if (aliases(expr, aliasTarget(data, ld, dst.rows(), dst.cols())))
+                {
+                    if (subtract)
+                        return dst = MatrixSub<Dst, MatrixMul<Lhs, Rhs>>(dst, expr);
+                    return dst = MatrixAdd<Dst, MatrixMul<Lhs, Rhs>>(dst, expr);
+                }
+                ProductOperand<Lhs> lhs(expr.lhs);
+                ProductOperand<Rhs> rhs(expr.rhs);
+                ProductKernel<T, typename ProductOperand<Lhs>::type, typename ProductOperand<Rhs>::type>::accumulate(
+                    data, ld, lhs.value, rhs.value, subtract);
+                return dst;
+            }
+        };
+
+        /**
+         * @brief noalias() 返回的代理对象：赋值时直接写入目标存储，不经过临时缓冲区
+         * @details 仅当调用者保证右侧表达式不引用目标本身时使用。
+         */
+        template <typename Dst>
+        class NoAlias
+        {
+        private:
+            Dst &dst;
+
+        public:
+            explicit NoAlias(Dst &d) : dst(d) {}
+
+            template <typename Expr>
+            Dst &operator=(const MatrixBase<Expr> &expr)
+            {
+                const Expr &e = expr.derived();
+                dst.resize(e.rows(), e.cols());
+                evaluateTo(dst.data(), dst.cols(), e);
+                return dst;
+            }
+        };
+    }
+}
@@ -0,0 +1,434 @@
+/**
+ * @file BatchedMatrix.hpp
+ * @brief 大批量同尺寸小矩阵的结构体数组（SoA）存储，以及跨批次向量化的 3x3、4x4 行列式、逆矩阵与求解。
+ * @details 逐个调用 LinAlg::inverse(MatrixNM<T, 3, 3>) 时，一个矩阵只有 9 个元素，SIMD 无从下手。
+ *          BatchedMatrix 把所有矩阵的同一元素 (i, j) 放在一块连续、64 字节对齐的平面中，
+ *          于是同一段代码一次处理 Packet<F>::size 个矩阵（AVX-512 下 8 个 double 或 16 个 float），
+ *          每个矩阵仍使用 LinAlg 中的闭式公式（余子式展开），批次之间没有数据依赖。
+ *          批量较大时按 parallelFor 切分到多个线程。
+ *          运算遵循 IEEE 754 语义：奇异矩阵不抛异常，其行列式为 0，逆矩阵与解为 inf/NaN，
+ *          调用方可通过行列式自行判断。Policy 只决定读出的 BasicReal 类型。
+ */
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include "NumberField.hpp"
+#include "Simd.hpp"
+#include "MatrixNM.hpp"
+#include "SplitComplex.hpp"
+#include "../Parallel/ParallelFor.hpp"
+
+namespace OxygenMath
+{
+    /**
+     * @brief count 个 R×C 矩阵的结构体数组存储
+     * @details 元素 (i, j) 的平面 plane(i, j) 是长度为 count 的连续数组，第 k 个矩阵的该元素位于 plane(i, j)[k]。
+     *          平面间距向上取整到 16 个元素，使每个平面都从 64 字节边界开始。
+     * @tparam F 底层浮点类型（double 或 float）
+     * @tparam R 行数
+     * @tparam C 列数
+     * @tparam Policy 读出矩阵时使用的 BasicReal 检查策略
+     */
+    template <typename F, size_t R, size_t C, typename Policy = CheckedArithmetic>
+    class BatchedMatrix
+    {
+    private:
+        size_t m_count, m_stride;
+        internal::AlignedArray<F> m_data;
+
+        static size_t paddedStride(size_t count) { return (count + 15) / 16 * 16; }
+
+    public:
+        using Scalar = BasicReal<F, Policy>;
+        static constexpr size_t RowsAtCompileTime = R;
+        static constexpr size_t ColsAtCompileTime = C;
+
+        BatchedMatrix() : m_count(0), m_stride(0) {}
+
+        explicit BatchedMatrix(size_t count)
+            : m_count(count), m_stride(paddedStride(count)), m_data(R * C * paddedStride(count)) {}
+
+        // 不初始化元素，供随后整体写入结果的运算使用
+        BatchedMatrix(size_t count, internal::UninitializedTag)
+            : m_count(count), m_stride(paddedStride(count)), m_data(R * C * paddedStride(count), false) {}
+
+        size_t size() const { return m_count; }
+
+        F *plane(size_t i, size_t j) { return m_data.data() + (i * C + j) * m_stride; }
+        const F *plane(size_t i, size_t j) const { return m_data.data() + (i * C + j) * m_stride; }
+
+        // 第 k 个矩阵的元素 (i, j)
+        F &operator()(size_t k, size_t i, size_t j)
+        {
+            if (k >= m_count || i >= R || j >= C)
+                throw std::out_of_range("Batched matrix index out of range");
+            return plane(i, j)[k];
+        }
+
+        F operator()(size_t k, size_t i, size_t j) const
+        {
+            if (k >= m_count || i >= R || j >= C)
+                throw std::out_of_range("Batched matrix index out of range");
+            return plane(i, j)[k];
+        }
+
+        // 读出第 k 个矩阵
+        MatrixNM<Scalar, R, C> get(size_t k) const
+        {
+            if (k >= m_count)
+                throw std::out_of_range("Batched matrix index out of range");
+            MatrixNM<Scalar, R, C> result;
+            for (size_t i = 0; i < R; ++i)
+                for (size_t j = 0; j < C; ++j)
+                    result(i, j) = Scalar(plane(i, j)[k]);
+            return result;
+        }
+
+        // 写入第 k 个矩阵
+        template <typename G, typename P>
+        void set(size_t k, const MatrixNM<BasicReal<G, P>, R, C> &value)
+        {
+            if (k >= m_count)
+                throw std::out_of_range("Batched matrix index out of range");
+            for (size_t i = 0; i < R; ++i)
+                for (size_t j = 0; j < C; ++j)
+                    plane(i, j)[k] = static_cast<F>(value(i, j).data);
+        }
+    };
+
+    template <typename F, size_t R, size_t C, typename Policy>
+    constexpr size_t BatchedMatrix<F, R, C, Policy>::RowsAtCompileTime;
+    template <typename F, size_t R, size_t C, typename Policy>
+    constexpr size_t BatchedMatrix<F, R, C, Policy>::ColsAtCompileTime;
+
+    // count 个长度为 N 的列向量
+    template <typename F, size_t N, typename Policy = CheckedArithmetic>
+    using BatchedVector = BatchedMatrix<F, N, 1, Policy>;
+
+    // count 个标量（如批量行列式），第 k 个值为 (k, 0, 0)
+    template <typename F, typename Policy = CheckedArithmetic>
+    using BatchedScalar = BatchedMatrix<F, 1, 1, Policy>;
+
+    namespace internal
+    {
+        // 单个线程至少处理的矩阵个数，避免小批量时线程创建开销超过计算本身
+        constexpr size_t BatchedGrain = 16384;
+
+        /**
+         * @brief 3x3 与 4x4 闭式公式，P 为数据包类型（Packet 或 ScalarPacket），一次处理 P::size 个矩阵
+         */
+        template <typename P, size_t N>
+        struct SmallMatrixKernel;
+
+        template <typename P>
+        struct SmallMatrixKernel<P, 3>
+        {
+            typedef typename P::type V;
+
+            static V diff(V a, V b, V c, V d) { return P::sub(P::mul(a, b), P::mul(c, d)); }
+
+            static V determinant(const V *a)
+            {
+                const V c0 = diff(a[4], a[8], a[5], a[7]);
+                const V c1 = diff(a[5], a[6], a[3], a[8]);
+                const V c2 = diff(a[3], a[7], a[4], a[6]);
+                return P::fmadd(a[0], c0, P::fmadd(a[1], c1, P::mul(a[2], c2)));
+            }
+
+            // 返回行列式，inv 为伴随矩阵除以行列式
+            static V inverse(const V *a, V *inv)
+            {
+                inv[0] = diff(a[4], a[8], a[5], a[7]);
+                inv[3] = diff(a[5], a[6], a[3], a[8]);
+                inv[6] = diff(a[3], a[7], a[4], a[6]);
+                const V det = P::fmadd(a[0], inv[0], P::fmadd(a[1], inv[3], P::mul(a[2], inv[6])));
+                inv[1] = diff(a[2], a[7], a[1], a[8]);
+                inv[2] = diff(a[1], a[5], a[2], a[4]);
+                inv[4] = diff(a[0], a[8], a[2], a[6]);
+                inv[5] = diff(a[2], a[3], a[0], a[5]);
+                inv[7] = diff(a[1], a[6], a[0], a[7]);
+                inv[8] = diff(a[0], a[4], a[1], a[3]);
+                const V r = P::div(P::set1(typename P::Scalar(1)), det);
+                for (size_t i = 0; i < 9; ++i)
+                    inv[i] = P::mul(inv[i], r);
+                return det;
+            }
+        };
+
+        template <typename P>
+        struct SmallMatrixKernel<P, 4>
+        {
+            typedef typename P::type V;
+
+            static V diff(V a, V b, V c, V d) { return P::sub(P::mul(a, b), P::mul(c, d)); }
+
+            // 上两行与下两行的 2x2 子式
+            static void minors(const V *a, V *s, V *c)
+            {
+                s[0] = diff(a[0], a[5], a[4], a[1]);
+                s[1] = diff(a[0], a[6], a[4], a[2]);
+                s[2] = diff(a[0], a[7], a[4], a[3]);
+                s[3] = diff(a[1], a[6], a[5], a[2]);
+                s[4] = diff(a[1], a[7], a[5], a[3]);
+                s[5] = diff(a[2], a[7], a[6], a[3]);
+                c[5] = diff(a[10], a[15], a[14], a[11]);
+                c[4] = diff(a[9], a[15], a[13], a[11]);
+                c[3] = diff(a[9], a[14], a[13], a[10]);
+                c[2] = diff(a[8], a[15], a[12], a[11]);
+                c[1] = diff(a[8], a[14], a[12], a[10]);
+                c[0] = diff(a[8], a[13], a[12], a[9]);
+            }
+
+            static V combine(const V *s, const V *c)
+            {
+                const V plus = P::fmadd(s[0], c[5], P::fmadd(s[2], c[3], P::fmadd(s[3], c[2], P::mul(s[5], c[0]))));
+                const V minus = P::fmadd(s[1], c[4], P::mul(s[4], c[1]));
+                return P::sub(plus, minus);
+            }
+
+            static V determinant(const V *a)
+            {
+                V s[6], c[6];
+                minors(a, s, c);
+                return combine(s, c);
+            }
+
+            // x * p - y * q + z * r
+            static V term(V x, V p, V y, V q, V z, V r) { return P::fmadd(z, r, P::sub(P::mul(x, p), P::mul(y, q))); }
+
+            static V inverse(const V *a, V *inv)
+            {
+                V s[6], c[6];
+                minors(a, s, c);
+                const V det = combine(s, c);
+                const V r = P::div(P::set1(typename P::Scalar(1)), det);
+                const V z = P::zero();
+                inv[0] = term(a[5], c[5], a[6], c[4], a[7], c[3]);
+                inv[1] = P::sub(z, term(a[1], c[5], a[2], c[4], a[3], c[3]));
+                inv[2] = term(a[13], s[5], a[14], s[4], a[15], s[3]);
+                inv[3] = P::sub(z, term(a[9], s[5], a[10], s[4], a[11], s[3]));
+                inv[4] = P::sub(z, term(a[4], c[5], a[6], c[2], a[7], c[1]));
+                inv[5] = term(a[0], c[5], a[2], c[2], a[3], c[1]);
+                inv[6] = P::sub(z, term(a[12], s[5], a[14], s[2], a[15], s[1]));
+                inv[7] = term(a[8], s[5], a[10], s[2], a[11], s[1]);
+                inv[8] = term(a[4], c[4], a[5], c[2], a[7], c[0]);
+                inv[9] = P::sub(z, term(a[0], c[4], a[1], c[2], a[3], c[0]));
+                inv[10] = term(a[12], s[4], a[13], s[2], a[15], s[0]);
+                inv[11] = P::sub(z, term(a[8], s[4], a[9], s[2], a[11], s[0]));
+                inv[12] = P::sub(z, term(a[4], c[3], a[5], c[1], a[6], c[0]));
+                inv[13] = term(a[0], c[3], a[1], c[1], a[2], c[0]);
+                inv[14] = P::sub(z, term(a[12], s[3], a[13], s[1], a[14], s[0]));
+                inv[15] = term(a[8], s[3], a[9], s[1], a[10], s[0]);
+                for (size_t i = 0; i < 16; ++i)
+                    inv[i] = P::mul(inv[i], r);
+                return det;
+            }
+        };
+
+        template <size_t N>
+        struct BatchedDeterminantOp
+        {
+            template <typename P, typename F>
+            static void apply(const F *const *in, F *const *out, size_t k)
+            {
+                typename P::type a[N * N];
+                for (size_t e = 0; e < N * N; ++e)
+                    a[e] = P::loadu(in[e] + k);
+                P::storeu(out[0] + k, SmallMatrixKernel<P, N>::determinant(a));
+            }
+        };
+
+        template <size_t N>
+        struct BatchedInverseOp
+        {
+            template <typename P, typename F>
+            static void apply(const F *const *in, F *const *out, size_t k)
+            {
+                typename P::type a[N * N], inv[N * N];
+                for (size_t e = 0; e < N * N; ++e)
+                    a[e] = P::loadu(in[e] + k);
+                SmallMatrixKernel<P, N>::inverse(a, inv);
+                for (size_t e = 0; e < N * N; ++e)
+                    P::storeu(out[e] + k, inv[e]);
+            }
+        };
+
+        // in 为 N*N 个矩阵平面后接 N 个右端项平面
+        template <size_t N>
+        struct BatchedSolveOp
+        {
+            template <typename P, typename F>
+            static void apply(const F *const *in, F *const *out, size_t k)
+            {
+                typename P::type a[N * N], inv[N * N], b[N];
+                for (size_t e = 0; e < N * N; ++e)
+                    a[e] = P::loadu(in[e] + k);
+                for (size_t i = 0; i < N; ++i)
+                    b[i] = P::loadu(in[N * N + i] + k);
+                SmallMatrixKernel<P, N>::inverse(a, inv);
+                for (size_t i = 0; i < N; ++i)
+                {
+                    typename P::type x = P::mul(inv[i * N], b[0]);
+                    for (size_t j = 1; j < N; ++j)
+                        x = P::fmadd(inv[i * N + j], b[j], x);
+                    P::storeu(out[i] + k, x);
+                }
+            }
+        };
+
+        /**
+         * @brief 对第 0 到 count - 1 个矩阵执行 Op::apply：整包部分用 Packet<F>，尾部用 ScalarPacket<F>，批量大时多线程
+         */
+        template <typename Op, typename F>
+        void batchedApply(size_t count, const F *const *in, F *const *out)
+        {
+            typedef simd::Packet<F> P;
+            typedef simd::ScalarPacket<F> S;
+            parallelFor(0, count, BatchedGrain, [in, out](size_t begin, size_t end)
+                        {
+                            size_t k = begin;
+                            for (; k + P::size <= end; k += P::size)
+                                Op::template apply<P>(in, out, k);
+                            for (; k < end; ++k)
+                                Op::template apply<S>(in, out, k); });
+        }
+
+        template <typename F, size_t R, size_t C, typename Policy>
+        void collectPlanes(const BatchedMatrix<F, R, C, Policy> &m, const F **planes)
+        {
+            for (size_t i = 0; i < R; ++i)
+                for (size_t j = 0; j < C; ++j)
+                    planes[i * C + j] = m.plane(i, j);
+        }
+
+        template <typename F, size_t R, size_t C, typename Policy>
+        void collectPlanes(BatchedMatrix<F, R, C, Policy> &m, F **planes)
+        {
+            for (size_t i = 0; i < R; ++i)
+                for (size_t j = 0; j < C; ++j)
+                    planes[i * C + j] = m.plane(i, j);
+        }
+
+        template <size_t N>
+        struct BatchedSupported
+        {
+            static constexpr bool value = N == 3 || N == 4;
+        };
+    }
+
+    namespace LinAlg
+    {
+        /**
+         * @brief 批量计算 3x3 或 4x4 矩阵的行列式，写入 det
+         *
+         * det 的批量大小与 A 不同时重新分配；批量相同时复用其内存，逐帧调用不再分配。
+         *
+         * @param A count 个 N×N 矩阵
+         * @param det 输出，第 k 个值为第 k 个矩阵的行列式
+         */
+        template <typename F, size_t N, typename Policy>
+        void determinant(const BatchedMatrix<F, N, N, Policy> &A, BatchedScalar<F, Policy> &det)
+        {
+            static_assert(internal::BatchedSupported<N>::value, "Batched determinant supports 3x3 and 4x4 matrices");
+            if (det.size() != A.size())
+                det = BatchedScalar<F, Policy>(A.size(), internal::UninitializedTag());
+            const F *in[N * N];
+            F *out[1];
+            internal::collectPlanes(A, in);
+            internal::collectPlanes(det, out);
+            internal::batchedApply<internal::BatchedDeterminantOp<N>>(A.size(), in, out);
+        }
+
+        /**
+         * @brief 批量计算 3x3 或 4x4 矩阵的行列式
+         *
+         * @param A count 个 N×N 矩阵
+         * @return BatchedScalar<F, Policy> 第 k 个值为第 k 个矩阵的行列式
+         */
+        template <typename F, size_t N, typename Policy>
+        BatchedScalar<F, Policy> determinant(const BatchedMatrix<F, N, N, Policy> &A)
+        {
+            BatchedScalar<F, Policy> det(A.size(), internal::UninitializedTag());
+            determinant(A, det);
+            return det;
+        }
+
+        /**
+         * @brief 批量计算 3x3 或 4x4 矩阵的逆矩阵，写入 inv
+         *
+         * 使用伴随矩阵除以行列式；奇异矩阵对应的结果为 inf/NaN，不抛出异常。
+         * 每组矩阵先整体读入寄存器再写回，因此 inv 可以就是 A（原地求逆）。
+         *
+         * @param A count 个 N×N 矩阵
+         * @param inv 输出，批量大小不同时重新分配
+         */
+        template <typename F, size_t N, typename Policy>
+        void inverse(const BatchedMatrix<F, N, N, Policy> &A, BatchedMatrix<F, N, N, Policy> &inv)
+        {
+            static_assert(internal::BatchedSupported<N>::value, "Batched inverse supports 3x3 and 4x4 matrices");
+            if (inv.size() != A.size())
+                inv = BatchedMatrix<F, N, N, Policy>(A.size(), internal::UninitializedTag());
+            const F *in[N * N];
+            F *out[N * N];
+            internal::collectPlanes(A, in);
+            internal::collectPlanes(inv, out);
+            internal::batchedApply<internal::BatchedInverseOp<N>>(A.size(), in, out);
+        }
+
+        /**
+         * @brief 批量计算 3x3 或 4x4 矩阵的逆矩阵
+         *
+         * @param A count 个 N×N 矩阵
+         * @return BatchedMatrix<F, N, N, Policy> 逐个矩阵的逆
+         */
+        template <typename F, size_t N, typename Policy>
+        BatchedMatrix<F, N, N, Policy> inverse(const BatchedMatrix<F, N, N, Policy> &A)
+        {
+            BatchedMatrix<F, N, N, Policy> inv(A.size(), internal::UninitializedTag());
+            inverse(A, inv);
+            return inv;
+        }
+
+        /**
+         * @brief 批量求解 A_k * x_k = b_k（3x3 或 4x4），写入 x
+         *
+         * 在寄存器中求出逆矩阵后直接与右端项相乘，不写回逆矩阵；奇异矩阵对应的解为 inf/NaN。
+         * x 可以就是 b。
+         *
+         * @param A count 个 N×N 系数矩阵
+         * @param b count 个右端向量
+         * @param x 输出，批量大小不同时重新分配
+         */
+        template <typename F, size_t N, typename Policy>
+        void solve(const BatchedMatrix<F, N, N, Policy> &A, const BatchedVector<F, N, Policy> &b, BatchedVector<F, N, Policy> &x)
+        {
+            static_assert(internal::BatchedSupported<N>::value, "Batched solve supports 3x3 and 4x4 systems");
+            if (A.size() != b.size())
+                throw std::invalid_argument("Batch sizes do not match");
+            if (x.size() != A.size())
+                x = BatchedVector<F, N, Policy>(A.size(), internal::UninitializedTag());
+            const F *in[N * N + N];
+            F *out[N];
+            internal::collectPlanes(A, in);
+            internal::collectPlanes(b, in + N * N);
+            internal::collectPlanes(x, out);
+            internal::batchedApply<internal::BatchedSolveOp<N>>(A.size(), in, out);
+        }
+
+        /**
+         * @brief 批量求解 A_k * x_k = b_k（3x3 或 4x4）
+         *
+         * @param A count 个 N×N 系数矩阵
+         * @param b count 个右端向量
+         * @return BatchedVector<F, N, Policy> 逐个方程组的解
+         */
+        template <typename F, size_t N, typename Policy>
+        BatchedVector<F, N, Policy> solve(const BatchedMatrix<F, N, N, Policy> &A, const BatchedVector<F, N, Policy> &b)
+        {
+            BatchedVector<F, N, Policy> x(A.size(), internal::UninitializedTag());
+            solve(A, b, x);
+            return x;
+        }
+    }
+}
@@ -0,0 +1,354 @@
+/**
+ * @file DenseStorage.hpp
+ * @brief 稠密矩阵的底层存储：编译期定长存储与运行期动态存储。
+ * @details MatrixNM 通过 DenseStorage<T, Rows, Cols>::type 选择存储方式：
+ *          - 任一维度为 Dynamic 时使用一块连续的、64 字节对齐的堆内存；
+ *          - 定长且不超过 OXYGENMATH_MAX_INLINE_BYTES 字节时内联在对象中（栈上），构造、拷贝都不分配；
+ *          - 定长但超过阈值时使用固定大小的对齐堆内存，避免大矩阵撑爆栈。
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <array>
+#include <algorithm>
+#include <type_traits>
+
+// 定长矩阵内联存储的字节上限，超过该值改用堆内存。可在包含头文件前定义以覆盖
+#ifndef OXYGENMATH_MAX_INLINE_BYTES
+#define OXYGENMATH_MAX_INLINE_BYTES 16384
+#endif
+
+// 内联存储的最大对齐字节数。C++17 之前 operator new 与 std::allocator 只保证 16 字节对齐，
+// 放进 std::vector 或 new 出来的矩阵若要求更高对齐会失效，因此默认不超过 16
+#ifndef OXYGENMATH_MAX_STATIC_ALIGN
+#if defined(__cpp_aligned_new)
+#define OXYGENMATH_MAX_STATIC_ALIGN 64
+#else
+#define OXYGENMATH_MAX_STATIC_ALIGN 16
+#endif
+#endif
+
+namespace OxygenMath
+{
+    // 运行期尺寸标记：MatrixNM<T, Dynamic, Dynamic> 即动态尺寸矩阵
+    constexpr size_t Dynamic = static_cast<size_t>(-1);
+
+    namespace internal
+    {
+        // 动态存储的默认对齐字节数（一条缓存行，同时满足 AVX-512 对齐要求）
+        constexpr size_t DefaultAlignment = 64;
+
+        /**
+         * @brief 分配按 alignment 对齐的内存块
+         * @details 多申请 alignment + sizeof(void*) 字节，并在对齐地址之前记录原始指针，
+         *          以便 alignedFree 归还。不依赖 C++17 的 std::aligned_alloc。
+         * @param bytes 需要的字节数
+         * @param alignment 对齐字节数，必须为 2 的幂
+         * @return 对齐后的指针，bytes 为 0 时返回 nullptr
+         */
+        inline void *alignedMalloc(size_t bytes, size_t alignment = DefaultAlignment)
+        {
+            if (bytes == 0)
+                return nullptr;
+            if (bytes > std::numeric_limits<size_t>::max() - alignment - sizeof(void *))
+                throw std::bad_alloc();
+            void *raw = std::malloc(bytes + alignment + sizeof(void *));
+            if (!raw)
+                throw std::bad_alloc();
+            uintptr_t start = reinterpret_cast<uintptr_t>(raw) + sizeof(void *);
+            uintptr_t aligned = (start + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+            reinterpret_cast<void **>(aligned)[-1] = raw;
+            return reinterpret_cast<void *>(aligned);
+        }
+
+        /**
+         * @brief 释放由 alignedMalloc 分配的内存
+         */
+        inline void alignedFree(void *ptr)
+        {
+            if (ptr)
+                std::free(reinterpret_cast<void **>(ptr)[-1]);
+        }
+
+        // 内联存储的对齐：按数据大小取 SIMD 宽度，且不超过 OXYGENMATH_MAX_STATIC_ALIGN
+        constexpr size_t simdAlignment(size_t bytes)
+        {
+            return bytes >= 64 ? 64 : bytes >= 32 ? 32 : bytes >= 16 ? 16 : 1;
+        }
+        constexpr size_t inlineAlignment(size_t bytes, size_t minAlign)
+        {
+            return simdAlignment(bytes) > OXYGENMATH_MAX_STATIC_ALIGN
+                       ? (minAlign > OXYGENMATH_MAX_STATIC_ALIGN ? minAlign : OXYGENMATH_MAX_STATIC_ALIGN)
+                       : (minAlign > simdAlignment(bytes) ? minAlign : simdAlignment(bytes));
+        }
+
+        /**
+         * @brief 编译期定长内联存储，元素保存在对象内部的对齐 std::array 中
+         */
+        template <typename T, size_t Rows, size_t Cols>
+        class InlineStorage
+        {
+        private:
+            alignas(inlineAlignment(Rows * Cols * sizeof(T), alignof(T))) std::array<T, Rows * Cols> m_data;
+
+        public:
+            InlineStorage() { m_data.fill(T::zero()); }
+
+            InlineStorage(size_t rows, size_t cols)
+            {
+                if (rows != Rows || cols != Cols)
+                    throw std::invalid_argument("Matrix dimensions do not match the fixed size");
+                m_data.fill(T::zero());
+            }
+
+            void resize(size_t rows, size_t cols)
+            {
+                if (rows != Rows || cols != Cols)
+                    throw std::invalid_argument("Cannot resize a fixed-size matrix");
+            }
+
+            void swap(InlineStorage &other) { m_data.swap(other.m_data); }
+
+            T *data() { return m_data.data(); }
+            const T *data() const { return m_data.data(); }
+
+            size_t rows() const { return Rows; }
+            size_t cols() const { return Cols; }
+            size_t size() const { return Rows * Cols; }
+        };
+
+        /**
+         * @brief 编译期定长的堆存储，用于超过内联阈值的大矩阵
+         * @details 缓冲区 DefaultAlignment 字节对齐；移动只转移指针，被移动的对象只能再被赋值或析构。
+         */
+        template <typename T, size_t Rows, size_t Cols>
+        class HeapStorage
+        {
+        private:
+            T *m_data;
+
+            static T *allocate()
+            {
+                T *ptr = static_cast<T *>(alignedMalloc(Rows * Cols * sizeof(T)));
+                for (size_t i = 0; i < Rows * Cols; ++i)
+                    new (ptr + i) T(T::zero());
+                return ptr;
+            }
+
+            static void release(T *ptr)
+            {
+                if (!ptr)
+                    return;
+                for (size_t i = 0; i < Rows * Cols; ++i)
+                    ptr[i].~T();
+                alignedFree(ptr);
+            }
+
+        public:
+            HeapStorage() : m_data(allocate()) {}
+
+            HeapStorage(size_t rows, size_t cols) : m_data(nullptr)
+            {
+                if (rows != Rows || cols != Cols)
+                    throw std::invalid_argument("Matrix dimensions do not match the fixed size");
+                m_data = allocate();
+            }
+
+            HeapStorage(const HeapStorage &other)
+                : m_data(static_cast<T *>(alignedMalloc(Rows * Cols * sizeof(T))))
+            {
+                for (size_t i = 0; i < Rows * Cols; ++i)
+                    new (m_data + i) T(other.m_data[i]);
+            }
+
+            HeapStorage(HeapStorage &&other) noexcept : m_data(other.m_data) { other.m_data = nullptr; }
+
+            HeapStorage &operator=(const HeapStorage &other)
+            {
+                if (this == &other)
+                    return *this;
+                if (!m_data)
+                    m_data = allocate();
+                std::copy(other.m_data, other.m_data + Rows * Cols, m_data);
+                return *this;
+            }
+
+            HeapStorage &operator=(HeapStorage &&other) noexcept
+            {
+                std::swap(m_data, other.m_data);
+                return *this;
+            }
+
+            ~HeapStorage() { release(m_data); }
+
+            void resize(size_t rows, size_t cols)
+            {
+                if (rows != Rows || cols != Cols)
+                    throw std::invalid_argument("Cannot resize a fixed-size matrix");
+            }
+
+            void swap(HeapStorage &other) noexcept { std::swap(m_data, other.m_data); }
+
+            T *data() { return m_data; }
+            const T *data() const { return m_data; }
+
+            size_t rows() const { return Rows; }
+            size_t cols() const { return Cols; }
+            size_t size() const { return Rows * Cols; }
+        };
+
+        /**
+         * @brief 编译期定长存储：小矩阵内联，大矩阵放到堆上
+         */
+        template <typename T, size_t Rows, size_t Cols>
+        struct FixedStorage
+        {
+            using type = typename std::conditional<Rows * Cols * sizeof(T) <= OXYGENMATH_MAX_INLINE_BYTES,
+                                                   InlineStorage<T, Rows, Cols>,
+                                                   HeapStorage<T, Rows, Cols>>::type;
+        };
+
+        /**
+         * @brief 运行期动态存储
+         * @details 所有元素位于一块连续的、DefaultAlignment 字节对齐的内存中（行主序）。
+         *          移动构造与移动赋值只交换指针，不会分配内存。
+         *          Rows/Cols 中不为 Dynamic 的维度在构造与 resize 时会被校验。
+         */
+        template <typename T, size_t Rows, size_t Cols>
+        class DynamicStorage
+        {
+        private:
+            T *m_data;
+            size_t m_rows;
+            size_t m_cols;
+
+            static void checkShape(size_t rows, size_t cols)
+            {
+                if ((Rows != Dynamic && rows != Rows) || (Cols != Dynamic && cols != Cols))
+                    throw std::invalid_argument("Matrix dimensions do not match the fixed dimension");
+                // rows * cols 回绕后会分配过小的内存，之后按行列下标写入即越界
+                if (cols != 0 && rows > std::numeric_limits<size_t>::max() / cols)
+                    throw std::length_error("Matrix dimensions overflow size_t");
+            }
+
+            static T *allocate(size_t size)
+            {
+                if (size > std::numeric_limits<size_t>::max() / sizeof(T))
+                    throw std::bad_alloc();
+                T *ptr = static_cast<T *>(alignedMalloc(size * sizeof(T)));
+                for (size_t i = 0; i < size; ++i)
+                    new (ptr + i) T(T::zero());
+                return ptr;
+            }
+
+            static void release(T *ptr, size_t size)
+            {
+                for (size_t i = 0; i < size; ++i)
+                    ptr[i].~T();
+                alignedFree(ptr);
+            }
+
+        public:
+            DynamicStorage()
+                : m_data(nullptr), m_rows(Rows == Dynamic ? 0 : Rows), m_cols(Cols == Dynamic ? 0 : Cols)
+            {
+                if (size() != 0)
+                    m_data = allocate(size());
+            }
+
+            DynamicStorage(size_t rows, size_t cols) : m_data(nullptr), m_rows(rows), m_cols(cols)
+            {
+                checkShape(rows, cols);
+                m_data = allocate(rows * cols);
+            }
+
+            DynamicStorage(const DynamicStorage &other)
+                : m_data(static_cast<T *>(alignedMalloc(other.size() * sizeof(T)))),
+                  m_rows(other.m_rows), m_cols(other.m_cols)
+            {
+                for (size_t i = 0; i < size(); ++i)
+                    new (m_data + i) T(other.m_data[i]);
+            }
+
+            DynamicStorage(DynamicStorage &&other) noexcept
+                : m_data(other.m_data), m_rows(other.m_rows), m_cols(other.m_cols)
+            {
+                other.m_data = nullptr;
+                other.m_rows = Rows == Dynamic ? 0 : Rows;
+                other.m_cols = Cols == Dynamic ? 0 : Cols;
+            }
+
+            DynamicStorage &operator=(const DynamicStorage &other)
+            {
+                if (this == &other)
+                    return *this;
+                if (size() == other.size())
+                {
+                    // 元素个数相同则复用现有内存
+                    for (size_t i = 0; i < size(); ++i)
+                        m_data[i] = other.m_data[i];
+                    m_rows = other.m_rows;
+                    m_cols = other.m_cols;
+                    return *this;
+                }
+                DynamicStorage tmp(other);
+                swap(tmp);
+                return *this;
+            }
+
+            DynamicStorage &operator=(DynamicStorage &&other) noexcept
+            {
+                swap(other);
+                return *this;
+            }
+
+            ~DynamicStorage() { release(m_data, size()); }
+
+            /**
+             * @brief 改变尺寸。元素个数不变时只修改行列数，否则重新分配并置零
+             */
+            void resize(size_t rows, size_t cols)
+            {
+                checkShape(rows, cols);
+                if (rows * cols != size())
+                {
+                    DynamicStorage tmp(rows, cols);
+                    swap(tmp);
+                }
+                m_rows = rows;
+                m_cols = cols;
+            }
+
+            void swap(DynamicStorage &other) noexcept
+            {
+                std::swap(m_data, other.m_data);
+                std::swap(m_rows, other.m_rows);
+                std::swap(m_cols, other.m_cols);
+            }
+
+            T *data() { return m_data; }
+            const T *data() const { return m_data; }
+
+            size_t rows() const { return m_rows; }
+            size_t cols() const { return m_cols; }
+            size_t size() const { return m_rows * m_cols; }
+        };
+
+        /**
+         * @brief 根据行列数选择存储方式
+         */
+        template <typename T, size_t Rows, size_t Cols>
+        struct DenseStorage
+        {
+            using type = typename std::conditional<Rows == Dynamic || Cols == Dynamic,
+                                                   DynamicStorage<T, Rows, Cols>,
+                                                   typename FixedStorage<T, Rows, Cols>::type>::type;
+        };
+    }
+}
@@ -0,0 +1,703 @@
+/**
+ * @file EigenKernel.hpp
+ * @brief 特征值内核：实对称矩阵的特征分解，以及一般实矩阵的 Hessenberg 约化 + Francis 双位移 QR。
+ * @details 小的定长矩阵（阶数不超过 JacobiMaxSize）使用循环 Jacobi 旋转，所有循环上界为编译期常量，
+ *          由编译器完全展开，全部数据在栈上。
+ *          其余矩阵先用分块 Householder 变换化为三对角矩阵（LAPACK dsytrd/dlatrd 的结构：
+ *          块内只累积 V、W，块结束后用两次 GEMM 完成 A22 -= V * W^T + W * V^T），
+ *          再对三对角矩阵做带 Wilkinson 位移的隐式 QL 迭代。
+ *          特征向量在内部按行保存（Y = Z^T），Givens 旋转只组合两个连续的行，便于向量化；
+ *          只求特征值时跳过 Q 的形成与旋转的累积，三对角阶段只需 O(n^2)。
+ *          一般实矩阵先做平衡（按 2 的幂缩放行列，不引入舍入误差），再用 Householder 变换约化为上 Hessenberg 矩阵，
+ *          最后用隐式双位移 Francis QR 迭代（EISPACK hqr）逐个收缩出 1x1 块（实特征值）与 2x2 块（共轭复特征值对）。
+ */
+#pragma once
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include "QRKernel.hpp"
+
+namespace OxygenMath
+{
+    namespace internal
+    {
+        // 定长矩阵阶数不超过该值时使用 Jacobi 方法
+        constexpr size_t JacobiMaxSize = 4;
+        // Jacobi 方法的最大扫描次数，3x3 矩阵通常 4 至 5 次即收敛
+        constexpr size_t JacobiMaxSweeps = 50;
+        // 三对角化的块宽
+        constexpr size_t TridiagonalBlockSize = 32;
+        // QL 迭代中每个特征值允许的最大迭代次数
+        constexpr size_t QLMaxIterations = 60;
+
+        /**
+         * @brief 按特征值升序排列，Y 的行（特征向量）随之交换；Y 为 nullptr 时只排序特征值
+         */
+        template <typename E>
+        void sortEigenpairs(size_t n, E *w, E *Y, size_t ldy)
+        {
+            for (size_t i = 0; i + 1 < n; ++i)
+            {
+                size_t minIndex = i;
+                for (size_t j = i + 1; j < n; ++j)
+                    if (w[j] < w[minIndex])
+                        minIndex = j;
+                if (minIndex == i)
+                    continue;
+                std::swap(w[i], w[minIndex]);
+                if (Y)
+                    std::swap_ranges(Y + i * ldy, Y + i * ldy + n, Y + minIndex * ldy);
+            }
+        }
+
+        /**
+         * @brief 循环 Jacobi 方法求 N×N 对称矩阵的特征分解
+         * @param A 行主序 N×N 对称矩阵（上下三角都必须有效）；vectors 为 true 时返回特征向量（按列），否则内容被破坏
+         * @param w 输出 N 个升序特征值
+         * @param vectors 是否计算特征向量
+         */
+        template <size_t N, typename E>
+        void jacobiEigen(E *A, E *w, bool vectors)
+        {
+            std::array<E, N * N> Y;
+            for (size_t i = 0; i < N; ++i)
+                for (size_t j = 0; j < N; ++j)
+                    Y[i * N + j] = i == j ? E(1) : E(0);
+
+            const E eps = std::numeric_limits<E>::epsilon();
+            for (size_t sweep = 0; sweep < JacobiMaxSweeps; ++sweep)
+            {
+                E off = E(0), diag = E(0);
+                for (size_t i = 0; i < N; ++i)
+                {
+                    diag += A[i * N + i] * A[i * N + i];
+                    for (size_t j = i + 1; j < N; ++j)
+                        off += A[i * N + j] * A[i * N + j];
+                }
+                if (off <= eps * eps * diag || off == E(0))
+                    break;
+
+                for (size_t p = 0; p < N; ++p)
+                    for (size_t q = p + 1; q < N; ++q)
+                    {
+                        const E apq = A[p * N + q];
+                        if (apq == E(0))
+                            continue;
+                        // 旋转角满足 tan(2 phi) = 2 a_pq / (a_qq - a_pp)，取 |phi| <= pi / 4 的一支
+                        const E theta = (A[q * N + q] - A[p * N + p]) / (E(2) * apq);
+                        const E t = std::copysign(E(1), theta) / (std::abs(theta) + std::sqrt(theta * theta + E(1)));
+                        const E c = E(1) / std::sqrt(t * t + E(1));
+                        const E s = t * c;
+                        for (size_t k = 0; k < N; ++k)
+                        {
+                            const E akp = A[k * N + p], akq = A[k * N + q];
+                            A[k * N + p] = c * akp - s * akq;
+                            A[k * N + q] = s * akp + c * akq;
+                        }
+                        for (size_t k = 0; k < N; ++k)
+                        {
+                            const E apk = A[p * N + k], aqk = A[q * N + k];
+                            A[p * N + k] = c * apk - s * aqk;
+                            A[q * N + k] = s * apk + c * aqk;
+                        }
+                        if (vectors)
+                            for (size_t k = 0; k < N; ++k)
+                            {
+                                const E ypk = Y[p * N + k], yqk = Y[q * N + k];
+                                Y[p * N + k] = c * ypk - s * yqk;
+                                Y[q * N + k] = s * ypk + c * yqk;
+                            }
+                    }
+            }
+
+            for (size_t i = 0; i < N; ++i)
+                w[i] = A[i * N + i];
+            sortEigenpairs(N, w, vectors ? Y.data() : static_cast<E *>(nullptr), N);
+            if (vectors)
+                for (size_t i = 0; i < N; ++i)
+                    for (size_t j = 0; j < N; ++j)
+                        A[i * N + j] = Y[j * N + i];
+        }
+
+        /**
+         * @brief 分块 Householder 三对角化 Q^T * A * Q = T
+         * @param n 矩阵阶数
+         * @param A 行主序对称矩阵（上下三角都必须有效）；返回时第 k 列第 k + 2 行起保存第 k 个反射向量（第 k + 1 个分量为 1，不存储）
+         * @param ld 行跨度
+         * @param d 输出 T 的 n 个对角元
+         * @param e 输出 T 的 n - 1 个次对角元，e[n - 1] 置 0
+         * @param tau 输出 n - 2 个反射系数（n < 3 时不写入）
+         */
+        template <typename E>
+        void tridiagonalize(size_t n, E *A, size_t ld, E *d, E *e, E *tau)
+        {
+            const size_t steps = n > 2 ? n - 2 : 0;
+            std::vector<E> Vb, Wb, x(n), p(n);
+            E y[TridiagonalBlockSize], z[TridiagonalBlockSize];
+            for (size_t k0 = 0; k0 < steps; k0 += TridiagonalBlockSize)
+            {
+                const size_t k1 = std::min(steps, k0 + TridiagonalBlockSize);
+                const size_t bw = k1 - k0;
+                Vb.assign((n - k0) * bw, E(0));
+                Wb.assign((n - k0) * bw, E(0));
+                // 第 i 行（全局行号）的 V、W 位于 (i - k0) * bw
+                E *V = Vb.data();
+                E *W = Wb.data();
+
+                for (size_t k = k0; k < k1; ++k)
+                {
+                    const size_t c = k - k0;
+                    // 第 k 列（由对称性即第 k 行）加上块内尚未写回的修正：a -= V * W(k)^T + W * V(k)^T
+                    const E *rowK = A + k * ld;
+                    const E *vk = V + (k - k0) * bw, *wk = W + (k - k0) * bw;
+                    for (size_t i = k; i < n; ++i)
+                    {
+                        const E *vi = V + (i - k0) * bw, *wi = W + (i - k0) * bw;
+                        E s = rowK[i];
+                        for (size_t r = 0; r < c; ++r)
+                            s -= vi[r] * wk[r] + wi[r] * vk[r];
+                        x[i] = s;
+                    }
+                    d[k] = x[k];
+                    const E t = householder(n - k - 1, x.data() + k + 1, size_t(1));
+                    tau[k] = t;
+                    e[k] = x[k + 1];
+                    x[k + 1] = E(1);
+                    for (size_t i = k + 1; i < n; ++i)
+                        V[(i - k0) * bw + c] = x[i];
+                    for (size_t i = k + 2; i < n; ++i)
+                        A[i * ld + k] = x[i];
+                    if (t == E(0))
+                        continue;
+
+                    // p = A22 * v，A22 对称，按行做 axpy：p += v_i * A(i, :)
+                    std::fill(p.begin() + k + 1, p.end(), E(0));
+                    for (size_t i = k + 1; i < n; ++i)
+                    {
+                        const E vi = x[i];
+                        const E *row = A + i * ld;
+                        for (size_t j = k + 1; j < n; ++j)
+                            p[j] += vi * row[j];
+                    }
+                    // p -= V * (W^T * v) + W * (V^T * v)
+                    if (c > 0)
+                    {
+                        for (size_t r = 0; r < c; ++r)
+                            y[r] = z[r] = E(0);
+                        for (size_t i = k + 1; i < n; ++i)
+                        {
+                            const E *vi = V + (i - k0) * bw, *wi = W + (i - k0) * bw;
+                            for (size_t r = 0; r < c; ++r)
+                            {
+                                y[r] += wi[r] * x[i];
+                                z[r] += vi[r] * x[i];
+                            }
+                        }
+                        for (size_t i = k + 1; i < n; ++i)
+                        {
+                            const E *vi = V + (i - k0) * bw, *wi = W + (i - k0) * bw;
+                            E s = E(0);
+                            for (size_t r = 0; r < c; ++r)
+                                s += vi[r] * y[r] + wi[r] * z[r];
+                            p[i] -= s;
+                        }
+                    }
+                    // w = tau * p - (tau^2 / 2) * (p^T v) * v
+                    E pv = E(0);
+                    for (size_t i = k + 1; i < n; ++i)
+                    {
+                        p[i] *= t;
+                        pv += p[i] * x[i];
+                    }
+                    const E alpha = -E(0.5) * t * pv;
+                    for (size_t i = k + 1; i < n; ++i)
+                        W[(i - k0) * bw + c] = p[i] + alpha * x[i];
+                }
+
+                // A22 -= V2 * W2^T + W2 * V2^T（两个三角都更新，下一块可以按行读取）
+                const size_t mm = n - k1;
+                const E *V2 = V + (k1 - k0) * bw, *W2 = W + (k1 - k0) * bw;
+                E *A22 = A + k1 * ld + k1;
+                gemm<E>(mm, mm, bw, E(-1), V2, bw, 1, W2, 1, bw, E(1), A22, ld);
+                gemm<E>(mm, mm, bw, E(-1), W2, bw, 1, V2, 1, bw, E(1), A22, ld);
+            }
+
+            if (n >= 2)
+            {
+                d[n - 2] = A[(n - 2) * ld + n - 2];
+                e[n - 2] = A[(n - 1) * ld + n - 2];
+            }
+            d[n - 1] = A[(n - 1) * ld + n - 1];
+            e[n - 1] = E(0);
+        }
+
+        /**
+         * @brief 对称三对角矩阵的隐式 QL 迭代（Wilkinson 位移）
+         * @param d 对角元，返回时为特征值（未排序）
+         * @param e 次对角元，长度 n（e[n - 1] 不使用），返回时被破坏
+         * @param Y 若非 nullptr，则每个旋转同时作用在 Y 的两行上（Y 为 n×n，行跨度 ldy）
+         * @throws std::runtime_error 如果某个特征值在 QLMaxIterations 次迭代内未收敛
+         */
+        template <typename E>
+        void tridiagonalQL(size_t n, E *d, E *e, E *Y, size_t ldy)
+        {
+            const E eps = std::numeric_limits<E>::epsilon();
+            for (size_t l = 0; l < n; ++l)
+            {
+                size_t iter = 0;
+                for (;;)
+                {
+                    size_t m = l;
+                    for (; m + 1 < n; ++m)
+                    {
+                        const E dd = std::abs(d[m]) + std::abs(d[m + 1]);
+                        if (std::abs(e[m]) <= eps * dd)
+                            break;
+                    }
+                    if (m == l)
+                        break;
+                    if (++iter > QLMaxIterations)
+                        throw std::runtime_error("Eigenvalue iteration did not converge.");
+
+                    E g = (d[l + 1] - d[l]) / (E(2) * e[l]);
+                    E r = std::hypot(g, E(1));
+                    g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+                    E s = E(1), c = E(1), p = E(0);
+                    bool underflow = false;
+                    for (size_t i = m; i-- > l;)
+                    {
+                        const E f = s * e[i], b = c * e[i];
+                        r = std::hypot(f, g);
+                        e[i + 1] = r;
+                        if (r == E(0))
+                        {
+                            // 次对角元下溢：矩阵已在 i + 1 处分裂
+                            d[i + 1] -= p;
+                            e[m] = E(0);
+                            underflow = true;
+                            break;
+                        }
+                        s = f / r;
+                        c = g / r;
+                        g = d[i + 1] - p;
+                        r = (d[i] - g) * s + E(2) * c * b;
+                        p = s * r;
+                        d[i + 1] = g + p;
+                        g = c * r - b;
+                        if (Y)
+                        {
+                            E *yi = Y + i * ldy, *yi1 = Y + (i + 1) * ldy;
+                            for (size_t k = 0; k < n; ++k)
+                            {
+                                const E a = yi[k], h = yi1[k];
+                                yi1[k] = s * a + c * h;
+                                yi[k] = c * a - s * h;
+                            }
+                        }
+                    }
+                    if (underflow)
+                        continue;
+                    d[l] -= p;
+                    e[l] = g;
+                    e[m] = E(0);
+                }
+            }
+        }
+
+        /**
+         * @brief 一般阶数对称矩阵的特征分解：三对角化 + 隐式 QL
+         * @param A 行主序 n×n 对称矩阵（上下三角都必须有效），vectors 为 true 时返回特征向量（按列）
+         * @param w 输出 n 个升序特征值
+         */
+        template <typename E>
+        void symmetricEigenTridiagonal(size_t n, E *A, size_t ld, E *w, bool vectors)
+        {
+            if (n == 0)
+                return;
+            std::vector<E> e(n), tau(n);
+            tridiagonalize(n, A, ld, w, e.data(), tau.data());
+            if (!vectors)
+            {
+                tridiagonalQL(n, w, e.data(), static_cast<E *>(nullptr), 0);
+                sortEigenpairs(n, w, static_cast<E *>(nullptr), 0);
+                return;
+            }
+
+            // Y = Q^T，Q = diag(1, Q')，Q' 的反射向量按 QR 的布局存放在 A 的第 1 行起
+            std::vector<E> Y(n * n, E(0));
+            for (size_t i = 0; i < n; ++i)
+                Y[i * n + i] = E(1);
+            if (n > 2)
+                qrApplyQ(n - 1, n - 2, A + ld, ld, tau.data(), Y.data() + n, n, n, true);
+            tridiagonalQL(n, w, e.data(), Y.data(), n);
+            sortEigenpairs(n, w, Y.data(), n);
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    A[i * ld + j] = Y[j * n + i];
+        }
+
+        /**
+         * @brief 对称矩阵特征分解的入口：只读取 A 的下三角，先镜像到上三角
+         * @details 第二个参数在编译期选择 Jacobi（定长小矩阵）或三对角化路径。
+         */
+        template <size_t N, typename E>
+        void symmetricEigen(size_t n, E *A, E *w, bool vectors, std::true_type)
+        {
+            static_assert(std::is_floating_point<E>::value, "Eigendecomposition requires a real floating-point scalar type");
+            for (size_t i = 0; i < N; ++i)
+                for (size_t j = i + 1; j < N; ++j)
+                    A[i * N + j] = A[j * N + i];
+            (void)n;
+            jacobiEigen<N>(A, w, vectors);
+        }
+
+        template <size_t N, typename E>
+        void symmetricEigen(size_t n, E *A, E *w, bool vectors, std::false_type)
+        {
+            static_assert(std::is_floating_point<E>::value, "Eigendecomposition requires a real floating-point scalar type");
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = i + 1; j < n; ++j)
+                    A[i * n + j] = A[j * n + i];
+            symmetricEigenTridiagonal(n, A, n, w, vectors);
+        }
+
+        // Francis QR 迭代中每个特征值允许的最大迭代次数，第 10、20、... 次使用特殊位移
+        constexpr size_t FrancisMaxIterations = 60;
+
+        /**
+         * @brief 平衡（LAPACK dgebal 的缩放部分）：用 2 的幂对角相似变换使各行与对应列的范数接近，特征值不变
+         */
+        template <typename E>
+        void balanceMatrix(size_t n, E *A, size_t ld)
+        {
+            const E radix = E(std::numeric_limits<E>::radix);
+            const E radix2 = radix * radix;
+            bool done = false;
+            while (!done)
+            {
+                done = true;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    E r = E(0), c = E(0);
+                    for (size_t j = 0; j < n; ++j)
+                        if (j != i)
+                        {
+                            c += std::abs(A[j * ld + i]);
+                            r += std::abs(A[i * ld + j]);
+                        }
+                    if (c == E(0) || r == E(0))
+                        continue;
+                    const E s = c + r;
+                    E f = E(1), g = r / radix;
+                    while (c < g)
+                    {
+                        f *= radix;
+                        c *= radix2;
+                    }
+                    g = r * radix;
+                    while (c > g)
+                    {
+                        f /= radix;
+                        c /= radix2;
+                    }
+                    if ((c + r) / f < E(0.95) * s)
+                    {
+                        done = false;
+                        const E inv = E(1) / f;
+                        for (size_t j = 0; j < n; ++j)
+                            A[i * ld + j] *= inv;
+                        for (size_t j = 0; j < n; ++j)
+                            A[j * ld + i] *= f;
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Householder 约化为上 Hessenberg 矩阵（LAPACK dgehd2），只保留 Hessenberg 部分，反射向量不保存
+         * @details 左乘按行做 axpy，右乘对每一行做连续的点积，两者都顺序访问行主序存储。
+         */
+        template <typename E>
+        void hessenbergReduce(size_t n, E *A, size_t ld)
+        {
+            std::vector<E> v(n), w(n);
+            for (size_t k = 0; k + 2 < n; ++k)
+            {
+                const size_t len = n - k - 1;
+                for (size_t i = 0; i < len; ++i)
+                    v[i] = A[(k + 1 + i) * ld + k];
+                const E t = householder(len, v.data(), size_t(1));
+                A[(k + 1) * ld + k] = v[0];
+                for (size_t i = 1; i < len; ++i)
+                    A[(k + 1 + i) * ld + k] = E(0);
+                if (t == E(0))
+                    continue;
+                v[0] = E(1);
+
+                // 左乘：A[k+1:n, k+1:n] -= tau * v * (v^T * A[k+1:n, k+1:n])
+                std::fill(w.begin(), w.begin() + len, E(0));
+                for (size_t i = 0; i < len; ++i)
+                {
+                    const E vi = v[i];
+                    const E *row = A + (k + 1 + i) * ld + k + 1;
+                    for (size_t j = 0; j < len; ++j)
+                        w[j] += vi * row[j];
+                }
+                for (size_t i = 0; i < len; ++i)
+                {
+                    const E s = t * v[i];
+                    E *row = A + (k + 1 + i) * ld + k + 1;
+                    for (size_t j = 0; j < len; ++j)
+                        row[j] -= s * w[j];
+                }
+
+                // 右乘：A[0:n, k+1:n] -= tau * (A[0:n, k+1:n] * v) * v^T
+                for (size_t r = 0; r < n; ++r)
+                {
+                    E *row = A + r * ld + k + 1;
+                    const E s = t * packetDot(len, row, v.data());
+                    for (size_t j = 0; j < len; ++j)
+                        row[j] -= s * v[j];
+                }
+            }
+        }
+
+        /**
+         * @brief 上 Hessenberg 矩阵的隐式双位移 Francis QR 迭代（EISPACK hqr），只求特征值
+         * @param A 行主序上 Hessenberg 矩阵，计算后被破坏
+         * @param wr、wi 输出 n 个特征值的实部与虚部；共轭复特征值成对出现，虚部为正者在前
+         * @throws std::runtime_error 如果某个特征值在 FrancisMaxIterations 次迭代内未收敛
+         */
+        template <typename E>
+        void hessenbergQR(size_t n, E *A, size_t ld, E *wr, E *wi)
+        {
+            const E eps = std::numeric_limits<E>::epsilon();
+            auto a = [A, ld](std::ptrdiff_t i, std::ptrdiff_t j) -> E & { return A[i * std::ptrdiff_t(ld) + j]; };
+            E anorm = E(0);
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = i > 0 ? i - 1 : 0; j < n; ++j)
+                    anorm += std::abs(a(i, j));
+
+            // 一次扫描中各步的 3 阶反射 (x, y, z, q, r)：行 (c0, c1, c2) -> c - p * (1, q, r)，p = x * c0 + y * c1 + z * c2
+            std::vector<E> reflectors(5 * n);
+            std::vector<char> active(n);
+            auto applyRight = [&reflectors](E *row, std::ptrdiff_t k)
+            {
+                const E *refl = reflectors.data() + 5 * k;
+                E pi = refl[0] * row[k] + refl[1] * row[k + 1];
+                if (refl[2] != E(0) || refl[4] != E(0))
+                {
+                    pi += refl[2] * row[k + 2];
+                    row[k + 2] -= pi * refl[4];
+                }
+                row[k + 1] -= pi * refl[3];
+                row[k] -= pi;
+            };
+
+            std::ptrdiff_t nn = std::ptrdiff_t(n) - 1;
+            E t = E(0);
+            size_t its = 0;
+            while (nn >= 0)
+            {
+                // 寻找可以忽略的次对角元，活动块为 [l, nn]
+                std::ptrdiff_t l = nn;
+                for (; l > 0; --l)
+                {
+                    E s = std::abs(a(l - 1, l - 1)) + std::abs(a(l, l));
+                    if (s == E(0))
+                        s = anorm;
+                    if (std::abs(a(l, l - 1)) <= eps * s)
+                    {
+                        a(l, l - 1) = E(0);
+                        break;
+                    }
+                }
+                E x = a(nn, nn);
+                if (l == nn)
+                {
+                    // 1x1 块：实特征值
+                    wr[nn] = x + t;
+                    wi[nn] = E(0);
+                    --nn;
+                    its = 0;
+                    continue;
+                }
+                E y = a(nn - 1, nn - 1);
+                E w = a(nn, nn - 1) * a(nn - 1, nn);
+                if (l == nn - 1)
+                {
+                    // 2x2 块：一对实特征值或一对共轭复特征值
+                    const E p = E(0.5) * (y - x);
+                    const E q = p * p + w;
+                    E z = std::sqrt(std::abs(q));
+                    x += t;
+                    if (q >= E(0))
+                    {
+                        z = p + std::copysign(z, p);
+                        wr[nn - 1] = wr[nn] = x + z;
+                        if (z != E(0))
+                            wr[nn] = x - w / z;
+                        wi[nn - 1] = wi[nn] = E(0);
+                    }
+                    else
+                    {
+                        wr[nn - 1] = wr[nn] = x + p;
+                        wi[nn - 1] = z;
+                        wi[nn] = -z;
+                    }
+                    nn -= 2;
+                    its = 0;
+                    continue;
+                }
+
+                if (its >= FrancisMaxIterations)
+                    throw std::runtime_error("Eigenvalue iteration did not converge.");
+                if (its > 0 && its % 10 == 0)
+                {
+                    // 特殊位移，打破可能的循环
+                    t += x;
+                    for (std::ptrdiff_t i = 0; i <= nn; ++i)
+                        a(i, i) -= x;
+                    const E s = std::abs(a(nn, nn - 1)) + std::abs(a(nn - 1, nn - 2));
+                    y = x = E(0.75) * s;
+                    w = E(-0.4375) * s * s;
+                }
+                ++its;
+
+                // 寻找两个连续的小次对角元，从第 m 行开始做双位移 QR 步
+                std::ptrdiff_t m = nn - 2;
+                E p = E(0), q = E(0), r = E(0), z = E(0);
+                for (;; --m)
+                {
+                    z = a(m, m);
+                    r = x - z;
+                    E s = y - z;
+                    p = (r * s - w) / a(m + 1, m) + a(m, m + 1);
+                    q = a(m + 1, m + 1) - z - r - s;
+                    r = a(m + 2, m + 1);
+                    s = std::abs(p) + std::abs(q) + std::abs(r);
+                    p /= s;
+                    q /= s;
+                    r /= s;
+                    if (m == l)
+                        break;
+                    const E u = std::abs(a(m, m - 1)) * (std::abs(q) + std::abs(r));
+                    const E v = std::abs(p) * (std::abs(a(m - 1, m - 1)) + std::abs(z) + std::abs(a(m + 1, m + 1)));
+                    if (u <= eps * v)
+                        break;
+                }
+                for (std::ptrdiff_t i = m; i < nn - 1; ++i)
+                {
+                    a(i + 2, i) = E(0);
+                    if (i != m)
+                        a(i + 2, i - 1) = E(0);
+                }
+
+                // 追赶凸起
+                for (std::ptrdiff_t k = m; k < nn; ++k)
+                {
+                    active[k] = 0;
+                    if (k != m)
+                    {
+                        p = a(k, k - 1);
+                        q = a(k + 1, k - 1);
+                        r = k + 1 != nn ? a(k + 2, k - 1) : E(0);
+                        x = std::abs(p) + std::abs(q) + std::abs(r);
+                        if (x != E(0))
+                        {
+                            p /= x;
+                            q /= x;
+                            r /= x;
+                        }
+                    }
+                    const E s = std::copysign(std::sqrt(p * p + q * q + r * r), p);
+                    if (s == E(0))
+                        continue;
+                    if (k == m)
+                    {
+                        if (l != m)
+                            a(k, k - 1) = -a(k, k - 1);
+                    }
+                    else
+                        a(k, k - 1) = -s * x;
+                    p += s;
+                    x = p / s;
+                    y = q / s;
+                    z = r / s;
+                    q /= p;
+                    r /= p;
+                    // 左乘：行 k、k + 1、k + 2
+                    E *rowK = &a(k, 0), *rowK1 = &a(k + 1, 0);
+                    E *rowK2 = k + 1 != nn ? &a(k + 2, 0) : nullptr;
+                    for (std::ptrdiff_t j = k; j <= nn; ++j)
+                    {
+                        E pj = rowK[j] + q * rowK1[j];
+                        if (rowK2)
+                        {
+                            pj += r * rowK2[j];
+                            rowK2[j] -= pj * z;
+                        }
+                        rowK1[j] -= pj * y;
+                        rowK[j] -= pj * x;
+                    }
+                    // 右乘：列 k、k + 1、k + 2。之后的步骤只会读写第 k + 1 行以下的行，
+                    // 因此这里只更新第 k + 1 至 k + 3 行，第 l 至 k 行的右乘延后到本次扫描结束时逐行完成
+                    E *refl = reflectors.data() + 5 * k;
+                    refl[0] = x;
+                    refl[1] = y;
+                    refl[2] = rowK2 ? z : E(0);
+                    refl[3] = q;
+                    refl[4] = rowK2 ? r : E(0);
+                    active[k] = 1;
+                    const std::ptrdiff_t iEnd = std::min(nn, k + 3);
+                    for (std::ptrdiff_t i = std::max(l, k + 1); i <= iEnd; ++i)
+                        applyRight(&a(i, 0), k);
+                }
+                // 延后的右乘：第 i 行依次作用第 max(m, i) 至 nn - 1 个反射。
+                // 每次处理 8 行，各行互不依赖，所用的缓存行在整个扫描中都留在 L1
+                for (std::ptrdiff_t i0 = l; i0 < nn; i0 += 8)
+                {
+                    const std::ptrdiff_t i1 = std::min(nn, i0 + 8);
+                    for (std::ptrdiff_t k = std::max(m, i0); k < nn; ++k)
+                    {
+                        if (!active[k])
+                            continue;
+                        const std::ptrdiff_t iEnd = std::min(i1, k + 1);
+                        for (std::ptrdiff_t i = i0; i < iEnd; ++i)
+                            applyRight(&a(i, 0), k);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief 一般实矩阵的全部特征值：平衡、Hessenberg 约化、Francis QR
+         * @param A 行主序 n×n 矩阵（行跨度 n），计算后被破坏
+         * @param wr、wi 输出特征值的实部与虚部，按实部升序、实部相同时按虚部升序排列
+         */
+        template <typename E>
+        void generalEigenvalues(size_t n, E *A, E *wr, E *wi)
+        {
+            static_assert(std::is_floating_point<E>::value, "Eigenvalues require a real floating-point scalar type");
+            if (n == 0)
+                return;
+            balanceMatrix(n, A, n);
+            hessenbergReduce(n, A, n);
+            hessenbergQR(n, A, n, wr, wi);
+            for (size_t i = 0; i + 1 < n; ++i)
+            {
+                size_t minIndex = i;
+                for (size_t j = i + 1; j < n; ++j)
+                    if (wr[j] < wr[minIndex] || (wr[j] == wr[minIndex] && wi[j] < wi[minIndex]))
+                        minIndex = j;
+                std::swap(wr[i], wr[minIndex]);
+                std::swap(wi[i], wi[minIndex]);
+            }
+        }
+    }
+}
@@ -0,0 +1,172 @@
+/**
+ * @file ElementwiseMath.hpp
+ * @brief 矩阵、向量及表达式上的惰性逐元素函数：exp、log、sin、cos、tanh、sqrt、abs。
+ * @details exp(A) 等返回 MatrixUnaryOp 表达式节点，与其他表达式组合后在赋值或归约时一次求值，
+ *          例如 C = exp(A) * 2.0 + sin(B)、tanh(A).sum() 都不生成中间矩阵。
+ *          实数元素（Real、Real32 等）使用 SimdMath.hpp 中的多项式内核：可线性访问时按数据包计算，
+ *          其余情况（转置等）与循环尾部用同一内核的标量版本，因此同一元素无论走哪条路径结果都相同。
+ *          双精度误差（相对正确舍入结果）：
+ *          - exp：约 1 ulp，x > 709.78 时为 inf，x < -708.40 时刷新为 0；
+ *          - log：约 1 ulp；
+ *          - sin/cos：|x| <= 2^29 时不超过 1 ulp，包括 x 接近 π/2 整数倍、结果接近 0 的情形；更大的参数调用标准库；
+ *          - tanh：约 2 ulp；
+ *          - sqrt、abs：正确舍入（0 ulp）。
+ *          单精度误差不超过 2 ulp（tanh 不超过 3 ulp），sin/cos 在 |x| <= 8192 时不超过 1 ulp，更大的参数调用标准库。
+ *          CheckedArithmetic 策略下 sqrt 遇到负数、log 遇到非正数时抛出 std::domain_error，与标量版本一致；
+ *          IEEEArithmetic 策略下得到 NaN / -inf。
+ *          复数元素支持 exp、log、sqrt，逐元素调用 AlgebraTool.hpp 中的标量函数。
+ */
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include "NumberField.hpp"
+#include "AlgebraTool.hpp"
+#include "MatrixBase.hpp"
+#include "MatrixExpr.hpp"
+#include "Simd.hpp"
+#include "SimdMath.hpp"
+
+namespace OxygenMath
+{
+    namespace internal
+    {
+        // 数据包中是否有分量小于 bound（orEqual 为 true 时小于等于）
+        template <typename P>
+        bool anyLess(typename P::type x, typename P::Scalar bound, bool orEqual)
+        {
+            alignas(64) typename P::Scalar lanes[P::size];
+            P::store(lanes, x);
+            for (size_t l = 0; l < P::size; ++l)
+                if (lanes[l] < bound || (orEqual && lanes[l] == bound))
+                    return true;
+            return false;
+        }
+
+        /**
+         * @brief 逐元素函数对象的公共部分：实数元素用 Op::packet 的标量版本计算
+         * @details Op::packet<P, Checked>(x) 对数据包类型 P 计算函数值，Checked 为元素类型的检查策略。
+         */
+        template <typename Op>
+        struct RealUnaryOp
+        {
+            template <typename F, typename Policy>
+            static BasicReal<F, Policy> apply(const BasicReal<F, Policy> &x)
+            {
+                return BasicReal<F, Policy>(Op::template packet<simd::ScalarPacket<F>, Policy::checked>(x.data));
+            }
+        };
+
+        struct ExpOp : RealUnaryOp<ExpOp>
+        {
+            using RealUnaryOp<ExpOp>::apply;
+            template <typename T>
+            static T apply(const T &x) { return exp(x); }
+
+            template <typename P, bool Checked>
+            static typename P::type packet(typename P::type x) { return simd::exp<P>(x); }
+        };
+
+        struct LogOp : RealUnaryOp<LogOp>
+        {
+            using RealUnaryOp<LogOp>::apply;
+            template <typename T>
+            static T apply(const T &x) { return log(x); }
+
+            template <typename P, bool Checked>
+            static typename P::type packet(typename P::type x)
+            {
+                if (Checked && anyLess<P>(x, typename P::Scalar(0), true))
+                    throw std::domain_error("Logarithm undefined for non-positive values");
+                return simd::log<P>(x);
+            }
+        };
+
+        struct SinOp : RealUnaryOp<SinOp>
+        {
+            template <typename P, bool Checked>
+            static typename P::type packet(typename P::type x) { return simd::sin<P>(x); }
+        };
+
+        struct CosOp : RealUnaryOp<CosOp>
+        {
+            template <typename P, bool Checked>
+            static typename P::type packet(typename P::type x) { return simd::cos<P>(x); }
+        };
+
+        struct TanhOp : RealUnaryOp<TanhOp>
+        {
+            template <typename P, bool Checked>
+            static typename P::type packet(typename P::type x) { return simd::tanh<P>(x); }
+        };
+
+        struct SqrtOp : RealUnaryOp<SqrtOp>
+        {
+            using RealUnaryOp<SqrtOp>::apply;
+            template <typename T>
+            static T apply(const T &x) { return sqrt(x); }
+
+            template <typename P, bool Checked>
+            static typename P::type packet(typename P::type x)
+            {
+                if (Checked && anyLess<P>(x, typename P::Scalar(0), false))
+                    throw std::domain_error("Square root of negative number");
+                return P::sqrt(x);
+            }
+        };
+
+        struct AbsOp : RealUnaryOp<AbsOp>
+        {
+            template <typename P, bool Checked>
+            static typename P::type packet(typename P::type x) { return P::abs(x); }
+        };
+    }
+
+    // 逐元素 e^x
+    template <typename Derived>
+    MatrixUnaryOp<Derived, internal::ExpOp> exp(const MatrixBase<Derived> &m)
+    {
+        return MatrixUnaryOp<Derived, internal::ExpOp>(m.derived());
+    }
+
+    // 逐元素自然对数
+    template <typename Derived>
+    MatrixUnaryOp<Derived, internal::LogOp> log(const MatrixBase<Derived> &m)
+    {
+        return MatrixUnaryOp<Derived, internal::LogOp>(m.derived());
+    }
+
+    // 逐元素正弦（仅限实数元素）
+    template <typename Derived>
+    MatrixUnaryOp<Derived, internal::SinOp> sin(const MatrixBase<Derived> &m)
+    {
+        return MatrixUnaryOp<Derived, internal::SinOp>(m.derived());
+    }
+
+    // 逐元素余弦（仅限实数元素）
+    template <typename Derived>
+    MatrixUnaryOp<Derived, internal::CosOp> cos(const MatrixBase<Derived> &m)
+    {
+        return MatrixUnaryOp<Derived, internal::CosOp>(m.derived());
+    }
+
+    // 逐元素双曲正切（仅限实数元素）
+    template <typename Derived>
+    MatrixUnaryOp<Derived, internal::TanhOp> tanh(const MatrixBase<Derived> &m)
+    {
+        return MatrixUnaryOp<Derived, internal::TanhOp>(m.derived());
+    }
+
+    // 逐元素平方根
+    template <typename Derived>
+    MatrixUnaryOp<Derived, internal::SqrtOp> sqrt(const MatrixBase<Derived> &m)
+    {
+        return MatrixUnaryOp<Derived, internal::SqrtOp>(m.derived());
+    }
+
+    // 逐元素绝对值（仅限实数元素）
+    template <typename Derived>
+    MatrixUnaryOp<Derived, internal::AbsOp> abs(const MatrixBase<Derived> &m)
+    {
+        return MatrixUnaryOp<Derived, internal::AbsOp>(m.derived());
+    }
+}
@@ -0,0 +1,283 @@
+/**
+ * @file Gemm.hpp
+ * @brief 分块、打包的通用矩阵乘法内核 C = alpha * A * B + beta * C。
+ * @details 采用 GotoBLAS/BLIS 的分层结构：
+ *          - NC 列块驻留 L3，KC×NC 的 B 面板打包后驻留 L3/L2；
+ *          - MC×KC 的 A 块打包后驻留 L2；
+ *          - MR×NR 的寄存器块由微内核计算，B 的 NR 列分片驻留 L1。
+ *          所有矩阵都以"行步长/列步长"描述，因此转置与子块无需拷贝即可参与运算。
+ *          规模达到 GemmParallelThreshold 时，每个 B 面板打包一次后由所有线程共享，
+ *          C 按行切成不超过线程数的块（长度为 MR 的整数倍）交给线程池，每块在自己的缓冲区中打包 A。
+ */
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include "Simd.hpp"
+#include "DenseStorage.hpp"
+#include "../Parallel/ParallelFor.hpp"
+
+namespace OxygenMath
+{
+    namespace internal
+    {
+        /**
+         * @brief GEMM 分块参数
+         * @details MR×NR 为寄存器块：NR 取两个数据包宽度，MR 保证累加器加上
+         *          B 的两个数据包与一个广播寄存器不超出寄存器文件。
+         *          KC 使一个 KC×NR 的 B 分片留在 L1，MC×KC 的 A 块留在 L2，
+         *          KC×NC 的 B 面板留在 L3。
+         */
+        template <typename F>
+        struct GemmBlocking
+        {
+            static constexpr size_t MR = simd::Packet<F>::size >= 8 ? 12 : (simd::Packet<F>::size >= 4 ? 6 : 4);
+            static constexpr size_t NR = 2 * simd::Packet<F>::size;
+            static constexpr size_t KC = 256;
+            static constexpr size_t MC = MR * 16;
+            static constexpr size_t NC = NR * 256;
+        };
+        template <typename F>
+        constexpr size_t GemmBlocking<F>::MR;
+        template <typename F>
+        constexpr size_t GemmBlocking<F>::NR;
+        template <typename F>
+        constexpr size_t GemmBlocking<F>::KC;
+        template <typename F>
+        constexpr size_t GemmBlocking<F>::MC;
+        template <typename F>
+        constexpr size_t GemmBlocking<F>::NC;
+
+        // 小于该规模（m*n*k）的乘法直接使用朴素循环，打包的开销得不偿失
+        constexpr size_t GemmSmallThreshold = 16 * 16 * 16;
+
+        // 达到该规模（m*n*k）且 m 至少有两个 MR 行块时按行并行
+        constexpr size_t GemmParallelThreshold = 96 * 96 * 96;
+
+        /**
+         * @brief 将 A 的 mc×kc 子块打包为若干 MR 行面板，每个面板按 k 主序连续存放
+         *        不足 MR 的行补零
+         */
+        template <typename F>
+        void gemmPackA(size_t mc, size_t kc, const F *A, size_t rsA, size_t csA, F *packed)
+        {
+            constexpr size_t MR = GemmBlocking<F>::MR;
+            for (size_t ir = 0; ir < mc; ir += MR)
+            {
+                const size_t mr = std::min(MR, mc - ir);
+                for (size_t p = 0; p < kc; ++p)
+                {
+                    for (size_t r = 0; r < mr; ++r)
+                        packed[r] = A[(ir + r) * rsA + p * csA];
+                    for (size_t r = mr; r < MR; ++r)
+                        packed[r] = F(0);
+                    packed += MR;
+                }
+            }
+        }
+
+        /**
+         * @brief 将 B 的 kc×nc 子块打包为若干 NR 列面板，每个面板按 k 主序连续存放
+         *        不足 NR 的列补零
+         */
+        template <typename F>
+        void gemmPackB(size_t kc, size_t nc, const F *B, size_t rsB, size_t csB, F *packed)
+        {
+            constexpr size_t NR = GemmBlocking<F>::NR;
+            for (size_t jr = 0; jr < nc; jr += NR)
+            {
+                const size_t nr = std::min(NR, nc - jr);
+                for (size_t p = 0; p < kc; ++p)
+                {
+                    const F *row = B + p * rsB + jr * csB;
+                    if (csB == 1)
+                    {
+                        for (size_t j = 0; j < nr; ++j)
+                            packed[j] = row[j];
+                    }
+                    else
+                    {
+                        for (size_t j = 0; j < nr; ++j)
+                            packed[j] = row[j * csB];
+                    }
+                    for (size_t j = nr; j < NR; ++j)
+                        packed[j] = F(0);
+                    packed += NR;
+                }
+            }
+        }
+
+        /**
+         * @brief MR×NR 寄存器块微内核：C[0:mr, 0:nr] = alpha * Ap * Bp + beta * C
+         * @details 每一步 k 载入 B 的一行（NR 个元素，两个数据包），广播 A 的 MR 个元素，
+         *          以 FMA 累加到 MR×2 个累加寄存器中。beta 为 0 时不读取 C。
+         */
+        template <typename F>
+        void gemmMicroKernel(size_t kc, const F *a, const F *b, F *C, size_t ldc,
+                             F alpha, F beta, size_t mr, size_t nr)
+        {
+            using P = simd::Packet<F>;
+            constexpr size_t MR = GemmBlocking<F>::MR;
+            constexpr size_t NR = GemmBlocking<F>::NR;
+            constexpr size_t NV = NR / P::size;
+
+            typename P::type acc[MR][NV];
+            for (size_t r = 0; r < MR; ++r)
+                for (size_t v = 0; v < NV; ++v)
+                    acc[r][v] = P::zero();
+
+            for (size_t p = 0; p < kc; ++p)
+            {
+                typename P::type bv[NV];
+                for (size_t v = 0; v < NV; ++v)
+                    bv[v] = P::load(b + v * P::size);
+                for (size_t r = 0; r < MR; ++r)
+                {
+                    const typename P::type av = P::set1(a[r]);
+                    for (size_t v = 0; v < NV; ++v)
+                        acc[r][v] = P::fmadd(av, bv[v], acc[r][v]);
+                }
+                a += MR;
+                b += NR;
+            }
+
+            const typename P::type valpha = P::set1(alpha);
+            if (mr == MR && nr == NR)
+            {
+                const typename P::type vbeta = P::set1(beta);
+                for (size_t r = 0; r < MR; ++r)
+                {
+                    for (size_t v = 0; v < NV; ++v)
+                    {
+                        F *c = C + r * ldc + v * P::size;
+                        if (beta == F(0))
+                            P::storeu(c, P::mul(valpha, acc[r][v]));
+                        else
+                            P::storeu(c, P::fmadd(valpha, acc[r][v], P::mul(vbeta, P::loadu(c))));
+                    }
+                }
+                return;
+            }
+
+            // 边界块：先写入对齐的临时块，再拷贝有效部分
+            alignas(64) F tile[MR * NR];
+            for (size_t r = 0; r < MR; ++r)
+                for (size_t v = 0; v < NV; ++v)
+                    P::store(tile + r * NR + v * P::size, P::mul(valpha, acc[r][v]));
+            for (size_t r = 0; r < mr; ++r)
+            {
+                for (size_t j = 0; j < nr; ++j)
+                {
+                    F &c = C[r * ldc + j];
+                    c = (beta == F(0)) ? tile[r * NR + j] : tile[r * NR + j] + beta * c;
+                }
+            }
+        }
+
+        /**
+         * @brief 朴素的 i-k-j 循环，用于小规模或退化（矩阵-向量）的乘法
+         */
+        template <typename F>
+        void gemmSmall(size_t m, size_t n, size_t k, F alpha,
+                       const F *A, size_t rsA, size_t csA,
+                       const F *B, size_t rsB, size_t csB,
+                       F beta, F *C, size_t ldc)
+        {
+            for (size_t i = 0; i < m; ++i)
+            {
+                F *c = C + i * ldc;
+                for (size_t j = 0; j < n; ++j)
+                    c[j] = (beta == F(0)) ? F(0) : beta * c[j];
+                for (size_t p = 0; p < k; ++p)
+                {
+                    const F aip = alpha * A[i * rsA + p * csA];
+                    const F *b = B + p * rsB;
+                    for (size_t j = 0; j < n; ++j)
+                        c[j] += aip * b[j * csB];
+                }
+            }
+        }
+
+        /**
+         * @brief 通用矩阵乘法 C = alpha * A * B + beta * C
+         *
+         * A 为 m×k，元素 (i, p) 位于 A[i * rsA + p * csA]；
+         * B 为 k×n，元素 (p, j) 位于 B[p * rsB + j * csB]；
+         * C 为 m×n 行主序，行跨度为 ldc。C 不得与 A、B 重叠。
+         *
+         * @tparam F 底层浮点类型
+         */
+        template <typename F>
+        void gemm(size_t m, size_t n, size_t k, F alpha,
+                  const F *A, size_t rsA, size_t csA,
+                  const F *B, size_t rsB, size_t csB,
+                  F beta, F *C, size_t ldc)
+        {
+            if (m == 0 || n == 0)
+                return;
+            if (k == 0 || m * n * k <= GemmSmallThreshold || m == 1 || n == 1)
+            {
+                gemmSmall(m, n, k, alpha, A, rsA, csA, B, rsB, csB, beta, C, ldc);
+                return;
+            }
+
+            typedef GemmBlocking<F> Blk;
+            const size_t kcMax = std::min(Blk::KC, k);
+            const size_t mcMax = std::min(Blk::MC, (m + Blk::MR - 1) / Blk::MR * Blk::MR);
+            const size_t ncMax = std::min(Blk::NC, (n + Blk::NR - 1) / Blk::NR * Blk::NR);
+            const size_t threads = (m * n * k >= GemmParallelThreshold && m >= 2 * Blk::MR)
+                                       ? std::min(parallelThreads(), m / Blk::MR)
+                                       : 1;
+            // 行方向切成 blocks 个长度为 MR 整数倍的块，每块一个 A 打包缓冲区，按块号索引
+            const size_t rowBlock = (m + threads - 1) / threads;
+            const size_t blockRows = (rowBlock + Blk::MR - 1) / Blk::MR * Blk::MR;
+            const size_t blocks = (m + blockRows - 1) / blockRows;
+            F *packedA = static_cast<F *>(alignedMalloc(blocks * mcMax * kcMax * sizeof(F)));
+            F *packedB = static_cast<F *>(alignedMalloc(kcMax * ncMax * sizeof(F)));
+
+            for (size_t jc = 0; jc < n; jc += Blk::NC)
+            {
+                const size_t nc = std::min(Blk::NC, n - jc);
+                for (size_t pc = 0; pc < k; pc += Blk::KC)
+                {
+                    const size_t kc = std::min(Blk::KC, k - pc);
+                    // 第一个 k 块应用调用者给的 beta，之后的 k 块在已有结果上累加
+                    const F betaBlock = (pc == 0) ? beta : F(1);
+                    gemmPackB(kc, nc, B + pc * rsB + jc * csB, rsB, csB, packedB);
+
+                    auto rowRange = [&](size_t block)
+                    {
+                        F *pa = packedA + block * mcMax * kcMax;
+                        const size_t i0 = block * blockRows, i1 = std::min(m, i0 + blockRows);
+                        for (size_t ic = i0; ic < i1; ic += Blk::MC)
+                        {
+                            const size_t mc = std::min(Blk::MC, i1 - ic);
+                            gemmPackA(mc, kc, A + ic * rsA + pc * csA, rsA, csA, pa);
+
+                            for (size_t jr = 0; jr < nc; jr += Blk::NR)
+                            {
+                                const size_t nr = std::min(Blk::NR, nc - jr);
+                                for (size_t ir = 0; ir < mc; ir += Blk::MR)
+                                {
+                                    const size_t mr = std::min(Blk::MR, mc - ir);
+                                    gemmMicroKernel(kc, pa + ir * kc, packedB + jr * kc,
+                                                    C + (ic + ir) * ldc + jc + jr, ldc,
+                                                    alpha, betaBlock, mr, nr);
+                                }
+                            }
+                        }
+                    };
+                    if (blocks == 1)
+                        rowRange(0);
+                    else
+                        parallelFor(0, blocks, 1, [&](size_t b0, size_t b1)
+                                    {
+                                        for (size_t b = b0; b < b1; ++b)
+                                            rowRange(b); });
+                }
+            }
+
+            alignedFree(packedA);
+            alignedFree(packedB);
+        }
+    }
+}
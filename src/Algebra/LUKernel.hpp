@@ -0,0 +1,279 @@
+/**
+ * @file LUKernel.hpp
+ * @brief 原地、分块、右视（right-looking）的部分主元 LU 分解内核。
+ * @details 与 LAPACK dgetrf 相同的结构：每次分解一个 NB 列宽的面板，
+ *          再用三角求解得到 U12，最后用 GEMM 完成尾部更新 A22 -= L21 * U12。
+ *          大矩阵的绝大部分浮点运算落在 GEMM 中，因此分解速度接近 GEMM。
+ *          矩阵按行主序存储、行跨度为 ld；L（单位下三角，不存对角线）与 U 共用同一块内存，
+ *          行交换记录为下标数组：第 k 步把第 k 行与第 pivots[k] 行交换。
+ *          求解时的前向/后向替换同样按 NB 行分块：对角块内逐行消去，块外部分用 GEMM 更新。
+ */
+#pragma once
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+#include <array>
+#include <vector>
+#include "Gemm.hpp"
+#include "Assign.hpp"
+
+namespace OxygenMath
+{
+    namespace internal
+    {
+        // 面板宽度
+        constexpr size_t LUBlockSize = 64;
+
+        /**
+         * @brief 行交换下标数组：定长矩阵使用 std::array（不分配内存），动态矩阵使用 std::vector
+         */
+        template <size_t N>
+        struct PivotArray
+        {
+            using type = std::array<size_t, N>;
+            static type make(size_t)
+            {
+                type p;
+                p.fill(0);
+                return p;
+            }
+        };
+
+        template <>
+        struct PivotArray<Dynamic>
+        {
+            using type = std::vector<size_t>;
+            static type make(size_t n) { return type(n, 0); }
+        };
+
+        template <typename E>
+        auto luMagnitude(const E &x) -> typename std::enable_if<std::is_floating_point<E>::value, E>::type
+        {
+            return std::abs(x);
+        }
+
+        template <typename E>
+        auto luMagnitude(const E &x) -> typename std::enable_if<!std::is_floating_point<E>::value, decltype(abs(x))>::type
+        {
+            return abs(x);
+        }
+
+        /**
+         * @brief C(m×n) -= A(m×k) * B(k×n)，三者均为行主序（行跨度分别为 lda、ldb、ldc），互不重叠
+         * @details 浮点元素交给分块 GEMM，其余元素类型使用 i-k-j 循环。
+         */
+        template <typename E>
+        void luTrailingUpdate(size_t m, size_t n, size_t k, const E *A, size_t lda, const E *B, size_t ldb, E *C, size_t ldc, std::true_type)
+        {
+            gemm<E>(m, n, k, E(-1), A, lda, 1, B, ldb, 1, E(1), C, ldc);
+        }
+
+        template <typename E>
+        void luTrailingUpdate(size_t m, size_t n, size_t k, const E *A, size_t lda, const E *B, size_t ldb, E *C, size_t ldc, std::false_type)
+        {
+            for (size_t i = 0; i < m; ++i)
+            {
+                E *c = C + i * ldc;
+                for (size_t p = 0; p < k; ++p)
+                {
+                    const E aip = A[i * lda + p];
+                    const E *b = B + p * ldb;
+                    for (size_t j = 0; j < n; ++j)
+                        c[j] -= aip * b[j];
+                }
+            }
+        }
+
+        // 右端项列数达到该值时，替换中块外部分的更新改用 GEMM；更少的列数下 GEMM 的打包开销不划算
+        constexpr size_t LUSolveGemmColumns = 4;
+
+        template <typename E>
+        void luSolveUpdate(size_t m, size_t n, size_t k, const E *A, size_t lda, const E *B, size_t ldb, E *C, size_t ldc)
+        {
+            if (std::is_floating_point<E>::value && n >= LUSolveGemmColumns)
+                luTrailingUpdate(m, n, k, A, lda, B, ldb, C, ldc, std::integral_constant<bool, std::is_floating_point<E>::value>());
+            else
+                luTrailingUpdate(m, n, k, A, lda, B, ldb, C, ldc, std::false_type());
+        }
+
+        /**
+         * @brief 非分块的面板分解：对第 col0 到 col1 列（所有 col0 之后的行）做部分主元消元
+         * @details 行交换作用于整行，因此面板左侧的 L 与右侧尚未处理的列同步交换。
+         *          主元为 0 的列不做除法（与 LAPACK 一致），由调用方根据 |主元| 判断奇异。
+         */
+        template <typename E, typename Pivots>
+        void luPanel(size_t n, E *A, size_t ld, size_t col0, size_t col1, Pivots &pivots, int &swapCount)
+        {
+            for (size_t k = col0; k < col1; ++k)
+            {
+                size_t maxRow = k;
+                auto maxVal = luMagnitude(A[k * ld + k]);
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    const auto v = luMagnitude(A[i * ld + k]);
+                    if (v > maxVal)
+                    {
+                        maxVal = v;
+                        maxRow = i;
+                    }
+                }
+                pivots[k] = maxRow;
+                if (maxRow != k)
+                {
+                    std::swap_ranges(A + k * ld, A + k * ld + n, A + maxRow * ld);
+                    ++swapCount;
+                }
+
+                const E pivot = A[k * ld + k];
+                if (pivot == E(0))
+                    continue;
+                const E *rowK = A + k * ld;
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    E *rowI = A + i * ld;
+                    const E l = rowI[k] / pivot;
+                    rowI[k] = l;
+                    for (size_t j = k + 1; j < col1; ++j)
+                        rowI[j] -= l * rowK[j];
+                }
+            }
+        }
+
+        /**
+         * @brief 原地分块 LU 分解 P * A = L * U
+         * @param n 矩阵阶数
+         * @param A 行主序矩阵，分解后保存 L\U
+         * @param ld 行跨度
+         * @param pivots 长度为 n 的行交换下标数组
+         * @param swapCount 累加实际发生的行交换次数
+         */
+        template <typename E, typename Pivots>
+        void luFactorBlocked(size_t n, E *A, size_t ld, Pivots &pivots, int &swapCount)
+        {
+            typedef std::integral_constant<bool, std::is_floating_point<E>::value> UseGemm;
+            for (size_t j0 = 0; j0 < n; j0 += LUBlockSize)
+            {
+                const size_t j1 = std::min(n, j0 + LUBlockSize);
+                luPanel(n, A, ld, j0, j1, pivots, swapCount);
+                if (j1 == n)
+                    break;
+
+                // U12 = L11^-1 * A12（L11 为单位下三角）
+                for (size_t i = j0 + 1; i < j1; ++i)
+                {
+                    E *rowI = A + i * ld;
+                    for (size_t p = j0; p < i; ++p)
+                    {
+                        const E lip = rowI[p];
+                        const E *rowP = A + p * ld;
+                        for (size_t j = j1; j < n; ++j)
+                            rowI[j] -= lip * rowP[j];
+                    }
+                }
+
+                // A22 -= L21 * U12
+                luTrailingUpdate(n - j1, n - j1, j1 - j0, A + j1 * ld + j0, ld, A + j0 * ld + j1, ld, A + j1 * ld + j1, ld, UseGemm());
+            }
+        }
+
+        /**
+         * @brief 前向替换 L * Y = B（L 为单位下三角，只读取严格下三角部分），结果覆盖 B
+         * @details B 为 n×nrhs 行主序（行跨度 ldb）。每个 NB 行的块先在块内逐行做整行 axpy，
+         *          再把该块对下方所有行的贡献 B[j1:n] -= L[j1:n, j0:j1] * B[j0:j1] 一次完成。
+         */
+        template <typename E>
+        void luForwardSubstitute(size_t n, const E *L, size_t ld, E *B, size_t nrhs, size_t ldb)
+        {
+            for (size_t j0 = 0; j0 < n; j0 += LUBlockSize)
+            {
+                const size_t j1 = std::min(n, j0 + LUBlockSize);
+                for (size_t i = j0 + 1; i < j1; ++i)
+                {
+                    E *rowI = B + i * ldb;
+                    for (size_t p = j0; p < i; ++p)
+                    {
+                        const E lip = L[i * ld + p];
+                        const E *rowP = B + p * ldb;
+                        for (size_t j = 0; j < nrhs; ++j)
+                            rowI[j] -= lip * rowP[j];
+                    }
+                }
+                if (j1 < n)
+                    luSolveUpdate(n - j1, nrhs, j1 - j0, L + j1 * ld + j0, ld, B + j0 * ldb, ldb, B + j1 * ldb, ldb);
+            }
+        }
+
+        /**
+         * @brief 后向替换 U * X = Y（U 为上三角），结果覆盖 B
+         * @details 与前向替换对称：从最后一个块开始，块内求解后用 B[0:j0] -= U[0:j0, j0:j1] * B[j0:j1] 更新上方所有行。
+         */
+        template <typename E>
+        void luBackSubstitute(size_t n, const E *U, size_t ld, E *B, size_t nrhs, size_t ldb)
+        {
+            for (size_t j1 = n; j1 > 0;)
+            {
+                const size_t j0 = j1 > LUBlockSize ? j1 - LUBlockSize : 0;
+                for (size_t i = j1; i-- > j0;)
+                {
+                    E *rowI = B + i * ldb;
+                    for (size_t p = i + 1; p < j1; ++p)
+                    {
+                        const E uip = U[i * ld + p];
+                        const E *rowP = B + p * ldb;
+                        for (size_t j = 0; j < nrhs; ++j)
+                            rowI[j] -= uip * rowP[j];
+                    }
+                    const E pivot = U[i * ld + i];
+                    for (size_t j = 0; j < nrhs; ++j)
+                        rowI[j] = rowI[j] / pivot;
+                }
+                if (j0 > 0)
+                    luSolveUpdate(j0, nrhs, j1 - j0, U + j0, ld, B + j0 * ldb, ldb, B, ldb);
+                j1 = j0;
+            }
+        }
+
+        /**
+         * @brief 用 L\U 与行交换下标原地求解 A * X = B，B 为 n×nrhs 行主序（行跨度 ldb）
+         */
+        template <typename E, typename Pivots>
+        void luSolveRows(size_t n, const E *LU, size_t ld, const Pivots &pivots, E *B, size_t nrhs, size_t ldb)
+        {
+            for (size_t k = 0; k < n; ++k)
+                if (pivots[k] != k)
+                    std::swap_ranges(B + k * ldb, B + k * ldb + nrhs, B + pivots[k] * ldb);
+            luForwardSubstitute(n, LU, ld, B, nrhs, ldb);
+            luBackSubstitute(n, LU, ld, B, nrhs, ldb);
+        }
+
+        /**
+         * @brief LU 内核使用的元素类型：double/float 封装的 Real 直接按底层浮点数处理，其余保持原类型
+         */
+        template <typename T, bool = RawScalar<T>::value>
+        struct LUElement
+        {
+            typedef T type;
+            static T *cast(T *p) { return p; }
+            static const T *cast(const T *p) { return p; }
+        };
+
+        template <typename T>
+        struct LUElement<T, true>
+        {
+            typedef typename RawScalar<T>::type type;
+            static type *cast(T *p) { return reinterpret_cast<type *>(p); }
+            static const type *cast(const T *p) { return reinterpret_cast<const type *>(p); }
+        };
+
+        /**
+         * @brief 用紧凑 LU 分解（LinAlg::LUFactorization）原地求解 A * X = B，B 为 n×nrhs 行主序、行跨度为 ldb
+         */
+        template <typename Factorization, typename T>
+        void luSolveInPlace(const Factorization &lu, T *B, size_t nrhs, size_t ldb)
+        {
+            typedef LUElement<T> Elem;
+            luSolveRows(lu.size(), Elem::cast(lu.LU.data()), lu.size(), lu.pivots, Elem::cast(B), nrhs, ldb);
+        }
+    }
+}
@@ -1,9 +1,46 @@
 #pragma once
+#include <cmath>
+#include <limits>
 #include "AlgebraTool.hpp"
 #include "MatrixNM.hpp"
 #include "VectorN.hpp"
+#include "LUKernel.hpp"
+#include "SymmetricKernel.hpp"
+#include "QRKernel.hpp"
+#include "EigenKernel.hpp"
+#include "SVDKernel.hpp"
 namespace OxygenMath
 {
+    namespace internal
+    {
+        /**
+         * @brief 构造长度为 n 的向量：定长向量忽略 n，动态向量按 n 分配
+         */
+        template <typename T, size_t N>
+        struct SizedVector
+        {
+            static VectorN<T, N> make(size_t) { return VectorN<T, N>(); }
+        };
+
+        template <typename T>
+        struct SizedVector<T, Dynamic>
+        {
+            static VectorN<T, Dynamic> make(size_t n) { return VectorN<T, Dynamic>(n); }
+        };
+
+        /**
+         * @brief 实数类型对应的复数类型：BasicReal<F, P> 对应 BasicComplex<F, P>
+         */
+        template <typename T>
+        struct ComplexScalar;
+
+        template <typename F, typename P>
+        struct ComplexScalar<BasicReal<F, P>>
+        {
+            typedef BasicComplex<F, P> type;
+        };
+    }
+
     namespace LinAlg
     {
         template <typename T, size_t N>
@@ -15,12 +52,14 @@ namespace OxygenMath
             int swapCount;
             bool isSingular;
 
-            LUPResult() : swapCount(0), isSingular(false)
+            LUPResult() : LUPResult(N == Dynamic ? 0 : N) {}
+
+            explicit LUPResult(size_t n) : L(n, n), U(n, n), P(n, n), swapCount(0), isSingular(false)
             {
                 // 初始化L为单位矩阵，U和P为零矩阵
-                for (size_t i = 0; i < N; ++i)
+                for (size_t i = 0; i < n; ++i)
                 {
-                    for (size_t j = 0; j < N; ++j)
+                    for (size_t j = 0; j < n; ++j)
                     {
                         L(i, j) = (i == j) ? 1 : 0;
                         U(i, j) = 0;
@@ -29,11 +68,77 @@ namespace OxygenMath
                 }
             }
         };
+        /**
+         * @brief 紧凑形式的 LU 分解结果：P * A = L * U
+         * @details L（单位下三角，对角线不存储）与 U 共用一个 n×n 矩阵，
+         *          置换记录为行交换下标：第 k 步把第 k 行与第 pivots[k] 行交换。
+         *          定长矩阵的下标数组为 std::array，整个分解不分配堆内存。
+         */
+        template <typename T, size_t N>
+        struct LUFactorization
+        {
+            MatrixNM<T, N, N> LU;
+            typename internal::PivotArray<N>::type pivots;
+            int swapCount;
+            bool isSingular;
+
+            size_t size() const { return LU.rows(); }
+        };
+
+        /**
+         * @brief 原地 LU 分解（分块、部分主元），A 被覆盖为 L\U
+         *
+         * @param A 待分解的方阵，返回时保存 L 的严格下三角与 U 的上三角
+         * @param pivots 行交换下标，长度为 n
+         * @param swapCount 返回实际发生的行交换次数
+         * @return bool 是否存在 |U(i, i)| <= epsilon（矩阵奇异）
+         */
+        template <typename T, size_t N>
+        bool luFactorInPlace(MatrixNM<T, N, N> &A, typename internal::PivotArray<N>::type &pivots, int &swapCount)
+        {
+            if (A.rows() != A.cols())
+                throw std::invalid_argument("LU decomposition requires a square matrix");
+            const size_t n = A.rows();
+            if (pivots.size() != n)
+                throw std::invalid_argument("Pivot array size does not match the matrix dimension");
+            swapCount = 0;
+            internal::luFactorBlocked(n, internal::LUElement<T>::cast(A.data()), n, pivots, swapCount);
+
+            for (size_t i = 0; i < n; ++i)
+                if (abs(A(i, i)) <= Constants::epsilon)
+                    return true;
+            return false;
+        }
+
+        /**
+         * @brief 对方阵做紧凑形式的 LU 分解（带部分主元）
+         *
+         * 按值接收 A，调用方传入右值时不产生拷贝；分解在该矩阵上原地完成。
+         *
+         * @param A 输入的 N×N 方阵
+         * @return LUFactorization<T, N> L\U、行交换下标、交换次数及是否奇异
+         */
+        template <typename T, size_t N>
+        LUFactorization<T, N> luFactor(MatrixNM<T, N, N> A)
+        {
+            const size_t n = A.rows();
+            LUFactorization<T, N> result{std::move(A), internal::PivotArray<N>::make(n), 0, false};
+            result.isSingular = luFactorInPlace(result.LU, result.pivots, result.swapCount);
+            return result;
+        }
+
         /**
          * @brief 对给定的方阵进行LU分解（带部分主元的LUP分解）
          *
          * 该函数使用部分主元法对输入矩阵A进行LU分解，得到一个下三角矩阵L、
          * 上三角矩阵U以及行交换信息P，满足 PA = LU。
+         * 分解本身由 luFactor 完成，这里只把紧凑结果展开为三个矩阵；
+         * 只需要求解、求逆或行列式时应直接使用 luFactor。
+         *
+         * 奇异矩阵：分解总是进行到最后一列（主元为 0 的列跳过消元），返回的 L、U、P 仍满足 PA = LU，
+         * swapCount 为全部行交换次数，isSingular 表示存在 |U(i, i)| <= epsilon。
+         * 早期版本在遇到第一个过小的主元时立即返回，L、U、P 只填充到该列为止；
+         * 两种情况下 solve/inverse 都会因 isSingular 抛出异常，determinant 返回 0。
          *
          * @tparam T 矩阵元素的数据类型
          * @tparam N 矩阵的维度大小
@@ -43,50 +148,25 @@ namespace OxygenMath
         template <typename T, size_t N>
         LUPResult<T, N> luDecomposition(const MatrixNM<T, N, N> &A)
         {
-            LUPResult<T, N> result;
-            MatrixNM<T, N, N> A_copy = A;
-
-            for (size_t k = 0; k < N; ++k)
-            {
-                // 1. 寻找主元
-                size_t maxRow = k;
-                for (size_t i = k + 1; i < N; ++i)
-                {
-                    if (abs(A_copy(i, k)) > abs(A_copy(maxRow, k)))
-                        maxRow = i;
-                }
-                if (abs(A_copy(maxRow, k)) <= Constants::epsilon)
-                {
-                    result.isSingular = true;
-                    return result;
-                }
+            const LUFactorization<T, N> lu = luFactor(A);
+            const size_t n = lu.size();
+            LUPResult<T, N> result(n);
+            result.swapCount = lu.swapCount;
+            result.isSingular = lu.isSingular;
 
-                // 2. 交换行（A、P、L的已知部分）
-                if (maxRow != k)
-                {
-                    for (size_t j = 0; j < N; ++j)
-                    {
-                        swap(A_copy(k, j), A_copy(maxRow, j));
-                        swap(result.P(k, j), result.P(maxRow, j));
-                        if (j < k)
-                            swap(result.L(k, j), result.L(maxRow, j)); // 只交换已知部分
-                    }
-                    result.swapCount++;
-                }
+            for (size_t k = 0; k < n; ++k)
+                if (lu.pivots[k] != k)
+                    for (size_t j = 0; j < n; ++j)
+                        swap(result.P(k, j), result.P(lu.pivots[k], j));
 
-                // 3. U的第k行
-                for (size_t j = k; j < N; ++j)
-                    result.U(k, j) = A_copy(k, j);
-
-                // 4. L的第k列
-                result.L(k, k) = 1; // 对角线始终为1
-                for (size_t i = k + 1; i < N; ++i)
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
                 {
-                    result.L(i, k) = A_copy(i, k) / result.U(k, k);
-                    for (size_t j = k; j < N; ++j)
-                        A_copy(i, j) -= result.L(i, k) * result.U(k, j);
+                    if (j < i)
+                        result.L(i, j) = lu.LU(i, j);
+                    else
+                        result.U(i, j) = lu.LU(i, j);
                 }
-            }
             return result;
         }
 
@@ -99,21 +179,25 @@ namespace OxygenMath
         template <typename T, size_t N>
         T determinant(const MatrixNM<T, N, N> &A_input)
         {
-            MatrixNM<T, N, N> A = A_input;
-            auto lup = luDecomposition(A);
+            return determinant(luFactor(A_input));
+        }
 
-            if (lup.isSingular)
-            {
+        /**
+         * @brief 由紧凑 LU 分解计算行列式
+         * @param lu luFactor 的结果
+         * @return 矩阵的行列式值，若矩阵奇异则返回0
+         */
+        template <typename T, size_t N>
+        T determinant(const LUFactorization<T, N> &lu)
+        {
+            if (lu.isSingular)
                 return 0;
-            }
 
             T detU = 1;
-            for (size_t i = 0; i < N; ++i)
-            {
-                detU *= lup.U(i, i);
-            }
+            for (size_t i = 0; i < lu.size(); ++i)
+                detU *= lu.LU(i, i);
 
-            T sign = (lup.swapCount % 2 == 0) ? 1 : -1;
+            T sign = (lu.swapCount % 2 == 0) ? 1 : -1;
             return sign * detU;
         }
 
@@ -125,19 +209,18 @@ namespace OxygenMath
         template <typename T, size_t N>
         T determinant(const LUPResult<T, N> &result)
         {
-            auto lup = result;
-            if (lup.isSingular)
+            if (result.isSingular)
             {
                 return 0;
             }
 
             T detU = 1;
-            for (size_t i = 0; i < N; ++i)
+            for (size_t i = 0; i < result.U.rows(); ++i)
             {
-                detU *= lup.U(i, i);
+                detU *= result.U(i, i);
             }
 
-            T sign = (lup.swapCount % 2 == 0) ? 1 : -1;
+            T sign = (result.swapCount % 2 == 0) ? 1 : -1;
             return sign * detU;
         }
 
@@ -186,8 +269,8 @@ namespace OxygenMath
         /**
          * @brief 计算方阵 A 的逆矩阵
          *
-         * 使用 LU 分解方法计算给定方阵的逆矩阵。该方法通过求解一系列线性方程组 Ax = e_i，
-         * 其中 e_i 是单位向量，来逐列构造逆矩阵。
+         * 使用紧凑 LU 分解计算给定方阵的逆矩阵：以单位矩阵为右端项，
+         * 一次对全部 n 列做前向/后向替换，得到 A^-1。
          *
          * @param A 输入的 N×N 方阵
          * @return 返回 A 的逆矩阵
@@ -196,57 +279,37 @@ namespace OxygenMath
         template <typename T, size_t N>
         MatrixNM<T, N, N> inverse(const MatrixNM<T, N, N> &A)
         {
-            auto lup = luDecomposition(A);
-            if (lup.isSingular)
-                throw std::runtime_error("Matrix is singular.");
-
-            MatrixNM<T, N, N> inv;
-
-            for (size_t col = 0; col < N; ++col)
-            {
-                // 单位向量 e
-                MatrixNM<T, N, 1> e;
-                for (size_t i = 0; i < N; ++i)
-                    e(i, 0) = (i == col) ? T::identity() : T::zero();
-
-                // 右端项 b = P * e
-                MatrixNM<T, N, 1> b;
-                b = lup.P * e;
-
-                // 解 L*y = b（前向替换）
-                MatrixNM<T, N, 1> y;
-                for (size_t i = 0; i < N; ++i)
-                {
-                    T sum = b(i, 0);
-                    for (size_t j = 0; j < i; ++j)
-                        sum -= lup.L(i, j) * y(j, 0);
-                    y(i, 0) = sum / lup.L(i, i);
-                }
+            return inverse(luFactor(A));
+        }
 
-                // 解 U*x = y（后向替换）
-                MatrixNM<T, N, 1> x;
-                for (int i = N - 1; i >= 0; --i)
-                {
-                    T sum = y(i, 0);
-                    for (size_t j = i + 1; j < N; ++j)
-                        sum -= lup.U(i, j) * x(j, 0);
-                    x(i, 0) = sum / lup.U(i, i);
-                }
+        /**
+         * @brief 由紧凑 LU 分解计算逆矩阵
+         *
+         * @param lu luFactor 的结果
+         * @return MatrixNM<T, N, N> 原矩阵的逆矩阵
+         * @throws std::runtime_error 如果矩阵奇异（不可逆）
+         */
+        template <typename T, size_t N>
+        MatrixNM<T, N, N> inverse(const LUFactorization<T, N> &lu)
+        {
+            if (lu.isSingular)
+                throw std::runtime_error("Matrix is singular.");
 
-                for (size_t row = 0; row < N; ++row)
-                    inv(row, col) = x(row, 0);
-            }
+            const size_t n = lu.size();
+            MatrixNM<T, N, N> inv(n, n);
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    inv(i, j) = (i == j) ? T::identity() : T::zero();
+            solveInPlace(lu, inv);
             return inv;
         }
 
         /**
          * @brief 计算矩阵的逆矩阵
          *
-         * 该函数通过 LUP 分解结果求解原矩阵的逆。具体方法是：
-         * 对于单位矩阵的每一列 e_i，求解线性方程 A * x = P * e_i，
-         * 其中 A = L * U（LUP 分解结果），P 是置换矩阵。
-         * 通过前向替换解 L * y = P * e_i，再通过后向替换解 U * x = y，
-         * 得到的 x 即为逆矩阵的第 i 列。
+         * 该函数通过 LUP 分解结果求解原矩阵的逆：以 P 为右端项（即 P * I），
+         * 对全部列依次做前向替换 L * Y = P 与后向替换 U * X = Y，得到的 X 即为 A^-1。
+         * 分解结果按引用读取，不做拷贝。
          *
          * @param A LUP 分解结果，包含 L、U 矩阵和置换矩阵 P
          * @return MatrixNM<T, N, N> 原矩阵的逆矩阵
@@ -255,47 +318,843 @@ namespace OxygenMath
         template <typename T, size_t N>
         MatrixNM<T, N, N> inverse(const LUPResult<T, N> &A)
         {
-            auto lup = A;
+            if (A.isSingular)
+                throw std::runtime_error("Matrix is singular.");
+
+            typedef internal::LUElement<T> Elem;
+            const size_t n = A.U.rows();
+            MatrixNM<T, N, N> inv = A.P;
+            internal::luForwardSubstitute(n, Elem::cast(A.L.data()), n, Elem::cast(inv.data()), n, n);
+            internal::luBackSubstitute(n, Elem::cast(A.U.data()), n, Elem::cast(inv.data()), n, n);
+            return inv;
+        }
+
+        /**
+         * @brief 利用 LUP 分解结果求解线性方程组 A * x = b
+         *
+         * 先计算 P * b，再依次做前向替换 L * y = P * b 与后向替换 U * x = y，
+         * 不拷贝分解结果。
+         *
+         * @param lup A 的 LUP 分解结果
+         * @param b 右端向量
+         * @return VectorN<T, N> 方程组的解
+         * @throws std::runtime_error 如果矩阵奇异
+         */
+        template <typename T, size_t N>
+        VectorN<T, N> solve(const LUPResult<T, N> &lup, const VectorN<T, N> &b)
+        {
             if (lup.isSingular)
                 throw std::runtime_error("Matrix is singular.");
+            const size_t n = lup.U.rows();
+            if (b.rows() * b.cols() != n)
+                throw std::invalid_argument("Right-hand side size does not match the matrix dimension");
 
-            MatrixNM<T, N, N> inv;
+            VectorN<T, N> x(lup.P * b);
+            for (size_t i = 0; i < n; ++i)
+            {
+                T sum = x[i];
+                for (size_t j = 0; j < i; ++j)
+                    sum -= lup.L(i, j) * x[j];
+                x[i] = sum;
+            }
+            for (size_t i = n; i-- > 0;)
+            {
+                T sum = x[i];
+                for (size_t j = i + 1; j < n; ++j)
+                    sum -= lup.U(i, j) * x[j];
+                x[i] = sum / lup.U(i, i);
+            }
+            return x;
+        }
+
+        /**
+         * @brief 利用紧凑 LU 分解原地求解 A * X = B，B 的每一列是一个右端项
+         *
+         * 先按行交换下标置换 B 的行，再做分块前向替换（单位下三角 L）与分块后向替换（U）；
+         * 右端项较多时块外部分的更新走 GEMM。不形成逆矩阵，也不拷贝分解结果。
+         *
+         * @param lu luFactor 的结果
+         * @param B 右端项矩阵（n×m），返回时被解覆盖
+         * @throws std::runtime_error 如果矩阵奇异
+         */
+        template <typename T, size_t N, size_t M>
+        void solveInPlace(const LUFactorization<T, N> &lu, MatrixNM<T, N, M> &B)
+        {
+            if (lu.isSingular)
+                throw std::runtime_error("Matrix is singular.");
+            if (B.rows() != lu.size())
+                throw std::invalid_argument("Right-hand side size does not match the matrix dimension");
+            internal::luSolveInPlace(lu, B.data(), B.cols(), B.cols());
+        }
+
+        /**
+         * @brief 利用紧凑 LU 分解原地求解 A * x = b
+         *
+         * @param lu luFactor 的结果
+         * @param b 右端向量，返回时被解覆盖
+         * @throws std::runtime_error 如果矩阵奇异
+         */
+        template <typename T, size_t N>
+        void solveInPlace(const LUFactorization<T, N> &lu, VectorN<T, N> &b)
+        {
+            if (lu.isSingular)
+                throw std::runtime_error("Matrix is singular.");
+            if (b.rows() * b.cols() != lu.size())
+                throw std::invalid_argument("Right-hand side size does not match the matrix dimension");
+            internal::luSolveInPlace(lu, b.data(), 1, 1);
+        }
+
+        /**
+         * @brief 利用紧凑 LU 分解求解 A * X = B（多个右端项）
+         *
+         * B 按值传入，传右值时不产生拷贝，解写回该矩阵后返回。
+         *
+         * @param lu luFactor 的结果
+         * @param B 右端项矩阵（n×m）
+         * @return MatrixNM<T, N, M> 方程组的解
+         * @throws std::runtime_error 如果矩阵奇异
+         */
+        template <typename T, size_t N, size_t M>
+        MatrixNM<T, N, M> solve(const LUFactorization<T, N> &lu, MatrixNM<T, N, M> B)
+        {
+            solveInPlace(lu, B);
+            return B;
+        }
+
+        /**
+         * @brief 利用紧凑 LU 分解求解 A * x = b
+         *
+         * @param lu luFactor 的结果
+         * @param b 右端向量
+         * @return VectorN<T, N> 方程组的解
+         * @throws std::runtime_error 如果矩阵奇异
+         */
+        template <typename T, size_t N>
+        VectorN<T, N> solve(const LUFactorization<T, N> &lu, VectorN<T, N> b)
+        {
+            solveInPlace(lu, b);
+            return b;
+        }
+
+        /**
+         * @brief Cholesky 分解结果：A = L * L^T
+         * @details L 为下三角矩阵（严格上三角为 0）。A 不是正定矩阵时 isPositiveDefinite 为 false，L 不可用。
+         */
+        template <typename T, size_t N>
+        struct CholeskyFactorization
+        {
+            MatrixNM<T, N, N> L;
+            bool isPositiveDefinite;
+
+            size_t size() const { return L.rows(); }
+        };
 
-            for (size_t col = 0; col < N; ++col)
+        /**
+         * @brief 对称正定矩阵的分块 Cholesky 分解
+         *
+         * 只读取 A 的下三角（含对角线），浮点运算量约为 LU 的一半，且无需选主元。
+         * 按值接收 A，传右值时分解在该矩阵上原地完成。
+         *
+         * @param A 输入的 N×N 对称正定矩阵
+         * @return CholeskyFactorization<T, N> 下三角因子 L 以及是否正定
+         */
+        template <typename T, size_t N>
+        CholeskyFactorization<T, N> cholesky(MatrixNM<T, N, N> A)
+        {
+            if (A.rows() != A.cols())
+                throw std::invalid_argument("Cholesky decomposition requires a square matrix");
+            const size_t n = A.rows();
+            CholeskyFactorization<T, N> result{std::move(A), false};
+            result.isPositiveDefinite = internal::choleskyBlocked(n, internal::LUElement<T>::cast(result.L.data()), n) == n;
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = i + 1; j < n; ++j)
+                    result.L(i, j) = T::zero();
+            return result;
+        }
+
+        /**
+         * @brief 利用 Cholesky 分解原地求解 A * X = B（依次求解 L * Y = B 与 L^T * X = Y）
+         *
+         * @param chol cholesky 的结果
+         * @param B 右端项矩阵（n×m），返回时被解覆盖
+         * @throws std::runtime_error 如果矩阵不是正定的
+         */
+        template <typename T, size_t N, size_t M>
+        void solveInPlace(const CholeskyFactorization<T, N> &chol, MatrixNM<T, N, M> &B)
+        {
+            if (!chol.isPositiveDefinite)
+                throw std::runtime_error("Matrix is not positive definite.");
+            if (B.rows() != chol.size())
+                throw std::invalid_argument("Right-hand side size does not match the matrix dimension");
+            internal::choleskySolveInPlace(chol, B.data(), B.cols(), B.cols());
+        }
+
+        template <typename T, size_t N>
+        void solveInPlace(const CholeskyFactorization<T, N> &chol, VectorN<T, N> &b)
+        {
+            if (!chol.isPositiveDefinite)
+                throw std::runtime_error("Matrix is not positive definite.");
+            if (b.rows() * b.cols() != chol.size())
+                throw std::invalid_argument("Right-hand side size does not match the matrix dimension");
+            internal::choleskySolveInPlace(chol, b.data(), 1, 1);
+        }
+
+        /**
+         * @brief 利用 Cholesky 分解求解 A * X = B
+         */
+        template <typename T, size_t N, size_t M>
+        MatrixNM<T, N, M> solve(const CholeskyFactorization<T, N> &chol, MatrixNM<T, N, M> B)
+        {
+            solveInPlace(chol, B);
+            return B;
+        }
+
+        /**
+         * @brief 利用 Cholesky 分解求解 A * x = b
+         */
+        template <typename T, size_t N>
+        VectorN<T, N> solve(const CholeskyFactorization<T, N> &chol, VectorN<T, N> b)
+        {
+            solveInPlace(chol, b);
+            return b;
+        }
+
+        /**
+         * @brief 由 Cholesky 分解计算 ln(det(A)) = 2 * Σ ln(L(i, i))
+         *
+         * 直接求行列式在阶数较大时容易上溢或下溢，对数形式不会。
+         *
+         * @throws std::runtime_error 如果矩阵不是正定的
+         */
+        template <typename T, size_t N>
+        T logDeterminant(const CholeskyFactorization<T, N> &chol)
+        {
+            if (!chol.isPositiveDefinite)
+                throw std::runtime_error("Matrix is not positive definite.");
+            T sum = T::zero();
+            for (size_t i = 0; i < chol.size(); ++i)
+                sum += log(chol.L(i, i));
+            return sum + sum;
+        }
+
+        /**
+         * @brief 带 Bunch-Kaufman 主元的 LDL^T 分解结果：P^T * A * P = L * D * L^T
+         * @details LD 的对角线保存 D 的对角元，严格下三角保存单位下三角 L；
+         *          D 含 2x2 块时（blocks[k] == 2），块的非对角元 D(k + 1, k) 存放在 LD(k + 1, k)，此处 L 的元素为 0。
+         *          第 k 步把第 k 行/列与第 pivots[k] 行/列对称交换。
+         */
+        template <typename T, size_t N>
+        struct LDLTFactorization
+        {
+            MatrixNM<T, N, N> LD;
+            typename internal::PivotArray<N>::type pivots;
+            typename internal::PivotArray<N>::type blocks;
+            bool isSingular;
+
+            size_t size() const { return LD.rows(); }
+        };
+
+        /**
+         * @brief 对称（可以不定）矩阵的 LDL^T 分解，使用 Bunch-Kaufman 部分主元
+         *
+         * 只读取 A 的下三角（含对角线）。与 LU 相比浮点运算量减半，且保持对称性；
+         * 1x1 与 2x2 主元块保证了不定矩阵上的数值稳定性。
+         *
+         * @param A 输入的 N×N 对称矩阵
+         * @return LDLTFactorization<T, N> 分解结果；某个主元块的行列式不超过 epsilon 时 isSingular 为 true
+         */
+        template <typename T, size_t N>
+        LDLTFactorization<T, N> ldlt(MatrixNM<T, N, N> A)
+        {
+            if (A.rows() != A.cols())
+                throw std::invalid_argument("LDLT decomposition requires a square matrix");
+            const size_t n = A.rows();
+            LDLTFactorization<T, N> result{std::move(A), internal::PivotArray<N>::make(n), internal::PivotArray<N>::make(n), false};
+            internal::ldltFactor(n, internal::LUElement<T>::cast(result.LD.data()), n, result.pivots, result.blocks);
+
+            const auto &D = result.LD;
+            for (size_t k = 0; k < n; k += result.blocks[k])
             {
-                // 单位向量 e
-                MatrixNM<T, N, 1> e;
-                for (size_t i = 0; i < N; ++i)
-                    e(i, 0) = (i == col) ? T::identity() : T::zero();
-
-                // 右端项 b = P * e
-                MatrixNM<T, N, 1> b;
-                b = lup.P * e;
-
-                // 解 L*y = b（前向替换）
-                MatrixNM<T, N, 1> y;
-                for (size_t i = 0; i < N; ++i)
+                const T det = result.blocks[k] == 1 ? D(k, k) : D(k, k) * D(k + 1, k + 1) - D(k + 1, k) * D(k + 1, k);
+                if (abs(det) <= Constants::epsilon)
+                    result.isSingular = true;
+            }
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = i + 1; j < n; ++j)
+                    result.LD(i, j) = T::zero();
+            return result;
+        }
+
+        /**
+         * @brief 利用 LDL^T 分解原地求解 A * X = B
+         *
+         * @param f ldlt 的结果
+         * @param B 右端项矩阵（n×m），返回时被解覆盖
+         * @throws std::runtime_error 如果矩阵奇异
+         */
+        template <typename T, size_t N, size_t M>
+        void solveInPlace(const LDLTFactorization<T, N> &f, MatrixNM<T, N, M> &B)
+        {
+            if (f.isSingular)
+                throw std::runtime_error("Matrix is singular.");
+            if (B.rows() != f.size())
+                throw std::invalid_argument("Right-hand side size does not match the matrix dimension");
+            internal::ldltSolveInPlace(f, B.data(), B.cols(), B.cols());
+        }
+
+        template <typename T, size_t N>
+        void solveInPlace(const LDLTFactorization<T, N> &f, VectorN<T, N> &b)
+        {
+            if (f.isSingular)
+                throw std::runtime_error("Matrix is singular.");
+            if (b.rows() * b.cols() != f.size())
+                throw std::invalid_argument("Right-hand side size does not match the matrix dimension");
+            internal::ldltSolveInPlace(f, b.data(), 1, 1);
+        }
+
+        /**
+         * @brief 利用 LDL^T 分解求解 A * X = B
+         */
+        template <typename T, size_t N, size_t M>
+        MatrixNM<T, N, M> solve(const LDLTFactorization<T, N> &f, MatrixNM<T, N, M> B)
+        {
+            solveInPlace(f, B);
+            return B;
+        }
+
+        /**
+         * @brief 利用 LDL^T 分解求解 A * x = b
+         */
+        template <typename T, size_t N>
+        VectorN<T, N> solve(const LDLTFactorization<T, N> &f, VectorN<T, N> b)
+        {
+            solveInPlace(f, b);
+            return b;
+        }
+
+        /**
+         * @brief 由 LDL^T 分解计算 ln|det(A)|，并给出行列式的符号
+         *
+         * det(A) = det(D)，为各 1x1、2x2 主元块行列式之积。
+         *
+         * @param f ldlt 的结果
+         * @param sign 返回行列式的符号（1 或 -1）；矩阵奇异时为 0，返回值为 -inf
+         * @return T ln|det(A)|
+         */
+        template <typename T, size_t N>
+        T logDeterminant(const LDLTFactorization<T, N> &f, int &sign)
+        {
+            const auto &D = f.LD;
+            T sum = T::zero();
+            sign = 1;
+            for (size_t k = 0; k < f.size(); k += f.blocks[k])
+            {
+                const T det = f.blocks[k] == 1 ? D(k, k) : D(k, k) * D(k + 1, k + 1) - D(k + 1, k) * D(k + 1, k);
+                if (det == T::zero())
                 {
-                    T sum = b(i, 0);
-                    for (size_t j = 0; j < i; ++j)
-                        sum -= lup.L(i, j) * y(j, 0);
-                    y(i, 0) = sum / lup.L(i, i);
+                    sign = 0;
+                    return T(-std::numeric_limits<double>::infinity());
                 }
+                if (det < T::zero())
+                    sign = -sign;
+                sum += log(abs(det));
+            }
+            return sum;
+        }
+
+        /**
+         * @brief 由 LDL^T 分解计算 ln|det(A)|
+         */
+        template <typename T, size_t N>
+        T logDeterminant(const LDLTFactorization<T, N> &f)
+        {
+            int sign;
+            return logDeterminant(f, sign);
+        }
+
+        /**
+         * @brief Householder QR 分解结果：A = Q * R，Q 不显式保存
+         * @details QR 的上三角（含对角线）为 R，对角线以下第 k 列保存第 k 个反射向量（首分量 1 不存储）；
+         *          tau 为 min(M, N) 个反射系数。Q = H_1 * H_2 * ... * H_k，用 applyQ / applyQTranspose 作用到其他矩阵。
+         */
+        template <typename T, size_t M, size_t N>
+        struct QRFactorization
+        {
+            MatrixNM<T, M, N> QR;
+            typename internal::CoefficientArray<T, internal::MinDimension<M, N>::value>::type tau;
+
+            size_t rows() const { return QR.rows(); }
+            size_t cols() const { return QR.cols(); }
+        };
+
+        /**
+         * @brief 分块 Householder QR 分解（紧凑 WY 表示）
+         *
+         * 适用于任意 M×N 矩阵。每 64 列为一个面板，尾部更新由 GEMM 完成；不超过 64 列的定长矩阵不分配堆内存。
+         * 按值接收 A，传右值时分解在该矩阵上原地完成。
+         *
+         * @param A 输入的 M×N 矩阵
+         * @return QRFactorization<T, M, N> 分解结果
+         */
+        template <typename T, size_t M, size_t N>
+        QRFactorization<T, M, N> qr(MatrixNM<T, M, N> A)
+        {
+            const size_t m = A.rows(), n = A.cols();
+            typedef internal::CoefficientArray<T, internal::MinDimension<M, N>::value> TauArray;
+            QRFactorization<T, M, N> result{std::move(A), TauArray::make(std::min(m, n))};
+            typedef internal::LUElement<T> Elem;
+            internal::qrFactor(m, n, Elem::cast(result.QR.data()), n, Elem::cast(result.tau.data()));
+            return result;
+        }
+
+        /**
+         * @brief 原地计算 B = Q * B（B 为 m×k 矩阵），不形成 Q
+         */
+        template <typename T, size_t M, size_t N, size_t K>
+        void applyQ(const QRFactorization<T, M, N> &f, MatrixNM<T, M, K> &B)
+        {
+            if (B.rows() != f.rows())
+                throw std::invalid_argument("Matrix dimensions do not match for applying Q");
+            typedef internal::LUElement<T> Elem;
+            internal::qrApplyQ(f.rows(), std::min(f.rows(), f.cols()), Elem::cast(f.QR.data()), f.cols(),
+                               Elem::cast(f.tau.data()), Elem::cast(B.data()), B.cols(), B.cols(), false);
+        }
+
+        template <typename T, size_t M, size_t N>
+        void applyQ(const QRFactorization<T, M, N> &f, VectorN<T, M> &b)
+        {
+            if (b.rows() * b.cols() != f.rows())
+                throw std::invalid_argument("Matrix dimensions do not match for applying Q");
+            typedef internal::LUElement<T> Elem;
+            internal::qrApplyQ(f.rows(), std::min(f.rows(), f.cols()), Elem::cast(f.QR.data()), f.cols(),
+                               Elem::cast(f.tau.data()), Elem::cast(b.data()), 1, 1, false);
+        }
+
+        /**
+         * @brief 原地计算 B = Q^T * B（B 为 m×k 矩阵），不形成 Q
+         */
+        template <typename T, size_t M, size_t N, size_t K>
+        void applyQTranspose(const QRFactorization<T, M, N> &f, MatrixNM<T, M, K> &B)
+        {
+            if (B.rows() != f.rows())
+                throw std::invalid_argument("Matrix dimensions do not match for applying Q");
+            typedef internal::LUElement<T> Elem;
+            internal::qrApplyQ(f.rows(), std::min(f.rows(), f.cols()), Elem::cast(f.QR.data()), f.cols(),
+                               Elem::cast(f.tau.data()), Elem::cast(B.data()), B.cols(), B.cols(), true);
+        }
+
+        template <typename T, size_t M, size_t N>
+        void applyQTranspose(const QRFactorization<T, M, N> &f, VectorN<T, M> &b)
+        {
+            if (b.rows() * b.cols() != f.rows())
+                throw std::invalid_argument("Matrix dimensions do not match for applying Q");
+            typedef internal::LUElement<T> Elem;
+            internal::qrApplyQ(f.rows(), std::min(f.rows(), f.cols()), Elem::cast(f.QR.data()), f.cols(),
+                               Elem::cast(f.tau.data()), Elem::cast(b.data()), 1, 1, true);
+        }
+
+        /**
+         * @brief 取出 QR 分解的上三角因子 R（N×N，要求 M >= N）
+         */
+        template <typename T, size_t M, size_t N>
+        MatrixNM<T, N, N> qrR(const QRFactorization<T, M, N> &f)
+        {
+            const size_t n = f.cols();
+            if (f.rows() < n)
+                throw std::invalid_argument("R factor requires rows >= cols");
+            MatrixNM<T, N, N> R(n, n);
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    R(i, j) = j < i ? T::zero() : f.QR(i, j);
+            return R;
+        }
+
+        /**
+         * @brief 利用 QR 分解求最小二乘解 min ||A * X - B||（A 为 m×n，m >= n）
+         *
+         * 先在 B 的副本上作用 Q^T，再对前 n 行用 R 做后向替换。
+         *
+         * @param f qr 的结果
+         * @param B 右端项矩阵（m×k）
+         * @return MatrixNM<T, N, K> 最小二乘解（n×k）
+         * @throws std::runtime_error 如果 R 的某个对角元绝对值不超过 epsilon（A 列秩亏）
+         */
+        template <typename T, size_t M, size_t N, size_t K>
+        MatrixNM<T, N, K> leastSquares(const QRFactorization<T, M, N> &f, MatrixNM<T, M, K> B)
+        {
+            const size_t n = f.cols(), k = B.cols();
+            if (f.rows() < n)
+                throw std::invalid_argument("Least squares requires rows >= cols");
+            for (size_t i = 0; i < n; ++i)
+                if (abs(f.QR(i, i)) <= Constants::epsilon)
+                    throw std::runtime_error("Matrix is rank deficient.");
+            applyQTranspose(f, B);
+            typedef internal::LUElement<T> Elem;
+            internal::luBackSubstitute(n, Elem::cast(f.QR.data()), n, Elem::cast(B.data()), k, k);
+            MatrixNM<T, N, K> X(n, k);
+            std::copy(B.data(), B.data() + n * k, X.data());
+            return X;
+        }
+
+        /**
+         * @brief 利用 QR 分解求最小二乘解 min ||A * x - b||（A 为 m×n，m >= n）
+         * @throws std::runtime_error 如果 A 列秩亏
+         */
+        template <typename T, size_t M, size_t N>
+        VectorN<T, N> leastSquares(const QRFactorization<T, M, N> &f, VectorN<T, M> b)
+        {
+            const size_t n = f.cols();
+            if (f.rows() < n)
+                throw std::invalid_argument("Least squares requires rows >= cols");
+            for (size_t i = 0; i < n; ++i)
+                if (abs(f.QR(i, i)) <= Constants::epsilon)
+                    throw std::runtime_error("Matrix is rank deficient.");
+            applyQTranspose(f, b);
+            typedef internal::LUElement<T> Elem;
+            internal::luBackSubstitute(n, Elem::cast(f.QR.data()), n, Elem::cast(b.data()), 1, 1);
+            VectorN<T, N> x = internal::SizedVector<T, N>::make(n);
+            std::copy(b.data(), b.data() + n, x.data());
+            return x;
+        }
+
+        /**
+         * @brief 求超定方程组 A * x = b 的最小二乘解（A 为 m×n，m >= n）
+         */
+        template <typename T, size_t M, size_t N>
+        VectorN<T, N> leastSquares(const MatrixNM<T, M, N> &A, const VectorN<T, M> &b)
+        {
+            return leastSquares(qr(A), b);
+        }
+
+        /**
+         * @brief 实对称矩阵的特征分解结果：A = V * diag(eigenvalues) * V^T
+         * @details eigenvalues 按升序排列，eigenvectors 的第 i 列为对应 eigenvalues(i) 的单位特征向量，各列两两正交。
+         */
+        template <typename T, size_t N>
+        struct SymmetricEigenDecomposition
+        {
+            VectorN<T, N> eigenvalues;
+            MatrixNM<T, N, N> eigenvectors;
+
+            size_t size() const { return eigenvectors.rows(); }
+        };
+
+        /**
+         * @brief 实对称矩阵的特征分解
+         *
+         * 只读取 A 的下三角（含对角线）。阶数不超过 4 的定长矩阵（如 3x3 惯性张量）使用编译期展开的 Jacobi 旋转，
+         * 不分配堆内存；其余矩阵使用分块 Householder 三对角化加隐式 QL 迭代。
+         * 按值接收 A，传右值时特征向量直接写入该矩阵的存储。
+         *
+         * @param A 输入的 N×N 对称矩阵
+         * @return SymmetricEigenDecomposition<T, N> 升序特征值与对应的特征向量
+         * @throws std::runtime_error 如果 QL 迭代不收敛
+         */
+        template <typename T, size_t N>
+        SymmetricEigenDecomposition<T, N> symmetricEigen(MatrixNM<T, N, N> A)
+        {
+            if (A.rows() != A.cols())
+                throw std::invalid_argument("Eigendecomposition requires a square matrix");
+            const size_t n = A.rows();
+            VectorN<T, N> values = internal::SizedVector<T, N>::make(n);
+            typedef internal::LUElement<T> Elem;
+            internal::symmetricEigen<N>(n, Elem::cast(A.data()), Elem::cast(values.data()), true,
+                                        std::integral_constant<bool, (N != Dynamic && N <= internal::JacobiMaxSize)>());
+            return SymmetricEigenDecomposition<T, N>{std::move(values), std::move(A)};
+        }
 
-                // 解 U*x = y（后向替换）
-                MatrixNM<T, N, 1> x;
-                for (int i = N - 1; i >= 0; --i)
+        /**
+         * @brief 只计算实对称矩阵的特征值（升序）
+         *
+         * 省去 Q 的形成与旋转的累积，三对角化之后只需 O(n^2) 运算，大矩阵上比 symmetricEigen 快数倍。
+         *
+         * @param A 输入的 N×N 对称矩阵，只读取下三角
+         * @return VectorN<T, N> 升序特征值
+         */
+        template <typename T, size_t N>
+        VectorN<T, N> symmetricEigenvalues(MatrixNM<T, N, N> A)
+        {
+            if (A.rows() != A.cols())
+                throw std::invalid_argument("Eigendecomposition requires a square matrix");
+            const size_t n = A.rows();
+            VectorN<T, N> values = internal::SizedVector<T, N>::make(n);
+            typedef internal::LUElement<T> Elem;
+            internal::symmetricEigen<N>(n, Elem::cast(A.data()), Elem::cast(values.data()), false,
+                                        std::integral_constant<bool, (N != Dynamic && N <= internal::JacobiMaxSize)>());
+            return values;
+        }
+
+        /**
+         * @brief 薄奇异值分解结果：A = U * diag(singularValues) * V^T
+         * @details k = min(M, N)。singularValues 非负且按降序排列；U（M×k）与 V（N×k）的列标准正交。
+         */
+        template <typename T, size_t M, size_t N>
+        struct SVDDecomposition
+        {
+            MatrixNM<T, M, internal::MinDimension<M, N>::value> U;
+            VectorN<T, internal::MinDimension<M, N>::value> singularValues;
+            MatrixNM<T, N, internal::MinDimension<M, N>::value> V;
+
+            size_t size() const { return singularValues.rows() * singularValues.cols(); }
+        };
+
+        /**
+         * @brief 奇异值分解（Householder 双对角化 + Golub-Kahan 隐式位移 QR）
+         *
+         * 行数多于列数时先做 QR 分解，只对 N×N 的 R 做双对角化与迭代；列数多于行数时对 A^T 求解。
+         *
+         * @param A 输入的 M×N 矩阵
+         * @return SVDDecomposition<T, M, N> 薄 SVD
+         * @throws std::runtime_error 如果 QR 迭代不收敛
+         */
+        template <typename T, size_t M, size_t N>
+        SVDDecomposition<T, M, N> svd(MatrixNM<T, M, N> A)
+        {
+            const size_t m = A.rows(), n = A.cols(), k = std::min(m, n);
+            constexpr size_t K = internal::MinDimension<M, N>::value;
+            SVDDecomposition<T, M, N> result{MatrixNM<T, M, K>(m, k), internal::SizedVector<T, K>::make(k), MatrixNM<T, N, K>(n, k)};
+            typedef internal::LUElement<T> Elem;
+            internal::svdThin(m, n, Elem::cast(A.data()), Elem::cast(result.singularValues.data()),
+                              Elem::cast(result.U.data()), Elem::cast(result.V.data()));
+            return result;
+        }
+
+        /**
+         * @brief 只计算奇异值（降序），省去奇异向量的形成与旋转的累积
+         */
+        template <typename T, size_t M, size_t N>
+        VectorN<T, internal::MinDimension<M, N>::value> singularValues(MatrixNM<T, M, N> A)
+        {
+            const size_t m = A.rows(), n = A.cols();
+            constexpr size_t K = internal::MinDimension<M, N>::value;
+            VectorN<T, K> s = internal::SizedVector<T, K>::make(std::min(m, n));
+            typedef internal::LUElement<T> Elem;
+            internal::svdThin(m, n, Elem::cast(A.data()), Elem::cast(s.data()),
+                              static_cast<typename Elem::type *>(nullptr), static_cast<typename Elem::type *>(nullptr));
+            return s;
+        }
+
+        /**
+         * @brief 奇异值的默认截断阈值 max(M, N) * eps * sigma_max（与 NumPy、MATLAB 一致）
+         */
+        template <typename T, size_t K>
+        T svdTolerance(const VectorN<T, K> &s, size_t m, size_t n)
+        {
+            typedef typename internal::LUElement<T>::type E;
+            const size_t k = s.rows() * s.cols();
+            if (k == 0)
+                return T::zero();
+            return s[0] * T(double(std::max(m, n)) * std::numeric_limits<E>::epsilon());
+        }
+
+        /**
+         * @brief 数值秩：大于 tolerance 的奇异值个数
+         */
+        template <typename T, size_t M, size_t N>
+        size_t rank(const MatrixNM<T, M, N> &A, T tolerance)
+        {
+            const auto s = singularValues(A);
+            size_t r = 0;
+            for (size_t i = 0; i < s.rows() * s.cols(); ++i)
+                if (s[i] > tolerance)
+                    ++r;
+            return r;
+        }
+
+        /**
+         * @brief 数值秩，阈值取 max(M, N) * eps * sigma_max
+         */
+        template <typename T, size_t M, size_t N>
+        size_t rank(const MatrixNM<T, M, N> &A)
+        {
+            const auto s = singularValues(A);
+            const T tolerance = svdTolerance(s, A.rows(), A.cols());
+            size_t r = 0;
+            for (size_t i = 0; i < s.rows() * s.cols(); ++i)
+                if (s[i] > tolerance)
+                    ++r;
+            return r;
+        }
+
+        /**
+         * @brief 2-范数条件数 sigma_max / sigma_min；奇异矩阵返回 +inf
+         */
+        template <typename T, size_t M, size_t N>
+        T cond(const MatrixNM<T, M, N> &A)
+        {
+            const auto s = singularValues(A);
+            const size_t k = s.rows() * s.cols();
+            if (k == 0 || s[k - 1] == T::zero())
+                return T(std::numeric_limits<double>::infinity());
+            return s[0] / s[k - 1];
+        }
+
+        /**
+         * @brief Moore-Penrose 伪逆 A^+ = V * diag(1 / sigma) * U^T，不超过 tolerance 的奇异值视为 0
+         *
+         * @param A 输入的 M×N 矩阵
+         * @param tolerance 奇异值截断阈值
+         * @return MatrixNM<T, N, M> 伪逆
+         */
+        template <typename T, size_t M, size_t N>
+        MatrixNM<T, N, M> pinv(const MatrixNM<T, M, N> &A, T tolerance)
+        {
+            const auto f = svd(A);
+            const size_t n = A.cols(), k = f.size();
+            auto Vs = f.V;
+            for (size_t j = 0; j < k; ++j)
+            {
+                const T inv = f.singularValues[j] > tolerance ? T(1.0) / f.singularValues[j] : T::zero();
+                for (size_t i = 0; i < n; ++i)
+                    Vs(i, j) = Vs(i, j) * inv;
+            }
+            return MatrixNM<T, N, M>(Vs * f.U.transpose());
+        }
+
+        /**
+         * @brief Moore-Penrose 伪逆，阈值取 max(M, N) * eps * sigma_max
+         */
+        template <typename T, size_t M, size_t N>
+        MatrixNM<T, N, M> pinv(const MatrixNM<T, M, N> &A)
+        {
+            return pinv(A, svdTolerance(singularValues(A), A.rows(), A.cols()));
+        }
+
+        /**
+         * @brief 随机化截断 SVD：只求前 k 个奇异三元组 A ≈ U * diag(s) * V^T
+         *
+         * 对 A 只做 2 * powerIterations + 2 次 GEMM，其余计算都在 (k + oversampling) 维的小矩阵上进行，
+         * 大矩阵上比完整 SVD 快几个数量级。奇异值衰减缓慢时可增大 powerIterations 以提高精度。
+         *
+         * @param A 输入的 M×N 矩阵
+         * @param k 需要的奇异值个数，不超过 min(M, N)
+         * @param oversampling 额外的随机采样向量个数
+         * @param powerIterations 幂迭代次数
+         * @param seed 随机数种子
+         * @return SVDDecomposition<T, Dynamic, Dynamic> U 为 M×k，V 为 N×k
+         */
+        template <typename T, size_t M, size_t N>
+        SVDDecomposition<T, Dynamic, Dynamic> randomizedSVD(const MatrixNM<T, M, N> &A, size_t k, size_t oversampling = 10,
+                                                            size_t powerIterations = 2, unsigned long long seed = 0x5eed)
+        {
+            const size_t m = A.rows(), n = A.cols();
+            if (k == 0 || k > std::min(m, n))
+                throw std::invalid_argument("Requested rank exceeds the matrix dimensions");
+            SVDDecomposition<T, Dynamic, Dynamic> result{MatrixX<T>(m, k), VectorN<T, Dynamic>(k), MatrixX<T>(n, k)};
+            typedef internal::LUElement<T> Elem;
+            internal::randomizedSvd(m, n, Elem::cast(A.data()), k, oversampling, powerIterations, seed,
+                                    Elem::cast(result.singularValues.data()), Elem::cast(result.U.data()), Elem::cast(result.V.data()));
+            return result;
+        }
+
+        /**
+         * @brief 一般实矩阵的全部特征值
+         *
+         * 先平衡矩阵，再用 Householder 变换约化为上 Hessenberg 矩阵，最后做带收缩的隐式双位移 Francis QR 迭代，
+         * 总运算量 O(n^3)。复特征值以共轭对的形式出现。
+         *
+         * @param A 输入的 N×N 实矩阵
+         * @return 特征值，按实部升序、实部相同时按虚部升序排列
+         * @throws std::runtime_error 如果 QR 迭代不收敛
+         */
+        template <typename T, size_t N>
+        VectorN<typename internal::ComplexScalar<T>::type, N> eigenvalues(MatrixNM<T, N, N> A)
+        {
+            typedef typename internal::ComplexScalar<T>::type C;
+            typedef typename internal::LUElement<T>::type E;
+            if (A.rows() != A.cols())
+                throw std::invalid_argument("Eigenvalues require a square matrix");
+            const size_t n = A.rows();
+            std::vector<E> wr(n), wi(n);
+            internal::generalEigenvalues(n, internal::LUElement<T>::cast(A.data()), wr.data(), wi.data());
+            VectorN<C, N> values = internal::SizedVector<C, N>::make(n);
+            for (size_t i = 0; i < n; ++i)
+                values[i] = C(wr[i], wi[i]);
+            return values;
+        }
+
+        /**
+         * @brief 混合精度求解的结果
+         */
+        template <typename T, size_t N>
+        struct RefinementResult
+        {
+            VectorN<T, N> x;
+            size_t iterations; // 迭代修正的次数
+            bool converged;    // 单精度分解加迭代修正是否达到双精度精度；否则已退回双精度 LU 求解
+        };
+
+        /**
+         * @brief 混合精度 LU 求解 A * x = b：单精度分解，双精度迭代修正
+         *
+         * 把 A 转换为单精度后做 LU 分解（SIMD 宽度翻倍、内存流量减半），
+         * 然后重复以下步骤直到收敛：
+         *   1. 以双精度计算残差 r = b - A * x；
+         *   2. 用单精度分解求解修正量 A * d = r；
+         *   3. x += d。
+         * 收敛判据与 LAPACK dsgesv 相同：||r||∞ <= ||x||∞ · ||A||∞ · eps · sqrt(n)，eps 为双精度机器精度。
+         * A 的条件数约超过 1/eps(float) ≈ 1e7 时修正不收敛，此时退回双精度 LU 直接求解。
+         *
+         * @param A 系数矩阵（双精度）
+         * @param b 右端向量
+         * @param maxIter 最大修正次数
+         * @return RefinementResult<T, N> 解、修正次数及是否收敛
+         */
+        template <typename P, size_t N>
+        RefinementResult<BasicReal<double, P>, N> mixedPrecisionSolve(const MatrixNM<BasicReal<double, P>, N, N> &A,
+                                                                      const VectorN<BasicReal<double, P>, N> &b,
+                                                                      size_t maxIter = 30)
+        {
+            typedef BasicReal<double, P> T;
+            typedef BasicReal<float, P> Low;
+            if (A.rows() != A.cols())
+                throw std::invalid_argument("Mixed precision solve requires a square matrix");
+            const size_t n = A.rows();
+
+            RefinementResult<T, N> result{VectorN<T, N>(b), 0, false};
+
+            T anrm = T::zero();
+            for (size_t i = 0; i < n; ++i)
+            {
+                T rowSum = T::zero();
+                for (size_t j = 0; j < n; ++j)
+                    rowSum += abs(A(i, j));
+                if (rowSum > anrm)
+                    anrm = rowSum;
+            }
+            const T cte = anrm * T(std::numeric_limits<double>::epsilon() * std::sqrt(double(n)));
+
+            const LUFactorization<Low, N> lowLU = luFactor(MatrixNM<Low, N, N>(A.template cast<Low>()));
+            if (!lowLU.isSingular)
+            {
+                result.x = solve(lowLU, VectorN<Low, N>(b.template cast<Low>())).template cast<T>();
+                for (size_t iter = 0; iter <= maxIter; ++iter)
                 {
-                    T sum = y(i, 0);
-                    for (size_t j = i + 1; j < N; ++j)
-                        sum -= lup.U(i, j) * x(j, 0);
-                    x(i, 0) = sum / lup.U(i, i);
+                    const VectorN<T, N> r(b - A * result.x);
+                    T rnrm = T::zero(), xnrm = T::zero();
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        if (abs(r[i]) > rnrm)
+                            rnrm = abs(r[i]);
+                        if (abs(result.x[i]) > xnrm)
+                            xnrm = abs(result.x[i]);
+                    }
+                    result.iterations = iter;
+                    if (rnrm <= xnrm * cte)
+                    {
+                        result.converged = true;
+                        return result;
+                    }
+                    if (iter == maxIter)
+                        break;
+                    const VectorN<Low, N> d = solve(lowLU, VectorN<Low, N>(r.template cast<Low>()));
+                    result.x = result.x + d.template cast<T>();
                 }
-
-                for (size_t row = 0; row < N; ++row)
-                    inv(row, col) = x(row, 0);
             }
-            return inv;
+
+            // 单精度分解奇异或修正不收敛：双精度重新分解
+            result.x = solve(luFactor(A), b);
+            return result;
         }
 
         /**
@@ -357,31 +1216,35 @@ namespace OxygenMath
          * @param b 常数向量（N维）
          * @param x0 初始解（N维）
          * @param maxIter 最大迭代次数
-         * @param tol 收敛容差
+         * @param tol 收敛容差，一轮扫描中各分量更新量的绝对值之和小于 tol 时停止
          * @return VectorN<T, N> 迭代得到的解
+         * @note 需要迭代步数、松弛因子或稀疏矩阵时使用 LinAlg::sor / ssor / multicolorGaussSeidel（IterativeSolvers.hpp）
          */
         template <typename T, size_t N>
         VectorN<T, N> gaussSeidel(const MatrixNM<T, N, N> &A, const VectorN<T, N> &b,
                                   const VectorN<T, N> &x0, size_t maxIter = 1000, T tol = Constants::epsilon)
         {
+            const size_t n = A.rows();
             VectorN<T, N> x = x0;
+            const T *a = A.data(), *pb = b.data();
+            T *px = x.data();
             for (size_t iter = 0; iter < maxIter; ++iter)
             {
-                VectorN<T, N> x_old = x;
-                for (size_t i = 0; i < N; ++i)
+                // 更新量在扫描中顺带累加，不需要保存上一轮的解
+                T err = T::zero();
+                for (size_t i = 0; i < n; ++i)
                 {
-                    T sum = b(i);
-                    for (size_t j = 0; j < N; ++j)
+                    const T *row = a + i * n;
+                    T sum = pb[i];
+                    for (size_t j = 0; j < n; ++j)
                     {
                         if (j != i)
-                            sum -= A(i, j) * x(j);
+                            sum -= row[j] * px[j];
                     }
-                    x(i) = sum / A(i, i);
+                    const T xi = sum / row[i];
+                    err += abs(xi - px[i]);
+                    px[i] = xi;
                 }
-                // 检查收敛
-                T err = T::zero();
-                for (size_t k = 0; k < N; ++k)
-                    err += abs(x(k) - x_old(k));
                 if (err < tol)
                     break;
             }
@@ -11,17 +11,35 @@ namespace OxygenMath
     {
     };
     //  所以为 Real 类型特化
-    template <>
-    struct is_scalar_type<Real> : std::true_type
+    template <typename F, typename P>
+    struct is_scalar_type<BasicReal<F, P>> : std::true_type
     {
     };
 
     // 为 Complex 类型特化
-    template <>
-    struct is_scalar_type<Complex> : std::true_type
+    template <typename F, typename P>
+    struct is_scalar_type<BasicComplex<F, P>> : std::true_type
     {
     };
 
+    template <typename T>
+    class MatrixView;
+
+    namespace internal
+    {
+        // 归约的实现，见 Reduction.hpp
+        template <typename E>
+        struct Reduction;
+
+        // 可以取子块视图的类型及其存储的访问方式，见 MatrixView.hpp
+        template <typename E>
+        struct ViewTraits;
+
+        // 复合赋值 +=、-= 的实现，见 Assign.hpp
+        template <typename Dst>
+        struct CompoundAssign;
+    }
+
     /**
      * @brief 矩阵基类，使用CRTP实现静态多态
      *
@@ -77,11 +95,170 @@ namespace OxygenMath
             return MatrixSub<Derived, Other>(derived(), other.derived());
         }
 
+        // ------------------ 复合赋值（仅限矩阵、向量及可写视图，原地累加） ------------------
+
+        // A += B，A += B * C 直接把乘积累加到 A
+        template <typename Other>
+        Derived &operator+=(const MatrixBase<Other> &other)
+        {
+            return internal::CompoundAssign<Derived>::add(derived(), other.derived());
+        }
+
+        // A -= B，A -= B * C 直接从 A 中减去乘积
+        template <typename Other>
+        Derived &operator-=(const MatrixBase<Other> &other)
+        {
+            return internal::CompoundAssign<Derived>::sub(derived(), other.derived());
+        }
+
+        // A *= B 即 A = A * B，乘积先写入暂存区
+        template <typename Other>
+        Derived &operator*=(const MatrixBase<Other> &other)
+        {
+            return derived() = derived() * other.derived();
+        }
+
+        // 每个元素乘以 scalar
+        template <typename S>
+        auto operator*=(const S &scalar)
+            -> typename std::enable_if<is_scalar_type<S>::value, Derived &>::type
+        {
+            return derived() = derived() * scalar;
+        }
+
         // 转置
         auto transpose() const -> MatrixTranspose<Derived>
         {
             return MatrixTranspose<Derived>(derived());
         }
+
+        /**
+         * @brief 逐元素转换为 NewScalar 类型（惰性求值），如 A.template cast<Real32>()
+         */
+        template <typename NewScalar>
+        MatrixCast<Derived, NewScalar> cast() const
+        {
+            return MatrixCast<Derived, NewScalar>(derived());
+        }
+
+        /**
+         * @brief 立即求值，返回保存结果的矩阵
+         * @details 需要多次访问同一个乘积（例如逐元素读取 A * B * C）时，
+         *          先 eval() 可以避免重复计算。
+         */
+        template <typename D = Derived>
+        typename internal::ExprTraits<D>::PlainObject eval() const
+        {
+            return typename internal::ExprTraits<D>::PlainObject(derived());
+        }
+
+        // ------------------ 视图（引用原存储，不拷贝，仅限矩阵及其视图） ------------------
+
+        // 从 (i, j) 开始的 r×c 子块
+        template <typename D = Derived>
+        MatrixView<typename internal::ViewTraits<D>::Element> block(size_t i, size_t j, size_t r, size_t c)
+        {
+            return internal::ViewTraits<D>::block(derived(), i, j, r, c);
+        }
+
+        template <typename D = Derived>
+        MatrixView<typename internal::ViewTraits<D>::ConstElement> block(size_t i, size_t j, size_t r, size_t c) const
+        {
+            return internal::ViewTraits<D>::block(derived(), i, j, r, c);
+        }
+
+        // 第 i 行（1×cols）
+        template <typename D = Derived>
+        MatrixView<typename internal::ViewTraits<D>::Element> row(size_t i)
+        {
+            return internal::ViewTraits<D>::block(derived(), i, 0, 1, cols());
+        }
+
+        template <typename D = Derived>
+        MatrixView<typename internal::ViewTraits<D>::ConstElement> row(size_t i) const
+        {
+            return internal::ViewTraits<D>::block(derived(), i, 0, 1, cols());
+        }
+
+        // 第 j 列（rows×1）
+        template <typename D = Derived>
+        MatrixView<typename internal::ViewTraits<D>::Element> col(size_t j)
+        {
+            return internal::ViewTraits<D>::block(derived(), 0, j, rows(), 1);
+        }
+
+        template <typename D = Derived>
+        MatrixView<typename internal::ViewTraits<D>::ConstElement> col(size_t j) const
+        {
+            return internal::ViewTraits<D>::block(derived(), 0, j, rows(), 1);
+        }
+
+        // 主对角线，min(rows, cols)×1 的列
+        template <typename D = Derived>
+        MatrixView<typename internal::ViewTraits<D>::Element> diagonal()
+        {
+            return internal::ViewTraits<D>::diagonal(derived());
+        }
+
+        template <typename D = Derived>
+        MatrixView<typename internal::ViewTraits<D>::ConstElement> diagonal() const
+        {
+            return internal::ViewTraits<D>::diagonal(derived());
+        }
+
+        // ------------------ 归约（与表达式融合，不生成临时矩阵） ------------------
+
+        // 所有元素之和
+        template <typename D = Derived>
+        typename internal::ExprTraits<D>::Scalar sum() const
+        {
+            return internal::Reduction<D>::sum(derived());
+        }
+
+        // 所有元素的平方和（Frobenius 范数的平方），仅限实数元素
+        template <typename D = Derived>
+        typename internal::ExprTraits<D>::Scalar squaredNorm() const
+        {
+            return internal::Reduction<D>::squaredNorm(derived());
+        }
+
+        // Frobenius 范数（向量的 L2 范数），仅限实数元素
+        template <typename D = Derived>
+        typename internal::ExprTraits<D>::Scalar norm() const
+        {
+            return internal::Reduction<D>::norm(derived());
+        }
+
+        /**
+         * @brief 逐元素的 Lp 范数 (Σ|x|^p)^(1/p)，仅限实数元素
+         * @param p 大于 0；p 为无穷大（std::numeric_limits<double>::infinity()）时返回最大绝对值
+         */
+        template <typename D = Derived>
+        typename internal::ExprTraits<D>::Scalar lpNorm(double p) const
+        {
+            return internal::Reduction<D>::lpNorm(derived(), p);
+        }
+
+        // 最大元素，仅限实数元素；含 NaN 时返回 NaN，空矩阵抛出异常
+        template <typename D = Derived>
+        typename internal::ExprTraits<D>::Scalar maxCoeff() const
+        {
+            return internal::Reduction<D>::maxCoeff(derived());
+        }
+
+        // 最小元素，仅限实数元素；含 NaN 时返回 NaN，空矩阵抛出异常
+        template <typename D = Derived>
+        typename internal::ExprTraits<D>::Scalar minCoeff() const
+        {
+            return internal::Reduction<D>::minCoeff(derived());
+        }
+
+        // 逐元素乘积之和（不取共轭），两者尺寸必须相同
+        template <typename Other>
+        typename internal::ExprTraits<Other>::Scalar dot(const MatrixBase<Other> &other) const
+        {
+            return internal::Reduction<Derived>::dot(derived(), other.derived());
+        }
     };
 
     // 全局运算符：标量 * 矩阵
@@ -92,4 +269,17 @@ namespace OxygenMath
     {
         return ScalarMatrixMul<S, Derived>(scalar, mat.derived());
     }
+
+    namespace internal
+    {
+        template <typename Derived>
+        std::true_type isMatrixExpressionTest(const MatrixBase<Derived> *);
+        std::false_type isMatrixExpressionTest(...);
+    }
+
+    // 判断类型是否为矩阵表达式（继承自 MatrixBase），用于约束表达式构造函数
+    template <typename E>
+    struct is_matrix_expression : decltype(internal::isMatrixExpressionTest(static_cast<const E *>(nullptr)))
+    {
+    };
 }
\ No newline at end of file
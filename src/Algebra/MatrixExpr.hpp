@@ -1,4 +1,9 @@
 #pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <ostream>
+#include <type_traits>
+#include "DenseStorage.hpp"
 
 namespace OxygenMath
 {
@@ -6,6 +11,78 @@ namespace OxygenMath
     template <typename Derived>
     class MatrixBase;
 
+    template <typename T, size_t Rows, size_t Cols>
+    class MatrixNM;
+
+    template <typename T, size_t N>
+    class VectorN;
+
+    template <typename T>
+    class MatrixView;
+
+    namespace internal
+    {
+        // 是否为持有数据的"普通对象"（矩阵、向量），其余类型均为表达式
+        template <typename E>
+        struct IsPlainObject : std::false_type
+        {
+        };
+        template <typename T, size_t Rows, size_t Cols>
+        struct IsPlainObject<MatrixNM<T, Rows, Cols>> : std::true_type
+        {
+        };
+        template <typename T, size_t N>
+        struct IsPlainObject<VectorN<T, N>> : std::true_type
+        {
+        };
+
+        /**
+         * @brief 表达式节点保存子表达式的方式
+         * @details 普通对象按常引用保存；子表达式按值保存，
+         *          这样 auto e = A * B + C; 中的临时节点不会悬空。
+         */
+        template <typename E>
+        struct Nested
+        {
+            using type = typename std::conditional<IsPlainObject<E>::value, const E &, const E>::type;
+        };
+
+        /**
+         * @brief 表达式的编译期信息：元素类型、行列数（未知时为 Dynamic）以及求值结果类型
+         */
+        template <typename E>
+        struct ExprTraits;
+
+        template <typename T, size_t Rows, size_t Cols>
+        struct ExprTraits<MatrixNM<T, Rows, Cols>>
+        {
+            using Scalar = T;
+            static constexpr size_t RowsAtCompileTime = Rows;
+            static constexpr size_t ColsAtCompileTime = Cols;
+            using PlainObject = MatrixNM<T, Rows, Cols>;
+        };
+
+        // 向量的行列方向在运行期决定，因此行列数都视为未知
+        template <typename T, size_t N>
+        struct ExprTraits<VectorN<T, N>>
+        {
+            using Scalar = T;
+            static constexpr size_t RowsAtCompileTime = Dynamic;
+            static constexpr size_t ColsAtCompileTime = Dynamic;
+            using PlainObject = VectorN<T, N>;
+        };
+
+        template <typename Scalar, size_t Rows, size_t Cols>
+        struct ExprTraitsBase
+        {
+            using PlainObject = MatrixNM<Scalar, Rows, Cols>;
+            static constexpr size_t RowsAtCompileTime = Rows;
+            static constexpr size_t ColsAtCompileTime = Cols;
+        };
+
+        constexpr size_t pickDim(size_t a, size_t b) { return a != Dynamic ? a : b; }
+    }
+
     template <typename Derived>
     struct MatrixExpr : MatrixBase<Derived>
     {
@@ -20,8 +97,8 @@ namespace OxygenMath
     template <typename Lhs, typename Rhs>
     struct MatrixAdd : MatrixExpr<MatrixAdd<Lhs, Rhs>>
     {
-        const Lhs &lhs;
-        const Rhs &rhs;
+        typename internal::Nested<Lhs>::type lhs;
+        typename internal::Nested<Rhs>::type rhs;
 
         MatrixAdd(const Lhs &l, const Rhs &r) : lhs(l), rhs(r)
         {
@@ -42,8 +119,8 @@ namespace OxygenMath
     template <typename Lhs, typename Rhs>
     struct MatrixSub : MatrixExpr<MatrixSub<Lhs, Rhs>>
     {
-        const Lhs &lhs;
-        const Rhs &rhs;
+        typename internal::Nested<Lhs>::type lhs;
+        typename internal::Nested<Rhs>::type rhs;
 
         MatrixSub(const Lhs &l, const Rhs &r) : lhs(l), rhs(r)
         {
@@ -60,12 +137,16 @@ namespace OxygenMath
         }
     };
 
-    // 矩阵乘法表达式
+    /**
+     * @brief 矩阵乘法表达式
+     * @note 赋值给矩阵时整体求值（见 Assign.hpp），不是普通对象的操作数只会被求值一次；
+     *       直接调用 operator()(i, j) 则每次计算一个点积，连乘时请先 eval()。
+     */
     template <typename Lhs, typename Rhs>
     struct MatrixMul : MatrixExpr<MatrixMul<Lhs, Rhs>>
     {
-        const Lhs &lhs;
-        const Rhs &rhs;
+        typename internal::Nested<Lhs>::type lhs;
+        typename internal::Nested<Rhs>::type rhs;
 
         MatrixMul(const Lhs &l, const Rhs &r) : lhs(l), rhs(r)
         {
@@ -91,7 +172,7 @@ namespace OxygenMath
     template <typename Mat, typename Scalar>
     struct MatrixScalarMul : MatrixExpr<MatrixScalarMul<Mat, Scalar>>
     {
-        const Mat &mat;
+        typename internal::Nested<Mat>::type mat;
         const Scalar scalar;
 
         MatrixScalarMul(const Mat &m, const Scalar &s) : mat(m), scalar(s) {}
@@ -110,7 +191,7 @@ namespace OxygenMath
     struct ScalarMatrixMul : MatrixExpr<ScalarMatrixMul<Scalar, Mat>>
     {
         const Scalar scalar;
-        const Mat &mat;
+        typename internal::Nested<Mat>::type mat;
 
         ScalarMatrixMul(const Scalar &s, const Mat &m) : scalar(s), mat(m) {}
 
@@ -127,7 +208,7 @@ namespace OxygenMath
     template <typename Mat>
     struct MatrixTranspose : MatrixExpr<MatrixTranspose<Mat>>
     {
-        const Mat &mat;
+        typename internal::Nested<Mat>::type mat;
 
         MatrixTranspose(const Mat &m) : mat(m) {}
 
@@ -139,6 +220,128 @@ namespace OxygenMath
             return mat(j, i);
         }
     };
+
+    // 元素类型转换表达式，例如 A.cast<Real32>()
+    template <typename Mat, typename NewScalar>
+    struct MatrixCast : MatrixExpr<MatrixCast<Mat, NewScalar>>
+    {
+        typename internal::Nested<Mat>::type mat;
+
+        MatrixCast(const Mat &m) : mat(m) {}
+
+        size_t rows() const { return mat.rows(); }
+        size_t cols() const { return mat.cols(); }
+
+        NewScalar operator()(size_t i, size_t j) const
+        {
+            return NewScalar(mat(i, j));
+        }
+    };
+
+    /**
+     * @brief 逐元素函数表达式，例如 exp(A)、sin(v)、abs(M)（见 ElementwiseMath.hpp）
+     * @tparam Op 函数对象类型，Op::apply(x) 计算一个元素，元素类型不变
+     */
+    template <typename Mat, typename Op>
+    struct MatrixUnaryOp : MatrixExpr<MatrixUnaryOp<Mat, Op>>
+    {
+        typename internal::Nested<Mat>::type mat;
+
+        MatrixUnaryOp(const Mat &m) : mat(m) {}
+
+        size_t rows() const { return mat.rows(); }
+        size_t cols() const { return mat.cols(); }
+
+        auto operator()(size_t i, size_t j) const -> decltype(Op::apply(mat(i, j)))
+        {
+            return Op::apply(mat(i, j));
+        }
+    };
+
+    namespace internal
+    {
+        // 把求值结果类型的元素类型替换为 S，保持矩阵/向量的种类与尺寸
+        template <typename Plain, typename S>
+        struct RebindScalar;
+        template <typename T, size_t Rows, size_t Cols, typename S>
+        struct RebindScalar<MatrixNM<T, Rows, Cols>, S>
+        {
+            using type = MatrixNM<S, Rows, Cols>;
+        };
+        template <typename T, size_t N, typename S>
+        struct RebindScalar<VectorN<T, N>, S>
+        {
+            using type = VectorN<S, N>;
+        };
+
+        template <typename Lhs, typename Rhs>
+        struct ExprTraits<MatrixAdd<Lhs, Rhs>>
+            : ExprTraitsBase<typename ExprTraits<Lhs>::Scalar,
+                             pickDim(ExprTraits<Lhs>::RowsAtCompileTime, ExprTraits<Rhs>::RowsAtCompileTime),
+                             pickDim(ExprTraits<Lhs>::ColsAtCompileTime, ExprTraits<Rhs>::ColsAtCompileTime)>
+        {
+            using Scalar = typename ExprTraits<Lhs>::Scalar;
+        };
+
+        template <typename Lhs, typename Rhs>
+        struct ExprTraits<MatrixSub<Lhs, Rhs>> : ExprTraits<MatrixAdd<Lhs, Rhs>>
+        {
+        };
+
+        template <typename Lhs, typename Rhs>
+        struct ExprTraits<MatrixMul<Lhs, Rhs>>
+            : ExprTraitsBase<typename ExprTraits<Lhs>::Scalar,
+                             ExprTraits<Lhs>::RowsAtCompileTime,
+                             ExprTraits<Rhs>::ColsAtCompileTime>
+        {
+            using Scalar = typename ExprTraits<Lhs>::Scalar;
+        };
+
+        template <typename Mat, typename S>
+        struct ExprTraits<MatrixScalarMul<Mat, S>>
+            : ExprTraitsBase<typename ExprTraits<Mat>::Scalar,
+                             ExprTraits<Mat>::RowsAtCompileTime,
+                             ExprTraits<Mat>::ColsAtCompileTime>
+        {
+            using Scalar = typename ExprTraits<Mat>::Scalar;
+        };
+
+        template <typename S, typename Mat>
+        struct ExprTraits<ScalarMatrixMul<S, Mat>> : ExprTraits<MatrixScalarMul<Mat, S>>
+        {
+        };
+
+        template <typename Mat>
+        struct ExprTraits<MatrixTranspose<Mat>>
+            : ExprTraitsBase<typename ExprTraits<Mat>::Scalar,
+                             ExprTraits<Mat>::ColsAtCompileTime,
+                             ExprTraits<Mat>::RowsAtCompileTime>
+        {
+            using Scalar = typename ExprTraits<Mat>::Scalar;
+        };
+
+        template <typename Mat, typename S>
+        struct ExprTraits<MatrixCast<Mat, S>>
+        {
+            using Scalar = S;
+            static constexpr size_t RowsAtCompileTime = ExprTraits<Mat>::RowsAtCompileTime;
+            static constexpr size_t ColsAtCompileTime = ExprTraits<Mat>::ColsAtCompileTime;
+            using PlainObject = typename RebindScalar<typename ExprTraits<Mat>::PlainObject, S>::type;
+        };
+
+        template <typename Mat, typename Op>
+        struct ExprTraits<MatrixUnaryOp<Mat, Op>> : ExprTraits<Mat>
+        {
+        };
+
+        // 视图的尺寸在运行期决定，求值结果为动态尺寸矩阵
+        template <typename T>
+        struct ExprTraits<MatrixView<T>> : ExprTraitsBase<typename std::remove_const<T>::type, Dynamic, Dynamic>
+        {
+            using Scalar = typename std::remove_const<T>::type;
+        };
+    }
+
     // 输出运算符
     template <typename Expr>
     std::ostream &operator<<(std::ostream &os, const MatrixExpr<Expr> &expr)
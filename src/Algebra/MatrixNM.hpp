@@ -7,12 +7,18 @@
 #include "AlgebraTool.hpp"
 #include "MatrixBase.hpp"
 #include "MatrixExpr.hpp"
+#include "DenseStorage.hpp"
+#include "Assign.hpp"
+#include "Reduction.hpp"
+#include "MatrixView.hpp"
 #include "../Constants.hpp"
 
 namespace OxygenMath
 {
     /*! \brief 矩阵模板类，支持基本线性代数运算,只实现矩阵的构造和基本运算，求解行列式，逆，是否奇异位于LinerAlgbraAlgorithm.hpp
      * \tparam T 矩阵元素类型，必须继承自NumberField
+     * \tparam Rows 行数，为 Dynamic 时在运行期确定
+     * \tparam Cols 列数，为 Dynamic 时在运行期确定
      */
     template <typename T, size_t Rows, size_t Cols>
     class MatrixNM : public MatrixBase<MatrixNM<T, Rows, Cols>>
@@ -21,55 +27,76 @@ namespace OxygenMath
                       "Matrix<T> requires T to inherit from NumberField<T>");
 
     private:
-        std::vector<T> data;
+        using Storage = typename internal::DenseStorage<T, Rows, Cols>::type;
+        Storage storage;
         using Scalar = T;
 
     public:
-        MatrixNM() : data(Rows * Cols, T::zero()) {}
+        MatrixNM() {}
 
-        template <typename Expr>
-        MatrixNM(const Expr &expr)
+        // 指定尺寸构造，元素初始化为零元；定长矩阵要求尺寸与模板参数一致
+        MatrixNM(size_t rows, size_t cols) : storage(rows, cols) {}
+
+        template <typename Expr,
+                  typename = typename std::enable_if<is_matrix_expression<Expr>::value>::type>
+        MatrixNM(const Expr &expr) : storage(expr.rows(), expr.cols())
         {
-            for (size_t i = 0; i < Rows; ++i)
-                for (size_t j = 0; j < Cols; ++j)
-                    data[i * Cols + j] = expr(i, j);
+            internal::evaluateTo(storage.data(), cols(), expr);
         }
         MatrixNM(const std::initializer_list<std::initializer_list<T>> &init)
+            : storage(init.size(), init.size() > 0 ? init.begin()->size() : 0)
         {
-            if (init.size() != Rows || (init.size() > 0 && init.begin()->size() != Cols))
-                throw std::invalid_argument("Initializer list size does not match matrix dimensions");
-
-            data.reserve(Rows * Cols);
+            const size_t c = cols();
+            size_t i = 0;
             for (const auto &row : init)
             {
+                if (row.size() != c)
+                    throw std::invalid_argument("Initializer list size does not match matrix dimensions");
+                size_t j = 0;
                 for (const auto &elem : row)
                 {
-                    data.push_back(elem);
+                    storage.data()[i * c + j] = elem;
+                    ++j;
                 }
+                ++i;
             }
         }
         T &operator()(size_t row, size_t col)
         {
-            return data[row * Cols + col];
+            return storage.data()[row * storage.cols() + col];
         }
 
         const T &operator()(size_t row, size_t col) const
         {
-            return data[row * Cols + col];
+            return storage.data()[row * storage.cols() + col];
         }
 
-        size_t rows() const { return Rows; }
-        size_t cols() const { return Cols; }
+        size_t rows() const { return storage.rows(); }
+        size_t cols() const { return storage.cols(); }
+
+        // 连续行主序存储的首地址
+        T *data() { return storage.data(); }
+        const T *data() const { return storage.data(); }
+
+        // 改变尺寸（仅动态维度可变），元素个数变化时内容置零
+        void resize(size_t rows, size_t cols) { storage.resize(rows, cols); }
 
-        // 从表达式赋值
+        // 声明右侧表达式不引用本矩阵，赋值时直接写入存储而不经过临时缓冲区
+        internal::NoAlias<MatrixNM> noalias() { return internal::NoAlias<MatrixNM>(*this); }
+
+        // 从表达式赋值：尺寸不变时直接写入现有存储（右侧引用本矩阵时由别名分析决定是否经过暂存区），
+        // 尺寸改变时求值到新分配的存储
         template <typename Expr>
         MatrixNM &operator=(const Expr &expr)
         {
-            std::vector<T> tmp(Rows * Cols);
-            for (size_t i = 0; i < Rows; ++i)
-                for (size_t j = 0; j < Cols; ++j)
-                    tmp[i * Cols + j] = expr(i, j);
-            data = std::move(tmp);
+            if (expr.rows() == rows() && expr.cols() == cols())
+            {
+                internal::assignTo(storage.data(), cols(), expr);
+                return *this;
+            }
+            Storage tmp(expr.rows(), expr.cols());
+            internal::evaluateTo(tmp.data(), tmp.cols(), expr);
+            storage = std::move(tmp);
             return *this;
         }
 
@@ -77,7 +104,18 @@ namespace OxygenMath
         {
             static_assert(Rows == Cols, "Identity matrix must be square");
             MatrixNM<T, Rows, Cols> result;
-            for (size_t i = 0; i < Rows; ++i)
+            for (size_t i = 0; i < result.rows(); ++i)
+            {
+                result(i, i) = T::identity();
+            }
+            return result;
+        }
+
+        // n×n 单位矩阵，主要用于动态尺寸矩阵
+        static MatrixNM<T, Rows, Cols> identity(size_t n)
+        {
+            MatrixNM<T, Rows, Cols> result(n, n);
+            for (size_t i = 0; i < n; ++i)
             {
                 result(i, i) = T::identity();
             }
@@ -86,29 +124,31 @@ namespace OxygenMath
 
         friend std::ostream &operator<<(std::ostream &os, const MatrixNM &matrix)
         {
-            if (Rows == 0 || Cols == 0)
+            const size_t rows = matrix.rows();
+            const size_t cols = matrix.cols();
+            if (rows == 0 || cols == 0)
             {
                 return os << "[]";
             }
 
             os << "[";
-            for (size_t i = 0; i < Rows; ++i)
+            for (size_t i = 0; i < rows; ++i)
             {
                 if (i != 0)
                     os << " ";
 
                 os << "[";
-                for (size_t j = 0; j < Cols; ++j)
+                for (size_t j = 0; j < cols; ++j)
                 {
                     os << matrix(i, j);
-                    if (j < Cols - 1)
+                    if (j < cols - 1)
                     {
                         os << ", ";
                     }
                 }
                 os << "]";
 
-                if (i < Rows - 1)
+                if (i < rows - 1)
                 {
                     os << ",\n";
                 }
@@ -123,10 +163,10 @@ namespace OxygenMath
                       "Matrix<T> requires T to inherit from NumberField<T>");
 
     private:
-        T data[4];
+        T elems[4];
 
     public:
-        MatrixNM() : data{T::zero(), T::zero(), T::zero(), T::zero()} {}
+        MatrixNM() : elems{T::zero(), T::zero(), T::zero(), T::zero()} {}
 
         MatrixNM(const std::initializer_list<std::initializer_list<T>> &init)
         {
@@ -136,27 +176,44 @@ namespace OxygenMath
             auto row1 = *init.begin();
             auto row2 = *(init.begin() + 1);
 
-            data[0] = *(row1.begin());
-            data[1] = *(row1.begin() + 1);
-            data[2] = *(row2.begin());
-            data[3] = *(row2.begin() + 1);
+            elems[0] = *(row1.begin());
+            elems[1] = *(row1.begin() + 1);
+            elems[2] = *(row2.begin());
+            elems[3] = *(row2.begin() + 1);
         }
 
-        MatrixNM(T m11, T m12, T m21, T m22) : data{m11, m12, m21, m22} {}
+        MatrixNM(T m11, T m12, T m21, T m22) : elems{m11, m12, m21, m22} {}
+
+        MatrixNM(size_t rows, size_t cols) : MatrixNM()
+        {
+            if (rows != 2 || cols != 2)
+                throw std::invalid_argument("Matrix dimensions do not match 2x2 matrix");
+        }
 
         T &operator()(size_t row, size_t col)
         {
-            return data[row * 2 + col];
+            return elems[row * 2 + col];
         }
 
         const T &operator()(size_t row, size_t col) const
         {
-            return data[row * 2 + col];
+            return elems[row * 2 + col];
         }
 
         size_t rows() const { return 2; }
         size_t cols() const { return 2; }
 
+        T *data() { return elems; }
+        const T *data() const { return elems; }
+
+        void resize(size_t rows, size_t cols)
+        {
+            if (rows != 2 || cols != 2)
+                throw std::invalid_argument("Cannot resize a fixed-size matrix");
+        }
+
+        internal::NoAlias<MatrixNM> noalias() { return internal::NoAlias<MatrixNM>(*this); }
+
         static MatrixNM<T, 2, 2> identity()
         {
             MatrixNM<T, 2, 2> result;
@@ -167,13 +224,21 @@ namespace OxygenMath
             return result;
         }
 
+        template <typename Expr,
+                  typename = typename std::enable_if<is_matrix_expression<Expr>::value>::type>
+        MatrixNM(const Expr &expr)
+        {
+            if (expr.rows() != 2 || expr.cols() != 2)
+                throw std::invalid_argument("Expression size does not match 2x2 matrix");
+            internal::evaluateTo(elems, 2, expr);
+        }
+
         template <typename Expr>
         MatrixNM &operator=(const Expr &expr)
         {
-            data[0] = expr(0, 0);
-            data[1] = expr(0, 1);
-            data[2] = expr(1, 0);
-            data[3] = expr(1, 1);
+            if (expr.rows() != 2 || expr.cols() != 2)
+                throw std::invalid_argument("Expression size does not match 2x2 matrix");
+            internal::assignTo(elems, 2, expr);
             return *this;
         }
 
@@ -191,10 +256,10 @@ namespace OxygenMath
                       "Matrix<T> requires T to inherit from NumberField<T>");
 
     private:
-        T data[9];
+        T elems[9];
 
     public:
-        MatrixNM() : data{T::zero(), T::zero(), T::zero(),
+        MatrixNM() : elems{T::zero(), T::zero(), T::zero(),
                           T::zero(), T::zero(), T::zero(),
                           T::zero(), T::zero(), T::zero()} {}
 
@@ -210,7 +275,7 @@ namespace OxygenMath
                 auto row_it = row.begin();
                 for (size_t j = 0; j < 3; ++j, ++row_it)
                 {
-                    data[i * 3 + j] = *row_it;
+                    elems[i * 3 + j] = *row_it;
                 }
             }
         }
@@ -218,23 +283,40 @@ namespace OxygenMath
         MatrixNM(T m11, T m12, T m13,
                  T m21, T m22, T m23,
                  T m31, T m32, T m33)
-            : data{m11, m12, m13,
+            : elems{m11, m12, m13,
                    m21, m22, m23,
                    m31, m32, m33} {}
 
+        MatrixNM(size_t rows, size_t cols) : MatrixNM()
+        {
+            if (rows != 3 || cols != 3)
+                throw std::invalid_argument("Matrix dimensions do not match 3x3 matrix");
+        }
+
         T &operator()(size_t row, size_t col)
         {
-            return data[row * 3 + col];
+            return elems[row * 3 + col];
         }
 
         const T &operator()(size_t row, size_t col) const
         {
-            return data[row * 3 + col];
+            return elems[row * 3 + col];
         }
 
         size_t rows() const { return 3; }
         size_t cols() const { return 3; }
 
+        T *data() { return elems; }
+        const T *data() const { return elems; }
+
+        void resize(size_t rows, size_t cols)
+        {
+            if (rows != 3 || cols != 3)
+                throw std::invalid_argument("Cannot resize a fixed-size matrix");
+        }
+
+        internal::NoAlias<MatrixNM> noalias() { return internal::NoAlias<MatrixNM>(*this); }
+
         static MatrixNM<T, 3, 3> identity()
         {
             MatrixNM<T, 3, 3> result;
@@ -245,16 +327,21 @@ namespace OxygenMath
             return result;
         }
 
+        template <typename Expr,
+                  typename = typename std::enable_if<is_matrix_expression<Expr>::value>::type>
+        MatrixNM(const Expr &expr)
+        {
+            if (expr.rows() != 3 || expr.cols() != 3)
+                throw std::invalid_argument("Expression size does not match 3x3 matrix");
+            internal::evaluateTo(elems, 3, expr);
+        }
+
         template <typename Expr>
         MatrixNM &operator=(const Expr &expr)
         {
-            for (size_t i = 0; i < 3; ++i)
-            {
-                for (size_t j = 0; j < 3; ++j)
-                {
-                    data[i * 3 + j] = expr(i, j);
-                }
-            }
+            if (expr.rows() != 3 || expr.cols() != 3)
+                throw std::invalid_argument("Expression size does not match 3x3 matrix");
+            internal::assignTo(elems, 3, expr);
             return *this;
         }
 
@@ -265,4 +352,10 @@ namespace OxygenMath
                       << " [" << matrix(2, 0) << ", " << matrix(2, 1) << ", " << matrix(2, 2) << "]]";
         }
     };
+
+    // 动态尺寸矩阵：行列数在运行期确定，一份实例化即可服务任意规模
+    template <typename T>
+    using MatrixX = MatrixNM<T, Dynamic, Dynamic>;
+    using MatrixXf = MatrixX<Real>;
+    using MatrixXc = MatrixX<Complex>;
 }
\ No newline at end of file
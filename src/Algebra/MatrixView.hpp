@@ -0,0 +1,158 @@
+/**
+ * @file MatrixView.hpp
+ * @brief 矩阵子块、行、列与对角线视图：按跨度引用父矩阵的存储，不拷贝数据。
+ * @details 视图由 MatrixBase 的 block()、row()、col()、diagonal() 得到，元素 (i, j) 位于 data()[i * stride() + j]：
+ *          - block(i, j, r, c)、row(i)、col(j) 的跨度为父矩阵的行跨度；
+ *          - diagonal() 是 min(rows, cols)×1 的列，跨度为行跨度 + 1。
+ *          视图是普通的矩阵表达式，参与加减、数乘、逐元素函数与归约，实数元素时逐行以 SIMD 数据包求值；
+ *          作为乘法操作数时与矩阵一样
+ *          直接以"行步长/列步长"交给 GEMM 内核，不打包到临时矩阵。视图的视图仍是同一种视图。
+ *          视图不拥有存储，父矩阵析构或改变尺寸后视图失效。
+ */
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "MatrixBase.hpp"
+#include "MatrixExpr.hpp"
+#include "Assign.hpp"
+
+namespace OxygenMath
+{
+    /**
+     * @brief 矩阵视图
+     * @details 元素类型不带 const 时可以写入：对视图赋值（包括视图之间的赋值）把结果写回父矩阵的对应元素，
+     *          而不是让视图指向别处。右侧可以引用同一个父矩阵，例如 A.row(0) = A.row(1) + A.row(0)，
+     *          与视图重叠的部分由别名分析处理（见 Assign.hpp）。
+     * @tparam T 元素类型，只读视图为 const T
+     */
+    template <typename T>
+    class MatrixView : public MatrixExpr<MatrixView<T>>
+    {
+    public:
+        using Scalar = typename std::remove_const<T>::type;
+
+    private:
+        T *m_data;
+        size_t m_rows, m_cols, m_stride;
+
+        template <typename Expr>
+        MatrixView &assign(const Expr &expr)
+        {
+            static_assert(!std::is_const<T>::value, "Cannot assign to a read-only view");
+            if (expr.rows() != m_rows || expr.cols() != m_cols)
+                throw std::invalid_argument("View assignment requires an expression of the same dimensions");
+            internal::assignTo(m_data, m_stride, expr);
+            return *this;
+        }
+
+    public:
+        MatrixView(T *data, size_t rows, size_t cols, size_t stride)
+            : m_data(data), m_rows(rows), m_cols(cols), m_stride(stride) {}
+
+        MatrixView(const MatrixView &) = default;
+
+        // 可写视图可以隐式转换为只读视图
+        template <typename U,
+                  typename = typename std::enable_if<std::is_same<const U, T>::value && !std::is_same<U, T>::value>::type>
+        MatrixView(const MatrixView<U> &other)
+            : m_data(other.data()), m_rows(other.rows()), m_cols(other.cols()), m_stride(other.stride()) {}
+
+        size_t rows() const { return m_rows; }
+        size_t cols() const { return m_cols; }
+
+        // 相邻两行首元素之间的距离
+        size_t stride() const { return m_stride; }
+
+        T *data() const { return m_data; }
+
+        T &operator()(size_t i, size_t j) const { return m_data[i * m_stride + j]; }
+
+        MatrixView &operator=(const MatrixView &other) { return assign(other); }
+
+        template <typename Expr>
+        MatrixView &operator=(const MatrixBase<Expr> &expr) { return assign(expr.derived()); }
+
+        // 所有元素置为 value
+        void fill(const Scalar &value)
+        {
+            static_assert(!std::is_const<T>::value, "Cannot assign to a read-only view");
+            for (size_t i = 0; i < m_rows; ++i)
+                std::fill(m_data + i * m_stride, m_data + i * m_stride + m_cols, value);
+        }
+    };
+
+    namespace internal
+    {
+        /**
+         * @brief 在跨度为 stride 的 rows×cols 存储上截取视图
+         */
+        template <typename Element>
+        struct ViewFactory
+        {
+            static MatrixView<Element> block(Element *data, size_t stride, size_t rows, size_t cols,
+                                             size_t i, size_t j, size_t r, size_t c)
+            {
+                if (i > rows || r > rows - i || j > cols || c > cols - j)
+                    throw std::out_of_range("Block exceeds matrix bounds");
+                return MatrixView<Element>(data + i * stride + j, r, c, stride);
+            }
+
+            static MatrixView<Element> diagonal(Element *data, size_t stride, size_t rows, size_t cols)
+            {
+                return MatrixView<Element>(data, std::min(rows, cols), 1, stride + 1);
+            }
+        };
+
+        template <typename T, size_t Rows, size_t Cols>
+        struct ViewTraits<MatrixNM<T, Rows, Cols>>
+        {
+            using Element = T;
+            using ConstElement = const T;
+            using Matrix = MatrixNM<T, Rows, Cols>;
+
+            static MatrixView<T> block(Matrix &m, size_t i, size_t j, size_t r, size_t c)
+            {
+                return ViewFactory<T>::block(m.data(), m.cols(), m.rows(), m.cols(), i, j, r, c);
+            }
+            static MatrixView<const T> block(const Matrix &m, size_t i, size_t j, size_t r, size_t c)
+            {
+                return ViewFactory<const T>::block(m.data(), m.cols(), m.rows(), m.cols(), i, j, r, c);
+            }
+            static MatrixView<T> diagonal(Matrix &m)
+            {
+                return ViewFactory<T>::diagonal(m.data(), m.cols(), m.rows(), m.cols());
+            }
+            static MatrixView<const T> diagonal(const Matrix &m)
+            {
+                return ViewFactory<const T>::diagonal(m.data(), m.cols(), m.rows(), m.cols());
+            }
+        };
+
+        // 视图的视图：跨度不变，只读视图的子视图仍只读
+        template <typename T>
+        struct ViewTraits<MatrixView<T>>
+        {
+            using Element = T;
+            using ConstElement = const typename std::remove_const<T>::type;
+
+            static MatrixView<T> block(MatrixView<T> &v, size_t i, size_t j, size_t r, size_t c)
+            {
+                return ViewFactory<T>::block(v.data(), v.stride(), v.rows(), v.cols(), i, j, r, c);
+            }
+            static MatrixView<ConstElement> block(const MatrixView<T> &v, size_t i, size_t j, size_t r, size_t c)
+            {
+                return ViewFactory<ConstElement>::block(v.data(), v.stride(), v.rows(), v.cols(), i, j, r, c);
+            }
+            static MatrixView<T> diagonal(MatrixView<T> &v)
+            {
+                return ViewFactory<T>::diagonal(v.data(), v.stride(), v.rows(), v.cols());
+            }
+            static MatrixView<ConstElement> diagonal(const MatrixView<T> &v)
+            {
+                return ViewFactory<ConstElement>::diagonal(v.data(), v.stride(), v.rows(), v.cols());
+            }
+        };
+    }
+}
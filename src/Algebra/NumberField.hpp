@@ -8,6 +8,7 @@
 #pragma once
 #include <iostream>
 #include <cmath>
+#include <stdexcept>
 
 namespace OxygenMath
 {
@@ -35,164 +36,216 @@ namespace OxygenMath
         friend T operator/(const T &lhs, const T &rhs) { return lhs.div(rhs); }
     };
 
-    class Real : public NumberField<Real>
+    /**
+     * @brief 算术检查策略：除零、负数开方等非法运算抛出异常（默认）
+     */
+    struct CheckedArithmetic
+    {
+        static constexpr bool checked = true;
+    };
+
+    /**
+     * @brief 算术检查策略：完全遵循 IEEE 754，非法运算得到 inf/nan 而不抛异常
+     * @details 运算中没有分支，编译器可以像处理裸 double 一样自动向量化
+     *          （生成 vdivpd、vsqrtpd 等打包指令），适合 LU、迭代法等内层循环。
+     */
+    struct IEEEArithmetic
+    {
+        static constexpr bool checked = false;
+    };
+
+    /**
+     * @brief 实数域
+     * @tparam F 底层浮点类型
+     * @tparam Policy 算术检查策略，CheckedArithmetic 或 IEEEArithmetic
+     */
+    template <typename F, typename Policy = CheckedArithmetic>
+    class BasicReal : public NumberField<BasicReal<F, Policy>>
     {
     public:
-        double data;
+        F data;
+
+        BasicReal(F d = F(0)) : data(d) {}
 
-        Real(double d = 0.0) : data(d) {}
+        // 不同精度或检查策略之间需要显式转换
+        template <typename G, typename Q>
+        explicit BasicReal(const BasicReal<G, Q> &other) : data(static_cast<F>(other.data)) {}
 
         // Real + Real
-        Real add(const Real &other) const { return Real(data + other.data); }
+        BasicReal add(const BasicReal &other) const { return BasicReal(data + other.data); }
         // Real - Real
-        Real sub(const Real &other) const { return Real(data - other.data); }
+        BasicReal sub(const BasicReal &other) const { return BasicReal(data - other.data); }
         // Real * Real
-        Real mul(const Real &other) const { return Real(data * other.data); }
+        BasicReal mul(const BasicReal &other) const { return BasicReal(data * other.data); }
         // Real / Real
-        Real div(const Real &other) const
+        BasicReal div(const BasicReal &other) const
         {
-            if (other.data == 0.0)
+            if (Policy::checked && other.data == F(0))
                 throw std::invalid_argument("Division by zero");
-            return Real(data / other.data);
+            return BasicReal(data / other.data);
         }
         // 复合赋值运算符
-        Real &operator+=(const Real &other)
+        BasicReal &operator+=(const BasicReal &other)
         {
             data += other.data;
             return *this;
         }
-        Real &operator-=(const Real &other)
+        BasicReal &operator-=(const BasicReal &other)
         {
             data -= other.data;
             return *this;
         }
-        Real &operator*=(const Real &other)
+        BasicReal &operator*=(const BasicReal &other)
         {
             data *= other.data;
             return *this;
         }
-        Real &operator/=(const Real &other)
+        BasicReal &operator/=(const BasicReal &other)
         {
-            if (other.data == 0.0)
+            if (Policy::checked && other.data == F(0))
                 throw std::invalid_argument("Division by zero");
             data /= other.data;
             return *this;
         }
         // 逻辑运算符重载
-        bool operator>=(const Real &rhs) const { return data >= rhs.data; }
-        bool operator>(const Real &rhs) const { return data > rhs.data; }
-        bool operator<=(const Real &rhs) const { return data <= rhs.data; }
-        bool operator<(const Real &rhs) const { return data < rhs.data; }
-        bool operator==(const Real &rhs) const { return data == rhs.data; }
-        bool operator!=(const Real &rhs) const { return data != rhs.data; }
-        friend Real operator-(const Real &real) { return Real(-real.data); }
+        bool operator>=(const BasicReal &rhs) const { return data >= rhs.data; }
+        bool operator>(const BasicReal &rhs) const { return data > rhs.data; }
+        bool operator<=(const BasicReal &rhs) const { return data <= rhs.data; }
+        bool operator<(const BasicReal &rhs) const { return data < rhs.data; }
+        bool operator==(const BasicReal &rhs) const { return data == rhs.data; }
+        bool operator!=(const BasicReal &rhs) const { return data != rhs.data; }
+        friend BasicReal operator-(const BasicReal &real) { return BasicReal(-real.data); }
 
         // 支持 sqrt() 函数以提供L2范数
-        Real sqrt() const
+        BasicReal sqrt() const
         {
-            if (data < 0.0)
+            if (Policy::checked && data < F(0))
                 throw std::domain_error("Square root of negative number");
-            return Real(std::sqrt(data));
+            return BasicReal(std::sqrt(data));
         }
 
-        static Real zero() { return Real(0.0); }
-        static Real identity() { return Real(1.0); }
+        static BasicReal zero() { return BasicReal(F(0)); }
+        static BasicReal identity() { return BasicReal(F(1)); }
 
-        friend std::ostream &operator<<(std::ostream &os, const Real &r)
+        friend std::ostream &operator<<(std::ostream &os, const BasicReal &r)
         {
             os << r.data;
             return os;
         }
     };
 
-    class Complex : public NumberField<Complex>
+    /**
+     * @brief 复数域
+     * @tparam F 实部、虚部的底层浮点类型
+     * @tparam Policy 算术检查策略，CheckedArithmetic 或 IEEEArithmetic
+     */
+    template <typename F, typename Policy = CheckedArithmetic>
+    class BasicComplex : public NumberField<BasicComplex<F, Policy>>
     {
     public:
-        double real, imag;
+        F real, imag;
+
+        BasicComplex(F r = F(0), F i = F(0)) : real(r), imag(i) {}
 
-        Complex(double r = 0.0, double i = 0.0) : real(r), imag(i) {}
+        // 不同精度或检查策略之间需要显式转换
+        template <typename G, typename Q>
+        explicit BasicComplex(const BasicComplex<G, Q> &other)
+            : real(static_cast<F>(other.real)), imag(static_cast<F>(other.imag)) {}
 
         // Complex + Complex
-        Complex add(const Complex &other) const
+        BasicComplex add(const BasicComplex &other) const
         {
-            return Complex(real + other.real, imag + other.imag);
+            return BasicComplex(real + other.real, imag + other.imag);
         }
 
         // Complex - Complex
-        Complex sub(const Complex &other) const
+        BasicComplex sub(const BasicComplex &other) const
         {
-            return Complex(real - other.real, imag - other.imag);
+            return BasicComplex(real - other.real, imag - other.imag);
         }
 
         // Complex * Complex
-        Complex mul(const Complex &other) const
+        BasicComplex mul(const BasicComplex &other) const
         {
-            double r = real * other.real - imag * other.imag;
-            double i = real * other.imag + imag * other.real;
-            return Complex(r, i);
+            F r = real * other.real - imag * other.imag;
+            F i = real * other.imag + imag * other.real;
+            return BasicComplex(r, i);
         }
 
         // Complex / Complex
-        Complex div(const Complex &other) const
+        BasicComplex div(const BasicComplex &other) const
         {
-            double denom = other.real * other.real + other.imag * other.imag;
-            if (denom == 0.0)
+            F denom = other.real * other.real + other.imag * other.imag;
+            if (Policy::checked && denom == F(0))
                 throw std::invalid_argument("Division by zero");
 
-            double r = (real * other.real + imag * other.imag) / denom;
-            double i = (imag * other.real - real * other.imag) / denom;
-            return Complex(r, i);
+            F r = (real * other.real + imag * other.imag) / denom;
+            F i = (imag * other.real - real * other.imag) / denom;
+            return BasicComplex(r, i);
         }
         // 复合赋值运算符
-        Complex &operator+=(const Complex &other)
+        BasicComplex &operator+=(const BasicComplex &other)
         {
             real += other.real;
             imag += other.imag;
             return *this;
         }
 
-        Complex &operator-=(const Complex &other)
+        BasicComplex &operator-=(const BasicComplex &other)
         {
             real -= other.real;
             imag -= other.imag;
             return *this;
         }
 
-        Complex &operator*=(const Complex &other)
+        BasicComplex &operator*=(const BasicComplex &other)
         {
-            double r = real * other.real - imag * other.imag;
-            double i = real * other.imag + imag * other.real;
+            F r = real * other.real - imag * other.imag;
+            F i = real * other.imag + imag * other.real;
             real = r;
             imag = i;
             return *this;
         }
 
-        Complex &operator/=(const Complex &other)
+        BasicComplex &operator/=(const BasicComplex &other)
         {
-            double denom = other.real * other.real + other.imag * other.imag;
-            if (denom == 0.0)
+            F denom = other.real * other.real + other.imag * other.imag;
+            if (Policy::checked && denom == F(0))
                 throw std::invalid_argument("Division by zero");
 
-            double r = (real * other.real + imag * other.imag) / denom;
-            double i = (imag * other.real - real * other.imag) / denom;
+            F r = (real * other.real + imag * other.imag) / denom;
+            F i = (imag * other.real - real * other.imag) / denom;
             real = r;
             imag = i;
             return *this;
         }
-        Complex sqrt() const
+        bool operator==(const BasicComplex &rhs) const { return real == rhs.real && imag == rhs.imag; }
+        bool operator!=(const BasicComplex &rhs) const { return !(*this == rhs); }
+        friend BasicComplex operator-(const BasicComplex &c) { return BasicComplex(-c.real, -c.imag); }
+
+        BasicComplex sqrt() const
         {
-            double r = std::sqrt(std::sqrt(real * real + imag * imag));
-            double theta = std::atan2(imag, real) / 2.0;
-            return Complex(r * std::cos(theta), r * std::sin(theta));
+            F r = std::sqrt(std::sqrt(real * real + imag * imag));
+            F theta = std::atan2(imag, real) / F(2);
+            return BasicComplex(r * std::cos(theta), r * std::sin(theta));
         }
 
-        static Complex zero() { return Complex(0.0, 0.0); }
-        static Complex identity() { return Complex(1.0, 0.0); }
+        static BasicComplex zero() { return BasicComplex(F(0), F(0)); }
+        static BasicComplex identity() { return BasicComplex(F(1), F(0)); }
 
-        friend std::ostream &operator<<(std::ostream &os, const Complex &c)
+        friend std::ostream &operator<<(std::ostream &os, const BasicComplex &c)
         {
             os << c.real << (c.imag >= 0 ? "+" : "") << c.imag << "i";
             return os;
         }
     };
+
+    using Real = BasicReal<double, CheckedArithmetic>;
+    using Complex = BasicComplex<double, CheckedArithmetic>;
+    // 单精度实数与复数：SIMD 宽度翻倍、内存带宽减半，精度约 7 位有效数字
+    using Real32 = BasicReal<float, CheckedArithmetic>;
+    using Complex32 = BasicComplex<float, CheckedArithmetic>;
+    // 不做任何检查、行为与裸 double 完全一致的实数与复数
+    using RealIEEE = BasicReal<double, IEEEArithmetic>;
+    using ComplexIEEE = BasicComplex<double, IEEEArithmetic>;
 }
\ No newline at end of file
@@ -0,0 +1,437 @@
+/**
+ * @file QRKernel.hpp
+ * @brief 分块 Householder QR 分解内核（紧凑 WY 表示），以及不显式形成 Q 的 Q / Q^T 作用。
+ * @details 矩阵按行主序存储、行跨度为 ld。第 k 个反射为 H_k = I - tau_k * v_k * v_k^T，
+ *          v_k 的第 k 个分量为 1（不存储），其余分量存放在 A 第 k 列的对角线以下；R 存放在上三角。
+ *          与 LAPACK dgeqrf 相同，每次分解 NB 列宽的面板，再把面板内的 NB 个反射合并为
+ *          H_1 H_2 ... H_nb = I - V * T * V^T（T 为 nb×nb 上三角），尾部矩阵的更新
+ *          A2 -= V * (T^T * (V^T * A2)) 由两次 GEMM 完成。
+ *          面板内与少量右端项的计算只用栈上的 NB 长度工作数组，不分配堆内存。
+ */
+#pragma once
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+#include <type_traits>
+#include "LUKernel.hpp"
+
+namespace OxygenMath
+{
+    namespace internal
+    {
+        /**
+         * @brief 两个编译期维度中较小者，任一为 Dynamic 时结果为 Dynamic
+         */
+        template <size_t M, size_t N>
+        struct MinDimension
+        {
+            static constexpr size_t value = (M == Dynamic || N == Dynamic) ? Dynamic : (M < N ? M : N);
+        };
+
+        /**
+         * @brief 标量系数数组：定长时使用 std::array，Dynamic 时使用 std::vector
+         */
+        template <typename T, size_t K>
+        struct CoefficientArray
+        {
+            using type = std::array<T, K>;
+            static type make(size_t)
+            {
+                type a;
+                a.fill(T(0));
+                return a;
+            }
+        };
+
+        template <typename T>
+        struct CoefficientArray<T, Dynamic>
+        {
+            using type = std::vector<T>;
+            static type make(size_t n) { return type(n, T(0)); }
+        };
+
+        /**
+         * @brief 2-范数 sqrt(sum x[i]^2)（i 从 1 到 len - 1，不含首元素），不会因中间的平方上溢或下溢而失真
+         * @details 先直接累加平方和；结果上溢，或小到次正规数附近而丢失精度时，
+         *          改用 LAPACK dnrm2 的缩放累加（以当前最大绝对值为尺度）重新计算。
+         */
+        template <typename E>
+        E householderTailNorm(size_t len, const E *x, size_t stride)
+        {
+            E sum = E(0);
+            for (size_t i = 1; i < len; ++i)
+                sum += x[i * stride] * x[i * stride];
+            if (sum <= std::numeric_limits<E>::max() && sum >= std::numeric_limits<E>::min() / std::numeric_limits<E>::epsilon())
+                return std::sqrt(sum);
+            E scale = E(0), ssq = E(1);
+            for (size_t i = 1; i < len; ++i)
+            {
+                const E a = std::abs(x[i * stride]);
+                if (a == E(0))
+                    continue;
+                if (scale < a)
+                {
+                    ssq = E(1) + ssq * (scale / a) * (scale / a);
+                    scale = a;
+                }
+                else
+                    ssq += (a / scale) * (a / scale);
+            }
+            return scale * std::sqrt(ssq);
+        }
+
+        /**
+         * @brief 生成 Householder 反射（LAPACK dlarfg）：使 H * x = (beta, 0, ..., 0)^T
+         * @param len 向量长度
+         * @param x 向量首元素地址，元素间隔为 stride；返回时 x[0] = beta，其余为 v 的第 2 个分量起的部分
+         * @param stride 元素间隔
+         * @return tau；x 已在第一个分量之后全为 0 时返回 0（H = I）
+         */
+        template <typename E>
+        E householder(size_t len, E *x, size_t stride)
+        {
+            const E xnorm = householderTailNorm(len, x, stride);
+            if (xnorm == E(0))
+                return E(0);
+            const E alpha = x[0];
+            const E beta = -std::copysign(std::hypot(alpha, xnorm), alpha);
+            // |alpha - beta| >= |beta|；只有它小于最小正规数时倒数才会上溢，此时改为逐个相除
+            const E denom = alpha - beta;
+            if (std::abs(denom) >= std::numeric_limits<E>::min())
+            {
+                const E scale = E(1) / denom;
+                for (size_t i = 1; i < len; ++i)
+                    x[i * stride] *= scale;
+            }
+            else
+                for (size_t i = 1; i < len; ++i)
+                    x[i * stride] /= denom;
+            x[0] = beta;
+            return (beta - alpha) / beta;
+        }
+
+        /**
+         * @brief 点积 sum(x[i] * y[i])，用 Packet 累加以避免标量加法的依赖链
+         */
+        template <typename E>
+        E packetDot(size_t n, const E *x, const E *y)
+        {
+            typedef simd::Packet<E> P;
+            typename P::type acc0 = P::zero(), acc1 = P::zero();
+            size_t i = 0;
+            for (; i + 2 * P::size <= n; i += 2 * P::size)
+            {
+                acc0 = P::fmadd(P::loadu(x + i), P::loadu(y + i), acc0);
+                acc1 = P::fmadd(P::loadu(x + i + P::size), P::loadu(y + i + P::size), acc1);
+            }
+            alignas(64) E lanes[P::size];
+            P::store(lanes, P::add(acc0, acc1));
+            E sum = E(0);
+            for (size_t l = 0; l < P::size; ++l)
+                sum += lanes[l];
+            for (; i < n; ++i)
+                sum += x[i] * y[i];
+            return sum;
+        }
+
+        /**
+         * @brief 依次把反射 H_k（k 从 k0 到 k1 - 1，reverse 为 true 时倒序）作用到 B（m×ncols，行跨度 ldb）的所有列
+         * @details V 为反射向量所在矩阵（行跨度 ldv），v_k 位于第 k 列的第 k + 1 行起。
+         *          按 NB 列分段，每段用栈上的 w = v^T * B 计算 B -= tau * v * w，内层循环连续访问 B 的行。
+         */
+        template <typename E, typename Tau>
+        void applyReflectors(size_t m, const E *V, size_t ldv, const Tau &tau, size_t k0, size_t k1,
+                             E *B, size_t ldb, size_t ncols, bool reverse)
+        {
+            E w[LUBlockSize];
+            for (size_t c0 = 0; c0 < ncols; c0 += LUBlockSize)
+            {
+                const size_t nc = std::min(ncols - c0, LUBlockSize);
+                for (size_t step = 0; step < k1 - k0; ++step)
+                {
+                    const size_t k = reverse ? k1 - 1 - step : k0 + step;
+                    const E t = tau[k];
+                    if (t == E(0))
+                        continue;
+                    E *rowK = B + k * ldb + c0;
+                    for (size_t j = 0; j < nc; ++j)
+                        w[j] = rowK[j];
+                    for (size_t i = k + 1; i < m; ++i)
+                    {
+                        const E vi = V[i * ldv + k];
+                        const E *rowI = B + i * ldb + c0;
+                        for (size_t j = 0; j < nc; ++j)
+                            w[j] += vi * rowI[j];
+                    }
+                    for (size_t j = 0; j < nc; ++j)
+                    {
+                        w[j] *= t;
+                        rowK[j] -= w[j];
+                    }
+                    for (size_t i = k + 1; i < m; ++i)
+                    {
+                        const E vi = V[i * ldv + k];
+                        E *rowI = B + i * ldb + c0;
+                        for (size_t j = 0; j < nc; ++j)
+                            rowI[j] -= vi * w[j];
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief 与 applyReflectors 相同，但先把每组 NB 个反射向量按列连续复制到 Vc 再作用
+         * @details 大矩阵的一列跨越许多内存页，右端项很少时逐个反射按列读取 V 会被 TLB 缺失拖慢；
+         *          按行读取并转置复制后，每个反射只需顺序扫描一段连续内存。
+         * @param Vc 工作区，至少 (m - k0) * NB 个元素
+         */
+        template <typename E, typename Tau>
+        void applyReflectorsPacked(size_t m, const E *V, size_t ldv, const Tau &tau, size_t kmax,
+                                   E *B, size_t ldb, size_t ncols, bool reverse, E *Vc)
+        {
+            const size_t blocks = (kmax + LUBlockSize - 1) / LUBlockSize;
+            for (size_t b = 0; b < blocks; ++b)
+            {
+                const size_t j0 = (reverse ? blocks - 1 - b : b) * LUBlockSize;
+                const size_t j1 = std::min(kmax, j0 + LUBlockSize);
+                const size_t nb = j1 - j0, mm = m - j0;
+                // 按 16 行一组转置，读写两侧同时只涉及少量缓存行与内存页
+                for (size_t i0 = j0 + 1; i0 < m; i0 += 16)
+                {
+                    const size_t i1 = std::min(m, i0 + 16);
+                    for (size_t c = 0; c < nb; ++c)
+                        for (size_t i = std::max(i0, j0 + c + 1); i < i1; ++i)
+                            Vc[c * mm + (i - j0)] = V[i * ldv + j0 + c];
+                }
+                for (size_t step = 0; step < nb; ++step)
+                {
+                    const size_t c = reverse ? nb - 1 - step : step;
+                    const size_t k = j0 + c;
+                    const E t = tau[k];
+                    if (t == E(0))
+                        continue;
+                    const E *v = Vc + c * mm - j0;
+                    if (ncols == 1)
+                    {
+                        // 单个右端项：点积用 4 个独立累加器打断加法依赖链
+                        E s0 = B[k * ldb], s1 = E(0), s2 = E(0), s3 = E(0);
+                        size_t i = k + 1;
+                        for (; i + 4 <= m; i += 4)
+                        {
+                            s0 += v[i] * B[i * ldb];
+                            s1 += v[i + 1] * B[(i + 1) * ldb];
+                            s2 += v[i + 2] * B[(i + 2) * ldb];
+                            s3 += v[i + 3] * B[(i + 3) * ldb];
+                        }
+                        for (; i < m; ++i)
+                            s0 += v[i] * B[i * ldb];
+                        const E w = t * ((s0 + s1) + (s2 + s3));
+                        B[k * ldb] -= w;
+                        for (i = k + 1; i < m; ++i)
+                            B[i * ldb] -= v[i] * w;
+                        continue;
+                    }
+                    for (size_t c0 = 0; c0 < ncols; c0 += LUBlockSize)
+                    {
+                        const size_t nc = std::min(ncols - c0, LUBlockSize);
+                        E w[LUBlockSize];
+                        E *rowK = B + k * ldb + c0;
+                        for (size_t j = 0; j < nc; ++j)
+                            w[j] = rowK[j];
+                        for (size_t i = k + 1; i < m; ++i)
+                        {
+                            const E vi = v[i];
+                            const E *rowI = B + i * ldb + c0;
+                            for (size_t j = 0; j < nc; ++j)
+                                w[j] += vi * rowI[j];
+                        }
+                        for (size_t j = 0; j < nc; ++j)
+                        {
+                            w[j] *= t;
+                            rowK[j] -= w[j];
+                        }
+                        for (size_t i = k + 1; i < m; ++i)
+                        {
+                            const E vi = v[i];
+                            E *rowI = B + i * ldb + c0;
+                            for (size_t j = 0; j < nc; ++j)
+                                rowI[j] -= vi * w[j];
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief 第 [k0, k1) 个反射的紧凑 WY 表示（LAPACK dlarft，前向、按列存储）
+         * @param Vd 输出：反射向量的稠密副本，(m - k0)×nb 行主序，含单位对角线与其上方的 0
+         * @param T 输出：nb×nb 上三角矩阵（行跨度 LUBlockSize），H_k0 ... H_(k1-1) = I - Vd * T * Vd^T
+         */
+        template <typename E, typename Tau>
+        void buildBlockReflector(size_t m, const E *V, size_t ldv, const Tau &tau, size_t k0, size_t k1, E *Vd, E *T)
+        {
+            const size_t nb = k1 - k0;
+            for (size_t i = k0; i < m; ++i)
+            {
+                E *row = Vd + (i - k0) * nb;
+                for (size_t c = 0; c < nb; ++c)
+                {
+                    const size_t k = k0 + c;
+                    row[c] = i < k ? E(0) : (i == k ? E(1) : V[i * ldv + k]);
+                }
+            }
+
+            E z[LUBlockSize];
+            for (size_t c = 0; c < nb; ++c)
+            {
+                // z = Vd[:, 0:c]^T * Vd[:, c]
+                for (size_t r = 0; r < c; ++r)
+                    z[r] = E(0);
+                for (size_t i = k0 + c; i < m; ++i)
+                {
+                    const E *row = Vd + (i - k0) * nb;
+                    for (size_t r = 0; r < c; ++r)
+                        z[r] += row[r] * row[c];
+                }
+                // T[0:c, c] = -tau_c * T[0:c, 0:c] * z
+                const E t = tau[k0 + c];
+                for (size_t r = 0; r < c; ++r)
+                {
+                    E sum = E(0);
+                    for (size_t p = r; p < c; ++p)
+                        sum += T[r * LUBlockSize + p] * z[p];
+                    T[r * LUBlockSize + c] = -t * sum;
+                }
+                T[c * LUBlockSize + c] = t;
+                for (size_t r = c + 1; r < nb; ++r)
+                    T[r * LUBlockSize + c] = E(0);
+            }
+        }
+
+        /**
+         * @brief 把块反射 I - Vd * T * Vd^T（transpose 为 true 时为其转置）作用到 B（mm×ncols，行跨度 ldb）
+         * @param W 工作区，至少 nb * ncols 个元素
+         */
+        template <typename E>
+        void applyBlockReflector(size_t mm, size_t nb, const E *Vd, const E *T, E *B, size_t ldb, size_t ncols,
+                                 bool transpose, E *W)
+        {
+            // W = Vd^T * B
+            gemm<E>(nb, ncols, mm, E(1), Vd, 1, nb, B, ldb, 1, E(0), W, ncols);
+            // W = T^T * W（下三角，自下而上）或 W = T * W（上三角，自上而下）
+            if (transpose)
+            {
+                for (size_t i = nb; i-- > 0;)
+                {
+                    E *rowI = W + i * ncols;
+                    const E tii = T[i * LUBlockSize + i];
+                    for (size_t j = 0; j < ncols; ++j)
+                        rowI[j] *= tii;
+                    for (size_t r = 0; r < i; ++r)
+                    {
+                        const E tri = T[r * LUBlockSize + i];
+                        const E *rowR = W + r * ncols;
+                        for (size_t j = 0; j < ncols; ++j)
+                            rowI[j] += tri * rowR[j];
+                    }
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < nb; ++i)
+                {
+                    E *rowI = W + i * ncols;
+                    const E tii = T[i * LUBlockSize + i];
+                    for (size_t j = 0; j < ncols; ++j)
+                        rowI[j] *= tii;
+                    for (size_t r = i + 1; r < nb; ++r)
+                    {
+                        const E tir = T[i * LUBlockSize + r];
+                        const E *rowR = W + r * ncols;
+                        for (size_t j = 0; j < ncols; ++j)
+                            rowI[j] += tir * rowR[j];
+                    }
+                }
+            }
+            // B -= Vd * W
+            gemm<E>(mm, ncols, nb, E(-1), Vd, nb, 1, W, ncols, 1, E(1), B, ldb);
+        }
+
+        /**
+         * @brief 原地分块 Householder QR 分解 A = Q * R
+         * @param m 行数
+         * @param n 列数
+         * @param A 行主序矩阵，返回时上三角为 R，对角线以下为反射向量
+         * @param ld 行跨度
+         * @param tau 长度为 min(m, n) 的反射系数（可按下标写入的指针或迭代器）
+         */
+        template <typename E, typename Tau>
+        void qrFactor(size_t m, size_t n, E *A, size_t ld, Tau tau)
+        {
+            static_assert(std::is_floating_point<E>::value, "QR decomposition requires a real floating-point scalar type");
+            const size_t kmax = std::min(m, n);
+            std::vector<E> Vd, W;
+            std::vector<E> T;
+            for (size_t j0 = 0; j0 < kmax; j0 += LUBlockSize)
+            {
+                const size_t j1 = std::min(kmax, j0 + LUBlockSize);
+                const size_t panelEnd = std::min(n, j0 + LUBlockSize);
+
+                // 面板内逐列生成反射并作用到面板剩余的列
+                for (size_t k = j0; k < j1; ++k)
+                {
+                    tau[k] = householder(m - k, A + k * ld + k, ld);
+                    if (k + 1 < panelEnd)
+                        applyReflectors(m, A, ld, tau, k, k + 1, A + k + 1, ld, panelEnd - k - 1, false);
+                }
+
+                // 尾部 A[j0:m, panelEnd:n] 用块反射更新
+                if (panelEnd < n)
+                {
+                    const size_t nb = j1 - j0, mm = m - j0, ncols = n - panelEnd;
+                    Vd.resize(mm * nb);
+                    T.resize(LUBlockSize * LUBlockSize);
+                    W.resize(nb * ncols);
+                    buildBlockReflector(m, A, ld, tau, j0, j1, Vd.data(), T.data());
+                    applyBlockReflector(mm, nb, Vd.data(), T.data(), A + j0 * ld + panelEnd, ld, ncols, true, W.data());
+                }
+            }
+        }
+
+        /**
+         * @brief 把 Q（transpose 为 false）或 Q^T（transpose 为 true）作用到 B（m×nrhs，行跨度 ldb）
+         * @details 右端项不少于 LUSolveGemmColumns 列时按 NB 个反射一组使用块反射与 GEMM，否则逐个反射作用；
+         *          后者在矩阵不超过 NB×NB 时直接按列读取反射向量，不分配内存。
+         */
+        template <typename E, typename Tau>
+        void qrApplyQ(size_t m, size_t kmax, const E *QR, size_t ld, const Tau &tau, E *B, size_t nrhs, size_t ldb, bool transpose)
+        {
+            if (nrhs < LUSolveGemmColumns)
+            {
+                if (m * kmax <= LUBlockSize * LUBlockSize)
+                {
+                    applyReflectors(m, QR, ld, tau, 0, kmax, B, ldb, nrhs, !transpose);
+                    return;
+                }
+                std::vector<E> Vc(m * LUBlockSize);
+                applyReflectorsPacked(m, QR, ld, tau, kmax, B, ldb, nrhs, !transpose, Vc.data());
+                return;
+            }
+            std::vector<E> Vd, W(LUBlockSize * nrhs), T(LUBlockSize * LUBlockSize);
+            const size_t blocks = (kmax + LUBlockSize - 1) / LUBlockSize;
+            for (size_t b = 0; b < blocks; ++b)
+            {
+                // Q^T = H_k ... H_1：从第一组开始；Q = H_1 ... H_k：从最后一组开始
+                const size_t j0 = (transpose ? b : blocks - 1 - b) * LUBlockSize;
+                const size_t j1 = std::min(kmax, j0 + LUBlockSize);
+                const size_t nb = j1 - j0, mm = m - j0;
+                Vd.resize(mm * nb);
+                buildBlockReflector(m, QR, ld, tau, j0, j1, Vd.data(), T.data());
+                applyBlockReflector(mm, nb, Vd.data(), T.data(), B + j0 * ldb, ldb, nrhs, transpose, W.data());
+            }
+        }
+    }
+}
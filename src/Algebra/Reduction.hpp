@@ -0,0 +1,386 @@
+/**
+ * @file Reduction.hpp
+ * @brief 表达式上的惰性归约：sum、squaredNorm、norm、lpNorm、maxCoeff/minCoeff、dot。
+ * @details 归约直接作用在表达式树上，与逐元素运算融合成一遍扫描，不生成中间矩阵，
+ *          例如 (A - B).norm() 只读取一次 A 与 B：
+ *          - 表达式可线性访问（见 Assign.hpp 中的 LinearEvaluator）时，以 SIMD 数据包为单位累积，
+ *            每块使用四个累加寄存器；叶子都连续时按一维下标遍历，含视图时逐行遍历；
+ *          - 其余实数表达式（含转置等）通过求值器逐元素累积；
+ *          - 非实数元素（复数）只支持 sum 与 dot，按元素类型的加法与乘法累积。
+ *          maxCoeff/minCoeff 与 lpNorm(∞) 传播 NaN：含 NaN 时结果为 NaN，与 NaN 的位置及 SIMD 宽度无关。
+ *          元素个数超过 ParallelReduceGrain 时由 parallelReduce 分块并行，
+ *          分块只取决于规模与线程数，因此线程数不变时结果可重复。
+ */
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include "NumberField.hpp"
+#include "MatrixExpr.hpp"
+#include "Simd.hpp"
+#include "Assign.hpp"
+#include "../Parallel/ParallelFor.hpp"
+
+namespace OxygenMath
+{
+    namespace internal
+    {
+        /**
+         * @brief 归约算子：packet 把一个数据包累积到数据包累加器，scalar 累积一个元素，
+         *        mergePacket / merge 合并两个累加器
+         */
+        template <typename F>
+        struct SumReduce
+        {
+            using Value = F;
+            using P = simd::Packet<F>;
+            F identity() const { return F(0); }
+            typename P::type packet(typename P::type acc, typename P::type x) const { return P::add(acc, x); }
+            F scalar(F acc, F x) const { return acc + x; }
+            typename P::type mergePacket(typename P::type a, typename P::type b) const { return P::add(a, b); }
+            F merge(F a, F b) const { return a + b; }
+        };
+
+        template <typename F>
+        struct SquaredNormReduce : SumReduce<F>
+        {
+            using P = simd::Packet<F>;
+            typename P::type packet(typename P::type acc, typename P::type x) const { return P::fmadd(x, x, acc); }
+            F scalar(F acc, F x) const { return acc + x * x; }
+        };
+
+        template <typename F>
+        struct AbsSumReduce : SumReduce<F>
+        {
+            using P = simd::Packet<F>;
+            typename P::type packet(typename P::type acc, typename P::type x) const { return P::add(acc, P::abs(x)); }
+            F scalar(F acc, F x) const { return acc + std::abs(x); }
+        };
+
+        // Σ|x|^p：数据包逐分量调用 std::pow
+        template <typename F>
+        struct PowSumReduce : SumReduce<F>
+        {
+            using P = simd::Packet<F>;
+            F p;
+            explicit PowSumReduce(F power) : p(power) {}
+            typename P::type packet(typename P::type acc, typename P::type x) const
+            {
+                alignas(64) F lanes[P::size];
+                P::store(lanes, P::abs(x));
+                for (size_t l = 0; l < P::size; ++l)
+                    lanes[l] = std::pow(lanes[l], p);
+                return P::add(acc, P::load(lanes));
+            }
+            F scalar(F acc, F x) const { return acc + std::pow(std::abs(x), p); }
+        };
+
+        /**
+         * @brief 传播 NaN 的 max/min：任一操作数为 NaN 时结果为 NaN
+         * @details P::max(b, a) 在含 NaN 时取 a（与 SSE/AVX 的 maxpd 相同），因此 a 为 NaN 时已得到 NaN；
+         *          再用 b <= b 不成立挑出 b 为 NaN 的分量。数据包与循环尾部（ScalarPacket）走同一套规则，
+         *          结果与 NaN 所在位置、数据包宽度无关。
+         */
+        template <typename P>
+        typename P::type maxPropagateNaN(typename P::type a, typename P::type b)
+        {
+            return P::selectLessEq(b, b, P::max(b, a), b);
+        }
+
+        template <typename P>
+        typename P::type minPropagateNaN(typename P::type a, typename P::type b)
+        {
+            return P::selectLessEq(b, b, P::min(b, a), b);
+        }
+
+        template <typename F>
+        struct MaxAbsReduce
+        {
+            using Value = F;
+            using P = simd::Packet<F>;
+            using S = simd::ScalarPacket<F>;
+            F identity() const { return F(0); }
+            typename P::type packet(typename P::type acc, typename P::type x) const { return maxPropagateNaN<P>(acc, P::abs(x)); }
+            F scalar(F acc, F x) const { return maxPropagateNaN<S>(acc, std::abs(x)); }
+            typename P::type mergePacket(typename P::type a, typename P::type b) const { return maxPropagateNaN<P>(a, b); }
+            F merge(F a, F b) const { return maxPropagateNaN<S>(a, b); }
+        };
+
+        template <typename F>
+        struct MaxReduce
+        {
+            using Value = F;
+            using P = simd::Packet<F>;
+            using S = simd::ScalarPacket<F>;
+            F identity() const { return -std::numeric_limits<F>::infinity(); }
+            typename P::type packet(typename P::type acc, typename P::type x) const { return maxPropagateNaN<P>(acc, x); }
+            F scalar(F acc, F x) const { return maxPropagateNaN<S>(acc, x); }
+            typename P::type mergePacket(typename P::type a, typename P::type b) const { return maxPropagateNaN<P>(a, b); }
+            F merge(F a, F b) const { return maxPropagateNaN<S>(a, b); }
+        };
+
+        template <typename F>
+        struct MinReduce
+        {
+            using Value = F;
+            using P = simd::Packet<F>;
+            using S = simd::ScalarPacket<F>;
+            F identity() const { return std::numeric_limits<F>::infinity(); }
+            typename P::type packet(typename P::type acc, typename P::type x) const { return minPropagateNaN<P>(acc, x); }
+            F scalar(F acc, F x) const { return minPropagateNaN<S>(acc, x); }
+            typename P::type mergePacket(typename P::type a, typename P::type b) const { return minPropagateNaN<P>(a, b); }
+            F merge(F a, F b) const { return minPropagateNaN<S>(a, b); }
+        };
+
+        // 两个可线性访问的表达式的逐元素乘积，用于点积
+        template <typename Lhs, typename Rhs>
+        struct LinearProduct
+        {
+            using F = typename LinearEvaluator<Lhs>::F;
+            using P = simd::Packet<F>;
+            LinearEvaluator<Lhs> lhs;
+            LinearEvaluator<Rhs> rhs;
+            LinearProduct(const Lhs &l, const Rhs &r) : lhs(l), rhs(r) {}
+            F coeff(size_t k) const { return lhs.coeff(k) * rhs.coeff(k); }
+            typename P::type packet(size_t k) const { return P::mul(lhs.packet(k), rhs.packet(k)); }
+            F coeff(size_t i, size_t j) const { return lhs.coeff(i, j) * rhs.coeff(i, j); }
+            typename P::type packet(size_t i, size_t j) const { return P::mul(lhs.packet(i, j), rhs.packet(i, j)); }
+            bool contiguous(size_t r, size_t c) const { return lhs.contiguous(r, c) && rhs.contiguous(r, c); }
+        };
+
+        // 线性访问求值器的第 i 行，按行内下标读取
+        template <typename Ev>
+        struct LinearRow
+        {
+            using F = typename Ev::F;
+            using P = simd::Packet<F>;
+            const Ev &ev;
+            size_t i;
+            F coeff(size_t j) const { return ev.coeff(i, j); }
+            typename P::type packet(size_t j) const { return ev.packet(i, j); }
+        };
+
+        // 两个表达式的逐元素乘积，按 (i, j) 访问
+        template <typename Lhs, typename Rhs>
+        struct EvaluatorProduct
+        {
+            Evaluator<Lhs> lhs;
+            Evaluator<Rhs> rhs;
+            EvaluatorProduct(const Lhs &l, const Rhs &r) : lhs(l), rhs(r) {}
+            auto coeff(size_t i, size_t j) const -> decltype(lhs.coeff(i, j) * rhs.coeff(i, j))
+            {
+                return lhs.coeff(i, j) * rhs.coeff(i, j);
+            }
+        };
+
+        /**
+         * @brief 在线性下标区间 [k0, k1) 上归约，四个数据包累加器交替累积以隐藏加法延迟
+         */
+        template <typename F, typename Op, typename Ev>
+        F linearReduceBlock(const Op &op, const Ev &ev, size_t k0, size_t k1)
+        {
+            typedef simd::Packet<F> P;
+            const typename P::type init = P::set1(op.identity());
+            typename P::type acc0 = init, acc1 = init, acc2 = init, acc3 = init;
+            size_t k = k0;
+            for (; k + 4 * P::size <= k1; k += 4 * P::size)
+            {
+                acc0 = op.packet(acc0, ev.packet(k));
+                acc1 = op.packet(acc1, ev.packet(k + P::size));
+                acc2 = op.packet(acc2, ev.packet(k + 2 * P::size));
+                acc3 = op.packet(acc3, ev.packet(k + 3 * P::size));
+            }
+            for (; k + P::size <= k1; k += P::size)
+                acc0 = op.packet(acc0, ev.packet(k));
+            acc0 = op.mergePacket(op.mergePacket(acc0, acc1), op.mergePacket(acc2, acc3));
+
+            alignas(64) F lanes[P::size];
+            P::store(lanes, acc0);
+            F result = lanes[0];
+            for (size_t l = 1; l < P::size; ++l)
+                result = op.merge(result, lanes[l]);
+            for (; k < k1; ++k)
+                result = op.scalar(result, ev.coeff(k));
+            return result;
+        }
+
+        template <typename F, typename Op, typename Ev>
+        F linearReduce(const Op &op, const Ev &ev, size_t n)
+        {
+            return parallelReduce(size_t(0), n, ParallelReduceGrain, op.identity(),
+                                  [&](size_t k0, size_t k1)
+                                  { return linearReduceBlock<F>(op, ev, k0, k1); },
+                                  [&](F a, F b)
+                                  { return op.merge(a, b); });
+        }
+
+        // 叶子不连续（视图）时逐行以数据包归约，按行分块并行
+        template <typename F, typename Op, typename Ev>
+        F rowReduce(const Op &op, const Ev &ev, size_t r, size_t c)
+        {
+            return parallelReduce(size_t(0), r, std::max<size_t>(1, ParallelReduceGrain / std::max<size_t>(c, 1)), op.identity(),
+                                  [&](size_t i0, size_t i1)
+                                  {
+                                      F result = op.identity();
+                                      for (size_t i = i0; i < i1; ++i)
+                                          result = op.merge(result, linearReduceBlock<F>(op, LinearRow<Ev>{ev, i}, 0, c));
+                                      return result;
+                                  },
+                                  [&](F a, F b)
+                                  { return op.merge(a, b); });
+        }
+
+        // 可线性访问的表达式：叶子都连续时按一维下标归约，否则逐行归约
+        template <typename F, typename Op, typename Ev>
+        F linearReduce(const Op &op, const Ev &ev, size_t r, size_t c)
+        {
+            return ev.contiguous(r, c) ? linearReduce<F>(op, ev, r * c) : rowReduce<F>(op, ev, r, c);
+        }
+
+        // 逐元素归约（元素为实数），按行分块并行
+        template <typename F, typename Op, typename Ev>
+        F coeffReduce(const Op &op, const Ev &ev, size_t r, size_t c)
+        {
+            typedef typename std::remove_cv<typename std::remove_reference<decltype(ev.coeff(0, 0))>::type>::type T;
+            return parallelReduce(size_t(0), r, std::max<size_t>(1, ParallelReduceGrain / std::max<size_t>(c, 1)), op.identity(),
+                                  [&](size_t i0, size_t i1)
+                                  {
+                                      F result = op.identity();
+                                      for (size_t i = i0; i < i1; ++i)
+                                          for (size_t j = 0; j < c; ++j)
+                                              result = op.scalar(result, T(ev.coeff(i, j)).data);
+                                      return result;
+                                  },
+                                  [&](F a, F b)
+                                  { return op.merge(a, b); });
+        }
+
+        // 逐元素求和（任意元素类型），按行分块并行
+        template <typename T, typename Ev>
+        T coeffSum(const Ev &ev, size_t r, size_t c)
+        {
+            return parallelReduce(size_t(0), r, std::max<size_t>(1, ParallelReduceGrain / std::max<size_t>(c, 1)), T::zero(),
+                                  [&](size_t i0, size_t i1)
+                                  {
+                                      T result = T::zero();
+                                      for (size_t i = i0; i < i1; ++i)
+                                          for (size_t j = 0; j < c; ++j)
+                                              result += ev.coeff(i, j);
+                                      return result;
+                                  },
+                                  [](const T &a, const T &b)
+                                  { return a + b; });
+        }
+
+        /**
+         * @brief 表达式归约的实现，由 MatrixBase 的 sum()、norm() 等成员调用
+         */
+        template <typename E>
+        struct Reduction
+        {
+            using Scalar = typename ExprTraits<E>::Scalar;
+
+            // 实数元素：按算子 Op 归约，可线性访问时走数据包路径
+            template <typename Op>
+            static Scalar reduce(const E &e, const Op &op)
+            {
+                static_assert(RawScalar<Scalar>::value, "This reduction requires real (Real or Real32) elements");
+                return Scalar(reduceRaw(e, op, std::integral_constant<bool, LinearEvaluator<E>::value>()));
+            }
+
+            template <typename Op>
+            static typename Op::Value reduceRaw(const E &e, const Op &op, std::true_type)
+            {
+                LinearEvaluator<E> ev(e);
+                return linearReduce<typename Op::Value>(op, ev, e.rows(), e.cols());
+            }
+
+            template <typename Op>
+            static typename Op::Value reduceRaw(const E &e, const Op &op, std::false_type)
+            {
+                Evaluator<E> ev(e);
+                return coeffReduce<typename Op::Value>(op, ev, e.rows(), e.cols());
+            }
+
+            static Scalar sum(const E &e)
+            {
+                return sum(e, std::integral_constant<bool, RawScalar<Scalar>::value>());
+            }
+
+            static Scalar sum(const E &e, std::true_type)
+            {
+                return reduce(e, SumReduce<typename RawScalar<Scalar>::type>());
+            }
+
+            static Scalar sum(const E &e, std::false_type)
+            {
+                Evaluator<E> ev(e);
+                return coeffSum<Scalar>(ev, e.rows(), e.cols());
+            }
+
+            static Scalar squaredNorm(const E &e)
+            {
+                return reduce(e, SquaredNormReduce<typename RawScalar<Scalar>::type>());
+            }
+
+            static Scalar norm(const E &e)
+            {
+                return Scalar(std::sqrt(squaredNorm(e).data));
+            }
+
+            static Scalar lpNorm(const E &e, double p)
+            {
+                typedef typename RawScalar<Scalar>::type F;
+                if (!(p > 0))
+                    throw std::invalid_argument("lpNorm requires p > 0");
+                if (p == std::numeric_limits<double>::infinity())
+                    return reduce(e, MaxAbsReduce<F>());
+                if (p == 1)
+                    return reduce(e, AbsSumReduce<F>());
+                if (p == 2)
+                    return norm(e);
+                return Scalar(std::pow(reduce(e, PowSumReduce<F>(static_cast<F>(p))).data, F(1) / static_cast<F>(p)));
+            }
+
+            static Scalar maxCoeff(const E &e)
+            {
+                if (e.rows() * e.cols() == 0)
+                    throw std::invalid_argument("maxCoeff of an empty matrix");
+                return reduce(e, MaxReduce<typename RawScalar<Scalar>::type>());
+            }
+
+            static Scalar minCoeff(const E &e)
+            {
+                if (e.rows() * e.cols() == 0)
+                    throw std::invalid_argument("minCoeff of an empty matrix");
+                return reduce(e, MinReduce<typename RawScalar<Scalar>::type>());
+            }
+
+            template <typename Other>
+            static Scalar dot(const E &e, const Other &other)
+            {
+                if (!(e.rows() == other.rows() && e.cols() == other.cols()))
+                    throw std::invalid_argument("dot requires expressions of the same dimensions");
+                return dot(e, other, std::integral_constant<bool, LinearPair<E, Other>::value>());
+            }
+
+            template <typename Other>
+            static Scalar dot(const E &e, const Other &other, std::true_type)
+            {
+                typedef typename RawScalar<Scalar>::type F;
+                LinearProduct<E, Other> ev(e, other);
+                return Scalar(linearReduce<F>(SumReduce<F>(), ev, e.rows(), e.cols()));
+            }
+
+            template <typename Other>
+            static Scalar dot(const E &e, const Other &other, std::false_type)
+            {
+                EvaluatorProduct<E, Other> ev(e, other);
+                return coeffSum<Scalar>(ev, e.rows(), e.cols());
+            }
+        };
+    }
+}
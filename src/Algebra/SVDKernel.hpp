@@ -0,0 +1,403 @@
+/**
+ * @file SVDKernel.hpp
+ * @brief 奇异值分解内核：Householder 双对角化 + Golub-Kahan 隐式位移 QR，以及随机化截断 SVD。
+ * @details 矩阵按行主序存储。m > n 时先做 QR 分解，只对 n×n 的 R 求 SVD（与 LAPACK dgesvd 的做法相同），
+ *          m < n 时对 A^T 求解后交换 U、V。
+ *          与对称特征分解相同，左右奇异向量在内部按行保存（U^T、V^T），Givens 旋转只组合两个连续的行。
+ *          随机化 SVD（Halko, Martinsson, Tropp）只需对 A 做少量 GEMM，再对 (k + p)×n 的小矩阵求完整 SVD。
+ */
+#pragma once
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include "QRKernel.hpp"
+
+namespace OxygenMath
+{
+    namespace internal
+    {
+        // 双对角 QR 迭代中每个奇异值允许的最大迭代次数
+        constexpr size_t SVDMaxIterations = 75;
+
+        /**
+         * @brief 把 n×n 方阵 A 化为上双对角矩阵 B = U_b^T * A * V_b
+         * @details 第 k 个左反射保存在第 k 列第 k + 1 行起（与 QR 相同的布局），
+         *          第 k 个右反射保存在第 k 行第 k + 2 列起（第 k + 1 个分量为 1，不存储）。
+         * @param d 输出 n 个对角元
+         * @param e 输出 n - 1 个上次对角元，e[n - 1] 置 0
+         * @param tauL n 个左反射系数
+         * @param tauR n 个右反射系数（最后两个为 0）
+         */
+        template <typename E>
+        void bidiagonalize(size_t n, E *A, size_t ld, E *d, E *e, E *tauL, E *tauR)
+        {
+            std::vector<E> dots(n);
+            for (size_t k = 0; k < n; ++k)
+            {
+                // 左反射消去第 k 列对角线以下的元素
+                tauL[k] = householder(n - k, A + k * ld + k, ld);
+                d[k] = A[k * ld + k];
+                if (k + 1 < n)
+                    applyReflectors(n, A, ld, tauL, k, k + 1, A + k + 1, ld, n - k - 1, false);
+
+                tauR[k] = E(0);
+                e[k] = E(0);
+                if (k + 1 >= n)
+                    continue;
+                // 右反射消去第 k 行上次对角线右侧的元素
+                E *rowK = A + k * ld;
+                const E t = householder(n - k - 1, rowK + k + 1, size_t(1));
+                tauR[k] = t;
+                e[k] = rowK[k + 1];
+                if (t == E(0))
+                    continue;
+                // 对第 k + 1 行起的每一行：r -= tau * (r . v) * v^T，v 的首分量为 1
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    const E *rowI = A + i * ld;
+                    dots[i] = t * (rowI[k + 1] + packetDot(n - k - 2, rowI + k + 2, rowK + k + 2));
+                }
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    E *rowI = A + i * ld;
+                    const E s = dots[i];
+                    rowI[k + 1] -= s;
+                    for (size_t j = k + 2; j < n; ++j)
+                        rowI[j] -= s * rowK[j];
+                }
+            }
+        }
+
+        /**
+         * @brief 对两行做 Givens 旋转：(x, y) <- (c * x + s * y, c * y - s * x)
+         */
+        template <typename E>
+        void rotateRows(size_t len, E *x, E *y, E c, E s)
+        {
+            for (size_t j = 0; j < len; ++j)
+            {
+                const E a = x[j], b = y[j];
+                x[j] = c * a + s * b;
+                y[j] = c * b - s * a;
+            }
+        }
+
+        /**
+         * @brief 上双对角矩阵的 Golub-Kahan 隐式位移 QR 迭代（Golub-Reinsch）
+         * @param n 阶数
+         * @param d 对角元，返回时为非负奇异值（未排序）
+         * @param e 上次对角元，e[i] = B(i, i + 1)，返回时被破坏
+         * @param Ut、Vt 若非 nullptr，分别为 n×len 的左、右奇异向量（按行），旋转同时作用其上
+         * @throws std::runtime_error 如果某个奇异值在 SVDMaxIterations 次迭代内未收敛
+         */
+        template <typename E>
+        void bidiagonalQR(size_t n, E *d, E *e, E *Ut, size_t lenU, E *Vt, size_t lenV)
+        {
+            if (n == 0)
+                return;
+            // rv[i] = B(i - 1, i)，rv[0] = 0
+            std::vector<E> rv(n, E(0));
+            for (size_t i = 1; i < n; ++i)
+                rv[i] = e[i - 1];
+            const E eps = std::numeric_limits<E>::epsilon();
+            E anorm = E(0);
+            for (size_t i = 0; i < n; ++i)
+                anorm = std::max(anorm, std::abs(d[i]) + std::abs(rv[i]));
+
+            for (size_t k = n; k-- > 0;)
+            {
+                for (size_t its = 0;; ++its)
+                {
+                    // 寻找可分裂的位置 l：rv[l] 可以忽略，或 d[l - 1] 可以忽略（此时需要先消去 rv[l]）
+                    size_t l = k;
+                    bool cancel = true;
+                    for (;; --l)
+                    {
+                        if (l == 0 || std::abs(rv[l]) <= eps * anorm)
+                        {
+                            cancel = false;
+                            break;
+                        }
+                        if (std::abs(d[l - 1]) <= eps * anorm)
+                            break;
+                    }
+                    if (cancel)
+                    {
+                        const size_t nm = l - 1;
+                        E c = E(0), s = E(1);
+                        for (size_t i = l; i <= k; ++i)
+                        {
+                            const E f = s * rv[i];
+                            rv[i] = c * rv[i];
+                            if (std::abs(f) <= eps * anorm)
+                                break;
+                            const E g = d[i];
+                            const E h = std::hypot(f, g);
+                            d[i] = h;
+                            c = g / h;
+                            s = -f / h;
+                            if (Ut)
+                                rotateRows(lenU, Ut + nm * lenU, Ut + i * lenU, c, s);
+                        }
+                    }
+
+                    const E z = d[k];
+                    if (l == k)
+                    {
+                        if (z < E(0))
+                        {
+                            d[k] = -z;
+                            if (Vt)
+                                for (size_t j = 0; j < lenV; ++j)
+                                    Vt[k * lenV + j] = -Vt[k * lenV + j];
+                        }
+                        break;
+                    }
+                    if (its >= SVDMaxIterations)
+                        throw std::runtime_error("Singular value iteration did not converge.");
+
+                    // 由右下角 2x2 子块确定位移
+                    E x = d[l];
+                    const size_t nm = k - 1;
+                    E y = d[nm];
+                    E g = rv[nm];
+                    E h = rv[k];
+                    E f = ((y - z) * (y + z) + (g - h) * (g + h)) / (E(2) * h * y);
+                    g = std::hypot(f, E(1));
+                    f = ((x - z) * (x + z) + h * ((y / (f + std::copysign(g, f))) - h)) / x;
+
+                    // 追赶凸起
+                    E c = E(1), s = E(1);
+                    for (size_t j = l; j <= nm; ++j)
+                    {
+                        const size_t i = j + 1;
+                        g = rv[i];
+                        y = d[i];
+                        h = s * g;
+                        g = c * g;
+                        E zz = std::hypot(f, h);
+                        rv[j] = zz;
+                        c = f / zz;
+                        s = h / zz;
+                        f = x * c + g * s;
+                        g = g * c - x * s;
+                        h = y * s;
+                        y *= c;
+                        if (Vt)
+                            rotateRows(lenV, Vt + j * lenV, Vt + i * lenV, c, s);
+                        zz = std::hypot(f, h);
+                        d[j] = zz;
+                        if (zz != E(0))
+                        {
+                            c = f / zz;
+                            s = h / zz;
+                        }
+                        f = c * g + s * y;
+                        x = c * y - s * g;
+                        if (Ut)
+                            rotateRows(lenU, Ut + j * lenU, Ut + i * lenU, c, s);
+                    }
+                    rv[l] = E(0);
+                    rv[k] = f;
+                    d[k] = x;
+                }
+            }
+        }
+
+        /**
+         * @brief n×n 方阵的 SVD：A = U * diag(s) * V^T
+         * @param A 行主序 n×n 矩阵（行跨度 n），计算后被破坏
+         * @param s 输出 n 个降序奇异值
+         * @param Ut、Vt 若非 nullptr，输出 U^T 与 V^T（n×n，按行保存奇异向量）
+         */
+        template <typename E>
+        void svdSquare(size_t n, E *A, E *s, E *Ut, E *Vt)
+        {
+            std::vector<E> e(n), tauL(n), tauR(n);
+            bidiagonalize(n, A, n, s, e.data(), tauL.data(), tauR.data());
+            if (Ut)
+            {
+                // U^T = U_b^T * I
+                std::fill(Ut, Ut + n * n, E(0));
+                for (size_t i = 0; i < n; ++i)
+                    Ut[i * n + i] = E(1);
+                qrApplyQ(n, n, A, n, tauL.data(), Ut, n, n, true);
+            }
+            if (Vt)
+            {
+                // V_b = diag(1, Q')，右反射转置到 P 中后即为 QR 的布局
+                std::fill(Vt, Vt + n * n, E(0));
+                for (size_t i = 0; i < n; ++i)
+                    Vt[i * n + i] = E(1);
+                if (n > 2)
+                {
+                    std::vector<E> P(n * n, E(0));
+                    for (size_t k = 0; k + 2 < n; ++k)
+                        for (size_t j = k + 2; j < n; ++j)
+                            P[j * n + k] = A[k * n + j];
+                    qrApplyQ(n - 1, n - 2, P.data() + n, n, tauR.data(), Vt + n, n, n, true);
+                }
+            }
+            bidiagonalQR(n, s, e.data(), Ut, n, Vt, n);
+
+            // 降序排列
+            for (size_t i = 0; i + 1 < n; ++i)
+            {
+                size_t maxIndex = i;
+                for (size_t j = i + 1; j < n; ++j)
+                    if (s[j] > s[maxIndex])
+                        maxIndex = j;
+                if (maxIndex == i)
+                    continue;
+                std::swap(s[i], s[maxIndex]);
+                if (Ut)
+                    std::swap_ranges(Ut + i * n, Ut + i * n + n, Ut + maxIndex * n);
+                if (Vt)
+                    std::swap_ranges(Vt + i * n, Vt + i * n + n, Vt + maxIndex * n);
+            }
+        }
+
+        /**
+         * @brief m×n 矩阵的薄 SVD：A = U * diag(s) * V^T，k = min(m, n)
+         * @param A 行主序 m×n 矩阵（行跨度 n），计算后被破坏
+         * @param s 输出 k 个降序奇异值
+         * @param U 若非 nullptr，输出 m×k 左奇异向量（行主序，行跨度 k）
+         * @param V 若非 nullptr，输出 n×k 右奇异向量（行主序，行跨度 k）
+         */
+        template <typename E>
+        void svdThin(size_t m, size_t n, E *A, E *s, E *U, E *V)
+        {
+            static_assert(std::is_floating_point<E>::value, "SVD requires a real floating-point scalar type");
+            if (m == 0 || n == 0)
+                return;
+            if (m < n)
+            {
+                // A^T = V * S * U^T
+                std::vector<E> At(n * m);
+                for (size_t i = 0; i < m; ++i)
+                    for (size_t j = 0; j < n; ++j)
+                        At[j * m + i] = A[i * n + j];
+                svdThin(n, m, At.data(), s, V, U);
+                return;
+            }
+
+            // 与 dgesvd 相同：max|a| 超出 [sqrt(safmin) / eps, 其倒数] 时先按 2 的幂缩放到 1 附近，
+            // 避免双对角 QR 迭代中的平方上溢或下溢；缩放是精确的，最后把奇异值乘回
+            const E smallNorm = std::sqrt(std::numeric_limits<E>::min()) / std::numeric_limits<E>::epsilon();
+            E maxAbs = E(0);
+            for (size_t i = 0; i < m * n; ++i)
+                maxAbs = std::max(maxAbs, std::abs(A[i]));
+            int scaleExp = 0;
+            if (maxAbs > E(0) && (maxAbs < smallNorm || maxAbs > E(1) / smallNorm))
+            {
+                std::frexp(maxAbs, &scaleExp);
+                for (size_t i = 0; i < m * n; ++i)
+                    A[i] = std::ldexp(A[i], -scaleExp);
+            }
+
+            const bool vectors = U != nullptr || V != nullptr;
+            std::vector<E> Ut(vectors ? n * n : 0), Vt(vectors ? n * n : 0);
+            E *pUt = vectors ? Ut.data() : nullptr;
+            E *pVt = vectors ? Vt.data() : nullptr;
+            if (m == n)
+            {
+                svdSquare(n, A, s, pUt, pVt);
+                if (U)
+                    for (size_t i = 0; i < n; ++i)
+                        for (size_t j = 0; j < n; ++j)
+                            U[i * n + j] = Ut[j * n + i];
+            }
+            else
+            {
+                // 先做 QR，只对 R 求 SVD：U = Q * [U_R; 0]
+                std::vector<E> tau(n);
+                qrFactor(m, n, A, n, tau.data());
+                std::vector<E> R(n * n, E(0));
+                for (size_t i = 0; i < n; ++i)
+                    std::copy(A + i * n + i, A + i * n + n, R.data() + i * n + i);
+                svdSquare(n, R.data(), s, pUt, pVt);
+                if (U)
+                {
+                    std::fill(U, U + m * n, E(0));
+                    for (size_t i = 0; i < n; ++i)
+                        for (size_t j = 0; j < n; ++j)
+                            U[i * n + j] = Ut[j * n + i];
+                    qrApplyQ(m, n, A, n, tau.data(), U, n, n, false);
+                }
+            }
+            if (V)
+                for (size_t i = 0; i < n; ++i)
+                    for (size_t j = 0; j < n; ++j)
+                        V[i * n + j] = Vt[j * n + i];
+            if (scaleExp != 0)
+                for (size_t i = 0; i < n; ++i)
+                    s[i] = std::ldexp(s[i], scaleExp);
+        }
+
+        /**
+         * @brief 把 m×l 矩阵 Y（行跨度 l，m >= l）原地替换为其列空间的一组标准正交基 Q（QR 分解的薄 Q）
+         */
+        template <typename E>
+        void orthonormalizeColumns(size_t m, size_t l, E *Y)
+        {
+            std::vector<E> tau(l), Q(m * l, E(0));
+            qrFactor(m, l, Y, l, tau.data());
+            for (size_t i = 0; i < l; ++i)
+                Q[i * l + i] = E(1);
+            qrApplyQ(m, l, Y, l, tau.data(), Q.data(), l, l, false);
+            std::copy(Q.begin(), Q.end(), Y);
+        }
+
+        /**
+         * @brief 随机化截断 SVD：A ≈ U * diag(s) * V^T，只求前 k 个奇异三元组
+         * @details 用 l = k + oversampling 个高斯随机向量得到 Y = A * Omega，再做 powerIterations 次
+         *          (A * A^T) 的幂迭代（每次都重新正交化以保持数值稳定），得到近似列空间的基 Q（m×l）；
+         *          最后对 B = Q^T * A（l×n）求完整 SVD，U = Q * U_B。对 A 的访问全部是 GEMM。
+         * @param A 行主序 m×n 矩阵（行跨度 n），只读
+         * @param s 输出 k 个降序奇异值
+         * @param U 输出 m×k（行跨度 k）
+         * @param V 输出 n×k（行跨度 k）
+         */
+        template <typename E>
+        void randomizedSvd(size_t m, size_t n, const E *A, size_t k, size_t oversampling, size_t powerIterations,
+                           unsigned long long seed, E *s, E *U, E *V)
+        {
+            static_assert(std::is_floating_point<E>::value, "SVD requires a real floating-point scalar type");
+            const size_t l = std::min(std::min(m, n), k + oversampling);
+            std::mt19937_64 gen(seed);
+            std::normal_distribution<E> normal(E(0), E(1));
+            std::vector<E> Omega(n * l), Y(m * l), Z(n * l);
+            for (E &x : Omega)
+                x = normal(gen);
+
+            // Y = A * Omega
+            gemm<E>(m, l, n, E(1), A, n, 1, Omega.data(), l, 1, E(0), Y.data(), l);
+            orthonormalizeColumns(m, l, Y.data());
+            for (size_t it = 0; it < powerIterations; ++it)
+            {
+                // Z = A^T * Y，Y = A * Z
+                gemm<E>(n, l, m, E(1), A, 1, n, Y.data(), l, 1, E(0), Z.data(), l);
+                orthonormalizeColumns(n, l, Z.data());
+                gemm<E>(m, l, n, E(1), A, n, 1, Z.data(), l, 1, E(0), Y.data(), l);
+                orthonormalizeColumns(m, l, Y.data());
+            }
+
+            // B = Q^T * A（l×n），B = U_B * S * V_B^T
+            std::vector<E> B(l * n), sB(l), UB(l * l), VB(n * l);
+            gemm<E>(l, n, m, E(1), Y.data(), 1, l, A, n, 1, E(0), B.data(), n);
+            svdThin(l, n, B.data(), sB.data(), UB.data(), VB.data());
+
+            // 取前 k 个：U = Q * U_B(:, 0:k)，V = V_B(:, 0:k)
+            const size_t kk = std::min(k, l);
+            std::copy(sB.begin(), sB.begin() + kk, s);
+            gemm<E>(m, kk, l, E(1), Y.data(), l, 1, UB.data(), l, 1, E(0), U, k);
+            for (size_t i = 0; i < n; ++i)
+                std::copy(VB.data() + i * l, VB.data() + i * l + kk, V + i * k);
+        }
+    }
+}
@@ -0,0 +1,323 @@
+/**
+ * @file Simd.hpp
+ * @brief SIMD 数据包（Packet）抽象，为 GEMM 等计算内核提供统一的向量指令接口。
+ * @details 根据编译选项自动选择 AVX-512、AVX2+FMA、SSE2 或标量实现，
+ *          未开启任何指令集时退化为逐元素标量运算，保证代码在所有平台均可编译。
+ */
+#pragma once
+#include <cstddef>
+#include <cmath>
+
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace OxygenMath
+{
+    namespace simd
+    {
+        /**
+         * @brief 标量数据包：一个包只含一个元素。用作未开启指令集时的实现，
+         *        也用于向量化循环的尾部
+         * @tparam F 底层浮点类型
+         */
+        template <typename F>
+        struct ScalarPacket
+        {
+            using Scalar = F;
+            using type = F;
+            static constexpr size_t size = 1;
+
+            static type load(const F *p) { return *p; }
+            static type loadu(const F *p) { return *p; }
+            static void store(F *p, type v) { *p = v; }
+            static void storeu(F *p, type v) { *p = v; }
+            static type set1(F v) { return v; }
+            static type zero() { return F(0); }
+            static type add(type a, type b) { return a + b; }
+            static type sub(type a, type b) { return a - b; }
+            static type mul(type a, type b) { return a * b; }
+            // a * b + c；向量实现为融合乘加时这里也融合，使循环尾部与整包的结果逐位一致
+#if defined(__FMA__)
+            static type fmadd(type a, type b, type c) { return std::fma(a, b, c); }
+#else
+            static type fmadd(type a, type b, type c) { return a * b + c; }
+#endif
+            static type div(type a, type b) { return a / b; }
+            static type sqrt(type a) { return std::sqrt(a); }
+            static type abs(type a) { return std::abs(a); }
+            static type min(type a, type b) { return a < b ? a : b; }
+            static type max(type a, type b) { return a > b ? a : b; }
+            // a < b 时取 x，否则取 y（含 NaN 时取 y）
+            static type selectLess(type a, type b, type x, type y) { return a < b ? x : y; }
+            static type selectLessEq(type a, type b, type x, type y) { return a <= b ? x : y; }
+            // 2^n，n 为整数值且在正规数指数范围内
+            static type exp2i(type n) { return std::ldexp(F(1), static_cast<int>(n)); }
+            // 正的正规数 x = m * 2^e，m ∈ [0.5, 1)
+            static type frexp(type x, type &e)
+            {
+                int ei;
+                const F m = std::frexp(x, &ei);
+                e = F(ei);
+                return m;
+            }
+        };
+
+        /**
+         * @brief 数据包特征，size 为一个包中的元素个数
+         * @details 除基本算术外还提供 div/sqrt/abs/min/max、按比较结果选择（selectLess 等）
+         *          以及 exp2i/frexp 两个指数操作，供 SimdMath.hpp 中的初等函数使用。
+         * @tparam F 底层浮点类型
+         */
+        template <typename F>
+        struct Packet : ScalarPacket<F>
+        {
+        };
+
+#if defined(__AVX512F__)
+        template <>
+        struct Packet<double>
+        {
+            using Scalar = double;
+            using type = __m512d;
+            static constexpr size_t size = 8;
+            // 全选掩码：GCC 12 的非掩码版本内部用自赋值的 _mm512_undefined_pd() 作直通值，
+            // 会触发 -Wmaybe-uninitialized，因此用直通值为操作数的掩码版本，生成的指令相同
+            static constexpr __mmask8 Full = 0xFF;
+
+            static type load(const double *p) { return _mm512_load_pd(p); }
+            static type loadu(const double *p) { return _mm512_loadu_pd(p); }
+            static void store(double *p, type v) { _mm512_store_pd(p, v); }
+            static void storeu(double *p, type v) { _mm512_storeu_pd(p, v); }
+            static type set1(double v) { return _mm512_set1_pd(v); }
+            static type zero() { return _mm512_setzero_pd(); }
+            static type add(type a, type b) { return _mm512_add_pd(a, b); }
+            static type sub(type a, type b) { return _mm512_sub_pd(a, b); }
+            static type mul(type a, type b) { return _mm512_mul_pd(a, b); }
+            static type fmadd(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+            static type div(type a, type b) { return _mm512_div_pd(a, b); }
+            static type sqrt(type a) { return _mm512_mask_sqrt_pd(a, Full, a); }
+            static type abs(type a) { return _mm512_abs_pd(a); }
+            static type min(type a, type b) { return _mm512_mask_min_pd(a, Full, a, b); }
+            static type max(type a, type b) { return _mm512_mask_max_pd(a, Full, a, b); }
+            static type selectLess(type a, type b, type x, type y) { return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, _CMP_LT_OQ), y, x); }
+            static type selectLessEq(type a, type b, type x, type y) { return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, _CMP_LE_OQ), y, x); }
+            static type exp2i(type n) { return _mm512_mask_scalef_pd(n, Full, set1(1.0), n); }
+            static type frexp(type x, type &e)
+            {
+                e = add(_mm512_mask_getexp_pd(x, Full, x), set1(1.0));
+                return _mm512_mask_getmant_pd(x, Full, x, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_src);
+            }
+        };
+
+        template <>
+        struct Packet<float>
+        {
+            using Scalar = float;
+            using type = __m512;
+            static constexpr size_t size = 16;
+            static constexpr __mmask16 Full = 0xFFFF;
+
+            static type load(const float *p) { return _mm512_load_ps(p); }
+            static type loadu(const float *p) { return _mm512_loadu_ps(p); }
+            static void store(float *p, type v) { _mm512_store_ps(p, v); }
+            static void storeu(float *p, type v) { _mm512_storeu_ps(p, v); }
+            static type set1(float v) { return _mm512_set1_ps(v); }
+            static type zero() { return _mm512_setzero_ps(); }
+            static type add(type a, type b) { return _mm512_add_ps(a, b); }
+            static type sub(type a, type b) { return _mm512_sub_ps(a, b); }
+            static type mul(type a, type b) { return _mm512_mul_ps(a, b); }
+            static type fmadd(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+            static type div(type a, type b) { return _mm512_div_ps(a, b); }
+            static type sqrt(type a) { return _mm512_mask_sqrt_ps(a, Full, a); }
+            static type abs(type a) { return _mm512_abs_ps(a); }
+            static type min(type a, type b) { return _mm512_mask_min_ps(a, Full, a, b); }
+            static type max(type a, type b) { return _mm512_mask_max_ps(a, Full, a, b); }
+            static type selectLess(type a, type b, type x, type y) { return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ), y, x); }
+            static type selectLessEq(type a, type b, type x, type y) { return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_LE_OQ), y, x); }
+            static type exp2i(type n) { return _mm512_mask_scalef_ps(n, Full, set1(1.0f), n); }
+            static type frexp(type x, type &e)
+            {
+                e = add(_mm512_mask_getexp_ps(x, Full, x), set1(1.0f));
+                return _mm512_mask_getmant_ps(x, Full, x, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_src);
+            }
+        };
+#elif defined(__AVX2__) && defined(__FMA__)
+        template <>
+        struct Packet<double>
+        {
+            using Scalar = double;
+            using type = __m256d;
+            static constexpr size_t size = 4;
+
+            static type load(const double *p) { return _mm256_load_pd(p); }
+            static type loadu(const double *p) { return _mm256_loadu_pd(p); }
+            static void store(double *p, type v) { _mm256_store_pd(p, v); }
+            static void storeu(double *p, type v) { _mm256_storeu_pd(p, v); }
+            static type set1(double v) { return _mm256_set1_pd(v); }
+            static type zero() { return _mm256_setzero_pd(); }
+            static type add(type a, type b) { return _mm256_add_pd(a, b); }
+            static type sub(type a, type b) { return _mm256_sub_pd(a, b); }
+            static type mul(type a, type b) { return _mm256_mul_pd(a, b); }
+            static type fmadd(type a, type b, type c) { return _mm256_fmadd_pd(a, b, c); }
+            static type div(type a, type b) { return _mm256_div_pd(a, b); }
+            static type sqrt(type a) { return _mm256_sqrt_pd(a); }
+            static type abs(type a) { return _mm256_andnot_pd(set1(-0.0), a); }
+            static type selectLess(type a, type b, type x, type y) { return _mm256_blendv_pd(y, x, _mm256_cmp_pd(a, b, _CMP_LT_OQ)); }
+            static type selectLessEq(type a, type b, type x, type y) { return _mm256_blendv_pd(y, x, _mm256_cmp_pd(a, b, _CMP_LE_OQ)); }
+            static type min(type a, type b) { return _mm256_min_pd(a, b); }
+            static type max(type a, type b) { return _mm256_max_pd(a, b); }
+            // 把 n + bias 加到 1.5 * 2^52 上，整数落在尾数低位，再左移到指数域
+            static type exp2i(type n)
+            {
+                const type biased = add(n, set1(6755399441055744.0 + 1023));
+                return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(biased), 52));
+            }
+            static type frexp(type x, type &e)
+            {
+                const __m256i bits = _mm256_castpd_si256(x);
+                // 指数域与 2^52 的位模式拼接后减去 2^52，得到带偏置的指数
+                const type biasedExp = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_castpd_si256(set1(4503599627370496.0))));
+                e = sub(biasedExp, set1(4503599627370496.0 + 1022));
+                return _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)), _mm256_set1_epi64x(0x3FE0000000000000LL)));
+            }
+        };
+
+        template <>
+        struct Packet<float>
+        {
+            using Scalar = float;
+            using type = __m256;
+            static constexpr size_t size = 8;
+
+            static type load(const float *p) { return _mm256_load_ps(p); }
+            static type loadu(const float *p) { return _mm256_loadu_ps(p); }
+            static void store(float *p, type v) { _mm256_store_ps(p, v); }
+            static void storeu(float *p, type v) { _mm256_storeu_ps(p, v); }
+            static type set1(float v) { return _mm256_set1_ps(v); }
+            static type zero() { return _mm256_setzero_ps(); }
+            static type add(type a, type b) { return _mm256_add_ps(a, b); }
+            static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+            static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+            static type fmadd(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+            static type div(type a, type b) { return _mm256_div_ps(a, b); }
+            static type sqrt(type a) { return _mm256_sqrt_ps(a); }
+            static type abs(type a) { return _mm256_andnot_ps(set1(-0.0f), a); }
+            static type selectLess(type a, type b, type x, type y) { return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+            static type selectLessEq(type a, type b, type x, type y) { return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_LE_OQ)); }
+            static type min(type a, type b) { return _mm256_min_ps(a, b); }
+            static type max(type a, type b) { return _mm256_max_ps(a, b); }
+            // 把 n + bias 加到 1.5 * 2^23 上，整数落在尾数低位，再左移到指数域
+            static type exp2i(type n)
+            {
+                const type biased = add(n, set1(12582912.0f + 127));
+                return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_castps_si256(biased), 23));
+            }
+            static type frexp(type x, type &e)
+            {
+                const __m256i bits = _mm256_castps_si256(x);
+                // 指数域与 2^23 的位模式拼接后减去 2^23，得到带偏置的指数
+                const type biasedExp = _mm256_castsi256_ps(_mm256_or_si256(_mm256_srli_epi32(bits, 23), _mm256_castps_si256(set1(8388608.0f))));
+                e = sub(biasedExp, set1(8388608.0f + 126));
+                return _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F000000)));
+            }
+        };
+#elif defined(__SSE2__)
+        template <>
+        struct Packet<double>
+        {
+            using Scalar = double;
+            using type = __m128d;
+            static constexpr size_t size = 2;
+
+            static type load(const double *p) { return _mm_load_pd(p); }
+            static type loadu(const double *p) { return _mm_loadu_pd(p); }
+            static void store(double *p, type v) { _mm_store_pd(p, v); }
+            static void storeu(double *p, type v) { _mm_storeu_pd(p, v); }
+            static type set1(double v) { return _mm_set1_pd(v); }
+            static type zero() { return _mm_setzero_pd(); }
+            static type add(type a, type b) { return _mm_add_pd(a, b); }
+            static type sub(type a, type b) { return _mm_sub_pd(a, b); }
+            static type mul(type a, type b) { return _mm_mul_pd(a, b); }
+            static type fmadd(type a, type b, type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+            static type div(type a, type b) { return _mm_div_pd(a, b); }
+            static type sqrt(type a) { return _mm_sqrt_pd(a); }
+            static type abs(type a) { return _mm_andnot_pd(set1(-0.0), a); }
+            static type selectLess(type a, type b, type x, type y)
+            {
+                const type m = _mm_cmplt_pd(a, b);
+                return _mm_or_pd(_mm_and_pd(m, x), _mm_andnot_pd(m, y));
+            }
+            static type selectLessEq(type a, type b, type x, type y)
+            {
+                const type m = _mm_cmple_pd(a, b);
+                return _mm_or_pd(_mm_and_pd(m, x), _mm_andnot_pd(m, y));
+            }
+            static type min(type a, type b) { return _mm_min_pd(a, b); }
+            static type max(type a, type b) { return _mm_max_pd(a, b); }
+            // 把 n + bias 加到 1.5 * 2^52 上，整数落在尾数低位，再左移到指数域
+            static type exp2i(type n)
+            {
+                const type biased = add(n, set1(6755399441055744.0 + 1023));
+                return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(biased), 52));
+            }
+            static type frexp(type x, type &e)
+            {
+                const __m128i bits = _mm_castpd_si128(x);
+                // 指数域与 2^52 的位模式拼接后减去 2^52，得到带偏置的指数
+                const type biasedExp = _mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(bits, 52), _mm_castpd_si128(set1(4503599627370496.0))));
+                e = sub(biasedExp, set1(4503599627370496.0 + 1022));
+                return _mm_castsi128_pd(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi64x(0x000FFFFFFFFFFFFFLL)), _mm_set1_epi64x(0x3FE0000000000000LL)));
+            }
+        };
+
+        template <>
+        struct Packet<float>
+        {
+            using Scalar = float;
+            using type = __m128;
+            static constexpr size_t size = 4;
+
+            static type load(const float *p) { return _mm_load_ps(p); }
+            static type loadu(const float *p) { return _mm_loadu_ps(p); }
+            static void store(float *p, type v) { _mm_store_ps(p, v); }
+            static void storeu(float *p, type v) { _mm_storeu_ps(p, v); }
+            static type set1(float v) { return _mm_set1_ps(v); }
+            static type zero() { return _mm_setzero_ps(); }
+            static type add(type a, type b) { return _mm_add_ps(a, b); }
+            static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+            static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+            static type fmadd(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+            static type div(type a, type b) { return _mm_div_ps(a, b); }
+            static type sqrt(type a) { return _mm_sqrt_ps(a); }
+            static type abs(type a) { return _mm_andnot_ps(set1(-0.0f), a); }
+            static type selectLess(type a, type b, type x, type y)
+            {
+                const type m = _mm_cmplt_ps(a, b);
+                return _mm_or_ps(_mm_and_ps(m, x), _mm_andnot_ps(m, y));
+            }
+            static type selectLessEq(type a, type b, type x, type y)
+            {
+                const type m = _mm_cmple_ps(a, b);
+                return _mm_or_ps(_mm_and_ps(m, x), _mm_andnot_ps(m, y));
+            }
+            static type min(type a, type b) { return _mm_min_ps(a, b); }
+            static type max(type a, type b) { return _mm_max_ps(a, b); }
+            // 把 n + bias 加到 1.5 * 2^23 上，整数落在尾数低位，再左移到指数域
+            static type exp2i(type n)
+            {
+                const type biased = add(n, set1(12582912.0f + 127));
+                return _mm_castsi128_ps(_mm_slli_epi32(_mm_castps_si128(biased), 23));
+            }
+            static type frexp(type x, type &e)
+            {
+                const __m128i bits = _mm_castps_si128(x);
+                // 指数域与 2^23 的位模式拼接后减去 2^23，得到带偏置的指数
+                const type biasedExp = _mm_castsi128_ps(_mm_or_si128(_mm_srli_epi32(bits, 23), _mm_castps_si128(set1(8388608.0f))));
+                e = sub(biasedExp, set1(8388608.0f + 126));
+                return _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F000000)));
+            }
+        };
+#endif
+    }
+}
@@ -0,0 +1,573 @@
+/**
+ * @file SparseMatrix.hpp
+ * @brief 压缩行（CSR）/ 压缩列（CSC）稀疏矩阵，三元组（COO）组装，以及多线程稀疏矩阵-向量乘法。
+ * @details PDE 离散化产生的矩阵往往有上百万行、每行只有个位数非零元，稠密的 MatrixNM 根本放不下。
+ *          SparseMatrix 只保存非零元：
+ *          - 外层指针 outer[k]..outer[k+1] 给出第 k 行（CSR）或第 k 列（CSC）的非零元区间；
+ *          - 内层索引 inner[p] 是对应的列号（CSR）或行号（CSC），同一区间内严格递增；
+ *          - 数值 values[p] 与 inner[p] 一一对应。
+ *          内层索引使用 32 位无符号整数，SpMV 是带宽受限的，每个非零元少读 4 字节约有 1/3 的收益，
+ *          代价是行数、列数不能超过 2^32 - 1；外层指针仍为 size_t，非零元个数不受此限制。
+ *
+ *          SpMV 有两种访存形态：
+ *          - 聚集（gather）：y[k] = Σ values[p] * x[inner[p]]，按外层区间互不相交地写 y，
+ *            多线程时按非零元个数均衡地切分外层区间；
+ *          - 散射（scatter）：y[inner[p]] += values[p] * x[k]，多个外层区间会写同一个 y 元素。
+ *            单线程时直接散射；多线程时第一次调用按内层重新分组建立一份转置索引（O(nnz)，之后复用），
+ *            改为经由原数组位置间接取值的聚集，每个 y 元素只由一个线程写入，不需要每线程的缓冲区与归约。
+ *          CSR 的 A * x 与 CSC 的 Aᵀ * x 走聚集；CSR 的 Aᵀ * x 与 CSC 的 A * x 走散射。
+ *          double/float 封装的 Real 在内核中按底层浮点数处理，内层循环使用两个独立累加器以隐藏乘加延迟。
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "NumberField.hpp"
+#include "MatrixNM.hpp"
+#include "VectorN.hpp"
+#include "LUKernel.hpp"
+#include "../Parallel/ParallelFor.hpp"
+
+namespace OxygenMath
+{
+    /**
+     * @brief 稀疏矩阵组装用的三元组 (row, col, value)，重复的位置在组装时相加
+     */
+    template <typename T>
+    struct Triplet
+    {
+        size_t row, col;
+        T value;
+
+        Triplet() : row(0), col(0), value() {}
+        Triplet(size_t r, size_t c, const T &v) : row(r), col(c), value(v) {}
+    };
+
+    namespace internal
+    {
+        typedef std::uint32_t SparseIndex;
+
+        // 非零元少于该值时不切分到多个线程，线程创建的开销会超过计算本身
+        constexpr size_t SparseGrain = 1 << 16;
+
+        /**
+         * @brief 把外层区间 [0, outer) 切成至多 parts 段，使每段的 (非零元个数 + 外层个数) 大致相等
+         * @return 段边界，长度为段数 + 1
+         */
+        inline std::vector<size_t> sparsePartition(size_t outer, const size_t *ptr, size_t parts)
+        {
+            const size_t nnz = ptr[outer];
+            if (nnz + outer < SparseGrain)
+                parts = 1;
+            parts = std::max<size_t>(1, std::min(parts, outer));
+            std::vector<size_t> bounds(1, 0);
+            const size_t total = nnz + outer;
+            for (size_t t = 1; t < parts; ++t)
+            {
+                // 第一个满足 ptr[k] + k >= t * total / parts 的 k
+                const size_t target = total / parts * t;
+                size_t lo = bounds.back(), hi = outer;
+                while (lo < hi)
+                {
+                    const size_t mid = lo + (hi - lo) / 2;
+                    if (ptr[mid] + mid < target)
+                        lo = mid + 1;
+                    else
+                        hi = mid;
+                }
+                if (lo > bounds.back() && lo < outer)
+                    bounds.push_back(lo);
+            }
+            bounds.push_back(outer);
+            return bounds;
+        }
+
+        /**
+         * @brief 聚集：y[k] = Σ_{p ∈ [ptr[k], ptr[k+1])} val[p] * x[idx[p]]，k ∈ [k0, k1)
+         */
+        template <typename E>
+        void sparseGather(size_t k0, size_t k1, const size_t *ptr, const SparseIndex *idx, const E *val,
+                          const E *x, E *y)
+        {
+            for (size_t k = k0; k < k1; ++k)
+            {
+                const size_t end = ptr[k + 1];
+                size_t p = ptr[k];
+                E s0 = E(), s1 = E();
+                for (; p + 2 <= end; p += 2)
+                {
+                    s0 += val[p] * x[idx[p]];
+                    s1 += val[p + 1] * x[idx[p + 1]];
+                }
+                if (p < end)
+                    s0 += val[p] * x[idx[p]];
+                y[k] = s0 + s1;
+            }
+        }
+
+        /**
+         * @brief 散射：y[idx[p]] += val[p] * x[k]，k ∈ [k0, k1)，y 需事先置零或保存待累加的值
+         */
+        template <typename E>
+        void sparseScatter(size_t k0, size_t k1, const size_t *ptr, const SparseIndex *idx, const E *val,
+                           const E *x, E *y)
+        {
+            for (size_t k = k0; k < k1; ++k)
+            {
+                const E xk = x[k];
+                for (size_t p = ptr[k], end = ptr[k + 1]; p < end; ++p)
+                    y[idx[p]] += val[p] * xk;
+            }
+        }
+
+        /**
+         * @brief 多线程聚集，outer 为外层个数，bounds 由 sparsePartition 给出
+         */
+        template <typename E>
+        void sparseGatherParallel(const std::vector<size_t> &bounds, const size_t *ptr, const SparseIndex *idx,
+                                  const E *val, const E *x, E *y)
+        {
+            const size_t parts = bounds.size() - 1;
+            if (parts == 1)
+            {
+                sparseGather(bounds[0], bounds[1], ptr, idx, val, x, y);
+                return;
+            }
+            parallelFor(0, parts, 1, [&](size_t b, size_t e)
+                        {
+                            for (size_t t = b; t < e; ++t)
+                                sparseGather(bounds[t], bounds[t + 1], ptr, idx, val, x, y); });
+        }
+
+        /**
+         * @brief 按内层重新分组的转置索引，用于把散射改写为聚集
+         * @details 内层下标 i 的非零元位于 [ptr[i], ptr[i+1])，outer[q] 为其外层下标，source[q] 为其在原数组中的位置。
+         *          只保存结构，数值仍从原数组读取，因此通过 valuePtr() 修改数值后无需重建。
+         */
+        struct SparseTransposedIndex
+        {
+            std::vector<size_t> ptr;
+            std::vector<SparseIndex> outer;
+            std::vector<size_t> source;
+            std::vector<size_t> partition;
+        };
+
+        /**
+         * @brief 对外层个数为 outer、内层个数为 inner 的压缩结构做一次计数排序，得到转置索引
+         * @details 按外层顺序填入，同一内层下标的非零元按外层下标递增排列，与串行散射的累加顺序相同。
+         */
+        inline std::shared_ptr<const SparseTransposedIndex> sparseTransposeIndex(size_t outer, size_t inner, const size_t *ptr,
+                                                                                 const SparseIndex *idx, size_t parts)
+        {
+            std::shared_ptr<SparseTransposedIndex> t = std::make_shared<SparseTransposedIndex>();
+            const size_t nnz = ptr[outer];
+            t->ptr.assign(inner + 1, 0);
+            for (size_t p = 0; p < nnz; ++p)
+                ++t->ptr[idx[p] + 1];
+            for (size_t i = 0; i < inner; ++i)
+                t->ptr[i + 1] += t->ptr[i];
+            t->outer.resize(nnz);
+            t->source.resize(nnz);
+            std::vector<size_t> next(t->ptr.begin(), t->ptr.end() - 1);
+            for (size_t k = 0; k < outer; ++k)
+                for (size_t p = ptr[k]; p < ptr[k + 1]; ++p)
+                {
+                    const size_t q = next[idx[p]]++;
+                    t->outer[q] = static_cast<SparseIndex>(k);
+                    t->source[q] = p;
+                }
+            t->partition = sparsePartition(inner, t->ptr.data(), parts);
+            return t;
+        }
+
+        /**
+         * @brief 经转置索引的多线程聚集：y[i] = Σ_q val[source[q]] * x[outer[q]]，结果覆盖 y
+         * @details 每个 y[i] 只由一个线程按外层下标递增的顺序累加，结果与线程数无关，也与串行散射的累加顺序一致。
+         */
+        template <typename E>
+        void sparseGatherTransposedParallel(const SparseTransposedIndex &t, const E *val, const E *x, E *y)
+        {
+            auto rows = [&](size_t i0, size_t i1)
+            {
+                for (size_t i = i0; i < i1; ++i)
+                {
+                    E s = E();
+                    for (size_t q = t.ptr[i], end = t.ptr[i + 1]; q < end; ++q)
+                        s += val[t.source[q]] * x[t.outer[q]];
+                    y[i] = s;
+                }
+            };
+            const std::vector<size_t> &bounds = t.partition;
+            const size_t parts = bounds.size() - 1;
+            if (parts == 1)
+            {
+                rows(bounds[0], bounds[1]);
+                return;
+            }
+            parallelFor(0, parts, 1, [&](size_t b, size_t e)
+                        {
+                            for (size_t p = b; p < e; ++p)
+                                rows(bounds[p], bounds[p + 1]); });
+        }
+    }
+
+    /**
+     * @brief 压缩存储的稀疏矩阵
+     * @tparam T 元素类型
+     * @tparam RowMajor true 为 CSR（按行压缩），false 为 CSC（按列压缩）
+     * @details 外层维度在 CSR 中是行、在 CSC 中是列。矩阵一经构造结构不再改变，只能通过 valuePtr() 修改数值。
+     */
+    template <typename T, bool RowMajor = true>
+    class SparseMatrix
+    {
+    private:
+        typedef internal::SparseIndex Index;
+        typedef internal::LUElement<T> Elem;
+        typedef typename Elem::type E;
+
+        size_t m_rows, m_cols;
+        std::vector<size_t> m_outer;
+        std::vector<Index> m_inner;
+        std::vector<T> m_values;
+        std::vector<size_t> m_partition; // 多线程 SpMV 的外层分段，构造时确定
+        // 散射方向多线程乘法用的转置索引，第一次需要时建立；结构不变，复制时共享
+        mutable std::shared_ptr<const internal::SparseTransposedIndex> m_scatterIndex;
+
+        size_t outerSize() const { return RowMajor ? m_rows : m_cols; }
+        size_t innerSize() const { return RowMajor ? m_cols : m_rows; }
+
+        static void checkDimensions(size_t rows, size_t cols)
+        {
+            const size_t limit = std::numeric_limits<Index>::max();
+            if (rows > limit || cols > limit)
+                throw std::invalid_argument("Sparse matrix dimension exceeds the index range");
+        }
+
+        void finalize()
+        {
+            m_partition = internal::sparsePartition(outerSize(), m_outer.data(), parallelThreads());
+        }
+
+        // 散射方向的乘积 y = Σ_k values[k 区间] * x[k]（y 长度为内层个数），结果覆盖 y
+        void scatterProduct(const E *x, E *y) const
+        {
+            const E *val = Elem::cast(m_values.data());
+            if (m_partition.size() <= 2)
+            {
+                std::fill(y, y + innerSize(), E());
+                internal::sparseScatter(0, outerSize(), m_outer.data(), m_inner.data(), val, x, y);
+                return;
+            }
+            // 并发调用可能各自建立一次，结果相同，保留最后写入的一份即可
+            std::shared_ptr<const internal::SparseTransposedIndex> index = std::atomic_load(&m_scatterIndex);
+            if (!index)
+            {
+                index = internal::sparseTransposeIndex(outerSize(), innerSize(), m_outer.data(), m_inner.data(),
+                                                       parallelThreads());
+                std::atomic_store(&m_scatterIndex, index);
+            }
+            internal::sparseGatherTransposedParallel(*index, val, x, y);
+        }
+
+        // 把一个外层区间内的 (内层索引, 数值) 按内层索引排序；区间通常很短且接近有序，用插入排序
+        void sortSegment(size_t begin, size_t end)
+        {
+            if (end - begin <= 32)
+            {
+                for (size_t p = begin + 1; p < end; ++p)
+                {
+                    const Index key = m_inner[p];
+                    if (key >= m_inner[p - 1])
+                        continue;
+                    const T value = m_values[p];
+                    size_t q = p;
+                    for (; q > begin && m_inner[q - 1] > key; --q)
+                    {
+                        m_inner[q] = m_inner[q - 1];
+                        m_values[q] = m_values[q - 1];
+                    }
+                    m_inner[q] = key;
+                    m_values[q] = value;
+                }
+                return;
+            }
+            std::vector<std::pair<Index, T>> entries(end - begin);
+            for (size_t p = begin; p < end; ++p)
+                entries[p - begin] = std::make_pair(m_inner[p], m_values[p]);
+            std::stable_sort(entries.begin(), entries.end(), [](const std::pair<Index, T> &a, const std::pair<Index, T> &b)
+                             { return a.first < b.first; });
+            for (size_t p = begin; p < end; ++p)
+            {
+                m_inner[p] = entries[p - begin].first;
+                m_values[p] = entries[p - begin].second;
+            }
+        }
+
+        // 按外层做一次计数排序分桶，再在每个区间内按内层排序并合并重复位置
+        void assemble(const std::vector<Triplet<T>> &triplets)
+        {
+            const size_t outer = outerSize(), inner = innerSize(), count = triplets.size();
+            m_outer.assign(outer + 1, 0);
+            for (const Triplet<T> &t : triplets)
+            {
+                const size_t k = RowMajor ? t.row : t.col, i = RowMajor ? t.col : t.row;
+                if (k >= outer || i >= inner)
+                    throw std::out_of_range("Triplet index out of range");
+                ++m_outer[k + 1];
+            }
+            for (size_t k = 0; k < outer; ++k)
+                m_outer[k + 1] += m_outer[k];
+            std::vector<size_t> next(m_outer.begin(), m_outer.end() - 1);
+            m_inner.resize(count);
+            m_values.resize(count);
+            for (const Triplet<T> &t : triplets)
+            {
+                const size_t p = next[RowMajor ? t.row : t.col]++;
+                m_inner[p] = static_cast<Index>(RowMajor ? t.col : t.row);
+                m_values[p] = t.value;
+            }
+
+            size_t write = 0;
+            for (size_t k = 0; k < outer; ++k)
+            {
+                const size_t begin = m_outer[k], end = m_outer[k + 1];
+                sortSegment(begin, end);
+                m_outer[k] = write;
+                for (size_t p = begin; p < end; ++p)
+                {
+                    if (write > m_outer[k] && m_inner[write - 1] == m_inner[p])
+                        m_values[write - 1] += m_values[p];
+                    else
+                    {
+                        m_inner[write] = m_inner[p];
+                        m_values[write] = m_values[p];
+                        ++write;
+                    }
+                }
+            }
+            m_outer[outer] = write;
+            if (write < count)
+            {
+                m_inner.resize(write);
+                m_values.resize(write);
+                m_inner.shrink_to_fit();
+                m_values.shrink_to_fit();
+            }
+            finalize();
+        }
+
+        template <typename V>
+        static void checkVector(const V &v, size_t n, const char *message)
+        {
+            if (v.rows() * v.cols() != n)
+                throw std::invalid_argument(message);
+        }
+
+        template <typename, bool>
+        friend class SparseMatrix;
+
+    public:
+        static constexpr bool IsRowMajor = RowMajor;
+
+        SparseMatrix() : m_rows(0), m_cols(0), m_outer(1, 0) { finalize(); }
+
+        // rows×cols 的零矩阵
+        SparseMatrix(size_t rows, size_t cols) : m_rows(rows), m_cols(cols)
+        {
+            checkDimensions(rows, cols);
+            m_outer.assign(outerSize() + 1, 0);
+            finalize();
+        }
+
+        /**
+         * @brief 由三元组组装，同一位置出现多次时数值相加
+         * @throw std::out_of_range 三元组的行或列越界
+         */
+        SparseMatrix(size_t rows, size_t cols, const std::vector<Triplet<T>> &triplets)
+            : m_rows(rows), m_cols(cols)
+        {
+            checkDimensions(rows, cols);
+            assemble(triplets);
+        }
+
+        /**
+         * @brief 直接接管压缩格式的三个数组
+         * @throw std::invalid_argument 外层指针不单调、长度不符，或某个区间内的内层索引不严格递增或越界
+         */
+        SparseMatrix(size_t rows, size_t cols, std::vector<size_t> outer, std::vector<Index> inner,
+                     std::vector<T> values)
+            : m_rows(rows), m_cols(cols), m_outer(std::move(outer)), m_inner(std::move(inner)),
+              m_values(std::move(values))
+        {
+            checkDimensions(rows, cols);
+            if (m_outer.size() != outerSize() + 1 || m_outer[0] != 0 || m_inner.size() != m_outer.back() ||
+                m_values.size() != m_inner.size())
+                throw std::invalid_argument("Inconsistent compressed sparse arrays");
+            for (size_t k = 0; k < outerSize(); ++k)
+            {
+                if (m_outer[k] > m_outer[k + 1])
+                    throw std::invalid_argument("Inconsistent compressed sparse arrays");
+                for (size_t p = m_outer[k]; p < m_outer[k + 1]; ++p)
+                    if (m_inner[p] >= innerSize() || (p > m_outer[k] && m_inner[p] <= m_inner[p - 1]))
+                        throw std::invalid_argument("Inconsistent compressed sparse arrays");
+            }
+            finalize();
+        }
+
+        // 由 CSC 构造 CSR 或反之，O(nnz + rows + cols)
+        explicit SparseMatrix(const SparseMatrix<T, !RowMajor> &other) : m_rows(other.m_rows), m_cols(other.m_cols)
+        {
+            const size_t outer = outerSize(), nnz = other.nonZeros();
+            m_outer.assign(outer + 1, 0);
+            for (size_t p = 0; p < nnz; ++p)
+                ++m_outer[other.m_inner[p] + 1];
+            for (size_t k = 0; k < outer; ++k)
+                m_outer[k + 1] += m_outer[k];
+            std::vector<size_t> next(m_outer.begin(), m_outer.end() - 1);
+            m_inner.resize(nnz);
+            m_values.resize(nnz);
+            for (size_t j = 0; j < other.outerSize(); ++j)
+                for (size_t p = other.m_outer[j]; p < other.m_outer[j + 1]; ++p)
+                {
+                    const size_t q = next[other.m_inner[p]]++;
+                    m_inner[q] = static_cast<Index>(j);
+                    m_values[q] = other.m_values[p];
+                }
+            finalize();
+        }
+
+        /**
+         * @brief 从稠密矩阵中取出所有非零元
+         */
+        template <typename Derived>
+        static SparseMatrix fromDense(const MatrixBase<Derived> &dense)
+        {
+            const Derived &A = dense.derived();
+            std::vector<Triplet<T>> triplets;
+            for (size_t i = 0; i < A.rows(); ++i)
+                for (size_t j = 0; j < A.cols(); ++j)
+                {
+                    const T v = A(i, j);
+                    if (!(v == T()))
+                        triplets.push_back(Triplet<T>(i, j, v));
+                }
+            return SparseMatrix(A.rows(), A.cols(), triplets);
+        }
+
+        size_t rows() const { return m_rows; }
+        size_t cols() const { return m_cols; }
+        size_t nonZeros() const { return m_values.size(); }
+
+        // 压缩格式的原始数组
+        const size_t *outerIndexPtr() const { return m_outer.data(); }
+        const Index *innerIndexPtr() const { return m_inner.data(); }
+        const T *valuePtr() const { return m_values.data(); }
+        T *valuePtr() { return m_values.data(); }
+
+        // 元素 (i, j)，不在非零结构中的位置返回 0；在区间内二分查找
+        T coeff(size_t i, size_t j) const
+        {
+            if (i >= m_rows || j >= m_cols)
+                throw std::out_of_range("Sparse matrix index out of range");
+            const size_t k = RowMajor ? i : j, key = RowMajor ? j : i;
+            const Index *begin = m_inner.data() + m_outer[k], *end = m_inner.data() + m_outer[k + 1];
+            const Index *it = std::lower_bound(begin, end, static_cast<Index>(key));
+            return it != end && *it == key ? m_values[it - m_inner.data()] : T();
+        }
+
+        // 转置：CSR 的数组按 CSC 解读即为转置矩阵，不需要重排
+        SparseMatrix<T, !RowMajor> transpose() const
+        {
+            SparseMatrix<T, !RowMajor> result;
+            result.m_rows = m_cols;
+            result.m_cols = m_rows;
+            result.m_outer = m_outer;
+            result.m_inner = m_inner;
+            result.m_values = m_values;
+            result.m_partition = m_partition;
+            return result;
+        }
+
+        MatrixNM<T, Dynamic, Dynamic> toDense() const
+        {
+            MatrixNM<T, Dynamic, Dynamic> result(m_rows, m_cols);
+            T *out = result.data();
+            for (size_t k = 0; k < outerSize(); ++k)
+                for (size_t p = m_outer[k]; p < m_outer[k + 1]; ++p)
+                {
+                    const size_t i = RowMajor ? k : m_inner[p], j = RowMajor ? m_inner[p] : k;
+                    out[i * m_cols + j] = m_values[p];
+                }
+            return result;
+        }
+
+        /**
+         * @brief y = A * x，写入已有的 y 中，不分配内存（CSC 多线程时第一次调用会建立一次转置索引）
+         * @throw std::invalid_argument x 长度不等于列数或 y 长度不等于行数
+         */
+        template <size_t N, size_t M>
+        void multiply(const VectorN<T, N> &x, VectorN<T, M> &y) const
+        {
+            checkVector(x, m_cols, "Sparse product dimension mismatch");
+            checkVector(y, m_rows, "Sparse product dimension mismatch");
+            if (static_cast<const void *>(x.data()) == static_cast<const void *>(y.data()))
+                throw std::invalid_argument("Sparse product output must not alias its input");
+            if (RowMajor)
+                internal::sparseGatherParallel(m_partition, m_outer.data(), m_inner.data(),
+                                               Elem::cast(m_values.data()), Elem::cast(x.data()), Elem::cast(y.data()));
+            else
+                scatterProduct(Elem::cast(x.data()), Elem::cast(y.data()));
+        }
+
+        /**
+         * @brief y = Aᵀ * x，写入已有的 y 中，不分配内存（CSR 多线程时第一次调用会建立一次转置索引）
+         * @throw std::invalid_argument x 长度不等于行数或 y 长度不等于列数
+         */
+        template <size_t N, size_t M>
+        void transposeMultiply(const VectorN<T, N> &x, VectorN<T, M> &y) const
+        {
+            checkVector(x, m_rows, "Sparse product dimension mismatch");
+            checkVector(y, m_cols, "Sparse product dimension mismatch");
+            if (static_cast<const void *>(x.data()) == static_cast<const void *>(y.data()))
+                throw std::invalid_argument("Sparse product output must not alias its input");
+            if (RowMajor)
+                scatterProduct(Elem::cast(x.data()), Elem::cast(y.data()));
+            else
+                internal::sparseGatherParallel(m_partition, m_outer.data(), m_inner.data(),
+                                               Elem::cast(m_values.data()), Elem::cast(x.data()), Elem::cast(y.data()));
+        }
+
+        // Aᵀ * x，返回新向量
+        template <size_t N>
+        VectorN<T, Dynamic> transposeMultiply(const VectorN<T, N> &x) const
+        {
+            VectorN<T, Dynamic> y(m_cols);
+            transposeMultiply(x, y);
+            return y;
+        }
+
+        // A * x，返回新向量
+        template <size_t N>
+        friend VectorN<T, Dynamic> operator*(const SparseMatrix &A, const VectorN<T, N> &x)
+        {
+            VectorN<T, Dynamic> y(A.m_rows);
+            A.multiply(x, y);
+            return y;
+        }
+    };
+
+    template <typename T, bool RowMajor>
+    constexpr bool SparseMatrix<T, RowMajor>::IsRowMajor;
+
+    template <typename T>
+    using CSRMatrix = SparseMatrix<T, true>;
+    template <typename T>
+    using CSCMatrix = SparseMatrix<T, false>;
+    using SparseMatrixXf = CSRMatrix<Real>;
+    using SparseMatrixXc = CSRMatrix<Complex>;
+}
@@ -0,0 +1,558 @@
+/**
+ * @file SplitComplex.hpp
+ * @brief 实部/虚部分离存储（SoA）的复数向量与矩阵，以及在其上向量化的复数运算。
+ * @details BasicComplex 把实部和虚部交错存放，一次乘法需要在一个 SIMD 寄存器内交换分量，
+ *          编译器难以向量化。SplitComplexVector / SplitComplexMatrix 把所有实部、所有虚部
+ *          各自放在一块 64 字节对齐的连续内存中，这样：
+ *          - 加、减、逐元素乘、点积按 Packet 宽度同时处理多个复数；
+ *          - 矩阵乘法拆成四次实数 GEMM：Cr = Ar Br - Ai Bi，Ci = Ar Bi + Ai Br；
+ *          - exp、sqrt、log 使用 SimdMath.hpp 中的数据包实现。
+ *          运算遵循 IEEE 754 语义（不做除零等检查），Policy 只决定读出的 BasicComplex 类型。
+ */
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include "NumberField.hpp"
+#include "DenseStorage.hpp"
+#include "Simd.hpp"
+#include "SimdMath.hpp"
+#include "Gemm.hpp"
+#include "Assign.hpp"
+#include "MatrixNM.hpp"
+#include "VectorN.hpp"
+
+namespace OxygenMath
+{
+    namespace internal
+    {
+        /**
+         * @brief 64 字节对齐的定长浮点数组
+         * @details 默认把元素初始化为 0；运算结果的缓冲区随后会被整体覆盖，用 zeroFill = false 跳过初始化。
+         */
+        template <typename F>
+        class AlignedArray
+        {
+        private:
+            F *m_data;
+            size_t m_size;
+
+        public:
+            explicit AlignedArray(size_t n = 0, bool zeroFill = true)
+                : m_data(static_cast<F *>(alignedMalloc(n * sizeof(F)))), m_size(n)
+            {
+                if (zeroFill)
+                    std::fill(m_data, m_data + n, F(0));
+            }
+
+            AlignedArray(const AlignedArray &other) : AlignedArray(other.m_size, false)
+            {
+                std::copy(other.m_data, other.m_data + m_size, m_data);
+            }
+
+            AlignedArray(AlignedArray &&other) noexcept : m_data(other.m_data), m_size(other.m_size)
+            {
+                other.m_data = nullptr;
+                other.m_size = 0;
+            }
+
+            AlignedArray &operator=(AlignedArray other) noexcept
+            {
+                swap(other);
+                return *this;
+            }
+
+            ~AlignedArray() { alignedFree(m_data); }
+
+            void swap(AlignedArray &other) noexcept
+            {
+                std::swap(m_data, other.m_data);
+                std::swap(m_size, other.m_size);
+            }
+
+            F *data() { return m_data; }
+            const F *data() const { return m_data; }
+            size_t size() const { return m_size; }
+        };
+
+        struct UninitializedTag
+        {
+        };
+
+        /**
+         * @brief 对 n 个复数逐个执行 Op::apply，整包部分用 Packet<F>，尾部用 ScalarPacket<F>
+         */
+        template <typename Op, typename F>
+        void splitUnary(size_t n, const F *ar, const F *ai, F *cr, F *ci)
+        {
+            typedef simd::Packet<F> P;
+            typedef simd::ScalarPacket<F> S;
+            size_t i = 0;
+            for (; i + P::size <= n; i += P::size)
+            {
+                typename P::type re, im;
+                Op::template apply<P>(P::loadu(ar + i), P::loadu(ai + i), re, im);
+                P::storeu(cr + i, re);
+                P::storeu(ci + i, im);
+            }
+            for (; i < n; ++i)
+                Op::template apply<S>(ar[i], ai[i], cr[i], ci[i]);
+        }
+
+        template <typename Op, typename F>
+        void splitBinary(size_t n, const F *ar, const F *ai, const F *br, const F *bi, F *cr, F *ci)
+        {
+            typedef simd::Packet<F> P;
+            typedef simd::ScalarPacket<F> S;
+            size_t i = 0;
+            for (; i + P::size <= n; i += P::size)
+            {
+                typename P::type re, im;
+                Op::template apply<P>(P::loadu(ar + i), P::loadu(ai + i), P::loadu(br + i), P::loadu(bi + i), re, im);
+                P::storeu(cr + i, re);
+                P::storeu(ci + i, im);
+            }
+            for (; i < n; ++i)
+                Op::template apply<S>(ar[i], ai[i], br[i], bi[i], cr[i], ci[i]);
+        }
+
+        struct SplitAddOp
+        {
+            template <typename P>
+            static void apply(typename P::type ar, typename P::type ai, typename P::type br, typename P::type bi,
+                              typename P::type &cr, typename P::type &ci)
+            {
+                cr = P::add(ar, br);
+                ci = P::add(ai, bi);
+            }
+        };
+
+        struct SplitSubOp
+        {
+            template <typename P>
+            static void apply(typename P::type ar, typename P::type ai, typename P::type br, typename P::type bi,
+                              typename P::type &cr, typename P::type &ci)
+            {
+                cr = P::sub(ar, br);
+                ci = P::sub(ai, bi);
+            }
+        };
+
+        // (ar + i ai)(br + i bi) = (ar br - ai bi) + i (ar bi + ai br)
+        struct SplitMulOp
+        {
+            template <typename P>
+            static void apply(typename P::type ar, typename P::type ai, typename P::type br, typename P::type bi,
+                              typename P::type &cr, typename P::type &ci)
+            {
+                cr = P::sub(P::mul(ar, br), P::mul(ai, bi));
+                ci = P::fmadd(ar, bi, P::mul(ai, br));
+            }
+        };
+
+        struct SplitExpOp
+        {
+            template <typename P>
+            static void apply(typename P::type re, typename P::type im, typename P::type &cr, typename P::type &ci)
+            {
+                simd::complexExp<P>(re, im, cr, ci);
+            }
+        };
+
+        struct SplitSqrtOp
+        {
+            template <typename P>
+            static void apply(typename P::type re, typename P::type im, typename P::type &cr, typename P::type &ci)
+            {
+                simd::complexSqrt<P>(re, im, cr, ci);
+            }
+        };
+
+        struct SplitLogOp
+        {
+            template <typename P>
+            static void apply(typename P::type re, typename P::type im, typename P::type &cr, typename P::type &ci)
+            {
+                simd::complexLog<P>(re, im, cr, ci);
+            }
+        };
+
+        /**
+         * @brief 不取共轭的点积 sum(a[i] * b[i])，与 VectorN<Complex, N>::dot 的定义一致
+         */
+        template <typename F>
+        void splitDot(size_t n, const F *ar, const F *ai, const F *br, const F *bi, F &re, F &im)
+        {
+            typedef simd::Packet<F> P;
+            typename P::type accRe = P::zero(), accIm = P::zero();
+            size_t i = 0;
+            for (; i + P::size <= n; i += P::size)
+            {
+                const typename P::type xr = P::loadu(ar + i), xi = P::loadu(ai + i);
+                const typename P::type yr = P::loadu(br + i), yi = P::loadu(bi + i);
+                accRe = P::fmadd(xr, yr, accRe);
+                accRe = P::sub(accRe, P::mul(xi, yi));
+                accIm = P::fmadd(xr, yi, accIm);
+                accIm = P::fmadd(xi, yr, accIm);
+            }
+            alignas(64) F lanesRe[P::size], lanesIm[P::size];
+            P::store(lanesRe, accRe);
+            P::store(lanesIm, accIm);
+            re = F(0);
+            im = F(0);
+            for (size_t l = 0; l < P::size; ++l)
+            {
+                re += lanesRe[l];
+                im += lanesIm[l];
+            }
+            for (; i < n; ++i)
+            {
+                re += ar[i] * br[i] - ai[i] * bi[i];
+                im += ar[i] * bi[i] + ai[i] * br[i];
+            }
+        }
+    }
+
+    /**
+     * @brief 实部/虚部分离存储的运行期尺寸复数矩阵（行主序）
+     * @tparam F 底层浮点类型（double 或 float）
+     * @tparam Policy 读出元素时使用的 BasicComplex 检查策略
+     */
+    template <typename F, typename Policy = CheckedArithmetic>
+    class SplitComplexMatrix
+    {
+    private:
+        size_t m_rows, m_cols;
+        internal::AlignedArray<F> m_re, m_im;
+
+    public:
+        using Scalar = BasicComplex<F, Policy>;
+
+        SplitComplexMatrix() : m_rows(0), m_cols(0) {}
+
+        SplitComplexMatrix(size_t rows, size_t cols)
+            : m_rows(rows), m_cols(cols), m_re(rows * cols), m_im(rows * cols) {}
+
+        // 不初始化元素，供随后整体写入结果的运算使用
+        SplitComplexMatrix(size_t rows, size_t cols, internal::UninitializedTag)
+            : m_rows(rows), m_cols(cols), m_re(rows * cols, false), m_im(rows * cols, false) {}
+
+        // 从任意复数矩阵表达式转换（例如 MatrixXc 或 A * B）
+        template <typename Expr>
+        explicit SplitComplexMatrix(const MatrixBase<Expr> &expr)
+            : SplitComplexMatrix(expr.rows(), expr.cols(), internal::UninitializedTag())
+        {
+            internal::Evaluator<Expr> ev(expr.derived());
+            for (size_t i = 0; i < m_rows; ++i)
+                for (size_t j = 0; j < m_cols; ++j)
+                {
+                    const auto value = ev.coeff(i, j);
+                    m_re.data()[i * m_cols + j] = static_cast<F>(value.real);
+                    m_im.data()[i * m_cols + j] = static_cast<F>(value.imag);
+                }
+        }
+
+        size_t rows() const { return m_rows; }
+        size_t cols() const { return m_cols; }
+        size_t size() const { return m_rows * m_cols; }
+
+        Scalar operator()(size_t i, size_t j) const
+        {
+            if (i >= m_rows || j >= m_cols)
+                throw std::out_of_range("Matrix index out of range");
+            return Scalar(m_re.data()[i * m_cols + j], m_im.data()[i * m_cols + j]);
+        }
+
+        void set(size_t i, size_t j, const Scalar &value)
+        {
+            if (i >= m_rows || j >= m_cols)
+                throw std::out_of_range("Matrix index out of range");
+            m_re.data()[i * m_cols + j] = value.real;
+            m_im.data()[i * m_cols + j] = value.imag;
+        }
+
+        // 实部、虚部平面，元素 (i, j) 位于下标 i * cols() + j
+        F *realData() { return m_re.data(); }
+        const F *realData() const { return m_re.data(); }
+        F *imagData() { return m_im.data(); }
+        const F *imagData() const { return m_im.data(); }
+
+        SplitComplexMatrix &operator+=(const SplitComplexMatrix &other)
+        {
+            if (m_rows != other.m_rows || m_cols != other.m_cols)
+                throw std::invalid_argument("Matrix dimensions do not match");
+            internal::splitBinary<internal::SplitAddOp>(size(), realData(), imagData(), other.realData(), other.imagData(),
+                                                        realData(), imagData());
+            return *this;
+        }
+
+        SplitComplexMatrix &operator-=(const SplitComplexMatrix &other)
+        {
+            if (m_rows != other.m_rows || m_cols != other.m_cols)
+                throw std::invalid_argument("Matrix dimensions do not match");
+            internal::splitBinary<internal::SplitSubOp>(size(), realData(), imagData(), other.realData(), other.imagData(),
+                                                        realData(), imagData());
+            return *this;
+        }
+
+        // 转换回交错存储的复数矩阵
+        MatrixX<Scalar> toMatrix() const
+        {
+            MatrixX<Scalar> result(m_rows, m_cols);
+            for (size_t i = 0; i < m_rows; ++i)
+                for (size_t j = 0; j < m_cols; ++j)
+                    result(i, j) = Scalar(m_re.data()[i * m_cols + j], m_im.data()[i * m_cols + j]);
+            return result;
+        }
+    };
+
+    /**
+     * @brief 实部/虚部分离存储的运行期尺寸复数向量
+     */
+    template <typename F, typename Policy = CheckedArithmetic>
+    class SplitComplexVector
+    {
+    private:
+        internal::AlignedArray<F> m_re, m_im;
+
+    public:
+        using Scalar = BasicComplex<F, Policy>;
+
+        SplitComplexVector() {}
+
+        explicit SplitComplexVector(size_t n) : m_re(n), m_im(n) {}
+
+        SplitComplexVector(size_t n, internal::UninitializedTag) : m_re(n, false), m_im(n, false) {}
+
+        // 从任意复数行/列向量表达式转换
+        template <typename Expr>
+        explicit SplitComplexVector(const MatrixBase<Expr> &expr)
+            : SplitComplexVector(expr.rows() * expr.cols(), internal::UninitializedTag())
+        {
+            if (expr.rows() != 1 && expr.cols() != 1)
+                throw std::invalid_argument("Expression is not a vector");
+            internal::Evaluator<Expr> ev(expr.derived());
+            const bool column = expr.cols() == 1;
+            for (size_t i = 0; i < size(); ++i)
+            {
+                const auto value = column ? ev.coeff(i, 0) : ev.coeff(0, i);
+                m_re.data()[i] = static_cast<F>(value.real);
+                m_im.data()[i] = static_cast<F>(value.imag);
+            }
+        }
+
+        size_t size() const { return m_re.size(); }
+
+        // 与 set 一样检查下标；批量访问请直接使用 realData()/imagData()
+        Scalar operator[](size_t i) const
+        {
+            if (i >= size())
+                throw std::out_of_range("Vector index out of range");
+            return Scalar(m_re.data()[i], m_im.data()[i]);
+        }
+
+        void set(size_t i, const Scalar &value)
+        {
+            if (i >= size())
+                throw std::out_of_range("Vector index out of range");
+            m_re.data()[i] = value.real;
+            m_im.data()[i] = value.imag;
+        }
+
+        F *realData() { return m_re.data(); }
+        const F *realData() const { return m_re.data(); }
+        F *imagData() { return m_im.data(); }
+        const F *imagData() const { return m_im.data(); }
+
+        SplitComplexVector &operator+=(const SplitComplexVector &other)
+        {
+            if (size() != other.size())
+                throw std::invalid_argument("Vector sizes do not match");
+            internal::splitBinary<internal::SplitAddOp>(size(), realData(), imagData(), other.realData(), other.imagData(),
+                                                        realData(), imagData());
+            return *this;
+        }
+
+        SplitComplexVector &operator-=(const SplitComplexVector &other)
+        {
+            if (size() != other.size())
+                throw std::invalid_argument("Vector sizes do not match");
+            internal::splitBinary<internal::SplitSubOp>(size(), realData(), imagData(), other.realData(), other.imagData(),
+                                                        realData(), imagData());
+            return *this;
+        }
+
+        // 转换回交错存储的复数向量
+        VectorX<Scalar> toVector() const
+        {
+            VectorX<Scalar> result(size());
+            for (size_t i = 0; i < size(); ++i)
+                result[i] = (*this)[i];
+            return result;
+        }
+    };
+
+    namespace internal
+    {
+        template <typename Op, typename Split>
+        Split splitElementwise(const Split &a, const Split &b, Split result)
+        {
+            splitBinary<Op>(a.size(), a.realData(), a.imagData(), b.realData(), b.imagData(),
+                            result.realData(), result.imagData());
+            return result;
+        }
+
+        template <typename Op, typename Split>
+        Split splitApply(const Split &a, Split result)
+        {
+            splitUnary<Op>(a.size(), a.realData(), a.imagData(), result.realData(), result.imagData());
+            return result;
+        }
+
+        template <typename F, typename P>
+        void checkSameShape(const SplitComplexMatrix<F, P> &a, const SplitComplexMatrix<F, P> &b)
+        {
+            if (a.rows() != b.rows() || a.cols() != b.cols())
+                throw std::invalid_argument("Matrix dimensions do not match");
+        }
+
+        template <typename F, typename P>
+        void checkSameShape(const SplitComplexVector<F, P> &a, const SplitComplexVector<F, P> &b)
+        {
+            if (a.size() != b.size())
+                throw std::invalid_argument("Vector sizes do not match");
+        }
+
+        template <typename F, typename P>
+        SplitComplexMatrix<F, P> emptyLike(const SplitComplexMatrix<F, P> &a)
+        {
+            return SplitComplexMatrix<F, P>(a.rows(), a.cols(), UninitializedTag());
+        }
+
+        template <typename F, typename P>
+        SplitComplexVector<F, P> emptyLike(const SplitComplexVector<F, P> &a)
+        {
+            return SplitComplexVector<F, P>(a.size(), UninitializedTag());
+        }
+    }
+
+    // ------------------ 逐元素运算（向量与矩阵通用） ------------------
+
+    template <typename F, typename P>
+    SplitComplexMatrix<F, P> operator+(const SplitComplexMatrix<F, P> &a, const SplitComplexMatrix<F, P> &b)
+    {
+        internal::checkSameShape(a, b);
+        return internal::splitElementwise<internal::SplitAddOp>(a, b, internal::emptyLike(a));
+    }
+
+    template <typename F, typename P>
+    SplitComplexVector<F, P> operator+(const SplitComplexVector<F, P> &a, const SplitComplexVector<F, P> &b)
+    {
+        internal::checkSameShape(a, b);
+        return internal::splitElementwise<internal::SplitAddOp>(a, b, internal::emptyLike(a));
+    }
+
+    template <typename F, typename P>
+    SplitComplexMatrix<F, P> operator-(const SplitComplexMatrix<F, P> &a, const SplitComplexMatrix<F, P> &b)
+    {
+        internal::checkSameShape(a, b);
+        return internal::splitElementwise<internal::SplitSubOp>(a, b, internal::emptyLike(a));
+    }
+
+    template <typename F, typename P>
+    SplitComplexVector<F, P> operator-(const SplitComplexVector<F, P> &a, const SplitComplexVector<F, P> &b)
+    {
+        internal::checkSameShape(a, b);
+        return internal::splitElementwise<internal::SplitSubOp>(a, b, internal::emptyLike(a));
+    }
+
+    /**
+     * @brief 逐元素复数乘法
+     */
+    template <typename F, typename P>
+    SplitComplexMatrix<F, P> hadamard(const SplitComplexMatrix<F, P> &a, const SplitComplexMatrix<F, P> &b)
+    {
+        internal::checkSameShape(a, b);
+        return internal::splitElementwise<internal::SplitMulOp>(a, b, internal::emptyLike(a));
+    }
+
+    template <typename F, typename P>
+    SplitComplexVector<F, P> hadamard(const SplitComplexVector<F, P> &a, const SplitComplexVector<F, P> &b)
+    {
+        internal::checkSameShape(a, b);
+        return internal::splitElementwise<internal::SplitMulOp>(a, b, internal::emptyLike(a));
+    }
+
+    /**
+     * @brief 点积 sum(a[i] * b[i])（不取共轭）
+     */
+    template <typename F, typename P>
+    BasicComplex<F, P> dot(const SplitComplexVector<F, P> &a, const SplitComplexVector<F, P> &b)
+    {
+        internal::checkSameShape(a, b);
+        F re, im;
+        internal::splitDot(a.size(), a.realData(), a.imagData(), b.realData(), b.imagData(), re, im);
+        return BasicComplex<F, P>(re, im);
+    }
+
+    /**
+     * @brief 复数矩阵乘法，拆成四次实数 GEMM
+     */
+    template <typename F, typename P>
+    SplitComplexMatrix<F, P> operator*(const SplitComplexMatrix<F, P> &a, const SplitComplexMatrix<F, P> &b)
+    {
+        if (a.cols() != b.rows())
+            throw std::invalid_argument("In matrix multiplication, the number of columns in the first matrix must be equal to the number of rows in the second matrix.");
+        const size_t m = a.rows(), n = b.cols(), k = a.cols();
+        SplitComplexMatrix<F, P> c(m, n, internal::UninitializedTag());
+        internal::gemm<F>(m, n, k, F(1), a.realData(), k, 1, b.realData(), n, 1, F(0), c.realData(), n);
+        internal::gemm<F>(m, n, k, F(-1), a.imagData(), k, 1, b.imagData(), n, 1, F(1), c.realData(), n);
+        internal::gemm<F>(m, n, k, F(1), a.realData(), k, 1, b.imagData(), n, 1, F(0), c.imagData(), n);
+        internal::gemm<F>(m, n, k, F(1), a.imagData(), k, 1, b.realData(), n, 1, F(1), c.imagData(), n);
+        return c;
+    }
+
+    // ------------------ 逐元素初等函数 ------------------
+
+    template <typename F, typename P>
+    SplitComplexMatrix<F, P> exp(const SplitComplexMatrix<F, P> &a)
+    {
+        return internal::splitApply<internal::SplitExpOp>(a, internal::emptyLike(a));
+    }
+
+    template <typename F, typename P>
+    SplitComplexVector<F, P> exp(const SplitComplexVector<F, P> &a)
+    {
+        return internal::splitApply<internal::SplitExpOp>(a, internal::emptyLike(a));
+    }
+
+    template <typename F, typename P>
+    SplitComplexMatrix<F, P> sqrt(const SplitComplexMatrix<F, P> &a)
+    {
+        return internal::splitApply<internal::SplitSqrtOp>(a, internal::emptyLike(a));
+    }
+
+    template <typename F, typename P>
+    SplitComplexVector<F, P> sqrt(const SplitComplexVector<F, P> &a)
+    {
+        return internal::splitApply<internal::SplitSqrtOp>(a, internal::emptyLike(a));
+    }
+
+    // 主值对数；与 IEEE 语义一致，z = 0 时实部为 -inf
+    template <typename F, typename P>
+    SplitComplexMatrix<F, P> log(const SplitComplexMatrix<F, P> &a)
+    {
+        return internal::splitApply<internal::SplitLogOp>(a, internal::emptyLike(a));
+    }
+
+    template <typename F, typename P>
+    SplitComplexVector<F, P> log(const SplitComplexVector<F, P> &a)
+    {
+        return internal::splitApply<internal::SplitLogOp>(a, internal::emptyLike(a));
+    }
+
+    using SplitMatrixXc = SplitComplexMatrix<double>;
+    using SplitVectorXc = SplitComplexVector<double>;
+    using SplitMatrixXc32 = SplitComplexMatrix<float>;
+    using SplitVectorXc32 = SplitComplexVector<float>;
+}
@@ -0,0 +1,395 @@
+/**
+ * @file SymmetricKernel.hpp
+ * @brief 对称矩阵分解内核：分块 Cholesky（A = L * L^T）与 Bunch-Kaufman 主元的 LDL^T（P^T * A * P = L * D * L^T）。
+ * @details 与 LUKernel.hpp 相同，矩阵按行主序存储、行跨度为 ld，两种分解都只读取输入的下三角。
+ *          Cholesky 按 NB 列分块：对角块做非分块分解，面板 L21 由三角求解得到，尾部更新 A22 -= L21 * L21^T
+ *          只计算下三角的块（按块行调用 GEMM），浮点运算量约为 LU 的一半。
+ *          LDL^T 对称不定矩阵使用 Bunch-Kaufman 部分主元（1x1 或 2x2 主元块，alpha = (1 + sqrt(17)) / 8），
+ *          每一步的对称行列交换同时作用于已求出的 L 的行，因此 L 是普通的单位下三角矩阵。
+ */
+#pragma once
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+#include "LUKernel.hpp"
+
+namespace OxygenMath
+{
+    namespace internal
+    {
+        template <typename E>
+        auto symSqrt(const E &x) -> typename std::enable_if<std::is_floating_point<E>::value, E>::type
+        {
+            return std::sqrt(x);
+        }
+
+        template <typename E>
+        auto symSqrt(const E &x) -> typename std::enable_if<!std::is_floating_point<E>::value, decltype(sqrt(x))>::type
+        {
+            return sqrt(x);
+        }
+
+        /**
+         * @brief C(m×n) -= A(m×k) * B(k×n)，A、B 的元素按任意行/列跨度访问，C 为行主序（行跨度 ldc），三者互不重叠
+         * @details 用于转置读取 L 的更新。浮点元素且列数足够时使用 GEMM（打包时处理跨度），否则按 p-i-j 顺序循环。
+         */
+        template <typename E>
+        void stridedUpdate(size_t m, size_t n, size_t k, const E *A, size_t rsA, size_t csA,
+                           const E *B, size_t rsB, size_t csB, E *C, size_t ldc, std::false_type)
+        {
+            for (size_t p = 0; p < k; ++p)
+            {
+                const E *b = B + p * rsB;
+                for (size_t i = 0; i < m; ++i)
+                {
+                    const E aip = A[i * rsA + p * csA];
+                    E *c = C + i * ldc;
+                    for (size_t j = 0; j < n; ++j)
+                        c[j] -= aip * b[j * csB];
+                }
+            }
+        }
+
+        template <typename E>
+        void stridedUpdate(size_t m, size_t n, size_t k, const E *A, size_t rsA, size_t csA,
+                           const E *B, size_t rsB, size_t csB, E *C, size_t ldc, std::true_type)
+        {
+            if (n >= LUSolveGemmColumns)
+            {
+                gemm<E>(m, n, k, E(-1), A, rsA, csA, B, rsB, csB, E(1), C, ldc);
+                return;
+            }
+            stridedUpdate(m, n, k, A, rsA, csA, B, rsB, csB, C, ldc, std::false_type());
+        }
+
+        /**
+         * @brief 原地分块 Cholesky 分解 A = L * L^T，只读写下三角（对角块上三角的内容随之失效）
+         * @param n 矩阵阶数
+         * @param A 行主序矩阵，返回时下三角为 L
+         * @param ld 行跨度
+         * @return 成功时返回 n；遇到非正主元时返回该列下标，矩阵不是正定的
+         */
+        template <typename E>
+        size_t choleskyBlocked(size_t n, E *A, size_t ld)
+        {
+            typedef std::integral_constant<bool, std::is_floating_point<E>::value> UseGemm;
+            for (size_t j0 = 0; j0 < n; j0 += LUBlockSize)
+            {
+                const size_t j1 = std::min(n, j0 + LUBlockSize);
+
+                // 对角块 A11 = L11 * L11^T
+                for (size_t k = j0; k < j1; ++k)
+                {
+                    E *rowK = A + k * ld;
+                    if (!(rowK[k] > E(0)))
+                        return k;
+                    rowK[k] = symSqrt(rowK[k]);
+                    for (size_t i = k + 1; i < j1; ++i)
+                        A[i * ld + k] = A[i * ld + k] / rowK[k];
+                    for (size_t i = k + 1; i < j1; ++i)
+                    {
+                        E *rowI = A + i * ld;
+                        const E lik = rowI[k];
+                        for (size_t j = k + 1; j <= i; ++j)
+                            rowI[j] -= lik * A[j * ld + k];
+                    }
+                }
+                if (j1 == n)
+                    break;
+
+                // L21 = A21 * L11^-T，逐行前向替换。先把 L11 转置到对角块的上三角，
+                // 使每一步都是对该行的连续 axpy，而不是按列跨行读取 L11
+                for (size_t k = j0; k < j1; ++k)
+                    for (size_t q = k + 1; q < j1; ++q)
+                        A[k * ld + q] = A[q * ld + k];
+                for (size_t i = j1; i < n; ++i)
+                {
+                    E *rowI = A + i * ld;
+                    for (size_t k = j0; k < j1; ++k)
+                    {
+                        const E *rowK = A + k * ld;
+                        const E lik = rowI[k] / rowK[k];
+                        rowI[k] = lik;
+                        for (size_t q = k + 1; q < j1; ++q)
+                            rowI[q] -= lik * rowK[q];
+                    }
+                }
+
+                // A22 -= L21 * L21^T，只更新下三角的块：第 [i0, i1) 行更新第 [j1, i1) 列
+                for (size_t i0 = j1; i0 < n; i0 += LUBlockSize)
+                {
+                    const size_t i1 = std::min(n, i0 + LUBlockSize);
+                    stridedUpdate(i1 - i0, i1 - j1, j1 - j0, A + i0 * ld + j0, ld, 1,
+                                  A + j1 * ld + j0, 1, ld, A + i0 * ld + j1, ld, UseGemm());
+                }
+            }
+            return n;
+        }
+
+        /**
+         * @brief 用 Cholesky 因子 L 原地求解 L * L^T * X = B，B 为 n×nrhs 行主序（行跨度 ldb）
+         * @details 前向替换 L * Y = B 与 luForwardSubstitute 结构相同；后向替换 L^T * X = Y 在块内按列消去，
+         *          块外更新 B[0:j0] -= L[j0:j1, 0:j0]^T * B[j0:j1] 以转置方式读取 L。
+         */
+        template <typename E>
+        void choleskySolveRows(size_t n, const E *L, size_t ld, E *B, size_t nrhs, size_t ldb)
+        {
+            typedef std::integral_constant<bool, std::is_floating_point<E>::value> UseGemm;
+            for (size_t j0 = 0; j0 < n; j0 += LUBlockSize)
+            {
+                const size_t j1 = std::min(n, j0 + LUBlockSize);
+                for (size_t i = j0; i < j1; ++i)
+                {
+                    E *rowI = B + i * ldb;
+                    for (size_t p = j0; p < i; ++p)
+                    {
+                        const E lip = L[i * ld + p];
+                        const E *rowP = B + p * ldb;
+                        for (size_t j = 0; j < nrhs; ++j)
+                            rowI[j] -= lip * rowP[j];
+                    }
+                    const E lii = L[i * ld + i];
+                    for (size_t j = 0; j < nrhs; ++j)
+                        rowI[j] = rowI[j] / lii;
+                }
+                if (j1 < n)
+                    luSolveUpdate(n - j1, nrhs, j1 - j0, L + j1 * ld + j0, ld, B + j0 * ldb, ldb, B + j1 * ldb, ldb);
+            }
+
+            for (size_t j1 = n; j1 > 0;)
+            {
+                const size_t j0 = j1 > LUBlockSize ? j1 - LUBlockSize : 0;
+                for (size_t i = j1; i-- > j0;)
+                {
+                    E *rowI = B + i * ldb;
+                    const E lii = L[i * ld + i];
+                    for (size_t j = 0; j < nrhs; ++j)
+                        rowI[j] = rowI[j] / lii;
+                    for (size_t p = j0; p < i; ++p)
+                    {
+                        const E lip = L[i * ld + p];
+                        E *rowP = B + p * ldb;
+                        for (size_t j = 0; j < nrhs; ++j)
+                            rowP[j] -= lip * rowI[j];
+                    }
+                }
+                if (j0 > 0)
+                    stridedUpdate(j0, nrhs, j1 - j0, L + j0 * ld, 1, ld, B + j0 * ldb, ldb, 1, B, ldb, UseGemm());
+                j1 = j0;
+            }
+        }
+
+        /**
+         * @brief 下三角存储中对称交换第 a、b 行/列（k <= a < b），并交换 L 已求出的前 k 列
+         * @details a = k + 1 时（2x2 主元块）第 k 列的 A(a, k) 与 A(b, k) 也随之交换。
+         */
+        template <typename E>
+        void ldltSymmetricSwap(size_t n, E *A, size_t ld, size_t k, size_t a, size_t b)
+        {
+            std::swap_ranges(A + a * ld, A + a * ld + k, A + b * ld);
+            for (size_t i = b + 1; i < n; ++i)
+                std::swap(A[i * ld + a], A[i * ld + b]);
+            for (size_t j = a + 1; j < b; ++j)
+                std::swap(A[j * ld + a], A[b * ld + j]);
+            std::swap(A[a * ld + a], A[b * ld + b]);
+            for (size_t j = k; j < a; ++j)
+                std::swap(A[a * ld + j], A[b * ld + j]);
+        }
+
+        /**
+         * @brief 原地 Bunch-Kaufman LDL^T 分解 P^T * A * P = L * D * L^T，只读取下三角
+         * @param n 矩阵阶数
+         * @param A 行主序矩阵；返回时严格下三角为 L（2x2 主元块内的 L(k+1, k) 位置保存 D 的非对角元），对角线为 D 的对角元
+         * @param ld 行跨度
+         * @param pivots 第 k 步把第 k 行/列与第 pivots[k] 行/列对称交换
+         * @param blocks blocks[k] 为从第 k 行开始的主元块阶数（1 或 2），2x2 块的第二行为 0
+         */
+        template <typename E, typename Pivots>
+        void ldltFactor(size_t n, E *A, size_t ld, Pivots &pivots, Pivots &blocks)
+        {
+            const E alpha = (E(1) + symSqrt(E(17))) / E(8);
+            size_t k = 0;
+            while (k < n)
+            {
+                const auto absakk = luMagnitude(A[k * ld + k]);
+                size_t imax = k;
+                auto colmax = decltype(absakk)(0);
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    const auto v = luMagnitude(A[i * ld + k]);
+                    if (v > colmax)
+                    {
+                        colmax = v;
+                        imax = i;
+                    }
+                }
+
+                size_t kp = k, kstep = 1;
+                if (!(absakk < alpha * colmax))
+                    kp = k;
+                else
+                {
+                    // 第 imax 行（不含对角元）在尾部子矩阵中的最大模
+                    auto rowmax = decltype(absakk)(0);
+                    for (size_t j = k; j < imax; ++j)
+                        rowmax = std::max(rowmax, luMagnitude(A[imax * ld + j]));
+                    for (size_t i = imax + 1; i < n; ++i)
+                        rowmax = std::max(rowmax, luMagnitude(A[i * ld + imax]));
+
+                    if (!(absakk * rowmax < alpha * colmax * colmax))
+                        kp = k;
+                    else if (!(luMagnitude(A[imax * ld + imax]) < alpha * rowmax))
+                        kp = imax;
+                    else
+                    {
+                        kp = imax;
+                        kstep = 2;
+                    }
+                }
+
+                const size_t kk = k + kstep - 1;
+                if (kp != kk)
+                    ldltSymmetricSwap(n, A, ld, k, kk, kp);
+                pivots[k] = k;
+                pivots[kk] = kp;
+                blocks[k] = kstep;
+
+                // 主元列（消元前的值）复制到不被读取的上三角，使尾部更新的内层循环连续访问内存
+                E *rowK = A + k * ld;
+                E *rowK1 = A + (k + 1) * ld;
+                for (size_t j = k + kstep; j < n; ++j)
+                {
+                    rowK[j] = A[j * ld + k];
+                    if (kstep == 2)
+                        rowK1[j] = A[j * ld + k + 1];
+                }
+
+                if (kstep == 1)
+                {
+                    const E d = rowK[k];
+                    if (d != E(0))
+                    {
+                        for (size_t i = k + 1; i < n; ++i)
+                        {
+                            E *rowI = A + i * ld;
+                            const E li = rowI[k] / d;
+                            for (size_t j = k + 1; j <= i; ++j)
+                                rowI[j] -= li * rowK[j];
+                            rowI[k] = li;
+                        }
+                    }
+                }
+                else
+                {
+                    blocks[k + 1] = 0;
+                    const E d11 = rowK[k], d21 = rowK1[k], d22 = rowK1[k + 1];
+                    const E det = d11 * d22 - d21 * d21;
+                    for (size_t i = k + 2; i < n; ++i)
+                    {
+                        E *rowI = A + i * ld;
+                        const E w1 = rowI[k], w2 = rowI[k + 1];
+                        // (l1, l2) = (w1, w2) * D^-1
+                        const E l1 = (w1 * d22 - w2 * d21) / det;
+                        const E l2 = (w2 * d11 - w1 * d21) / det;
+                        for (size_t j = k + 2; j <= i; ++j)
+                            rowI[j] -= l1 * rowK[j] + l2 * rowK1[j];
+                        rowI[k] = l1;
+                        rowI[k + 1] = l2;
+                    }
+                }
+                k += kstep;
+            }
+        }
+
+        /**
+         * @brief 用 LDL^T 分解原地求解 A * X = B，B 为 n×nrhs 行主序（行跨度 ldb）
+         */
+        template <typename E, typename Pivots>
+        void ldltSolveRows(size_t n, const E *A, size_t ld, const Pivots &pivots, const Pivots &blocks,
+                           E *B, size_t nrhs, size_t ldb)
+        {
+            // B = P^T * B
+            for (size_t k = 0; k < n; ++k)
+                if (pivots[k] != k)
+                    std::swap_ranges(B + k * ldb, B + k * ldb + nrhs, B + pivots[k] * ldb);
+
+            // L * Y = B，2x2 块内 L(k+1, k) 为 0（该位置存放的是 D 的非对角元）
+            for (size_t i = 1; i < n; ++i)
+            {
+                E *rowI = B + i * ldb;
+                const size_t end = blocks[i] == 0 ? i - 1 : i;
+                for (size_t p = 0; p < end; ++p)
+                {
+                    const E lip = A[i * ld + p];
+                    const E *rowP = B + p * ldb;
+                    for (size_t j = 0; j < nrhs; ++j)
+                        rowI[j] -= lip * rowP[j];
+                }
+            }
+
+            // D * Z = Y
+            for (size_t k = 0; k < n; k += blocks[k])
+            {
+                E *row1 = B + k * ldb;
+                if (blocks[k] == 1)
+                {
+                    const E d = A[k * ld + k];
+                    for (size_t j = 0; j < nrhs; ++j)
+                        row1[j] = row1[j] / d;
+                }
+                else
+                {
+                    E *row2 = B + (k + 1) * ldb;
+                    const E d11 = A[k * ld + k], d21 = A[(k + 1) * ld + k], d22 = A[(k + 1) * ld + k + 1];
+                    const E det = d11 * d22 - d21 * d21;
+                    for (size_t j = 0; j < nrhs; ++j)
+                    {
+                        const E y1 = row1[j], y2 = row2[j];
+                        row1[j] = (d22 * y1 - d21 * y2) / det;
+                        row2[j] = (d11 * y2 - d21 * y1) / det;
+                    }
+                }
+            }
+
+            // L^T * X = Z，按列消去
+            for (size_t i = n; i-- > 1;)
+            {
+                const E *rowI = B + i * ldb;
+                const size_t end = blocks[i] == 0 ? i - 1 : i;
+                for (size_t p = 0; p < end; ++p)
+                {
+                    const E lip = A[i * ld + p];
+                    E *rowP = B + p * ldb;
+                    for (size_t j = 0; j < nrhs; ++j)
+                        rowP[j] -= lip * rowI[j];
+                }
+            }
+
+            // X = P * X
+            for (size_t k = n; k-- > 0;)
+                if (pivots[k] != k)
+                    std::swap_ranges(B + k * ldb, B + k * ldb + nrhs, B + pivots[k] * ldb);
+        }
+
+        /**
+         * @brief 用 LinAlg::CholeskyFactorization 原地求解，B 为 n×nrhs 行主序、行跨度为 ldb
+         */
+        template <typename Factorization, typename T>
+        void choleskySolveInPlace(const Factorization &f, T *B, size_t nrhs, size_t ldb)
+        {
+            typedef LUElement<T> Elem;
+            choleskySolveRows(f.size(), Elem::cast(f.L.data()), f.size(), Elem::cast(B), nrhs, ldb);
+        }
+
+        /**
+         * @brief 用 LinAlg::LDLTFactorization 原地求解，B 为 n×nrhs 行主序、行跨度为 ldb
+         */
+        template <typename Factorization, typename T>
+        void ldltSolveInPlace(const Factorization &f, T *B, size_t nrhs, size_t ldb)
+        {
+            typedef LUElement<T> Elem;
+            ldltSolveRows(f.size(), Elem::cast(f.LD.data()), f.size(), f.pivots, f.blocks, Elem::cast(B), nrhs, ldb);
+        }
+    }
+}
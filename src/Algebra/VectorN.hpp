@@ -4,6 +4,9 @@
 #include "MatrixBase.hpp"
 #include "MatrixExpr.hpp"
 #include "AlgebraTool.hpp"
+#include "DenseStorage.hpp"
+#include "Assign.hpp"
+#include "Reduction.hpp"
 
 namespace OxygenMath
 {
@@ -11,45 +14,50 @@ namespace OxygenMath
     class VectorN : public MatrixBase<VectorN<T, N>>
     {
     private:
-        std::array<T, N> data;
+        std::array<T, N> elems;
         bool is_row_vector = false; // 默认是列向量
     public:
-        VectorN() : data{}
+        VectorN() : elems{}
         {
             for (size_t i = 0; i < N; ++i)
-                data[i] = T::zero();
+                elems[i] = T::zero();
         }
 
-        template <typename Expr>
+        template <typename Expr,
+                  typename = typename std::enable_if<is_matrix_expression<Expr>::value>::type>
         VectorN(const Expr &expr)
         {
-            for (size_t i = 0; i < N; ++i)
-                data[i] = expr(i, 0);
+            if (expr.rows() * expr.cols() != N || (expr.rows() != 1 && expr.cols() != 1))
+                throw std::invalid_argument("Expression size does not match vector dimension");
+            internal::evaluateTo(elems.data(), expr.cols(), expr);
         }
         VectorN(std::initializer_list<T> init)
         {
             if (init.size() != N)
                 throw std::invalid_argument("Initializer list size does not match vector dimension");
 
-            std::copy(init.begin(), init.end(), data.begin());
+            std::copy(init.begin(), init.end(), elems.begin());
         }
 
         T &operator()(size_t i, size_t j = 0)
         {
             if (j != 0 || i >= N)
                 throw std::out_of_range("Vector index out of range");
-            return data[i];
+            return elems[i];
         }
 
         const T &operator()(size_t i, size_t j = 0) const
         {
             if (j != 0 || i >= N)
                 throw std::out_of_range("Vector index out of range");
-            return data[i];
+            return elems[i];
         }
 
-        T &operator[](size_t i) { return data[i]; }
-        const T &operator[](size_t i) const { return data[i]; }
+        T &operator[](size_t i) { return elems[i]; }
+        const T &operator[](size_t i) const { return elems[i]; }
+
+        T *data() { return elems.data(); }
+        const T *data() const { return elems.data(); }
 
         // 默认是列向量
         size_t rows() const { return is_row_vector ? 1 : N; }
@@ -59,19 +67,25 @@ namespace OxygenMath
         template <typename Expr>
         VectorN &operator=(const MatrixExpr<Expr> &expr)
         {
-            for (size_t i = 0; i < N; ++i)
-                data[i] = expr(i, 0);
+            const Expr &e = expr.derived();
+            if (e.rows() * e.cols() != N || (e.rows() != 1 && e.cols() != 1))
+                throw std::invalid_argument("Expression size does not match vector dimension");
+            // v = A * v 这类别名赋值由别名分析转为先写入暂存区
+            internal::assignTo(elems.data(), e.cols(), e);
             return *this;
         }
 
         // ------------------ 向量特有运算 ------------------
 
+        // 与任意表达式的点积，如 v.dot(a - b)
+        using MatrixBase<VectorN>::dot;
+
         // 点积
         T dot(const VectorN &other) const
         {
             T result = T::zero();
             for (size_t i = 0; i < N; ++i)
-                result += data[i] * other.data[i];
+                result += elems[i] * other.elems[i];
             return result;
         }
 
@@ -81,9 +95,9 @@ namespace OxygenMath
         cross(const VectorN &other) const
         {
             return VectorN{
-                data[1] * other[2] - data[2] * other[1],
-                data[2] * other[0] - data[0] * other[2],
-                data[0] * other[1] - data[1] * other[0]};
+                elems[1] * other[2] - elems[2] * other[1],
+                elems[2] * other[0] - elems[0] * other[2],
+                elems[0] * other[1] - elems[1] * other[0]};
         }
 
         // L2范数
@@ -103,7 +117,7 @@ namespace OxygenMath
             T scale = T::identity() / len;
             for (size_t i = 0; i < N; ++i)
             {
-                result[i] = data[i] * scale;
+                result[i] = elems[i] * scale;
             }
             return result;
         }
@@ -176,9 +190,164 @@ namespace OxygenMath
         }
     };
 
+    /**
+     * @brief 动态尺寸向量，长度在运行期确定
+     * @details 数据保存在一块连续的 64 字节对齐内存中，移动时不分配内存。
+     */
+    template <typename T>
+    class VectorN<T, Dynamic> : public MatrixBase<VectorN<T, Dynamic>>
+    {
+    private:
+        internal::DynamicStorage<T, Dynamic, 1> storage;
+        bool is_row_vector = false; // 默认是列向量
+    public:
+        VectorN() {}
+
+        explicit VectorN(size_t n) : storage(n, 1) {}
+
+        template <typename Expr,
+                  typename = typename std::enable_if<is_matrix_expression<Expr>::value>::type>
+        VectorN(const Expr &expr) : storage(expr.rows() * expr.cols(), 1)
+        {
+            if (expr.rows() != 1 && expr.cols() != 1)
+                throw std::invalid_argument("Expression is not a vector");
+            internal::evaluateTo(storage.data(), expr.cols(), expr);
+        }
+        VectorN(std::initializer_list<T> init) : storage(init.size(), 1)
+        {
+            std::copy(init.begin(), init.end(), storage.data());
+        }
+
+        T &operator()(size_t i, size_t j = 0)
+        {
+            if (j != 0 || i >= size())
+                throw std::out_of_range("Vector index out of range");
+            return storage.data()[i];
+        }
+
+        const T &operator()(size_t i, size_t j = 0) const
+        {
+            if (j != 0 || i >= size())
+                throw std::out_of_range("Vector index out of range");
+            return storage.data()[i];
+        }
+
+        T &operator[](size_t i) { return storage.data()[i]; }
+        const T &operator[](size_t i) const { return storage.data()[i]; }
+
+        size_t size() const { return storage.rows(); }
+        size_t rows() const { return is_row_vector ? 1 : size(); }
+        size_t cols() const { return is_row_vector ? size() : 1; }
+
+        T *data() { return storage.data(); }
+        const T *data() const { return storage.data(); }
+
+        // 改变长度，长度变化时内容置零
+        void resize(size_t n) { storage.resize(n, 1); }
+
+        // 从表达式赋值
+        template <typename Expr>
+        VectorN &operator=(const MatrixExpr<Expr> &expr)
+        {
+            const Expr &e = expr.derived();
+            if (e.rows() != 1 && e.cols() != 1)
+                throw std::invalid_argument("Expression is not a vector");
+            if (e.rows() * e.cols() == size())
+            {
+                internal::assignTo(storage.data(), e.cols(), e);
+                return *this;
+            }
+            internal::DynamicStorage<T, Dynamic, 1> tmp(e.rows() * e.cols(), 1);
+            internal::evaluateTo(tmp.data(), e.cols(), e);
+            storage = std::move(tmp);
+            return *this;
+        }
+
+        // ------------------ 向量特有运算 ------------------
+
+        // 与任意表达式的点积，如 v.dot(a - b)
+        using MatrixBase<VectorN>::dot;
+
+        // 点积；长向量按块并行累加，各块的部分和按块的顺序相加
+        T dot(const VectorN &other) const
+        {
+            if (other.size() != size())
+                throw std::invalid_argument("Dot product requires vectors of the same dimension");
+            const T *x = storage.data(), *y = other.storage.data();
+            return parallelReduce(
+                0, size(), internal::ParallelReduceGrain, T::zero(),
+                [x, y](size_t begin, size_t end)
+                {
+                    T result = T::zero();
+                    for (size_t i = begin; i < end; ++i)
+                        result += x[i] * y[i];
+                    return result;
+                },
+                [](const T &a, const T &b)
+                { return a + b; });
+        }
+
+        // L2范数
+        T norm() const
+        {
+            return sqrt(dot(*this));
+        }
+        // 单位化
+        VectorN normalize() const
+        {
+            T len = norm();
+            if (len == T::zero())
+                throw std::domain_error("Cannot normalize zero vector");
+
+            VectorN result(size());
+            T scale = T::identity() / len;
+            for (size_t i = 0; i < size(); ++i)
+            {
+                result[i] = storage.data()[i] * scale;
+            }
+            return result;
+        }
+
+        VectorN transpose() const
+        {
+            VectorN result = *this;
+            result.is_row_vector = !is_row_vector;
+            return result;
+        }
+
+        bool isRowVector() const { return is_row_vector; }
+
+        friend std::ostream &operator<<(std::ostream &os, const VectorN &v)
+        {
+            const size_t n = v.size();
+            if (n == 0)
+            {
+                return os << "[]";
+            }
+            os << "[";
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (v.isRowVector())
+                    os << v[i];
+                else
+                    os << "[" << v[i] << "]";
+                if (i + 1 < n)
+                {
+                    os << (v.isRowVector() ? ", " : ",\n ");
+                }
+            }
+            return os << "]";
+        }
+    };
+
     using Vector2f = VectorN<Real, 2>;
     using Vector3f = VectorN<Real, 3>;
     using Vector4f = VectorN<Real, 4>;
     using Vector2c = VectorN<Complex, 2>;
     using Vector3c = VectorN<Complex, 3>;
+
+    template <typename T>
+    using VectorX = VectorN<T, Dynamic>;
+    using VectorXf = VectorX<Real>;
+    using VectorXc = VectorX<Complex>;
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <limits>
 
 namespace OxygenMath
 {
@@ -10,7 +11,7 @@ namespace OxygenMath
         constexpr double big_epsilon = 1e-6;
         constexpr double inf = 1e20;
         constexpr double big_inf = 1e30;
-        constexpr double nan = 0.0 / 0.0;
+        constexpr double nan = std::numeric_limits<double>::quiet_NaN();
         constexpr double sqrt_2 = 1.414213562373095;
         constexpr double sqrt_3 = 1.732050807568877;
     }
@@ -179,11 +179,9 @@ namespace OxygenMath
         {
             Real A1 = p2(1) - p1(1);
             Real B1 = p1(0) - p2(0);
-            Real C1 = A1 * p1(0) + B1 * p1(1);
 
             Real A2 = p4(1) - p3(1);
             Real B2 = p3(0) - p4(0);
-            Real C2 = A2 * p3(0) + B2 * p3(1);
 
             Real det = A1 * B2 - A2 * B1;
             return det != Real::zero();
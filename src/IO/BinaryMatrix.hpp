@@ -0,0 +1,434 @@
+/**
+ * @file BinaryMatrix.hpp
+ * @brief 稠密矩阵的二进制文件格式：流式写入，内存映射零拷贝读取。
+ * @details 文件由 64 字节的文件头和紧随其后的数据区组成，所有整数均为小端序：
+ *          | 偏移 | 类型      | 内容                                                  |
+ *          | 0    | char[8]   | 魔数 "OXYMATRX"                                       |
+ *          | 8    | uint32    | 格式版本，当前为 1                                    |
+ *          | 12   | uint32    | 元素类型 BinaryDType                                  |
+ *          | 16   | uint64    | 行数                                                  |
+ *          | 24   | uint64    | 列数                                                  |
+ *          | 32   | uint64    | 数据区相对文件开头的偏移，是 alignment 的整数倍       |
+ *          | 40   | uint64    | 数据区字节数，等于 行数 × 列数 × 元素字节数           |
+ *          | 48   | uint32    | 数据区对齐字节数（2 的幂，不小于 64）                 |
+ *          | 52   | uint32    | 标志位，版本 1 中为 0                                 |
+ *          | 56   | byte[8]   | 保留，为 0                                            |
+ *          数据区按行主序连续存放元素的底层浮点数（复数为实部、虚部交替），不做任何编码。
+ *          读取时把整个文件映射到只读内存（POSIX mmap / Windows MapViewOfFile），
+ *          MappedMatrixFile::view() 返回直接指向映射页的只读 MatrixView：打开文件不读取数据，
+ *          页面在首次访问时才由操作系统载入，且在映射同一文件的进程之间共享页缓存。
+ *          视图可直接参与表达式、归约与 GEMM，也可以 eval() 拷贝成普通矩阵。
+ *          只支持小端序主机；格式错误或文件被截断时抛出 std::runtime_error。
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../Algebra/NumberField.hpp"
+#include "../Algebra/MatrixNM.hpp"
+#include "../Algebra/MatrixView.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace OxygenMath
+{
+    /**
+     * @brief 文件中的元素类型
+     */
+    enum class BinaryDType : uint32_t
+    {
+        Float64 = 1,   // Real、RealIEEE
+        Float32 = 2,   // Real32
+        Complex128 = 3, // Complex、ComplexIEEE
+        Complex64 = 4  // Complex32
+    };
+
+    namespace internal
+    {
+        // 元素类型与 BinaryDType 的对应关系；元素必须与底层浮点数组的内存布局一致
+        template <typename T>
+        struct BinaryDTypeOf;
+
+        template <typename Policy>
+        struct BinaryDTypeOf<BasicReal<double, Policy>>
+        {
+            static constexpr BinaryDType value = BinaryDType::Float64;
+            static_assert(sizeof(BasicReal<double, Policy>) == sizeof(double), "Real must be layout-compatible with double");
+        };
+
+        template <typename Policy>
+        struct BinaryDTypeOf<BasicReal<float, Policy>>
+        {
+            static constexpr BinaryDType value = BinaryDType::Float32;
+            static_assert(sizeof(BasicReal<float, Policy>) == sizeof(float), "Real32 must be layout-compatible with float");
+        };
+
+        template <typename Policy>
+        struct BinaryDTypeOf<BasicComplex<double, Policy>>
+        {
+            static constexpr BinaryDType value = BinaryDType::Complex128;
+            static_assert(sizeof(BasicComplex<double, Policy>) == 2 * sizeof(double), "Complex must be layout-compatible with double[2]");
+        };
+
+        template <typename Policy>
+        struct BinaryDTypeOf<BasicComplex<float, Policy>>
+        {
+            static constexpr BinaryDType value = BinaryDType::Complex64;
+            static_assert(sizeof(BasicComplex<float, Policy>) == 2 * sizeof(float), "Complex32 must be layout-compatible with float[2]");
+        };
+
+        inline size_t binaryDTypeSize(uint32_t dtype)
+        {
+            switch (dtype)
+            {
+            case static_cast<uint32_t>(BinaryDType::Float64):
+                return 8;
+            case static_cast<uint32_t>(BinaryDType::Float32):
+                return 4;
+            case static_cast<uint32_t>(BinaryDType::Complex128):
+                return 16;
+            case static_cast<uint32_t>(BinaryDType::Complex64):
+                return 8;
+            default:
+                return 0;
+            }
+        }
+
+        /**
+         * @brief 文件头（64 字节），字段含义见文件开头的说明
+         */
+        struct BinaryMatrixHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t dtype;
+            uint64_t rows;
+            uint64_t cols;
+            uint64_t payloadOffset;
+            uint64_t payloadBytes;
+            uint32_t alignment;
+            uint32_t flags;
+            unsigned char reserved[8];
+        };
+        static_assert(sizeof(BinaryMatrixHeader) == 64, "BinaryMatrixHeader must be 64 bytes");
+
+        constexpr char BinaryMatrixMagic[8] = {'O', 'X', 'Y', 'M', 'A', 'T', 'R', 'X'};
+        constexpr uint32_t BinaryMatrixVersion = 1;
+        constexpr uint32_t BinaryMatrixMinAlignment = 64;
+
+        inline bool littleEndianHost()
+        {
+            const uint16_t probe = 1;
+            unsigned char first;
+            std::memcpy(&first, &probe, 1);
+            return first == 1;
+        }
+
+        inline void requireLittleEndian()
+        {
+            if (!littleEndianHost())
+                throw std::runtime_error("Binary matrix files are only supported on little-endian hosts");
+        }
+
+        // 校验文件头，fileSize 为整个文件的字节数
+        inline void checkHeader(const BinaryMatrixHeader &h, uint64_t fileSize)
+        {
+            if (std::memcmp(h.magic, BinaryMatrixMagic, 8) != 0)
+                throw std::runtime_error("Not a binary matrix file");
+            if (h.version != BinaryMatrixVersion)
+                throw std::runtime_error("Unsupported binary matrix file version");
+            const size_t elem = binaryDTypeSize(h.dtype);
+            if (elem == 0)
+                throw std::runtime_error("Unknown element type in binary matrix file");
+            if (h.alignment < BinaryMatrixMinAlignment || (h.alignment & (h.alignment - 1)) != 0 ||
+                h.payloadOffset < sizeof(BinaryMatrixHeader) || h.payloadOffset % h.alignment != 0)
+                throw std::runtime_error("Invalid payload layout in binary matrix file");
+            if (h.cols != 0 && h.rows > UINT64_MAX / h.cols / elem)
+                throw std::runtime_error("Binary matrix dimensions overflow");
+            if (h.payloadBytes != h.rows * h.cols * elem)
+                throw std::runtime_error("Payload size does not match the matrix dimensions");
+            if (fileSize < h.payloadOffset || fileSize - h.payloadOffset < h.payloadBytes)
+                throw std::runtime_error("Binary matrix file is truncated");
+        }
+    }
+
+    /**
+     * @brief 流式写入二进制矩阵文件
+     * @details 构造时写入文件头，之后按行主序分批追加元素（writeRow / write），内存中只保留调用者传入的数据，
+     *          适合边计算边输出的大矩阵。close() 检查写入的元素个数与尺寸一致；
+     *          未调用 close() 就析构时文件保持不完整，读取时会被识别为截断。
+     * @tparam T 元素类型：Real、Real32、Complex 等
+     */
+    template <typename T>
+    class BinaryMatrixWriter
+    {
+    private:
+        std::ofstream m_out;
+        uint64_t m_rows, m_cols, m_written;
+
+    public:
+        /**
+         * @param alignment 数据区对齐字节数，2 的幂且不小于 64；取页大小（4096）时数据区按页对齐
+         */
+        BinaryMatrixWriter(const std::string &path, size_t rows, size_t cols, uint32_t alignment = internal::BinaryMatrixMinAlignment)
+            : m_rows(rows), m_cols(cols), m_written(0)
+        {
+            internal::requireLittleEndian();
+            if (alignment < internal::BinaryMatrixMinAlignment || (alignment & (alignment - 1)) != 0)
+                throw std::invalid_argument("Alignment must be a power of two not less than 64");
+            m_out.open(path, std::ios::binary | std::ios::trunc);
+            if (!m_out)
+                throw std::runtime_error("Cannot open file for writing: " + path);
+
+            internal::BinaryMatrixHeader header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, internal::BinaryMatrixMagic, 8);
+            header.version = internal::BinaryMatrixVersion;
+            header.dtype = static_cast<uint32_t>(internal::BinaryDTypeOf<T>::value);
+            header.rows = rows;
+            header.cols = cols;
+            header.payloadOffset = (sizeof(header) + alignment - 1) / alignment * alignment;
+            header.payloadBytes = m_rows * m_cols * sizeof(T);
+            header.alignment = alignment;
+            m_out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            const std::vector<char> padding(header.payloadOffset - sizeof(header), 0);
+            m_out.write(padding.data(), padding.size());
+            if (!m_out)
+                throw std::runtime_error("Failed to write binary matrix header: " + path);
+        }
+
+        BinaryMatrixWriter(const BinaryMatrixWriter &) = delete;
+        BinaryMatrixWriter &operator=(const BinaryMatrixWriter &) = delete;
+
+        // 追加 count 个元素
+        void write(const T *data, size_t count)
+        {
+            if (count > m_rows * m_cols - m_written)
+                throw std::out_of_range("Writing more elements than the matrix holds");
+            m_out.write(reinterpret_cast<const char *>(data), count * sizeof(T));
+            if (!m_out)
+                throw std::runtime_error("Failed to write binary matrix payload");
+            m_written += count;
+        }
+
+        // 追加一行（cols 个元素）
+        void writeRow(const T *row) { write(row, m_cols); }
+
+        // 已写入的元素个数
+        size_t written() const { return m_written; }
+
+        // 结束写入并关闭文件；元素个数不足时抛出异常
+        void close()
+        {
+            if (!m_out.is_open())
+                return;
+            if (m_written != m_rows * m_cols)
+                throw std::runtime_error("Binary matrix file closed before all elements were written");
+            m_out.close();
+            if (!m_out)
+                throw std::runtime_error("Failed to close binary matrix file");
+        }
+    };
+
+    /**
+     * @brief 把矩阵或表达式写入二进制文件，逐行求值后写出，不生成整个矩阵的副本
+     */
+    template <typename Derived>
+    void saveBinary(const std::string &path, const MatrixBase<Derived> &matrix, uint32_t alignment = internal::BinaryMatrixMinAlignment)
+    {
+        typedef typename internal::ExprTraits<Derived>::Scalar T;
+        const Derived &m = matrix.derived();
+        const size_t r = m.rows(), c = m.cols();
+        BinaryMatrixWriter<T> writer(path, r, c, alignment);
+        internal::Evaluator<Derived> ev(m);
+        std::vector<T> row(c);
+        for (size_t i = 0; i < r; ++i)
+        {
+            for (size_t j = 0; j < c; ++j)
+                row[j] = ev.coeff(i, j);
+            writer.writeRow(row.data());
+        }
+        writer.close();
+    }
+
+    /**
+     * @brief 以只读方式映射的二进制矩阵文件
+     * @details 对象存续期间映射有效，view() 返回的视图不得比它活得更久。只能移动，不能拷贝。
+     */
+    class MappedMatrixFile
+    {
+    private:
+        const unsigned char *m_base = nullptr;
+        size_t m_size = 0;
+        internal::BinaryMatrixHeader m_header;
+#if defined(_WIN32)
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#endif
+
+        void unmap()
+        {
+#if defined(_WIN32)
+            if (m_base)
+                UnmapViewOfFile(m_base);
+            if (m_mapping)
+                CloseHandle(m_mapping);
+            if (m_file != INVALID_HANDLE_VALUE)
+                CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+            m_mapping = nullptr;
+#else
+            if (m_base)
+                munmap(const_cast<unsigned char *>(m_base), m_size);
+#endif
+            m_base = nullptr;
+            m_size = 0;
+        }
+
+        void map(const std::string &path)
+        {
+#if defined(_WIN32)
+            m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE)
+                throw std::runtime_error("Cannot open file: " + path);
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(m_file, &size))
+                throw std::runtime_error("Cannot query file size: " + path);
+            m_size = static_cast<size_t>(size.QuadPart);
+            if (m_size < sizeof(internal::BinaryMatrixHeader))
+                throw std::runtime_error("Binary matrix file is truncated");
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!m_mapping)
+                throw std::runtime_error("Cannot map file: " + path);
+            m_base = static_cast<const unsigned char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            if (!m_base)
+                throw std::runtime_error("Cannot map file: " + path);
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error("Cannot open file: " + path);
+            struct stat st;
+            if (fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                throw std::runtime_error("Cannot query file size: " + path);
+            }
+            m_size = static_cast<size_t>(st.st_size);
+            if (m_size < sizeof(internal::BinaryMatrixHeader))
+            {
+                ::close(fd);
+                m_size = 0;
+                throw std::runtime_error("Binary matrix file is truncated");
+            }
+            void *base = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+            // 映射建立后即可关闭文件描述符
+            ::close(fd);
+            if (base == MAP_FAILED)
+            {
+                m_size = 0;
+                throw std::runtime_error("Cannot map file: " + path);
+            }
+            m_base = static_cast<const unsigned char *>(base);
+#endif
+        }
+
+    public:
+        explicit MappedMatrixFile(const std::string &path)
+        {
+            internal::requireLittleEndian();
+            try
+            {
+                map(path);
+                std::memcpy(&m_header, m_base, sizeof(m_header));
+                internal::checkHeader(m_header, m_size);
+            }
+            catch (...)
+            {
+                unmap();
+                throw;
+            }
+        }
+
+        MappedMatrixFile(MappedMatrixFile &&other) noexcept
+            : m_base(other.m_base), m_size(other.m_size), m_header(other.m_header)
+        {
+#if defined(_WIN32)
+            m_file = other.m_file;
+            m_mapping = other.m_mapping;
+            other.m_file = INVALID_HANDLE_VALUE;
+            other.m_mapping = nullptr;
+#endif
+            other.m_base = nullptr;
+            other.m_size = 0;
+        }
+
+        MappedMatrixFile &operator=(MappedMatrixFile &&other) noexcept
+        {
+            if (this != &other)
+            {
+                unmap();
+                m_base = other.m_base;
+                m_size = other.m_size;
+                m_header = other.m_header;
+#if defined(_WIN32)
+                m_file = other.m_file;
+                m_mapping = other.m_mapping;
+                other.m_file = INVALID_HANDLE_VALUE;
+                other.m_mapping = nullptr;
+#endif
+                other.m_base = nullptr;
+                other.m_size = 0;
+            }
+            return *this;
+        }
+
+        MappedMatrixFile(const MappedMatrixFile &) = delete;
+        MappedMatrixFile &operator=(const MappedMatrixFile &) = delete;
+
+        ~MappedMatrixFile() { unmap(); }
+
+        size_t rows() const { return static_cast<size_t>(m_header.rows); }
+        size_t cols() const { return static_cast<size_t>(m_header.cols); }
+        BinaryDType dtype() const { return static_cast<BinaryDType>(m_header.dtype); }
+
+        // 数据区在文件中的对齐字节数
+        size_t alignment() const { return m_header.alignment; }
+
+        /**
+         * @brief 指向映射页的只读视图，不拷贝数据
+         * @tparam T 元素类型，必须与文件中的元素类型对应（如 Float64 对应 Real 或 RealIEEE），否则抛出 std::invalid_argument
+         */
+        template <typename T>
+        MatrixView<const T> view() const
+        {
+            if (internal::BinaryDTypeOf<T>::value != dtype())
+                throw std::invalid_argument("Element type does not match the binary matrix file");
+            const T *data = reinterpret_cast<const T *>(m_base + m_header.payloadOffset);
+            return MatrixView<const T>(data, rows(), cols(), cols());
+        }
+    };
+
+    /**
+     * @brief 读取二进制矩阵文件到普通矩阵（映射后拷贝一次）
+     */
+    template <typename T>
+    MatrixNM<T, Dynamic, Dynamic> loadBinary(const std::string &path)
+    {
+        const MappedMatrixFile file(path);
+        return MatrixNM<T, Dynamic, Dynamic>(file.view<T>());
+    }
+}
@@ -0,0 +1,711 @@
+/**
+ * @file MatrixMarket.hpp
+ * @brief Matrix Market（.mtx）文本格式的分块多线程读取与写出，支持稀疏（coordinate）与稠密（array）数据。
+ * @details 读取时先解析文件头（banner 与尺寸行），正文按 MatrixMarketChunkBytes 字节分块读入，
+ *          每块在换行处切成若干段交给线程池并行解析，各段的结果按文件顺序汇入目标：
+ *          - readMatrixMarketSparse 把条目收集为三元组，再由 SparseMatrix 的三元组构造函数按计数排序组装成 CSR/CSC；
+ *          - readMatrixMarketDense 直接累加到稠密矩阵。
+ *          内存中同时只保留一个数据块的文本，条目本身（三元组或稠密矩阵）才与非零元个数成正比。
+ *          对称（symmetric）、斜对称（skew-symmetric）、Hermitian 文件只存下三角，读取时补全上三角；
+ *          pattern 文件的数值取 1；coordinate 中重复出现的位置数值相加。
+ *          写出时按批把条目并行格式化为文本，再按顺序写入文件；实数以 max_digits10 位有效数字输出，读回后逐位相同。
+ *          数值由 std::strtod 解析，依赖 C 语言环境的小数点（默认 "C" 环境为 '.'）。
+ *          文件无法打开或内容不合法时抛出 std::runtime_error；复数数据读入实数元素时抛出 std::invalid_argument。
+ */
+#pragma once
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../Algebra/NumberField.hpp"
+#include "../Algebra/MatrixNM.hpp"
+#include "../Algebra/SparseMatrix.hpp"
+#include "../Parallel/ParallelFor.hpp"
+
+namespace OxygenMath
+{
+    // 数值类型
+    enum class MatrixMarketField
+    {
+        Real,
+        Integer,
+        Complex,
+        Pattern
+    };
+
+    // 对称性：非 General 时文件只存下三角
+    enum class MatrixMarketSymmetry
+    {
+        General,
+        Symmetric,
+        SkewSymmetric,
+        Hermitian
+    };
+
+    /**
+     * @brief 文件头中的信息
+     * @details coordinate 为 true 时是稀疏的坐标格式，entries 为文件中的条目数（对称文件只计下三角）；
+     *          array 格式按列主序存放全部元素（对称文件只存下三角），entries 为应有的元素个数。
+     */
+    struct MatrixMarketInfo
+    {
+        bool coordinate = true;
+        MatrixMarketField field = MatrixMarketField::Real;
+        MatrixMarketSymmetry symmetry = MatrixMarketSymmetry::General;
+        size_t rows = 0, cols = 0, entries = 0;
+    };
+
+    namespace internal
+    {
+        // 每次读入的正文字节数
+        constexpr size_t MatrixMarketChunkBytes = 1 << 24;
+
+        // 每段至少包含的字节数，小文件不切分到多个线程
+        constexpr size_t MatrixMarketPieceBytes = 1 << 16;
+
+        // 写出时每批格式化的条目数
+        constexpr size_t MatrixMarketWriteBatch = 1 << 20;
+
+        /**
+         * @brief 元素类型与 Matrix Market 数值之间的转换
+         */
+        template <typename T>
+        struct MatrixMarketScalar;
+
+        template <typename F, typename Policy>
+        struct MatrixMarketScalar<BasicReal<F, Policy>>
+        {
+            typedef BasicReal<F, Policy> T;
+            static constexpr bool complex = false;
+            static constexpr int digits = std::numeric_limits<F>::max_digits10;
+            static T make(double re, double) { return T(static_cast<F>(re)); }
+            static T conj(const T &v) { return v; }
+            static T negate(const T &v) { return T(-v.data); }
+            static double real(const T &v) { return v.data; }
+            static double imag(const T &) { return 0; }
+        };
+
+        template <typename F, typename Policy>
+        struct MatrixMarketScalar<BasicComplex<F, Policy>>
+        {
+            typedef BasicComplex<F, Policy> T;
+            static constexpr bool complex = true;
+            static constexpr int digits = std::numeric_limits<F>::max_digits10;
+            static T make(double re, double im) { return T(static_cast<F>(re), static_cast<F>(im)); }
+            static T conj(const T &v) { return T(v.real, -v.imag); }
+            static T negate(const T &v) { return T(-v.real, -v.imag); }
+            static double real(const T &v) { return v.real; }
+            static double imag(const T &v) { return v.imag; }
+        };
+
+        inline std::string lowerCase(std::string s)
+        {
+            for (char &ch : s)
+                ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+            return s;
+        }
+
+        inline bool isBlank(char ch) { return ch == ' ' || ch == '\t' || ch == '\r'; }
+
+        inline const char *skipBlanks(const char *p)
+        {
+            while (isBlank(*p))
+                ++p;
+            return p;
+        }
+
+        inline const char *nextLine(const char *p)
+        {
+            while (*p != '\n')
+                ++p;
+            return p + 1;
+        }
+
+        inline size_t parseIndex(const char *&p)
+        {
+            p = skipBlanks(p);
+            if (*p < '0' || *p > '9')
+                throw std::runtime_error("Malformed Matrix Market entry");
+            const size_t maxValue = std::numeric_limits<size_t>::max();
+            size_t value = 0;
+            while (*p >= '0' && *p <= '9')
+            {
+                const size_t digit = static_cast<size_t>(*p++ - '0');
+                if (value > (maxValue - digit) / 10)
+                    throw std::runtime_error("Matrix Market index out of range");
+                value = value * 10 + digit;
+            }
+            return value;
+        }
+
+        inline double parseReal(const char *&p)
+        {
+            p = skipBlanks(p);
+            if (*p == '\n')
+                throw std::runtime_error("Malformed Matrix Market entry");
+            char *end;
+            const double value = std::strtod(p, &end);
+            if (end == p)
+                throw std::runtime_error("Malformed Matrix Market entry");
+            p = end;
+            return value;
+        }
+
+        /**
+         * @brief 按尺寸与对称性算出文件最多可容纳的元素个数（对称文件只计下三角）
+         * @return 超出 size_t 范围时返回 false
+         */
+        inline bool matrixMarketCapacity(const MatrixMarketInfo &info, size_t &capacity)
+        {
+            const size_t maxValue = std::numeric_limits<size_t>::max();
+            const size_t n = info.rows;
+            switch (info.symmetry)
+            {
+            case MatrixMarketSymmetry::General:
+                if (info.cols != 0 && info.rows > maxValue / info.cols)
+                    return false;
+                capacity = info.rows * info.cols;
+                return true;
+            case MatrixMarketSymmetry::SkewSymmetric:
+                if (n > 1 && n - 1 > maxValue / n)
+                    return false;
+                capacity = n > 1 ? n * (n - 1) / 2 : 0;
+                return true;
+            default:
+                if (n == maxValue || (n != 0 && n + 1 > maxValue / n))
+                    return false;
+                capacity = n * (n + 1) / 2;
+                return true;
+            }
+        }
+
+        /**
+         * @brief 正文中一个条目至少占用的字节数（含换行）
+         */
+        inline size_t minMatrixMarketEntryBytes(const MatrixMarketInfo &info)
+        {
+            // 每个下标或数值至少一个字符，彼此以一个空白分隔
+            size_t fields = info.coordinate ? 2 : 0;
+            if (info.field == MatrixMarketField::Complex)
+                fields += 2;
+            else if (info.field != MatrixMarketField::Pattern)
+                fields += 1;
+            return 2 * fields;
+        }
+
+        // 解析 banner 与尺寸行，in 停在正文开头
+        inline MatrixMarketInfo readMatrixMarketHeader(std::istream &in)
+        {
+            MatrixMarketInfo info;
+            std::string line;
+            if (!std::getline(in, line))
+                throw std::runtime_error("Empty Matrix Market file");
+            std::istringstream banner(line);
+            std::string tag, object, format, field, symmetry;
+            banner >> tag >> object >> format >> field >> symmetry;
+            if (tag != "%%MatrixMarket" || lowerCase(object) != "matrix")
+                throw std::runtime_error("Not a Matrix Market matrix file");
+            format = lowerCase(format);
+            field = lowerCase(field);
+            symmetry = lowerCase(symmetry);
+
+            if (format == "coordinate")
+                info.coordinate = true;
+            else if (format == "array")
+                info.coordinate = false;
+            else
+                throw std::runtime_error("Unknown Matrix Market format: " + format);
+
+            if (field == "real" || field == "double")
+                info.field = MatrixMarketField::Real;
+            else if (field == "integer")
+                info.field = MatrixMarketField::Integer;
+            else if (field == "complex")
+                info.field = MatrixMarketField::Complex;
+            else if (field == "pattern" && info.coordinate)
+                info.field = MatrixMarketField::Pattern;
+            else
+                throw std::runtime_error("Unknown Matrix Market field: " + field);
+
+            if (symmetry == "general")
+                info.symmetry = MatrixMarketSymmetry::General;
+            else if (symmetry == "symmetric")
+                info.symmetry = MatrixMarketSymmetry::Symmetric;
+            else if (symmetry == "skew-symmetric")
+                info.symmetry = MatrixMarketSymmetry::SkewSymmetric;
+            else if (symmetry == "hermitian")
+                info.symmetry = MatrixMarketSymmetry::Hermitian;
+            else
+                throw std::runtime_error("Unknown Matrix Market symmetry: " + symmetry);
+
+            // 跳过注释与空行，读取尺寸行
+            while (std::getline(in, line))
+            {
+                const size_t first = line.find_first_not_of(" \t\r");
+                if (first == std::string::npos || line[first] == '%')
+                    continue;
+                // operator>> 读 size_t 时接受负号并回绕成很大的数，因此先拒绝带符号的尺寸
+                if (line.find('-') != std::string::npos)
+                    throw std::runtime_error("Malformed Matrix Market size line");
+                std::istringstream size(line);
+                if (info.coordinate ? !(size >> info.rows >> info.cols >> info.entries) : !(size >> info.rows >> info.cols))
+                    throw std::runtime_error("Malformed Matrix Market size line");
+                if (info.symmetry != MatrixMarketSymmetry::General && info.rows != info.cols)
+                    throw std::runtime_error("Symmetric Matrix Market matrix must be square");
+                size_t capacity;
+                const bool representable = matrixMarketCapacity(info, capacity);
+                if (!info.coordinate)
+                {
+                    if (!representable)
+                        throw std::runtime_error("Matrix Market array size out of range");
+                    info.entries = capacity;
+                }
+                else if (representable && info.entries > capacity)
+                    throw std::runtime_error("Matrix Market entry count exceeds the matrix size");
+                return info;
+            }
+            throw std::runtime_error("Missing Matrix Market size line");
+        }
+
+        /**
+         * @brief 按块读取正文：每块都以完整的行结尾，块尾不完整的行留到下一块
+         */
+        class MatrixMarketChunker
+        {
+        private:
+            std::istream &m_in;
+            std::vector<char> m_buffer;
+            std::vector<char> m_carry;
+
+        public:
+            explicit MatrixMarketChunker(std::istream &in) : m_in(in) {}
+
+            // 读入下一块，返回 false 表示正文已读完；块内容为 [data(), data() + size)，末尾是 '\n'
+            bool next()
+            {
+                m_buffer.swap(m_carry);
+                m_carry.clear();
+                const size_t kept = m_buffer.size();
+                m_buffer.resize(kept + MatrixMarketChunkBytes + 1);
+                m_in.read(m_buffer.data() + kept, MatrixMarketChunkBytes);
+                const size_t got = static_cast<size_t>(m_in.gcount());
+                m_buffer.resize(kept + got);
+                if (m_buffer.empty())
+                    return false;
+                if (got == MatrixMarketChunkBytes)
+                {
+                    // 把最后一个换行之后的内容留给下一块
+                    size_t end = m_buffer.size();
+                    while (end > 0 && m_buffer[end - 1] != '\n')
+                        --end;
+                    if (end > 0)
+                    {
+                        m_carry.assign(m_buffer.begin() + end, m_buffer.end());
+                        m_buffer.resize(end);
+                    }
+                }
+                // 每行都以 '\n' 结尾，解析时遇到它即停止，不会越过缓冲区
+                if (m_buffer.back() != '\n')
+                    m_buffer.push_back('\n');
+                return true;
+            }
+
+            const char *data() const { return m_buffer.data(); }
+            size_t size() const { return m_buffer.size(); }
+        };
+
+        /**
+         * @brief 把 [begin, end) 在换行处切成若干段并行调用 parse(piece, pieceBegin, pieceEnd)，返回段数
+         */
+        template <typename Parse>
+        size_t parsePieces(const char *begin, const char *end, const Parse &parse)
+        {
+            const size_t bytes = static_cast<size_t>(end - begin);
+            const size_t pieces = std::max<size_t>(1, std::min(parallelThreads(), bytes / MatrixMarketPieceBytes));
+            std::vector<const char *> bounds(pieces + 1, end);
+            bounds[0] = begin;
+            for (size_t t = 1; t < pieces; ++t)
+            {
+                const char *p = std::max(bounds[t - 1], begin + bytes / pieces * t);
+                while (p < end && p[-1] != '\n')
+                    ++p;
+                bounds[t] = p;
+            }
+            parallelFor(0, pieces, 1, [&](size_t t0, size_t t1)
+                        {
+                            for (size_t t = t0; t < t1; ++t)
+                                parse(t, bounds[t], bounds[t + 1]); });
+            return pieces;
+        }
+
+        /**
+         * @brief 解析正文，按文件顺序对每个元素调用 sink(i, j, value)（下标从 0 开始），对称文件的镜像元素紧随其后
+         */
+        template <typename T, typename Sink>
+        void parseMatrixMarketBody(std::istream &in, const MatrixMarketInfo &info, Sink &sink)
+        {
+            typedef MatrixMarketScalar<T> S;
+            if (info.field == MatrixMarketField::Complex && !S::complex)
+                throw std::invalid_argument("Complex Matrix Market data requires a complex element type");
+            const bool complexField = info.field == MatrixMarketField::Complex;
+            const bool hasValue = info.field != MatrixMarketField::Pattern;
+            const size_t rows = info.rows, cols = info.cols;
+
+            auto emit = [&](size_t i, size_t j, const T &v)
+            {
+                sink(i, j, v);
+                if (i == j)
+                    return;
+                switch (info.symmetry)
+                {
+                case MatrixMarketSymmetry::Symmetric:
+                    sink(j, i, v);
+                    break;
+                case MatrixMarketSymmetry::SkewSymmetric:
+                    sink(j, i, S::negate(v));
+                    break;
+                case MatrixMarketSymmetry::Hermitian:
+                    sink(j, i, S::conj(v));
+                    break;
+                default:
+                    break;
+                }
+            };
+
+            MatrixMarketChunker chunker(in);
+            size_t seen = 0;
+            // array 格式的下一个元素位置（列主序；对称文件只走下三角）
+            size_t ai = 0, aj = 0;
+            if (!info.coordinate && info.symmetry == MatrixMarketSymmetry::SkewSymmetric)
+                ai = 1;
+            std::vector<std::vector<Triplet<T>>> entries;
+            std::vector<std::vector<T>> values;
+            while (chunker.next())
+            {
+                const char *begin = chunker.data(), *end = begin + chunker.size();
+                const size_t threads = parallelThreads();
+                if (info.coordinate)
+                {
+                    entries.resize(threads);
+                    const size_t pieces = parsePieces(begin, end, [&](size_t t, const char *p, const char *stop)
+                                                      {
+                        std::vector<Triplet<T>> &out = entries[t];
+                        out.clear();
+                        while (p < stop)
+                        {
+                            p = skipBlanks(p);
+                            if (*p == '\n' || *p == '%')
+                            {
+                                p = nextLine(p);
+                                continue;
+                            }
+                            const size_t i = parseIndex(p), j = parseIndex(p);
+                            if (i == 0 || i > rows || j == 0 || j > cols)
+                                throw std::runtime_error("Matrix Market entry index out of range");
+                            double re = 1, im = 0;
+                            if (hasValue)
+                                re = parseReal(p);
+                            if (complexField)
+                                im = parseReal(p);
+                            out.push_back(Triplet<T>(i - 1, j - 1, S::make(re, im)));
+                            p = nextLine(p);
+                        } });
+                    for (size_t t = 0; t < pieces; ++t)
+                    {
+                        seen += entries[t].size();
+                        if (seen > info.entries)
+                            throw std::runtime_error("Matrix Market file has more entries than declared");
+                        for (const Triplet<T> &e : entries[t])
+                            emit(e.row, e.col, e.value);
+                    }
+                }
+                else
+                {
+                    values.resize(threads);
+                    const size_t pieces = parsePieces(begin, end, [&](size_t t, const char *p, const char *stop)
+                                                      {
+                        std::vector<T> &out = values[t];
+                        out.clear();
+                        while (p < stop)
+                        {
+                            p = skipBlanks(p);
+                            if (*p == '\n' || *p == '%')
+                            {
+                                p = nextLine(p);
+                                continue;
+                            }
+                            const double re = parseReal(p);
+                            const double im = complexField ? parseReal(p) : 0;
+                            out.push_back(S::make(re, im));
+                            p = nextLine(p);
+                        } });
+                    const bool lower = info.symmetry != MatrixMarketSymmetry::General;
+                    const size_t firstRow = info.symmetry == MatrixMarketSymmetry::SkewSymmetric ? 1 : 0;
+                    for (size_t t = 0; t < pieces; ++t)
+                    {
+                        seen += values[t].size();
+                        if (seen > info.entries)
+                            throw std::runtime_error("Matrix Market file has more entries than declared");
+                        for (const T &v : values[t])
+                        {
+                            emit(ai, aj, v);
+                            if (++ai == rows)
+                            {
+                                ++aj;
+                                ai = lower ? aj + firstRow : 0;
+                            }
+                        }
+                    }
+                }
+            }
+            if (seen != info.entries)
+                throw std::runtime_error("Matrix Market file has fewer entries than declared");
+        }
+
+        inline void openForReading(std::ifstream &in, const std::string &path)
+        {
+            in.open(path, std::ios::binary);
+            if (!in)
+                throw std::runtime_error("Cannot open file: " + path);
+        }
+
+        inline void appendUnsigned(std::string &out, size_t value)
+        {
+            char digits[24];
+            size_t n = 0;
+            do
+            {
+                digits[n++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value != 0);
+            while (n > 0)
+                out.push_back(digits[--n]);
+        }
+
+        template <typename T>
+        void appendValue(std::string &out, const T &v)
+        {
+            typedef MatrixMarketScalar<T> S;
+            char text[64];
+            int n = std::snprintf(text, sizeof(text), "%.*g", S::digits, S::real(v));
+            out.append(text, static_cast<size_t>(n));
+            if (S::complex)
+            {
+                n = std::snprintf(text, sizeof(text), " %.*g", S::digits, S::imag(v));
+                out.append(text, static_cast<size_t>(n));
+            }
+        }
+
+        /**
+         * @brief 分批写出 count 个条目：每批切成若干段，format(text, begin, end) 并行把各段格式化为文本，再按顺序写入
+         */
+        template <typename Format>
+        void writeMatrixMarketLines(std::ostream &out, size_t count, const Format &format)
+        {
+            std::vector<std::string> texts;
+            for (size_t b = 0; b < count; b += MatrixMarketWriteBatch)
+            {
+                const size_t e = std::min(count, b + MatrixMarketWriteBatch);
+                const size_t pieces = std::max<size_t>(1, std::min(parallelThreads(), (e - b) / (MatrixMarketWriteBatch / 16)));
+                texts.resize(pieces);
+                parallelFor(0, pieces, 1, [&](size_t t0, size_t t1)
+                            {
+                                for (size_t t = t0; t < t1; ++t)
+                                {
+                                    texts[t].clear();
+                                    format(texts[t], b + (e - b) * t / pieces, b + (e - b) * (t + 1) / pieces);
+                                } });
+                for (size_t t = 0; t < pieces; ++t)
+                    out.write(texts[t].data(), static_cast<std::streamsize>(texts[t].size()));
+            }
+        }
+
+        inline const char *symmetryName(MatrixMarketSymmetry symmetry)
+        {
+            switch (symmetry)
+            {
+            case MatrixMarketSymmetry::Symmetric:
+                return "symmetric";
+            case MatrixMarketSymmetry::SkewSymmetric:
+                return "skew-symmetric";
+            case MatrixMarketSymmetry::Hermitian:
+                return "hermitian";
+            default:
+                return "general";
+            }
+        }
+
+        inline void openForWriting(std::ofstream &out, const std::string &path)
+        {
+            out.open(path, std::ios::binary | std::ios::trunc);
+            if (!out)
+                throw std::runtime_error("Cannot open file for writing: " + path);
+        }
+
+        inline void finishWriting(std::ofstream &out, const std::string &path)
+        {
+            out.close();
+            if (!out)
+                throw std::runtime_error("Failed to write file: " + path);
+        }
+    }
+
+    /**
+     * @brief 只读取文件头
+     */
+    inline MatrixMarketInfo readMatrixMarketInfo(const std::string &path)
+    {
+        std::ifstream in;
+        internal::openForReading(in, path);
+        return internal::readMatrixMarketHeader(in);
+    }
+
+    /**
+     * @brief 读取为稀疏矩阵（默认 CSR）；array 格式文件只保留非零元
+     */
+    template <typename T, bool RowMajor = true>
+    SparseMatrix<T, RowMajor> readMatrixMarketSparse(const std::string &path)
+    {
+        std::ifstream in;
+        internal::openForReading(in, path);
+        const MatrixMarketInfo info = internal::readMatrixMarketHeader(in);
+        // 声明的条目数只作参考：预留量不超过剩余正文按最短条目能写下的个数
+        size_t expected = info.entries;
+        const std::streampos body = in.tellg();
+        if (body != std::streampos(-1) && in.seekg(0, std::ios::end))
+        {
+            const std::streamoff remaining = in.tellg() - body;
+            in.seekg(body);
+            if (remaining >= 0)
+                expected = std::min(expected, static_cast<size_t>(remaining) / internal::minMatrixMarketEntryBytes(info) + 1);
+        }
+        in.clear();
+        std::vector<Triplet<T>> triplets;
+        triplets.reserve(info.symmetry == MatrixMarketSymmetry::General ? expected : 2 * expected);
+        const bool keepZeros = info.coordinate;
+        auto sink = [&](size_t i, size_t j, const T &v)
+        {
+            if (keepZeros || !(v == T()))
+                triplets.push_back(Triplet<T>(i, j, v));
+        };
+        internal::parseMatrixMarketBody<T>(in, info, sink);
+        return SparseMatrix<T, RowMajor>(info.rows, info.cols, triplets);
+    }
+
+    /**
+     * @brief 读取为稠密矩阵；coordinate 格式文件中未出现的位置为 0
+     */
+    template <typename T>
+    MatrixNM<T, Dynamic, Dynamic> readMatrixMarketDense(const std::string &path)
+    {
+        std::ifstream in;
+        internal::openForReading(in, path);
+        const MatrixMarketInfo info = internal::readMatrixMarketHeader(in);
+        // coordinate 文件的 rows * cols 不受条目数约束，稠密结果要求它不超出 size_t
+        if (info.cols != 0 && info.rows > std::numeric_limits<size_t>::max() / info.cols)
+            throw std::runtime_error("Matrix Market matrix is too large for dense storage");
+        MatrixNM<T, Dynamic, Dynamic> result(info.rows, info.cols);
+        auto sink = [&](size_t i, size_t j, const T &v)
+        { result(i, j) += v; };
+        internal::parseMatrixMarketBody<T>(in, info, sink);
+        return result;
+    }
+
+    /**
+     * @brief 以 coordinate 格式写出稀疏矩阵
+     * @param symmetry 不为 General 时只写下三角（斜对称时不含对角线），调用者需保证矩阵确有该对称性
+     */
+    template <typename T, bool RowMajor>
+    void writeMatrixMarket(const std::string &path, const SparseMatrix<T, RowMajor> &A,
+                           MatrixMarketSymmetry symmetry = MatrixMarketSymmetry::General)
+    {
+        typedef internal::MatrixMarketScalar<T> S;
+        if (symmetry != MatrixMarketSymmetry::General && A.rows() != A.cols())
+            throw std::invalid_argument("Symmetric Matrix Market output requires a square matrix");
+        const size_t outer = RowMajor ? A.rows() : A.cols(), nnz = A.nonZeros();
+        const size_t *ptr = A.outerIndexPtr();
+        const auto *inner = A.innerIndexPtr();
+        const T *values = A.valuePtr();
+        auto position = [&](size_t k, size_t p, size_t &i, size_t &j)
+        {
+            i = RowMajor ? k : inner[p];
+            j = RowMajor ? inner[p] : k;
+        };
+        auto keep = [&](size_t i, size_t j)
+        {
+            return symmetry == MatrixMarketSymmetry::General || i > j ||
+                   (i == j && symmetry != MatrixMarketSymmetry::SkewSymmetric);
+        };
+
+        size_t entries = nnz;
+        if (symmetry != MatrixMarketSymmetry::General)
+        {
+            entries = 0;
+            for (size_t k = 0; k < outer; ++k)
+                for (size_t p = ptr[k]; p < ptr[k + 1]; ++p)
+                {
+                    size_t i, j;
+                    position(k, p, i, j);
+                    entries += keep(i, j) ? 1 : 0;
+                }
+        }
+
+        std::ofstream out;
+        internal::openForWriting(out, path);
+        out << "%%MatrixMarket matrix coordinate " << (S::complex ? "complex" : "real") << ' '
+            << internal::symmetryName(symmetry) << '\n'
+            << A.rows() << ' ' << A.cols() << ' ' << entries << '\n';
+        internal::writeMatrixMarketLines(out, nnz, [&](std::string &text, size_t begin, size_t end)
+                                         {
+            size_t k = static_cast<size_t>(std::upper_bound(ptr, ptr + outer + 1, begin) - ptr) - 1;
+            for (size_t p = begin; p < end; ++p)
+            {
+                while (ptr[k + 1] <= p)
+                    ++k;
+                size_t i, j;
+                position(k, p, i, j);
+                if (!keep(i, j))
+                    continue;
+                internal::appendUnsigned(text, i + 1);
+                text.push_back(' ');
+                internal::appendUnsigned(text, j + 1);
+                text.push_back(' ');
+                internal::appendValue(text, values[p]);
+                text.push_back('\n');
+            } });
+        internal::finishWriting(out, path);
+    }
+
+    /**
+     * @brief 以 array 格式（列主序）写出稠密矩阵或表达式
+     */
+    template <typename Derived>
+    void writeMatrixMarket(const std::string &path, const MatrixBase<Derived> &matrix)
+    {
+        typedef typename internal::ExprTraits<Derived>::Scalar T;
+        typedef internal::MatrixMarketScalar<T> S;
+        const Derived &A = matrix.derived();
+        const size_t rows = A.rows(), cols = A.cols();
+        const internal::Evaluator<Derived> ev(A);
+
+        std::ofstream out;
+        internal::openForWriting(out, path);
+        out << "%%MatrixMarket matrix array " << (S::complex ? "complex" : "real") << " general\n"
+            << rows << ' ' << cols << '\n';
+        internal::writeMatrixMarketLines(out, rows * cols, [&](std::string &text, size_t begin, size_t end)
+                                         {
+            for (size_t t = begin; t < end; ++t)
+            {
+                internal::appendValue(text, T(ev.coeff(t % rows, t / rows)));
+                text.push_back('\n');
+            } });
+        internal::finishWriting(out, path);
+    }
+}
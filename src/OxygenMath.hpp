@@ -2,6 +2,13 @@
 #include "./Algebra/NumberField.hpp"
 #include "./Algebra/MatrixNM.hpp"
 #include "./Algebra/VectorN.hpp"
+#include "./Algebra/ElementwiseMath.hpp"
 #include "./Algebra/LinerAlgbraAlgorithm.hpp"
+#include "./Algebra/SplitComplex.hpp"
+#include "./Algebra/BatchedMatrix.hpp"
+#include "./Algebra/SparseMatrix.hpp"
+#include "./Algebra/IterativeSolvers.hpp"
+#include "./IO/BinaryMatrix.hpp"
+#include "./IO/MatrixMarket.hpp"
 
 #include "./Geometry/2dGeomertyAlgorithm.hpp"
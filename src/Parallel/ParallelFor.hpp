@@ -0,0 +1,120 @@
+/**
+ * @file ParallelFor.hpp
+ * @brief 按连续区间把循环分给线程池执行，以及并行归约。
+ * @details 区间 [begin, end) 被切成至多 parallelThreads() 个连续块，每块长度是 grain 的整数倍（最后一块除外），
+ *          调用线程执行最后一块，其余块作为任务提交给共享线程池（ThreadPool.hpp），调用线程做完自己的块后
+ *          一起执行池中剩余的任务直到全部完成。元素数不超过 grain 或只有一个线程时直接在调用线程中执行，
+ *          不经过线程池。任务内部可以再次调用 parallelFor。
+ *          任一块抛出的异常会在所有块结束后重新抛出。
+ */
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <exception>
+#include <vector>
+#include "ThreadPool.hpp"
+
+namespace OxygenMath
+{
+    namespace internal
+    {
+        /**
+         * @brief parallelFor 提交到线程池的一个块
+         */
+        template <typename Func>
+        struct ParallelForContext
+        {
+            const Func *func;
+            size_t begin, end, blockLength;
+            std::exception_ptr *errors;
+            TaskGroup *group;
+
+            static void run(void *context, size_t t)
+            {
+                ParallelForContext &ctx = *static_cast<ParallelForContext *>(context);
+                const size_t b = ctx.begin + t * ctx.blockLength;
+                try
+                {
+                    (*ctx.func)(b, std::min(ctx.end, b + ctx.blockLength));
+                }
+                catch (...)
+                {
+                    ctx.errors[t] = std::current_exception();
+                }
+                ctx.group->done();
+            }
+        };
+    }
+
+    /**
+     * @brief 并行执行 func(blockBegin, blockEnd)，各块互不重叠且覆盖 [begin, end)
+     * @param begin 区间起点
+     * @param end 区间终点（不含）
+     * @param grain 每块的最小长度；块边界总落在 begin + k * grain 上
+     * @param func 可被多个线程同时调用的函数对象
+     */
+    template <typename Func>
+    void parallelFor(size_t begin, size_t end, size_t grain, const Func &func)
+    {
+        if (end <= begin)
+            return;
+        grain = std::max<size_t>(grain, 1);
+        const size_t n = end - begin;
+        const size_t grains = (n + grain - 1) / grain;
+        size_t blocks = std::min(parallelThreads(), grains);
+        if (blocks <= 1)
+        {
+            func(begin, end);
+            return;
+        }
+
+        const size_t blockLength = (grains + blocks - 1) / blocks * grain;
+        blocks = (n + blockLength - 1) / blockLength;
+        internal::ThreadPool &pool = internal::threadPool();
+        internal::TaskGroup group(pool);
+        std::vector<std::exception_ptr> errors(blocks);
+        internal::ParallelForContext<Func> context{&func, begin, end, blockLength, errors.data(), &group};
+        group.add(blocks - 1);
+        for (size_t t = 0; t + 1 < blocks; ++t)
+            pool.submit(internal::PoolTask{&internal::ParallelForContext<Func>::run, &context, t});
+        try
+        {
+            func(begin + (blocks - 1) * blockLength, end);
+        }
+        catch (...)
+        {
+            errors[blocks - 1] = std::current_exception();
+        }
+        group.wait();
+        for (const auto &error : errors)
+            if (error)
+                std::rethrow_exception(error);
+    }
+
+    /**
+     * @brief 并行归约：把 [begin, end) 按 parallelFor 的方式分块，各块结果按块的顺序用 combine 合并
+     * @param identity 归约的单位元（空区间的结果）
+     * @param func func(blockBegin, blockEnd) 返回该块的归约结果
+     * @param combine combine(a, b) 合并两个结果
+     * @details 块的划分只取决于区间、grain 与线程数，因此线程数不变时结果可重复。
+     */
+    template <typename R, typename Func, typename Combine>
+    R parallelReduce(size_t begin, size_t end, size_t grain, const R &identity, const Func &func, const Combine &combine)
+    {
+        if (end <= begin)
+            return identity;
+        grain = std::max<size_t>(grain, 1);
+        const size_t grains = (end - begin + grain - 1) / grain;
+        const size_t blocks = std::min(parallelThreads(), grains);
+        if (blocks <= 1)
+            return func(begin, end);
+        const size_t blockLength = (grains + blocks - 1) / blocks * grain;
+        std::vector<R> partial((end - begin + blockLength - 1) / blockLength, identity);
+        parallelFor(begin, end, grain, [&](size_t b, size_t e)
+                    { partial[(b - begin) / blockLength] = func(b, e); });
+        R result = partial[0];
+        for (size_t t = 1; t < partial.size(); ++t)
+            result = combine(result, partial[t]);
+        return result;
+    }
+}
@@ -0,0 +1,301 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief 库内共享的常驻工作窃取线程池，以及线程数配置。
+ * @details 线程池有 parallelThreads() - 1 个工作线程（提交任务的线程自己也参与计算），
+ *          每个工作线程有一个任务队列，外部线程提交的任务进入单独的注入队列：
+ *          - 工作线程优先从自己队列的尾部取任务（后进先出，数据仍在缓存中）；
+ *          - 自己的队列为空时，从其他队列的头部窃取（先进先出，窃取到的通常是较大的块）；
+ *          - 所有队列都为空时在条件变量上休眠。
+ *          等待任务组完成的线程不会空等，而是一起执行队列中的任务，因此在任务内部再次并行（嵌套的 parallelFor）不会死锁。
+ *          任务只是"函数指针 + 上下文 + 下标"，队列是可增长的环形缓冲区，稳定运行后提交任务不分配内存。
+ *
+ *          线程数默认取环境变量 OXYGENMATH_NUM_THREADS，未设置时取 std::thread::hardware_concurrency()；
+ *          可用 setParallelThreads() 修改，线程池在下一次并行调用时按新线程数重建。
+ */
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OxygenMath
+{
+    namespace internal
+    {
+        // 0 表示尚未配置，按环境变量或硬件线程数确定
+        inline std::atomic<size_t> &configuredThreads()
+        {
+            static std::atomic<size_t> threads(0);
+            return threads;
+        }
+
+        inline size_t defaultThreads()
+        {
+            if (const char *env = std::getenv("OXYGENMATH_NUM_THREADS"))
+            {
+                const long n = std::strtol(env, nullptr, 10);
+                if (n > 0)
+                    return static_cast<size_t>(n);
+            }
+            const unsigned n = std::thread::hardware_concurrency();
+            return n == 0 ? 1 : n;
+        }
+    }
+
+    /**
+     * @brief 并行运算使用的线程数（至少为 1，含调用线程）
+     */
+    inline size_t parallelThreads()
+    {
+        std::atomic<size_t> &threads = internal::configuredThreads();
+        size_t n = threads.load(std::memory_order_relaxed);
+        if (n == 0)
+        {
+            n = internal::defaultThreads();
+            threads.store(n, std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    /**
+     * @brief 设置并行运算使用的线程数，n 为 0 时恢复默认值
+     * @note 只能在没有并行任务运行时调用；线程池在下一次并行调用时重建。
+     */
+    inline void setParallelThreads(size_t n)
+    {
+        internal::configuredThreads().store(n == 0 ? internal::defaultThreads() : n, std::memory_order_relaxed);
+    }
+
+    namespace internal
+    {
+        /**
+         * @brief 线程池任务：run(context, index)
+         */
+        struct PoolTask
+        {
+            void (*run)(void *, size_t);
+            void *context;
+            size_t index;
+        };
+
+        /**
+         * @brief 互斥锁保护的双端任务队列（环形缓冲区，满时容量翻倍）
+         */
+        class TaskQueue
+        {
+        private:
+            std::mutex m_lock;
+            std::vector<PoolTask> m_ring;
+            size_t m_head = 0, m_size = 0;
+
+        public:
+            TaskQueue() : m_ring(64) {}
+
+            void push(const PoolTask &task)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (m_size == m_ring.size())
+                {
+                    std::vector<PoolTask> grown(m_ring.size() * 2);
+                    for (size_t i = 0; i < m_size; ++i)
+                        grown[i] = m_ring[(m_head + i) % m_ring.size()];
+                    m_ring.swap(grown);
+                    m_head = 0;
+                }
+                m_ring[(m_head + m_size) % m_ring.size()] = task;
+                ++m_size;
+            }
+
+            // 所有者从尾部取
+            bool popBack(PoolTask &task)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (m_size == 0)
+                    return false;
+                --m_size;
+                task = m_ring[(m_head + m_size) % m_ring.size()];
+                return true;
+            }
+
+            // 窃取者从头部取
+            bool popFront(PoolTask &task)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (m_size == 0)
+                    return false;
+                task = m_ring[m_head];
+                m_head = (m_head + 1) % m_ring.size();
+                --m_size;
+                return true;
+            }
+        };
+
+        /**
+         * @brief 工作窃取线程池
+         */
+        class ThreadPool
+        {
+        private:
+            std::vector<std::unique_ptr<TaskQueue>> m_queues; // 前 workers 个属于工作线程，最后一个是注入队列
+            std::vector<std::thread> m_threads;
+            std::mutex m_sleepLock;
+            std::condition_variable m_wake;
+            std::atomic<size_t> m_pending;
+            bool m_stop;
+
+            // 当前线程在所属线程池中的队列下标；不是工作线程时为 npos
+            static const ThreadPool *&currentPool()
+            {
+                static thread_local const ThreadPool *pool = nullptr;
+                return pool;
+            }
+            static size_t &currentIndex()
+            {
+                static thread_local size_t index = 0;
+                return index;
+            }
+
+            // 从 home 开始依次尝试：自己的队列尾部，其余队列头部
+            bool take(size_t home, PoolTask &task)
+            {
+                const size_t queues = m_queues.size();
+                if (home < queues && m_queues[home]->popBack(task))
+                    return true;
+                for (size_t k = 1; k <= queues; ++k)
+                {
+                    const size_t victim = (home + k) % queues;
+                    if (victim != home && m_queues[victim]->popFront(task))
+                        return true;
+                }
+                return false;
+            }
+
+            void execute(const PoolTask &task)
+            {
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                task.run(task.context, task.index);
+            }
+
+            void workerLoop(size_t index)
+            {
+                currentPool() = this;
+                currentIndex() = index;
+                PoolTask task;
+                while (true)
+                {
+                    if (take(index, task))
+                    {
+                        execute(task);
+                        continue;
+                    }
+                    std::unique_lock<std::mutex> guard(m_sleepLock);
+                    m_wake.wait(guard, [this]()
+                                { return m_stop || m_pending.load(std::memory_order_relaxed) > 0; });
+                    if (m_stop && m_pending.load(std::memory_order_relaxed) == 0)
+                        return;
+                }
+            }
+
+        public:
+            explicit ThreadPool(size_t workers) : m_pending(0), m_stop(false)
+            {
+                for (size_t i = 0; i <= workers; ++i)
+                    m_queues.emplace_back(new TaskQueue());
+                for (size_t i = 0; i < workers; ++i)
+                    m_threads.emplace_back([this, i]()
+                                           { workerLoop(i); });
+            }
+
+            ~ThreadPool()
+            {
+                {
+                    std::lock_guard<std::mutex> guard(m_sleepLock);
+                    m_stop = true;
+                }
+                m_wake.notify_all();
+                for (auto &thread : m_threads)
+                    thread.join();
+            }
+
+            ThreadPool(const ThreadPool &) = delete;
+            ThreadPool &operator=(const ThreadPool &) = delete;
+
+            size_t workers() const { return m_threads.size(); }
+
+            // 工作线程提交到自己的队列，其他线程提交到注入队列
+            void submit(const PoolTask &task)
+            {
+                const size_t home = currentPool() == this ? currentIndex() : m_queues.size() - 1;
+                m_pending.fetch_add(1, std::memory_order_relaxed);
+                m_queues[home]->push(task);
+                {
+                    // 与 workerLoop 中的检查同步，避免错过唤醒
+                    std::lock_guard<std::mutex> guard(m_sleepLock);
+                }
+                m_wake.notify_one();
+            }
+
+            // 在当前线程上执行一个排队的任务；没有任务时返回 false
+            bool runOne()
+            {
+                const size_t home = currentPool() == this ? currentIndex() : m_queues.size() - 1;
+                PoolTask task;
+                if (!take(home, task))
+                    return false;
+                execute(task);
+                return true;
+            }
+        };
+
+        /**
+         * @brief 库内共享的线程池；线程数与 parallelThreads() 不一致时重建
+         * @note 重建只在没有并行任务运行时安全，见 setParallelThreads()。
+         */
+        inline ThreadPool &threadPool()
+        {
+            static std::mutex lock;
+            static std::unique_ptr<ThreadPool> pool;
+            static std::atomic<ThreadPool *> current(nullptr);
+            const size_t workers = parallelThreads() - 1;
+            ThreadPool *p = current.load(std::memory_order_acquire);
+            if (p && p->workers() == workers)
+                return *p;
+            std::lock_guard<std::mutex> guard(lock);
+            if (!pool || pool->workers() != workers)
+            {
+                pool.reset();
+                pool.reset(new ThreadPool(workers));
+                current.store(pool.get(), std::memory_order_release);
+            }
+            return *pool;
+        }
+
+        /**
+         * @brief 一组并发任务的完成计数
+         * @details wait() 在计数归零前帮忙执行线程池中的任务，没有任务可做时让出时间片。
+         */
+        class TaskGroup
+        {
+        private:
+            ThreadPool &m_pool;
+            std::atomic<size_t> m_remaining;
+
+        public:
+            explicit TaskGroup(ThreadPool &pool) : m_pool(pool), m_remaining(0) {}
+
+            void add(size_t n) { m_remaining.fetch_add(n, std::memory_order_relaxed); }
+            void done() { m_remaining.fetch_sub(1, std::memory_order_release); }
+
+            void wait()
+            {
+                while (m_remaining.load(std::memory_order_acquire) != 0)
+                    if (!m_pool.runOne())
+                        std::this_thread::yield();
+            }
+        };
+    }
+}
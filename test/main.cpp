@@ -1,10 +1,81 @@
 #include <iostream>
 #include <functional>
 #include <random>
+#include <cstdlib>
+#include <new>
+#include <complex>
+#include <limits>
+#include <cmath>
 #include "../src/OxygenMath.hpp"
 
 using namespace OxygenMath;
 static int test_pass_count = 0;
+
+// 统计堆分配次数，用于检查定长矩阵是否分配内存
+// 替换全部普通、数组、nothrow 与带尺寸的版本，分配都经 countedAlloc、释放都经 countedFree；
+// 两者不内联，GCC 看不到 new 出来的指针被 free，-Wall 下不会报 -Wmismatched-new-delete
+#if defined(__GNUC__)
+#define OXYGENMATH_TEST_NOINLINE __attribute__((noinline))
+#else
+#define OXYGENMATH_TEST_NOINLINE
+#endif
+static size_t heap_alloc_count = 0;
+static OXYGENMATH_TEST_NOINLINE void *countedAlloc(std::size_t size) noexcept
+{
+    ++heap_alloc_count;
+    return std::malloc(size ? size : 1);
+}
+static OXYGENMATH_TEST_NOINLINE void countedFree(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+void *operator new(std::size_t size)
+{
+    if (void *ptr = countedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t size)
+{
+    if (void *ptr = countedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc(size);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc(size);
+}
+void operator delete(void *ptr) noexcept
+{
+    countedFree(ptr);
+}
+void operator delete[](void *ptr) noexcept
+{
+    countedFree(ptr);
+}
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+    countedFree(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+    countedFree(ptr);
+}
+#if defined(__cpp_sized_deallocation)
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    countedFree(ptr);
+}
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    countedFree(ptr);
+}
+#endif
+
 void testMatrix();
 void testVector();
 void test2dGeometry();
@@ -12,10 +83,35 @@ void testLUP();
 void myTest();
 void testInverseAndDeterminant();
 void testGaussSeidel();
+void testDynamicMatrix();
+void testGemm();
+void testNestedProduct();
+void testFixedStorage();
+void testScalarPolicy();
+void testMixedPrecision();
+void testSplitComplex();
+void testBlockedLU();
+void testLUSolve();
+void testBatchedMatrix();
+void testSymmetricFactorization();
+void testQR();
+void testSymmetricEigen();
+void testSVD();
+void testGeneralEigenvalues();
+void testSparseMatrix();
+void testKrylovSolvers();
+void testRelaxation();
+void testThreadPool();
+void testExpressionReductions();
+void testElementwiseMath();
+void testMatrixViews();
+void testAliasAssignment();
+void testBinaryMatrixFile();
+void testMatrixMarket();
 int main()
 {
     auto test_funnctions = {testMatrix, test2dGeometry, testVector, testLUP, myTest, testInverseAndDeterminant};
-    std::vector<std::function<void()>> test_functions{testGaussSeidel};
+    std::vector<std::function<void()>> test_functions{testGaussSeidel, testDynamicMatrix, testGemm, testNestedProduct, testFixedStorage, testScalarPolicy, testMixedPrecision, testSplitComplex, testBlockedLU, testLUSolve, testBatchedMatrix, testSymmetricFactorization, testQR, testSymmetricEigen, testSVD, testGeneralEigenvalues, testSparseMatrix, testKrylovSolvers, testRelaxation, testThreadPool, testExpressionReductions, testElementwiseMath, testMatrixViews, testAliasAssignment, testBinaryMatrixFile, testMatrixMarket};
     for (const auto &func : test_functions)
     {
         func();
@@ -253,4 +349,2676 @@ void testInverseAndDeterminant()
     }
     std::cout << "=========Inverse & Determinant Test End=========" << std::endl;
     test_pass_count++;
-}
\ No newline at end of file
+}
+void testDynamicMatrix()
+{
+    std::cout << "=========Dynamic Matrix Test=========" << std::endl;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dis(-10.0, 10.0);
+    bool ok = true;
+
+    // 同一个实例化服务不同规模
+    for (size_t n : {1, 5, 50})
+    {
+        MatrixXf A(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                A(i, j) = dis(gen);
+
+        if (reinterpret_cast<uintptr_t>(A.data()) % 64 != 0)
+            ok = false;
+
+        auto invA = LinAlg::inverse(A);
+        MatrixXf prod = A * invA;
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+            {
+                Real expected = (i == j) ? 1.0 : 0.0;
+                if (abs(prod(i, j) - expected) > 1e-9)
+                    ok = false;
+            }
+
+        VectorXf b(n);
+        for (size_t i = 0; i < n; ++i)
+            b(i) = A(i, i) * Real(static_cast<double>(n)) + Real(1.0);
+        VectorXf x = invA * b;
+        VectorXf r = A * x - b;
+        if (r.norm() > 1e-8)
+            ok = false;
+    }
+
+    // 移动不分配内存，只转移缓冲区
+    MatrixXf big(200, 100);
+    const Real *buffer = big.data();
+    MatrixXf moved = std::move(big);
+    if (moved.data() != buffer || moved.rows() != 200 || moved.cols() != 100 || big.rows() != 0)
+        ok = false;
+
+    // 与定长矩阵互通
+    MatrixNM<Real, 2, 3> fixed{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    MatrixXf dyn = fixed;
+    MatrixXf dynT = dyn.transpose();
+    if (dynT.rows() != 3 || dynT.cols() != 2 || dynT(2, 1) != Real(6.0))
+        ok = false;
+
+    MatrixXf gs{{4.0, 1.0, 2.0}, {3.0, 5.0, 1.0}, {1.0, 1.0, 3.0}};
+    VectorXf gb{4.0, 7.0, 3.0};
+    VectorXf x0(3);
+    VectorXf gx = LinAlg::gaussSeidel(gs, gb, x0);
+    VectorXf gr = gs * gx - gb;
+    if (gr.norm() > 1e-6)
+        ok = false;
+    if (abs(LinAlg::determinant(gs) - Real(44.0)) > 1e-9)
+        ok = false;
+
+    // 行列数之积超出 size_t 时拒绝分配，而不是回绕成过小的缓冲区
+    const size_t half = size_t(1) << (std::numeric_limits<size_t>::digits / 2);
+    bool threwLength = false;
+    try
+    {
+        MatrixXf huge(half, half);
+    }
+    catch (const std::length_error &)
+    {
+        threwLength = true;
+    }
+    bool threwResize = false;
+    try
+    {
+        MatrixXf small(2, 2);
+        small.resize(half, half);
+    }
+    catch (const std::length_error &)
+    {
+        threwResize = true;
+    }
+    if (!threwLength || !threwResize)
+        ok = false;
+
+    std::cout << "Dynamic matrix test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Dynamic Matrix Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testGemm()
+{
+    std::cout << "=========GEMM Test=========" << std::endl;
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    bool ok = true;
+
+    // 覆盖小矩阵路径、边界块以及跨越 KC/MC 分块的尺寸
+    const size_t shapes[][3] = {{3, 4, 5}, {17, 9, 33}, {64, 64, 64}, {101, 77, 300}, {7, 130, 260}};
+    for (const auto &shape : shapes)
+    {
+        const size_t m = shape[0], n = shape[1], k = shape[2];
+        MatrixXf A(m, k), B(k, n), Bt(n, k);
+        for (size_t i = 0; i < m; ++i)
+            for (size_t p = 0; p < k; ++p)
+                A(i, p) = dis(gen);
+        for (size_t p = 0; p < k; ++p)
+            for (size_t j = 0; j < n; ++j)
+                Bt(j, p) = B(p, j) = dis(gen);
+
+        MatrixXf C = A * B;
+        MatrixXf Ct(n, m);
+        Ct = Bt * A.transpose();
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < n; ++j)
+            {
+                Real ref = 0.0;
+                for (size_t p = 0; p < k; ++p)
+                    ref += A(i, p) * B(p, j);
+                if (abs(C(i, j) - ref) > 1e-10 || abs(Ct(j, i) - ref) > 1e-10)
+                    ok = false;
+            }
+    }
+
+    // 赋值给自身的操作数时结果仍然正确
+    MatrixNM<Real, 20, 20> M;
+    for (size_t i = 0; i < 20; ++i)
+        for (size_t j = 0; j < 20; ++j)
+            M(i, j) = dis(gen);
+    MatrixNM<Real, 20, 20> M0 = M;
+    M = M * M;
+    for (size_t i = 0; i < 20; ++i)
+        for (size_t j = 0; j < 20; ++j)
+        {
+            Real ref = 0.0;
+            for (size_t p = 0; p < 20; ++p)
+                ref += M0(i, p) * M0(p, j);
+            if (abs(M(i, j) - ref) > 1e-10)
+                ok = false;
+        }
+
+    std::cout << "GEMM test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========GEMM Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testNestedProduct()
+{
+    std::cout << "=========Nested Product Test=========" << std::endl;
+    constexpr size_t N = 40;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    MatrixNM<Real, N, N> A, B, C;
+    for (size_t i = 0; i < N; ++i)
+        for (size_t j = 0; j < N; ++j)
+        {
+            A(i, j) = dis(gen);
+            B(i, j) = dis(gen);
+            C(i, j) = dis(gen);
+        }
+
+    // 参考结果：逐步显式求值
+    MatrixNM<Real, N, N> AB, ABC, ABtC, ABpC, BpC;
+    AB.noalias() = A * B;
+    ABC.noalias() = AB * C;
+    MatrixNM<Real, N, N> ABt = AB.transpose();
+    ABtC.noalias() = ABt * C;
+    BpC = B + C;
+    ABpC.noalias() = A * BpC;
+
+    auto close = [](const MatrixNM<Real, N, N> &X, const MatrixNM<Real, N, N> &Y)
+    {
+        for (size_t i = 0; i < N; ++i)
+            for (size_t j = 0; j < N; ++j)
+                if (abs(X(i, j) - Y(i, j)) > 1e-10)
+                    return false;
+        return true;
+    };
+
+    bool ok = true;
+    MatrixNM<Real, N, N> R1 = A * B * C;
+    MatrixNM<Real, N, N> R2 = (A * B).transpose() * C;
+    MatrixNM<Real, N, N> R3 = A * (B + C);
+    ok = ok && close(R1, ABC) && close(R2, ABtC) && close(R3, ABpC);
+
+    // 子表达式按值保存，auto 保存的表达式不会悬空
+    auto expr = A * B + C * Real(2.0);
+    MatrixNM<Real, N, N> R4 = expr;
+    MatrixNM<Real, N, N> R5 = (A * B).eval();
+    for (size_t i = 0; i < N; ++i)
+        for (size_t j = 0; j < N; ++j)
+            if (abs(R4(i, j) - (AB(i, j) + Real(2.0) * C(i, j))) > 1e-10 || R5(i, j) != AB(i, j))
+                ok = false;
+
+    // 非实数元素走通用路径
+    MatrixNM<Complex, 2, 2> c1{{Complex(1, 1), Complex(0, 2)}, {Complex(3, 0), Complex(1, -1)}};
+    MatrixNM<Complex, 2, 2> c3 = c1 * c1 * c1;
+    MatrixNM<Complex, 2, 2> c2 = c1 * c1;
+    MatrixNM<Complex, 2, 2> c3ref = c2 * c1;
+    for (size_t i = 0; i < 2; ++i)
+        for (size_t j = 0; j < 2; ++j)
+            if (c3(i, j).real != c3ref(i, j).real || c3(i, j).imag != c3ref(i, j).imag)
+                ok = false;
+
+    std::cout << "Nested product test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Nested Product Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testFixedStorage()
+{
+    std::cout << "=========Fixed Storage Test=========" << std::endl;
+    constexpr size_t N = 6;
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dis(-10.0, 10.0);
+    MatrixNM<Real, N, N> A;
+    for (size_t i = 0; i < N; ++i)
+        for (size_t j = 0; j < N; ++j)
+            A(i, j) = dis(gen);
+
+    // 小尺寸定长矩阵的构造、拷贝、赋值与求逆都不应分配堆内存
+    const size_t before = heap_alloc_count;
+    MatrixNM<Real, N, N> B = A;
+    MatrixNM<Real, N, 1> v;
+    B = A + B;
+    auto invA = LinAlg::inverse(A);
+    MatrixNM<Real, N, N> prod = A * invA;
+    const size_t allocations = heap_alloc_count - before;
+
+    bool ok = allocations == 0;
+    for (size_t i = 0; i < N; ++i)
+        for (size_t j = 0; j < N; ++j)
+        {
+            Real expected = (i == j) ? 1.0 : 0.0;
+            if (abs(prod(i, j) - expected) > 1e-10 || B(i, j) != A(i, j) * Real(2.0))
+                ok = false;
+        }
+    if (reinterpret_cast<uintptr_t>(A.data()) % alignof(MatrixNM<Real, N, N>) != 0 || alignof(MatrixNM<Real, N, N>) < 16)
+        ok = false;
+
+    // 超过内联阈值的定长矩阵放在堆上，移动时只转移缓冲区
+    MatrixNM<Real, 64, 64> big = MatrixNM<Real, 64, 64>::identity();
+    const Real *buffer = big.data();
+    MatrixNM<Real, 64, 64> moved = std::move(big);
+    if (moved.data() != buffer || moved(10, 10) != Real(1.0))
+        ok = false;
+    big = moved;
+    if (big(63, 63) != Real(1.0) || big(0, 1) != Real(0.0))
+        ok = false;
+
+    std::cout << "Heap allocations for 6x6 inverse: " << allocations << std::endl;
+    std::cout << "Fixed storage test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Fixed Storage Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testScalarPolicy()
+{
+    std::cout << "=========Scalar Policy Test=========" << std::endl;
+    bool ok = true;
+
+    // 默认的 Real 检查非法运算
+    bool thrown = false;
+    try
+    {
+        Real r = Real(1.0) / Real(0.0);
+        (void)r;
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    ok = ok && thrown;
+
+    // RealIEEE 与裸 double 行为一致
+    RealIEEE inf = RealIEEE(1.0) / RealIEEE(0.0);
+    RealIEEE nan = sqrt(RealIEEE(-1.0));
+    RealIEEE lg = log(RealIEEE(0.0));
+    ComplexIEEE cinf = ComplexIEEE(1.0, 1.0) / ComplexIEEE(0.0, 0.0);
+    ok = ok && std::isinf(inf.data) && std::isnan(nan.data) && std::isinf(lg.data) && !std::isfinite(cinf.real);
+
+    // 显式转换与线性代数
+    RealIEEE converted(Real(2.5));
+    ok = ok && converted.data == 2.5;
+    MatrixNM<RealIEEE, 4, 4> A{{4.0, 1.0, 2.0, 0.5}, {1.0, 5.0, 1.0, 0.0}, {2.0, 1.0, 6.0, 1.0}, {0.5, 0.0, 1.0, 3.0}};
+    auto invA = LinAlg::inverse(A);
+    MatrixNM<RealIEEE, 4, 4> prod = A * invA;
+    for (size_t i = 0; i < 4; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            if (std::abs(prod(i, j).data - (i == j ? 1.0 : 0.0)) > 1e-12)
+                ok = false;
+
+    std::cout << "Scalar policy test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Scalar Policy Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testMixedPrecision()
+{
+    std::cout << "=========Mixed Precision Test=========" << std::endl;
+    bool ok = true;
+
+    // 单精度标量与复数
+    Real32 a = 1.5f, b = 0.25f;
+    Complex32 c = Complex32(1.0f, 2.0f) * Complex32(3.0f, -1.0f);
+    ok = ok && (a * b).data == 0.375f && sqrt(Real32(4.0f)).data == 2.0f;
+    ok = ok && c.real == 5.0f && c.imag == 5.0f;
+    ok = ok && Real(Real32(0.5f)).data == 0.5;
+
+    // 单精度 GEMM 与朴素乘法一致
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    const size_t m = 37, k = 70, n = 45;
+    MatrixX<Real32> A32(m, k), B32(k, n);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t p = 0; p < k; ++p)
+            A32(i, p) = Real32(float(dis(gen)));
+    for (size_t p = 0; p < k; ++p)
+        for (size_t j = 0; j < n; ++j)
+            B32(p, j) = Real32(float(dis(gen)));
+    MatrixX<Real32> C32 = A32 * B32;
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < n; ++j)
+        {
+            double ref = 0.0;
+            for (size_t p = 0; p < k; ++p)
+                ref += double(A32(i, p).data) * double(B32(p, j).data);
+            if (std::abs(C32(i, j).data - ref) > 1e-4)
+                ok = false;
+        }
+
+    // 单精度分解 + 双精度修正，结果达到双精度精度
+    const size_t N = 120;
+    MatrixXf A(N, N);
+    VectorXf xTrue(N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        xTrue[i] = dis(gen);
+        for (size_t j = 0; j < N; ++j)
+            A(i, j) = dis(gen) + (i == j ? 4.0 : 0.0);
+    }
+    VectorXf rhs = A * xTrue;
+    auto result = LinAlg::mixedPrecisionSolve(A, rhs);
+    ok = ok && result.converged && result.iterations > 0;
+    for (size_t i = 0; i < N; ++i)
+        if (abs(result.x[i] - xTrue[i]) > 1e-12)
+            ok = false;
+
+    // 定长矩阵
+    MatrixNM<Real, 3, 3> F{{4.0, 1.0, 2.0}, {1.0, 5.0, 1.0}, {2.0, 1.0, 6.0}};
+    VectorN<Real, 3> fb{1.0, 2.0, 3.0};
+    auto fixed = LinAlg::mixedPrecisionSolve(F, fb);
+    VectorN<Real, 3> direct = LinAlg::solve(LinAlg::luDecomposition(F), fb);
+    for (size_t i = 0; i < 3; ++i)
+        if (abs(fixed.x[i] - direct[i]) > 1e-14)
+            ok = false;
+
+    std::cout << "Refinement iterations: " << result.iterations << std::endl;
+    std::cout << "Mixed precision test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Mixed Precision Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+// 以 ulp 计的误差，ref 为高精度参考值
+template <typename F>
+static double ulpError(F value, long double ref)
+{
+    if (std::isnan(value) || std::isnan(static_cast<double>(ref)))
+        return std::isnan(value) == std::isnan(static_cast<double>(ref)) ? 0.0 : 1e30;
+    if (std::isinf(value) || std::isinf(static_cast<double>(ref)))
+        return value == static_cast<F>(ref) ? 0.0 : 1e30;
+    const F r = static_cast<F>(ref);
+    const F ulp = std::nextafter(std::abs(r), std::numeric_limits<F>::infinity()) - std::abs(r);
+    return static_cast<double>(std::abs(static_cast<long double>(value) - ref) / ulp);
+}
+
+template <typename F>
+static double maxUlpOfSimdMath(std::mt19937 &gen)
+{
+    typedef simd::Packet<F> P;
+    std::uniform_real_distribution<double> wide(-700.0, 700.0), trig(-100.0, 100.0), pos(-300.0, 300.0);
+    double worst = 0.0;
+    alignas(64) F in[P::size], out[P::size], out2[P::size], in2[P::size];
+    for (int iter = 0; iter < 2000; ++iter)
+    {
+        for (size_t l = 0; l < P::size; ++l)
+        {
+            in[l] = static_cast<F>(std::is_same<F, float>::value ? wide(gen) / 9 : wide(gen));
+            in2[l] = static_cast<F>(std::pow(10.0, pos(gen) / (std::is_same<F, float>::value ? 8 : 1)));
+        }
+        P::store(out, simd::exp<P>(P::load(in)));
+        for (size_t l = 0; l < P::size; ++l)
+            worst = std::max(worst, ulpError(out[l], std::exp(static_cast<long double>(in[l]))));
+        P::store(out, simd::log<P>(P::load(in2)));
+        for (size_t l = 0; l < P::size; ++l)
+            worst = std::max(worst, ulpError(out[l], std::log(static_cast<long double>(in2[l]))));
+        for (size_t l = 0; l < P::size; ++l)
+            in[l] = static_cast<F>(trig(gen));
+        typename P::type s, c;
+        simd::sincos<P>(P::load(in), s, c);
+        P::store(out, s);
+        P::store(out2, c);
+        for (size_t l = 0; l < P::size; ++l)
+        {
+            // 结果接近 0 时按绝对误差衡量
+            const long double rs = std::sin(static_cast<long double>(in[l])), rc = std::cos(static_cast<long double>(in[l]));
+            if (std::abs(rs) > 1e-3)
+                worst = std::max(worst, ulpError(out[l], rs));
+            if (std::abs(rc) > 1e-3)
+                worst = std::max(worst, ulpError(out2[l], rc));
+        }
+        for (size_t l = 0; l < P::size; ++l)
+            in2[l] = static_cast<F>(trig(gen));
+        P::store(out, simd::atan2<P>(P::load(in), P::load(in2)));
+        for (size_t l = 0; l < P::size; ++l)
+            worst = std::max(worst, ulpError(out[l], std::atan2(static_cast<long double>(in[l]), static_cast<long double>(in2[l]))));
+    }
+    return worst;
+}
+
+void testSplitComplex()
+{
+    std::cout << "=========Split Complex Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(23);
+    std::uniform_real_distribution<double> dis(-2.0, 2.0);
+
+    // 初等函数的精度与特殊值
+    const double ulpDouble = maxUlpOfSimdMath<double>(gen);
+    const double ulpFloat = maxUlpOfSimdMath<float>(gen);
+    ok = ok && ulpDouble <= 2.0 && ulpFloat <= 2.0;
+    typedef simd::ScalarPacket<double> S;
+    ok = ok && simd::exp<S>(1000.0) == std::numeric_limits<double>::infinity() && simd::exp<S>(-1000.0) == 0.0;
+    ok = ok && std::isnan(simd::log<S>(-1.0)) && simd::log<S>(0.0) == -std::numeric_limits<double>::infinity();
+    ok = ok && std::abs(simd::log<S>(1e-310) - std::log(1e-310)) < 1e-12;
+
+    // 交错存储与分离存储的结果一致
+    const size_t n = 37;
+    VectorXc a(n), b(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i] = Complex(dis(gen), dis(gen));
+        b[i] = Complex(dis(gen), dis(gen));
+    }
+    SplitVectorXc sa(a), sb(b);
+    SplitVectorXc sum = sa + sb, diff = sa - sb, prod = hadamard(sa, sb);
+    SplitVectorXc e = exp(sa), r = sqrt(sa), l = log(sa);
+    auto close = [](const Complex &x, const Complex &y, double tol)
+    {
+        return std::abs(x.real - y.real) <= tol * (1 + std::abs(y.real)) && std::abs(x.imag - y.imag) <= tol * (1 + std::abs(y.imag));
+    };
+    for (size_t i = 0; i < n; ++i)
+    {
+        const std::complex<double> z(a[i].real, a[i].imag);
+        const std::complex<double> ez = std::exp(z), rz = std::sqrt(z), lz = std::log(z);
+        ok = ok && close(sum[i], a[i] + b[i], 1e-15) && close(diff[i], a[i] - b[i], 1e-15) && close(prod[i], a[i] * b[i], 1e-15);
+        ok = ok && close(e[i], Complex(ez.real(), ez.imag()), 1e-14) && close(r[i], Complex(rz.real(), rz.imag()), 1e-14) &&
+             close(l[i], Complex(lz.real(), lz.imag()), 1e-14);
+    }
+    ok = ok && close(dot(sa, sb), a.dot(b), 1e-13);
+    SplitVectorXc acc = sa;
+    acc += sb;
+    acc -= sa;
+    ok = ok && close(acc[n - 1], b[n - 1], 1e-15);
+    VectorXc back = sa.toVector();
+    ok = ok && back[n - 1] == a[n - 1];
+    bool threwIndex = false;
+    try
+    {
+        sa[n];
+    }
+    catch (const std::out_of_range &)
+    {
+        threwIndex = true;
+    }
+    ok = ok && threwIndex;
+
+    // 复数 GEMM
+    const size_t m = 19, k = 33, p = 26;
+    MatrixXc A(m, k), B(k, p);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < k; ++j)
+            A(i, j) = Complex(dis(gen), dis(gen));
+    for (size_t i = 0; i < k; ++i)
+        for (size_t j = 0; j < p; ++j)
+            B(i, j) = Complex(dis(gen), dis(gen));
+    MatrixXc C = A * B;
+    SplitMatrixXc sC = SplitMatrixXc(A) * SplitMatrixXc(B);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < p; ++j)
+            ok = ok && close(sC(i, j), C(i, j), 1e-13);
+
+    std::cout << "Max ulp error (double / float): " << ulpDouble << " / " << ulpFloat << std::endl;
+    std::cout << "Split complex test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Split Complex Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testBlockedLU()
+{
+    std::cout << "=========Blocked LU Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(29);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    // 跨越多个面板且不是面板宽度整数倍的尺寸
+    const size_t n = 203;
+    MatrixXf A(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            A(i, j) = dis(gen);
+
+    auto lu = LinAlg::luFactor(A);
+    ok = ok && !lu.isSingular && lu.pivots.size() == n;
+
+    // P * A = L * U
+    auto lup = LinAlg::luDecomposition(A);
+    MatrixXf PA = lup.P * A;
+    MatrixXf LU = lup.L * lup.U;
+    double maxErr = 0;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+        {
+            maxErr = std::max(maxErr, std::abs((PA(i, j) - LU(i, j)).data));
+            if (j < i && lup.U(i, j) != Real(0.0))
+                ok = false;
+            if (j > i && lup.L(i, j) != Real(0.0))
+                ok = false;
+        }
+    ok = ok && maxErr < 1e-12;
+
+    // 逆矩阵与行列式
+    MatrixXf I = A * LinAlg::inverse(lu);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            if (std::abs(I(i, j).data - (i == j ? 1.0 : 0.0)) > 1e-10)
+                ok = false;
+    ok = ok && LinAlg::determinant(lu) == LinAlg::determinant(lup);
+
+    // 定长矩阵与奇异矩阵
+    MatrixNM<Real, 3, 3> S{{{1.0, 2.0, 3.0}, {2.0, 4.0, 6.0}, {1.0, 0.0, 1.0}}};
+    auto luS = LinAlg::luFactor(S);
+    ok = ok && luS.isSingular && LinAlg::determinant(luS) == Real(0.0);
+
+    // 奇异矩阵的展开形式：分解进行到底，仍有 P * A = L * U，求解抛出异常
+    MatrixNM<Real, 4, 4> Z{{{0.0, 1.0, 2.0, 3.0}, {0.0, 2.0, 4.0, 1.0}, {0.0, 3.0, 6.0, 5.0}, {0.0, 1.0, 2.0, 7.0}}};
+    for (int which = 0; which < 2; ++which)
+    {
+        MatrixNM<Real, 4, 4> M = Z;
+        if (which == 1)
+            for (size_t i = 0; i < 4; ++i)
+                M(i, 0) = Real(1.0 + i);
+        auto lupZ = LinAlg::luDecomposition(M);
+        ok = ok && lupZ.isSingular && LinAlg::determinant(lupZ) == Real(0.0);
+        MatrixNM<Real, 4, 4> PZ = lupZ.P * M, LZ = lupZ.L * lupZ.U;
+        for (size_t i = 0; i < 4; ++i)
+            for (size_t j = 0; j < 4; ++j)
+            {
+                ok = ok && std::abs((PZ(i, j) - LZ(i, j)).data) < 1e-14;
+                if (j < i && lupZ.U(i, j) != Real(0.0))
+                    ok = false;
+                if ((j > i && lupZ.L(i, j) != Real(0.0)) || (j == i && lupZ.L(i, j) != Real(1.0)))
+                    ok = false;
+            }
+        bool threwSingular = false;
+        try
+        {
+            LinAlg::solve(lupZ, VectorN<Real, 4>{1.0, 2.0, 3.0, 4.0});
+        }
+        catch (const std::runtime_error &)
+        {
+            threwSingular = true;
+        }
+        ok = ok && threwSingular;
+    }
+    MatrixNM<Real, 3, 3> T{{{0.0, 2.0, 1.0}, {1.0, 1.0, 0.0}, {3.0, 0.0, 1.0}}};
+    ok = ok && std::abs(LinAlg::determinant(LinAlg::luFactor(T)).data - LinAlg::determinant(T).data) < 1e-14;
+
+    std::cout << "Max |PA - LU|: " << maxErr << std::endl;
+    std::cout << "Blocked LU test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Blocked LU Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testLUSolve()
+{
+    std::cout << "=========LU Solve Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(31);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    // 多个右端项：块外更新走 GEMM；单个右端项：走逐行循环
+    const size_t n = 150, m = 40;
+    MatrixXf A(n, n), B(n, m);
+    VectorXf b(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+            A(i, j) = dis(gen);
+        for (size_t j = 0; j < m; ++j)
+            B(i, j) = dis(gen);
+        b[i] = dis(gen);
+    }
+    const auto lu = LinAlg::luFactor(A);
+    MatrixXf X = LinAlg::solve(lu, B);
+    VectorXf x = LinAlg::solve(lu, b);
+    MatrixXf R = A * X;
+    VectorXf r(A * x);
+    double maxErr = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < m; ++j)
+            maxErr = std::max(maxErr, std::abs((R(i, j) - B(i, j)).data));
+        maxErr = std::max(maxErr, std::abs((r[i] - b[i]).data));
+    }
+    ok = ok && maxErr < 1e-11;
+
+    // 与旧的 LUPResult 路径一致
+    MatrixXf inv1 = LinAlg::inverse(LinAlg::luDecomposition(A));
+    MatrixXf inv2 = LinAlg::inverse(lu);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            ok = ok && std::abs((inv1(i, j) - inv2(i, j)).data) < 1e-10;
+
+    // 定长求解不分配堆内存
+    MatrixNM<Real, 5, 5> F;
+    VectorN<Real, 5> fb;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        for (size_t j = 0; j < 5; ++j)
+            F(i, j) = dis(gen) + (i == j ? 4.0 : 0.0);
+        fb[i] = dis(gen);
+    }
+    const size_t before = heap_alloc_count;
+    VectorN<Real, 5> fx = LinAlg::solve(LinAlg::luFactor(F), fb);
+    ok = ok && heap_alloc_count == before;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        Real sum = 0.0;
+        for (size_t j = 0; j < 5; ++j)
+            sum += F(i, j) * fx[j];
+        ok = ok && std::abs((sum - fb[i]).data) < 1e-13;
+    }
+
+    std::cout << "Max residual: " << maxErr << std::endl;
+    std::cout << "LU solve test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========LU Solve Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+template <typename F, size_t N>
+static bool checkBatched(size_t count, std::mt19937 &gen, double tol)
+{
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    BatchedMatrix<F, N, N> A(count);
+    BatchedVector<F, N> b(count);
+    for (size_t k = 0; k < count; ++k)
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = 0; j < N; ++j)
+                A(k, i, j) = static_cast<F>(dis(gen) + (i == j ? 2.0 : 0.0));
+            b(k, i, 0) = static_cast<F>(dis(gen));
+        }
+    const BatchedScalar<F> det = LinAlg::determinant(A);
+    const BatchedMatrix<F, N, N> inv = LinAlg::inverse(A);
+    const BatchedVector<F, N> x = LinAlg::solve(A, b);
+
+    bool ok = true;
+    for (size_t k = 0; k < count; ++k)
+    {
+        MatrixNM<Real, N, N> M;
+        for (size_t i = 0; i < N; ++i)
+            for (size_t j = 0; j < N; ++j)
+                M(i, j) = double(A(k, i, j));
+        const MatrixNM<Real, N, N> refInv = LinAlg::inverse(M);
+        const double refDet = LinAlg::determinant(M).data;
+        ok = ok && std::abs(det(k, 0, 0) - refDet) <= tol * std::abs(refDet);
+        for (size_t i = 0; i < N; ++i)
+        {
+            double bx = 0;
+            for (size_t j = 0; j < N; ++j)
+            {
+                ok = ok && std::abs(inv(k, i, j) - refInv(i, j).data) <= tol * (1 + std::abs(refInv(i, j).data));
+                bx += double(A(k, i, j)) * double(x(k, j, 0));
+            }
+            ok = ok && std::abs(bx - double(b(k, i, 0))) <= tol * 10;
+        }
+    }
+    return ok;
+}
+
+void testBatchedMatrix()
+{
+    std::cout << "=========Batched Matrix Test=========" << std::endl;
+    std::mt19937 gen(37);
+    bool ok = true;
+
+    // 包含不足一个数据包的尾部
+    ok = ok && checkBatched<double, 3>(37, gen, 1e-12) && checkBatched<double, 4>(37, gen, 1e-12);
+    ok = ok && checkBatched<float, 3>(53, gen, 1e-4) && checkBatched<float, 4>(53, gen, 1e-4);
+    // 超过单线程粒度，走 parallelFor 切分
+    ok = ok && checkBatched<double, 4>(40000, gen, 1e-12);
+
+    // 读写单个矩阵
+    BatchedMatrix<double, 3, 3> batch(5);
+    MatrixNM<Real, 3, 3> m{{{2.0, 0.0, 0.0}, {0.0, 4.0, 0.0}, {0.0, 0.0, 8.0}}};
+    batch.set(3, m);
+    MatrixNM<Real, 3, 3> back = LinAlg::inverse(batch).get(3);
+    ok = ok && back(0, 0) == Real(0.5) && back(1, 1) == Real(0.25) && back(2, 2) == Real(0.125) && back(0, 1) == Real(0.0);
+    ok = ok && !std::isfinite(LinAlg::inverse(batch)(0, 0, 0)) && LinAlg::determinant(batch)(0, 0, 0) == 0.0;
+    // 原地求逆
+    LinAlg::inverse(batch, batch);
+    ok = ok && batch(3, 2, 2) == 0.125 && batch(3, 0, 0) == 0.5;
+
+    // parallelFor 覆盖整个区间且块边界落在粒度的整数倍上
+    std::vector<int> hits(100003, 0);
+    bool aligned = true;
+    parallelFor(0, hits.size(), 1000, [&](size_t begin, size_t end)
+                {
+                    if (begin % 1000 != 0)
+                        aligned = false;
+                    for (size_t i = begin; i < end; ++i)
+                        ++hits[i]; });
+    ok = ok && aligned && std::count(hits.begin(), hits.end(), 1) == static_cast<long>(hits.size());
+
+    std::cout << "Batched matrix test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Batched Matrix Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+// ln|det(A)| 与行列式符号，由 LU 分解得到
+static double luLogAbsDeterminant(const MatrixXf &A, int &sign)
+{
+    const auto lu = LinAlg::luFactor(A);
+    double sum = 0;
+    sign = lu.swapCount % 2 == 0 ? 1 : -1;
+    for (size_t i = 0; i < lu.size(); ++i)
+    {
+        sum += std::log(std::abs(lu.LU(i, i).data));
+        if (lu.LU(i, i).data < 0)
+            sign = -sign;
+    }
+    return sum;
+}
+
+void testSymmetricFactorization()
+{
+    std::cout << "=========Symmetric Factorization Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(41);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    // 对称正定：A = M * M^T + n * I
+    const size_t n = 150, m = 9;
+    MatrixXf M(n, n), B(n, m);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+            M(i, j) = dis(gen);
+        for (size_t j = 0; j < m; ++j)
+            B(i, j) = dis(gen);
+    }
+    MatrixXf A = M * M.transpose();
+    for (size_t i = 0; i < n; ++i)
+        A(i, i) += Real(double(n));
+
+    // 只读取下三角：上三角填入无关的值
+    MatrixXf lowerOnly = A;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = i + 1; j < n; ++j)
+            lowerOnly(i, j) = 1e30;
+
+    auto residual = [&](const MatrixXf &X)
+    {
+        MatrixXf R = A * X;
+        double err = 0;
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < m; ++j)
+                err = std::max(err, std::abs((R(i, j) - B(i, j)).data));
+        return err;
+    };
+
+    const auto chol = LinAlg::cholesky(lowerOnly);
+    ok = ok && chol.isPositiveDefinite && chol.L(0, 1) == Real(0.0);
+    const double cholErr = residual(LinAlg::solve(chol, B));
+    ok = ok && cholErr < 1e-12;
+    int luSign = 0;
+    const double refLogDet = luLogAbsDeterminant(A, luSign);
+    ok = ok && std::abs(LinAlg::logDeterminant(chol).data - refLogDet) < 1e-9 * std::abs(refLogDet);
+
+    const auto ldltSpd = LinAlg::ldlt(lowerOnly);
+    ok = ok && !ldltSpd.isSingular && residual(LinAlg::solve(ldltSpd, B)) < 1e-12;
+
+    // 非正定矩阵
+    MatrixNM<Real, 3, 3> indefinite{{{1.0, 2.0, 0.0}, {2.0, 1.0, 0.0}, {0.0, 0.0, 1.0}}};
+    ok = ok && !LinAlg::cholesky(indefinite).isPositiveDefinite;
+
+    // 对称不定，对角线为 0 的块 [[0, C], [C^T, 0]] 迫使使用 2x2 主元
+    const size_t h = 60;
+    MatrixXf S(2 * h, 2 * h);
+    for (size_t i = 0; i < h; ++i)
+        for (size_t j = 0; j < h; ++j)
+        {
+            const double c = dis(gen) + (i == j ? 3.0 : 0.0);
+            S(i, h + j) = c;
+            S(h + j, i) = c;
+        }
+    VectorXf sb(2 * h);
+    for (size_t i = 0; i < 2 * h; ++i)
+        sb[i] = dis(gen);
+    const auto f = LinAlg::ldlt(S);
+    bool usedTwoByTwo = false;
+    for (size_t k = 0; k < 2 * h; ++k)
+        usedTwoByTwo = usedTwoByTwo || f.blocks[k] == 2;
+    VectorXf sx = LinAlg::solve(f, sb);
+    VectorXf sr(S * sx);
+    double ldltErr = 0;
+    for (size_t i = 0; i < 2 * h; ++i)
+        ldltErr = std::max(ldltErr, std::abs((sr[i] - sb[i]).data));
+    int sign = 0, refSign = 0;
+    const double logDet = LinAlg::logDeterminant(f, sign).data;
+    const double refLogDetS = luLogAbsDeterminant(S, refSign);
+    ok = ok && usedTwoByTwo && !f.isSingular && ldltErr < 1e-12;
+    ok = ok && sign == refSign && std::abs(logDet - refLogDetS) < 1e-9 * (1 + std::abs(refLogDetS));
+
+    // 定长小矩阵不分配堆内存
+    MatrixNM<Real, 4, 4> F{{{4.0, 1.0, 0.5, 0.0}, {1.0, 3.0, 0.0, 0.2}, {0.5, 0.0, 2.0, 0.1}, {0.0, 0.2, 0.1, 1.0}}};
+    VectorN<Real, 4> fb{1.0, 2.0, 3.0, 4.0};
+    const size_t before = heap_alloc_count;
+    VectorN<Real, 4> x1 = LinAlg::solve(LinAlg::cholesky(F), fb);
+    VectorN<Real, 4> x2 = LinAlg::solve(LinAlg::ldlt(F), fb);
+    ok = ok && heap_alloc_count == before;
+    for (size_t i = 0; i < 4; ++i)
+        ok = ok && std::abs((x1[i] - x2[i]).data) < 1e-14;
+
+    std::cout << "Max residual (Cholesky / LDLT): " << cholErr << " / " << ldltErr << std::endl;
+    std::cout << "Symmetric factorization test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Symmetric Factorization Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testQR()
+{
+    std::cout << "=========QR Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(43);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    // 检查 Q * R == A：把 R 补零到 m×n 后左乘 Q
+    auto reconstructionError = [](const MatrixXf &A)
+    {
+        const size_t m = A.rows(), n = A.cols();
+        const auto f = LinAlg::qr(A);
+        MatrixXf QR(m, n);
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < n; ++j)
+                QR(i, j) = j < i ? Real(0.0) : f.QR(i, j);
+        LinAlg::applyQ(f, QR);
+        double err = 0;
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < n; ++j)
+                err = std::max(err, std::abs((QR(i, j) - A(i, j)).data));
+        return err;
+    };
+
+    // 超过一个面板宽度，走分块路径
+    const size_t m = 300, n = 150, k = 6;
+    MatrixXf A(m, n), B(m, k);
+    VectorXf b(m);
+    for (size_t i = 0; i < m; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+            A(i, j) = dis(gen);
+        for (size_t j = 0; j < k; ++j)
+            B(i, j) = dis(gen);
+        b[i] = dis(gen);
+    }
+    const double recErr = reconstructionError(A);
+    MatrixXf wide(100, 200);
+    for (size_t i = 0; i < 100; ++i)
+        for (size_t j = 0; j < 200; ++j)
+            wide(i, j) = dis(gen);
+    ok = ok && recErr < 1e-12 && reconstructionError(wide) < 1e-12;
+
+    // Q^T * Q == I：分别用块反射（多列）与逐个反射（单列）作用
+    const auto f = LinAlg::qr(A);
+    MatrixXf Q(m, m);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < m; ++j)
+            Q(i, j) = i == j ? 1.0 : 0.0;
+    LinAlg::applyQ(f, Q);
+    MatrixXf QtQ = Q;
+    LinAlg::applyQTranspose(f, QtQ);
+    double orthErr = 0;
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < m; ++j)
+            orthErr = std::max(orthErr, std::abs(QtQ(i, j).data - (i == j ? 1.0 : 0.0)));
+    VectorXf q0(m);
+    for (size_t i = 0; i < m; ++i)
+        q0[i] = i == 0 ? 1.0 : 0.0;
+    LinAlg::applyQ(f, q0);
+    for (size_t i = 0; i < m; ++i)
+        ok = ok && std::abs((q0[i] - Q(i, 0)).data) < 1e-14;
+    ok = ok && orthErr < 1e-12;
+
+    // 最小二乘：残差与 A 的列空间正交（A^T * r == 0）
+    const VectorXf x = LinAlg::leastSquares(f, b);
+    VectorXf r(b - A * x);
+    double normalErr = 0;
+    for (size_t j = 0; j < n; ++j)
+    {
+        double s = 0;
+        for (size_t i = 0; i < m; ++i)
+            s += A(i, j).data * r[i].data;
+        normalErr = std::max(normalErr, std::abs(s));
+    }
+    ok = ok && x.rows() * x.cols() == n && normalErr < 1e-11;
+
+    // 多个右端项与逐列求解一致
+    const MatrixXf X = LinAlg::leastSquares(f, B);
+    ok = ok && X.rows() == n && X.cols() == k;
+    for (size_t j = 0; j < k; ++j)
+    {
+        VectorXf bj(m);
+        for (size_t i = 0; i < m; ++i)
+            bj[i] = B(i, j);
+        const VectorXf xj = LinAlg::leastSquares(f, bj);
+        for (size_t i = 0; i < n; ++i)
+            ok = ok && std::abs((xj[i] - X(i, j)).data) < 1e-12;
+    }
+
+    // 元素约为 1e±155、1e±200 时平方和会上溢/下溢：R 与奇异值应与未缩放时成比例
+    {
+        MatrixXf S0(40, 25);
+        for (size_t i = 0; i < 40; ++i)
+            for (size_t j = 0; j < 25; ++j)
+                S0(i, j) = dis(gen);
+        const auto f0 = LinAlg::qr(S0);
+        const auto sv0 = LinAlg::svd(S0).singularValues;
+        for (double s : {1e155, 1e-155, 1e200, 1e-200})
+        {
+            MatrixXf Ss(S0 * s);
+            const auto fs = LinAlg::qr(Ss);
+            const auto svs = LinAlg::svd(Ss).singularValues;
+            for (size_t i = 0; i < 25; ++i)
+            {
+                for (size_t j = i; j < 25; ++j)
+                    ok = ok && std::abs(fs.QR(i, j).data / s - f0.QR(i, j).data) < 1e-12;
+                ok = ok && std::abs(svs[i].data / s - sv0[i].data) < 1e-12 * sv0[0].data;
+            }
+        }
+    }
+
+    // 列秩亏
+    MatrixXf deficient(5, 3);
+    for (size_t i = 0; i < 5; ++i)
+    {
+        deficient(i, 0) = dis(gen);
+        deficient(i, 1) = deficient(i, 0) * Real(2.0);
+        deficient(i, 2) = dis(gen);
+    }
+    bool threw = false;
+    try
+    {
+        LinAlg::leastSquares(deficient, VectorXf(5));
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    ok = ok && threw;
+
+    // 定长小矩阵不分配堆内存：相容方程组的最小二乘解即精确解
+    MatrixNM<Real, 5, 3> F{{{1.0, 2.0, 0.5}, {0.0, 1.0, 3.0}, {2.0, -1.0, 1.0}, {1.0, 1.0, 1.0}, {4.0, 0.0, -2.0}}};
+    VectorN<Real, 3> expected{1.0, -2.0, 0.5};
+    VectorN<Real, 5> fb;
+    for (size_t i = 0; i < 5; ++i)
+        fb[i] = F(i, 0) * expected[0] + F(i, 1) * expected[1] + F(i, 2) * expected[2];
+    const size_t before = heap_alloc_count;
+    VectorN<Real, 3> fx = LinAlg::leastSquares(F, fb);
+    MatrixNM<Real, 3, 3> R = LinAlg::qrR(LinAlg::qr(F));
+    ok = ok && heap_alloc_count == before;
+    for (size_t i = 0; i < 3; ++i)
+        ok = ok && std::abs((fx[i] - expected[i]).data) < 1e-13;
+    ok = ok && R(1, 0) == Real(0.0) && R(2, 1) == Real(0.0);
+
+    std::cout << "Reconstruction / orthogonality / normal equation error: " << recErr << " / " << orthErr << " / " << normalErr << std::endl;
+    std::cout << "QR test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========QR Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testSymmetricEigen()
+{
+    std::cout << "=========Symmetric Eigen Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(47);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    // 检查 A * V == V * diag(w)、V^T * V == I 以及升序
+    auto check = [](const MatrixXf &A, const VectorXf &w, const MatrixXf &V, double &residual, double &orth)
+    {
+        const size_t n = A.rows();
+        MatrixXf AV = A * V;
+        MatrixXf VtV = V.transpose() * V;
+        residual = orth = 0;
+        bool sorted = true;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (i > 0)
+                sorted = sorted && w[i - 1] <= w[i];
+            for (size_t j = 0; j < n; ++j)
+            {
+                residual = std::max(residual, std::abs((AV(i, j) - V(i, j) * w[j]).data));
+                orth = std::max(orth, std::abs(VtV(i, j).data - (i == j ? 1.0 : 0.0)));
+            }
+        }
+        return sorted;
+    };
+
+    // 超过多个三对角化块宽
+    const size_t n = 200;
+    MatrixXf A(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j <= i; ++j)
+        {
+            const double v = dis(gen);
+            A(i, j) = v;
+            A(j, i) = v;
+        }
+    MatrixXf lowerOnly = A;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = i + 1; j < n; ++j)
+            lowerOnly(i, j) = 1e30;
+    const auto eig = LinAlg::symmetricEigen(lowerOnly);
+    double residual = 0, orth = 0;
+    ok = ok && check(A, eig.eigenvalues, eig.eigenvectors, residual, orth);
+    ok = ok && residual < 1e-12 && orth < 1e-12;
+    double trace = 0, sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        trace += A(i, i).data;
+        sum += eig.eigenvalues[i].data;
+    }
+    ok = ok && std::abs(trace - sum) < 1e-11;
+
+    // 只求特征值
+    const VectorXf values = LinAlg::symmetricEigenvalues(A);
+    for (size_t i = 0; i < n; ++i)
+        ok = ok && std::abs((values[i] - eig.eigenvalues[i]).data) < 1e-12;
+
+    // 重特征值：A = Q * diag(1, 1, 1, 2, 2, 3, ...) * Q^T，Q 取自 QR 分解
+    const size_t m = 40;
+    MatrixXf G(m, m), D(m, m);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < m; ++j)
+        {
+            G(i, j) = i == j ? 1.0 : 0.0;
+            D(i, j) = dis(gen);
+        }
+    LinAlg::applyQ(LinAlg::qr(D), G);
+    MatrixXf Lambda(m, m);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < m; ++j)
+            Lambda(i, j) = i == j ? double(i / 3 + 1) : 0.0;
+    MatrixXf GL = G * Lambda;
+    MatrixXf R = GL * G.transpose();
+    const auto rep = LinAlg::symmetricEigen(R);
+    double repResidual = 0, repOrth = 0;
+    ok = ok && check(R, rep.eigenvalues, rep.eigenvectors, repResidual, repOrth) && repResidual < 1e-12 && repOrth < 1e-12;
+    for (size_t i = 0; i < m; ++i)
+        ok = ok && std::abs(rep.eigenvalues[i].data - double(i / 3 + 1)) < 1e-12;
+
+    // 3x3 惯性张量：Jacobi，不分配堆内存
+    MatrixNM<Real, 3, 3> inertia{{{2.0, -0.5, 0.25}, {-0.5, 3.0, 0.0}, {0.25, 0.0, 1.0}}};
+    const size_t before = heap_alloc_count;
+    const auto small = LinAlg::symmetricEigen(inertia);
+    const VectorN<Real, 3> smallValues = LinAlg::symmetricEigenvalues(inertia);
+    ok = ok && heap_alloc_count == before;
+    MatrixXf inertiaX(3, 3), smallV(3, 3);
+    VectorXf smallW(3);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        smallW[i] = small.eigenvalues[i];
+        ok = ok && std::abs((smallValues[i] - small.eigenvalues[i]).data) < 1e-14;
+        for (size_t j = 0; j < 3; ++j)
+        {
+            inertiaX(i, j) = inertia(i, j);
+            smallV(i, j) = small.eigenvectors(i, j);
+        }
+    }
+    double smallResidual = 0, smallOrth = 0;
+    ok = ok && check(inertiaX, smallW, smallV, smallResidual, smallOrth) && smallResidual < 1e-14 && smallOrth < 1e-14;
+
+    std::cout << "Max residual / orthogonality error (n = 200): " << residual << " / " << orth << std::endl;
+    std::cout << "Symmetric eigen test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Symmetric Eigen Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testSVD()
+{
+    std::cout << "=========SVD Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(53);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    auto randomMatrix = [&](size_t m, size_t n)
+    {
+        MatrixXf A(m, n);
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < n; ++j)
+                A(i, j) = dis(gen);
+        return A;
+    };
+    auto maxDiff = [](const MatrixXf &X, const MatrixXf &Y)
+    {
+        double err = 0;
+        for (size_t i = 0; i < X.rows(); ++i)
+            for (size_t j = 0; j < X.cols(); ++j)
+                err = std::max(err, std::abs((X(i, j) - Y(i, j)).data));
+        return err;
+    };
+    auto identity = [](size_t n)
+    {
+        MatrixXf I(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                I(i, j) = i == j ? 1.0 : 0.0;
+        return I;
+    };
+    // 检查 U * S * V^T == A、U、V 列正交以及奇异值降序
+    auto checkSvd = [&](const MatrixXf &A, double &recErr)
+    {
+        const auto f = LinAlg::svd(A);
+        const size_t k = f.size();
+        MatrixXf US = f.U;
+        for (size_t i = 0; i < US.rows(); ++i)
+            for (size_t j = 0; j < k; ++j)
+                US(i, j) = US(i, j) * f.singularValues[j];
+        recErr = maxDiff(MatrixXf(US * f.V.transpose()), A);
+        bool good = maxDiff(MatrixXf(f.U.transpose() * f.U), identity(k)) < 1e-12 &&
+                    maxDiff(MatrixXf(f.V.transpose() * f.V), identity(k)) < 1e-12;
+        const VectorXf s = LinAlg::singularValues(A);
+        for (size_t i = 0; i < k; ++i)
+        {
+            good = good && f.singularValues[i] >= Real(0.0) && std::abs((s[i] - f.singularValues[i]).data) < 1e-12;
+            if (i > 0)
+                good = good && f.singularValues[i - 1] >= f.singularValues[i];
+        }
+        return good && recErr < 1e-12;
+    };
+
+    double tallErr = 0, wideErr = 0, squareErr = 0;
+    ok = ok && checkSvd(randomMatrix(120, 80), tallErr);
+    ok = ok && checkSvd(randomMatrix(60, 90), wideErr);
+    ok = ok && checkSvd(randomMatrix(70, 70), squareErr);
+
+    // 已知奇异值：A = Q1 * diag(sigma) * Q2^T
+    const size_t n = 50;
+    MatrixXf Q1 = identity(n), Q2 = identity(n);
+    LinAlg::applyQ(LinAlg::qr(randomMatrix(n, n)), Q1);
+    LinAlg::applyQ(LinAlg::qr(randomMatrix(n, n)), Q2);
+    MatrixXf Sigma(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            Sigma(i, j) = i == j ? std::pow(0.8, double(i)) : 0.0;
+    MatrixXf Q1S = Q1 * Sigma;
+    MatrixXf A = Q1S * Q2.transpose();
+    const VectorXf sigma = LinAlg::singularValues(A);
+    for (size_t i = 0; i < n; ++i)
+        ok = ok && std::abs(sigma[i].data - std::pow(0.8, double(i))) < 1e-13;
+    ok = ok && std::abs(LinAlg::cond(A).data - std::pow(0.8, -double(n - 1))) < 1e-6 * std::pow(0.8, -double(n - 1));
+
+    // 秩亏：30×5 与 5×20 的乘积
+    MatrixXf lowRank = randomMatrix(30, 5) * randomMatrix(5, 20);
+    ok = ok && LinAlg::rank(lowRank) == 5 && LinAlg::rank(randomMatrix(30, 20)) == 20;
+
+    // 伪逆：满列秩时与最小二乘一致；秩亏时满足 A * A^+ * A == A
+    MatrixXf tall = randomMatrix(40, 12);
+    VectorXf b(40);
+    for (size_t i = 0; i < 40; ++i)
+        b[i] = dis(gen);
+    const VectorXf xPinv(LinAlg::pinv(tall) * b);
+    const VectorXf xLs = LinAlg::leastSquares(tall, b);
+    for (size_t i = 0; i < 12; ++i)
+        ok = ok && std::abs((xPinv[i] - xLs[i]).data) < 1e-12;
+    const MatrixXf P = LinAlg::pinv(lowRank);
+    MatrixXf AP = lowRank * P;
+    const double penroseErr = maxDiff(MatrixXf(AP * lowRank), lowRank);
+    ok = ok && P.rows() == 20 && P.cols() == 30 && penroseErr < 1e-12;
+
+    // 随机化 SVD：奇异值按 0.5^i 衰减，前 10 个三元组与完整 SVD 一致
+    const size_t rm = 400, rn = 300, k = 10;
+    MatrixXf U0 = identity(rm), V0 = identity(rn);
+    LinAlg::applyQ(LinAlg::qr(randomMatrix(rm, rm)), U0);
+    LinAlg::applyQ(LinAlg::qr(randomMatrix(rn, rn)), V0);
+    MatrixXf US(rm, rn);
+    for (size_t i = 0; i < rm; ++i)
+        for (size_t j = 0; j < rn; ++j)
+            US(i, j) = U0(i, j) * std::pow(0.5, double(j));
+    MatrixXf big = US * V0.transpose();
+    const auto rsvd = LinAlg::randomizedSVD(big, k);
+    ok = ok && rsvd.U.rows() == rm && rsvd.U.cols() == k && rsvd.V.rows() == rn && rsvd.V.cols() == k;
+    double rsvdErr = 0;
+    for (size_t j = 0; j < k; ++j)
+    {
+        rsvdErr = std::max(rsvdErr, std::abs(rsvd.singularValues[j].data - std::pow(0.5, double(j))) / std::pow(0.5, double(j)));
+        // 奇异向量只确定到符号
+        double dotU = 0, dotV = 0;
+        for (size_t i = 0; i < rm; ++i)
+            dotU += rsvd.U(i, j).data * U0(i, j).data;
+        for (size_t i = 0; i < rn; ++i)
+            dotV += rsvd.V(i, j).data * V0(i, j).data;
+        ok = ok && std::abs(std::abs(dotU) - 1) < 1e-8 && std::abs(std::abs(dotV) - 1) < 1e-8;
+    }
+    ok = ok && rsvdErr < 1e-10;
+
+    // 定长矩阵
+    MatrixNM<Real, 3, 2> F{{{3.0, 0.0}, {0.0, 4.0}, {0.0, 0.0}}};
+    const auto fs = LinAlg::svd(F);
+    const MatrixNM<Real, 2, 3> Fp = LinAlg::pinv(F);
+    ok = ok && std::abs(fs.singularValues[0].data - 4.0) < 1e-15 && std::abs(fs.singularValues[1].data - 3.0) < 1e-15;
+    ok = ok && std::abs(Fp(0, 0).data - 1.0 / 3.0) < 1e-15 && std::abs(Fp(1, 1).data - 0.25) < 1e-15 && Fp(0, 2) == Real(0.0);
+
+    std::cout << "Reconstruction error (tall / wide / square): " << tallErr << " / " << wideErr << " / " << squareErr << std::endl;
+    std::cout << "Randomized SVD relative singular value error: " << rsvdErr << std::endl;
+    std::cout << "SVD test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========SVD Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testGeneralEigenvalues()
+{
+    std::cout << "=========General Eigenvalues Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(59);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    // 伴随矩阵：p(x) = (x - 1)(x - 2)(x - 3)(x^2 - 2x + 5)，根为 1、2、3、1 ± 2i
+    const double coeffs[5] = {-8.0, 28.0, -58.0, 67.0, -30.0}; // x^5 - 8x^4 + 28x^3 - 58x^2 + 67x - 30 的系数（去掉首项）
+    MatrixXf companion(5, 5);
+    for (size_t i = 0; i < 5; ++i)
+        for (size_t j = 0; j < 5; ++j)
+            companion(i, j) = i == 0 ? -coeffs[j] : (i == j + 1 ? 1.0 : 0.0);
+    const VectorXc roots = LinAlg::eigenvalues(companion);
+    const double expected[5][2] = {{1.0, -2.0}, {1.0, 0.0}, {1.0, 2.0}, {2.0, 0.0}, {3.0, 0.0}};
+    for (size_t i = 0; i < 5; ++i)
+    {
+        // 实部相同的根之间的顺序取决于舍入，逐个查找
+        bool found = false;
+        for (size_t j = 0; j < 5; ++j)
+            found = found || (std::abs(roots[j].real - expected[i][0]) < 1e-10 && std::abs(roots[j].imag - expected[i][1]) < 1e-10);
+        ok = ok && found;
+    }
+
+    // 旋转矩阵的特征值为 ±i
+    MatrixNM<Real, 2, 2> rotation{{{0.0, -1.0}, {1.0, 0.0}}};
+    const auto rot = LinAlg::eigenvalues(rotation);
+    ok = ok && std::abs(rot[0].real) < 1e-15 && std::abs(rot[0].imag + 1.0) < 1e-15 && std::abs(rot[1].imag - 1.0) < 1e-15;
+
+    // 随机矩阵：特征值之和等于迹，ln|特征值之积| 等于 ln|det|，复特征值成对共轭
+    const size_t n = 150;
+    MatrixXf A(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            A(i, j) = dis(gen);
+    const VectorXc lambda = LinAlg::eigenvalues(A);
+    double trace = 0, sumRe = 0, sumIm = 0, logAbs = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        trace += A(i, i).data;
+        sumRe += lambda[i].real;
+        sumIm += lambda[i].imag;
+        logAbs += 0.5 * std::log(lambda[i].real * lambda[i].real + lambda[i].imag * lambda[i].imag);
+        if (lambda[i].imag != 0.0)
+        {
+            bool hasConjugate = false;
+            for (size_t j = 0; j < n; ++j)
+                hasConjugate = hasConjugate || (lambda[j].real == lambda[i].real && lambda[j].imag == -lambda[i].imag);
+            ok = ok && hasConjugate;
+        }
+    }
+    int sign = 0;
+    const double refLogDet = luLogAbsDeterminant(A, sign);
+    const double traceErr = std::abs(trace - sumRe);
+    ok = ok && traceErr < 1e-11 && std::abs(sumIm) < 1e-11 && std::abs(logAbs - refLogDet) < 1e-9 * std::abs(refLogDet);
+
+    // 对称矩阵：与对称特征值一致
+    MatrixXf S = A + A.transpose();
+    const VectorXc ls = LinAlg::eigenvalues(S);
+    const VectorXf lsRef = LinAlg::symmetricEigenvalues(S);
+    for (size_t i = 0; i < n; ++i)
+        ok = ok && std::abs(ls[i].real - lsRef[i].data) < 1e-11 && ls[i].imag == 0.0;
+
+    // 行列尺度相差悬殊：D * M * D^-1 与 M 的特征值相同，依赖平衡保持精度
+    const size_t m = 30;
+    MatrixXf M(m, m), DMD(m, m);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < m; ++j)
+        {
+            M(i, j) = dis(gen);
+            DMD(i, j) = M(i, j) * std::pow(10.0, (double(i) - double(j)) * 0.4);
+        }
+    const VectorXc lm = LinAlg::eigenvalues(M), ld = LinAlg::eigenvalues(DMD);
+    double scaledErr = 0;
+    for (size_t i = 0; i < m; ++i)
+        scaledErr = std::max(scaledErr, std::abs(lm[i].real - ld[i].real) + std::abs(lm[i].imag - ld[i].imag));
+    ok = ok && scaledErr < 1e-9;
+
+    std::cout << "Trace error / scaled matrix error: " << traceErr << " / " << scaledErr << std::endl;
+    std::cout << "General eigenvalues test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========General Eigenvalues Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+
+void testSparseMatrix()
+{
+    std::cout << "=========Sparse Matrix Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(61);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    // 随机三元组（含重复位置，第 0 行很长）组装后与稠密矩阵比较
+    const size_t m = 40, n = 25;
+    MatrixXf dense(m, n);
+    std::vector<Triplet<Real>> triplets;
+    for (size_t t = 0; t < 300; ++t)
+    {
+        const size_t i = t < 80 ? 0 : gen() % m, j = gen() % n;
+        const double v = dis(gen);
+        triplets.push_back(Triplet<Real>(i, j, v));
+        dense(i, j) = dense(i, j) + v;
+    }
+    const SparseMatrixXf A(m, n, triplets);
+    const CSCMatrix<Real> Ac(A);
+    ok = ok && A.nonZeros() <= 300 && Ac.nonZeros() == A.nonZeros();
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < n; ++j)
+            ok = ok && A.coeff(i, j) == dense(i, j) && Ac.coeff(i, j) == dense(i, j);
+    for (size_t k = 0; k < m; ++k)
+        for (size_t p = A.outerIndexPtr()[k] + 1; p < A.outerIndexPtr()[k + 1]; ++p)
+            ok = ok && A.innerIndexPtr()[p - 1] < A.innerIndexPtr()[p];
+    const MatrixXf back = A.toDense();
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < n; ++j)
+            ok = ok && back(i, j) == dense(i, j);
+
+    // A * x 与 Aᵀ * y，CSR 与 CSC 两种存储
+    VectorXf x(n), y(m);
+    for (size_t j = 0; j < n; ++j)
+        x[j] = dis(gen);
+    for (size_t i = 0; i < m; ++i)
+        y[i] = dis(gen);
+    const VectorXf Ax = A * x, Acx = Ac * x, Aty = A.transposeMultiply(y), Acty = Ac.transposeMultiply(y);
+    const VectorXf Atx = A.transpose() * y;
+    double err = 0;
+    for (size_t i = 0; i < m; ++i)
+    {
+        double ref = 0;
+        for (size_t j = 0; j < n; ++j)
+            ref += dense(i, j).data * x[j].data;
+        err = std::max(err, std::abs(Ax[i].data - ref) + std::abs(Acx[i].data - ref));
+    }
+    for (size_t j = 0; j < n; ++j)
+    {
+        double ref = 0;
+        for (size_t i = 0; i < m; ++i)
+            ref += dense(i, j).data * y[i].data;
+        err = std::max(err, std::abs(Aty[j].data - ref) + std::abs(Acty[j].data - ref) + std::abs(Atx[j].data - ref));
+    }
+    ok = ok && err < 1e-13;
+
+    // 二维 5 点 Laplace：多段切分的聚集与散射（含缓冲区归约）与单段结果一致，且 Aᵀ = A
+    const size_t g = 200, N = g * g;
+    std::vector<Triplet<Real>> lap;
+    for (size_t i = 0; i < g; ++i)
+        for (size_t j = 0; j < g; ++j)
+        {
+            const size_t r = i * g + j;
+            lap.push_back(Triplet<Real>(r, r, 4.0));
+            if (i > 0)
+                lap.push_back(Triplet<Real>(r, r - g, -1.0));
+            if (i + 1 < g)
+                lap.push_back(Triplet<Real>(r, r + g, -1.0));
+            if (j > 0)
+                lap.push_back(Triplet<Real>(r, r - 1, -1.0));
+            if (j + 1 < g)
+                lap.push_back(Triplet<Real>(r, r + 1, -1.0));
+        }
+    const SparseMatrixXf L(N, N, lap);
+    VectorXf u(N), Lu(N), Ltu(N);
+    for (size_t i = 0; i < N; ++i)
+        u[i] = dis(gen);
+    L.multiply(u, Lu);
+    L.transposeMultiply(u, Ltu);
+    const std::vector<size_t> bounds = internal::sparsePartition(N, L.outerIndexPtr(), 4);
+    std::vector<double> gather(N), scatter(N);
+    const double *vals = reinterpret_cast<const double *>(L.valuePtr());
+    const double *ud = reinterpret_cast<const double *>(u.data());
+    internal::sparseGatherParallel(bounds, L.outerIndexPtr(), L.innerIndexPtr(), vals, ud, gather.data());
+    const auto index = internal::sparseTransposeIndex(N, N, L.outerIndexPtr(), L.innerIndexPtr(), 4);
+    internal::sparseGatherTransposedParallel(*index, vals, ud, scatter.data());
+    double lapErr = 0;
+    for (size_t i = 0; i < N; ++i)
+        lapErr = std::max(lapErr, std::abs(Lu[i].data - gather[i]) + std::abs(Ltu[i].data - scatter[i]) + std::abs(Lu[i].data - Ltu[i].data));
+    ok = ok && bounds.size() == 5 && index->partition.size() == 5 && L.nonZeros() == 5 * N - 4 * g && lapErr < 1e-13;
+
+    // 散射方向（CSR 的 Aᵀ * x、CSC 的 A * x）多线程：只在第一次调用时建立转置索引，之后与聚集方向一样
+    // 只有 parallelFor 自身的少量分配，不再有按线程数放大的缓冲区；结果与线程数无关，并与单线程散射逐位相同
+    std::vector<Triplet<Real>> skew(lap);
+    for (Triplet<Real> &t : skew)
+        if (t.col == t.row + 1)
+            t.value = Real(-1.5);
+    setParallelThreads(4);
+    const SparseMatrixXf Ls(N, N, skew);
+    const SparseMatrix<Real, false> Lc(Ls);
+    VectorXf t4(N), c4(N);
+    Ls.transposeMultiply(u, t4);
+    Lc.multiply(u, c4);
+    size_t before = heap_alloc_count;
+    Ls.multiply(u, c4);
+    const size_t gatherAllocations = heap_alloc_count - before;
+    before = heap_alloc_count;
+    for (int rep = 0; rep < 3; ++rep)
+    {
+        Ls.transposeMultiply(u, t4);
+        Lc.multiply(u, c4);
+    }
+    ok = ok && heap_alloc_count - before <= 6 * gatherAllocations;
+    setParallelThreads(1);
+    const SparseMatrixXf Ls1(N, N, skew);
+    const SparseMatrix<Real, false> Lc1(Ls1);
+    VectorXf t1(N), c1(N);
+    Ls1.transposeMultiply(u, t1);
+    Lc1.multiply(u, c1);
+    setParallelThreads(0);
+    for (size_t i = 0; i < N; ++i)
+        ok = ok && t4[i] == t1[i] && c4[i] == c1[i];
+
+    // 越界三元组与维度不匹配
+    bool threw = false;
+    try
+    {
+        SparseMatrixXf bad(3, 3, std::vector<Triplet<Real>>{Triplet<Real>(3, 0, 1.0)});
+    }
+    catch (const std::out_of_range &)
+    {
+        threw = true;
+    }
+    ok = ok && threw;
+    threw = false;
+    try
+    {
+        A * y;
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    ok = ok && threw;
+
+    std::cout << "Dense / Laplacian product error: " << err << " / " << lapErr << std::endl;
+    std::cout << "Sparse matrix test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Sparse Matrix Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+
+// 二维 g×g 网格上的 5 点差分矩阵：-Δu + c * ∂u/∂x，c = 0 时对称正定
+static SparseMatrixXf gridOperator(size_t g, double c)
+{
+    std::vector<Triplet<Real>> triplets;
+    for (size_t i = 0; i < g; ++i)
+        for (size_t j = 0; j < g; ++j)
+        {
+            const size_t r = i * g + j;
+            triplets.push_back(Triplet<Real>(r, r, 4.0));
+            if (i > 0)
+                triplets.push_back(Triplet<Real>(r, r - g, -1.0));
+            if (i + 1 < g)
+                triplets.push_back(Triplet<Real>(r, r + g, -1.0));
+            if (j > 0)
+                triplets.push_back(Triplet<Real>(r, r - 1, -1.0 - c));
+            if (j + 1 < g)
+                triplets.push_back(Triplet<Real>(r, r + 1, -1.0 + c));
+        }
+    return SparseMatrixXf(g * g, g * g, triplets);
+}
+
+void testKrylovSolvers()
+{
+    std::cout << "=========Krylov Solvers Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(67);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    const size_t g = 40, n = g * g;
+    const SparseMatrixXf L = gridOperator(g, 0.0), C = gridOperator(g, 0.4);
+    VectorXf b(n);
+    for (size_t i = 0; i < n; ++i)
+        b[i] = dis(gen);
+    auto trueResidual = [&](const SparseMatrixXf &A, const VectorXf &x)
+    {
+        const VectorXf Ax = A * x;
+        double r = 0, nb = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            r += (b[i].data - Ax[i].data) * (b[i].data - Ax[i].data);
+            nb += b[i].data * b[i].data;
+        }
+        return std::sqrt(r / nb);
+    };
+
+    // 对称正定：CG，预条件依次减少迭代步数
+    VectorXf x(n);
+    const LinAlg::IterativeResult cgPlain = LinAlg::conjugateGradient(L, b, x);
+    ok = ok && cgPlain.converged && trueResidual(L, x) < 1e-9;
+    x = VectorXf(n);
+    const LinAlg::IterativeResult cgJacobi = LinAlg::conjugateGradient(L, b, x, LinAlg::JacobiPreconditioner<Real>(L));
+    ok = ok && cgJacobi.converged && trueResidual(L, x) < 1e-9;
+    x = VectorXf(n);
+    const LinAlg::IC0Preconditioner<Real> ic(L);
+    const LinAlg::IterativeResult cgIC = LinAlg::conjugateGradient(L, b, x, ic);
+    ok = ok && cgIC.converged && trueResidual(L, x) < 1e-9 && cgIC.iterations < cgPlain.iterations / 2;
+
+    // 非对称：BiCGSTAB 与 GMRES，ILU(0) 预条件
+    const LinAlg::ILU0Preconditioner<Real> ilu(C);
+    x = VectorXf(n);
+    const LinAlg::IterativeResult bicg = LinAlg::bicgstab(C, b, x, ilu);
+    ok = ok && bicg.converged && trueResidual(C, x) < 1e-9;
+    x = VectorXf(n);
+    const LinAlg::IterativeResult gm = LinAlg::gmres(C, b, x, ilu, 1000, 1e-10, 20);
+    ok = ok && gm.converged && trueResidual(C, x) < 1e-9;
+    x = VectorXf(n);
+    const LinAlg::IterativeResult gmPlain = LinAlg::gmres(C, b, x, LinAlg::IdentityPreconditioner(), 2000, 1e-10, 20);
+    ok = ok && gmPlain.converged && trueResidual(C, x) < 1e-9 && gm.iterations < gmPlain.iterations;
+
+    // 工作区预热后，整个求解过程不分配内存
+    LinAlg::KrylovWorkspace<Real> workspace;
+    x = VectorXf(n);
+    LinAlg::gmres(C, b, x, ilu, workspace, 1000, 1e-10, 20);
+    x = VectorXf(n);
+    LinAlg::bicgstab(C, b, x, ilu, workspace);
+    x = VectorXf(n);
+    size_t before = heap_alloc_count;
+    LinAlg::gmres(C, b, x, ilu, workspace, 1000, 1e-10, 20);
+    std::fill(x.data(), x.data() + n, Real(0.0));
+    LinAlg::bicgstab(C, b, x, ilu, workspace);
+    std::fill(x.data(), x.data() + n, Real(0.0));
+    LinAlg::conjugateGradient(L, b, x, ic, workspace);
+    ok = ok && heap_alloc_count == before;
+
+    // 无矩阵算子：一维 Laplace 模板，结果与组装好的稀疏矩阵一致
+    const size_t m = 200;
+    auto stencil = LinAlg::makeLinearOperator(m, [m](const VectorXf &u, VectorXf &v)
+                                              {
+                                                  for (size_t i = 0; i < m; ++i)
+                                                      v[i] = 2.0 * u[i].data - (i > 0 ? u[i - 1].data : 0.0) - (i + 1 < m ? u[i + 1].data : 0.0); });
+    VectorXf f(m), u(m);
+    for (size_t i = 0; i < m; ++i)
+        f[i] = dis(gen);
+    const LinAlg::IterativeResult cgFree = LinAlg::conjugateGradient(stencil, f, u, LinAlg::IdentityPreconditioner(), 1000, 1e-12);
+    VectorXf Au(m);
+    stencil.multiply(u, Au);
+    double freeErr = 0;
+    for (size_t i = 0; i < m; ++i)
+        freeErr = std::max(freeErr, std::abs(Au[i].data - f[i].data));
+    ok = ok && cgFree.converged && cgFree.iterations <= m && freeErr < 1e-8;
+
+    // 稠密矩阵：与 LU 求解一致
+    const size_t d = 60;
+    MatrixXf D(d, d);
+    for (size_t i = 0; i < d; ++i)
+        for (size_t j = 0; j < d; ++j)
+            D(i, j) = dis(gen) + (i == j ? 2.0 * d : 0.0);
+    VectorXf rhs(d), xd(d);
+    for (size_t i = 0; i < d; ++i)
+        rhs[i] = dis(gen);
+    const LinAlg::IterativeResult dense = LinAlg::bicgstab(D, rhs, xd, LinAlg::JacobiPreconditioner<Real>(D));
+    const VectorXf ref = LinAlg::solve(LinAlg::luFactor(D), rhs);
+    double denseErr = 0;
+    for (size_t i = 0; i < d; ++i)
+        denseErr = std::max(denseErr, std::abs(xd[i].data - ref[i].data));
+    ok = ok && dense.converged && denseErr < 1e-9;
+
+    // 对称不定矩阵没有 IC(0)
+    bool threw = false;
+    try
+    {
+        SparseMatrixXf indefinite(2, 2, std::vector<Triplet<Real>>{Triplet<Real>(0, 0, 1.0), Triplet<Real>(1, 0, 2.0), Triplet<Real>(0, 1, 2.0), Triplet<Real>(1, 1, 1.0)});
+        LinAlg::IC0Preconditioner<Real> fail(indefinite);
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    ok = ok && threw;
+
+    std::cout << "Iterations CG / CG+Jacobi / CG+IC(0) / BiCGSTAB+ILU(0) / GMRES(20)+ILU(0) / GMRES(20): " << cgPlain.iterations << " / "
+              << cgJacobi.iterations << " / " << cgIC.iterations << " / " << bicg.iterations << " / " << gm.iterations << " / "
+              << gmPlain.iterations << std::endl;
+    std::cout << "Krylov solvers test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Krylov Solvers Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+
+void testRelaxation()
+{
+    std::cout << "=========Relaxation Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(71);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    const size_t g = 30, n = g * g;
+    const SparseMatrixXf L = gridOperator(g, 0.0), C = gridOperator(g, 0.3);
+    VectorXf b(n);
+    for (size_t i = 0; i < n; ++i)
+        b[i] = dis(gen);
+    auto trueResidual = [&](const SparseMatrixXf &A, const VectorXf &x)
+    {
+        const VectorXf Ax = A * x;
+        double r = 0, nb = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            r += (b[i].data - Ax[i].data) * (b[i].data - Ax[i].data);
+            nb += b[i].data * b[i].data;
+        }
+        return std::sqrt(r / nb);
+    };
+
+    // Gauss-Seidel 与最优松弛因子的 SOR：ω_opt = 2 / (1 + sin(πh))
+    const double omega = 2.0 / (1.0 + std::sin(3.14159265358979323846 / double(g + 1)));
+    VectorXf x(n);
+    const LinAlg::IterativeResult gs = LinAlg::sor(L, b, x, 1.0, 10000, 1e-8);
+    ok = ok && gs.converged && trueResidual(L, x) < 1e-7;
+    x = VectorXf(n);
+    const LinAlg::IterativeResult sorOpt = LinAlg::sor(L, b, x, omega, 10000, 1e-8);
+    ok = ok && sorOpt.converged && trueResidual(L, x) < 1e-7 && sorOpt.iterations * 5 < gs.iterations;
+    x = VectorXf(n);
+    const LinAlg::IterativeResult ss = LinAlg::ssor(C, b, x, 1.5, 10000, 1e-8);
+    ok = ok && ss.converged && trueResidual(C, x) < 1e-7;
+
+    // 红黑划分：2 种颜色，同色行互不耦合，迭代步数与自然顺序相当
+    const LinAlg::MatrixColoring coloring = LinAlg::colorRows(C);
+    ok = ok && coloring.colors() == 2 && coloring.colorStart[1] == n / 2;
+    std::vector<size_t> colorOf(n);
+    for (size_t c = 0; c < coloring.colors(); ++c)
+        for (size_t s = coloring.colorStart[c]; s < coloring.colorStart[c + 1]; ++s)
+            colorOf[coloring.rows[s]] = c;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t p = C.outerIndexPtr()[i]; p < C.outerIndexPtr()[i + 1]; ++p)
+            ok = ok && (C.innerIndexPtr()[p] == i || colorOf[C.innerIndexPtr()[p]] != colorOf[i]);
+    x = VectorXf(n);
+    const LinAlg::IterativeResult mc = LinAlg::multicolorGaussSeidel(C, coloring, b, x, 1.0, 10000, 1e-8);
+    ok = ok && mc.converged && trueResidual(C, x) < 1e-7;
+    x = VectorXf(n);
+    const LinAlg::IterativeResult mcSym = LinAlg::multicolorGaussSeidel(C, coloring, b, x, 1.0, 10000, 1e-8, true);
+    ok = ok && mcSym.converged && trueResidual(C, x) < 1e-7;
+    // 红黑顺序是相容次序，最优松弛因子与自然顺序相同
+    x = VectorXf(n);
+    const LinAlg::IterativeResult mcSor = LinAlg::multicolorGaussSeidel(L, b, x, omega, 10000, 1e-8);
+    ok = ok && mcSor.converged && trueResidual(L, x) < 1e-7 && mcSor.iterations < 2 * sorOpt.iterations;
+
+    // 一般结构：非对称的结构也要保证同色行互不耦合
+    std::vector<Triplet<Real>> triplets;
+    const size_t m = 300;
+    for (size_t i = 0; i < m; ++i)
+    {
+        triplets.push_back(Triplet<Real>(i, i, 10.0));
+        for (int k = 0; k < 3; ++k)
+            triplets.push_back(Triplet<Real>(i, gen() % m, dis(gen)));
+    }
+    const SparseMatrixXf R(m, m, triplets);
+    const LinAlg::MatrixColoring rc = LinAlg::colorRows(R);
+    std::vector<size_t> rcOf(m);
+    for (size_t c = 0; c < rc.colors(); ++c)
+        for (size_t s = rc.colorStart[c]; s < rc.colorStart[c + 1]; ++s)
+            rcOf[rc.rows[s]] = c;
+    for (size_t i = 0; i < m; ++i)
+        for (size_t p = R.outerIndexPtr()[i]; p < R.outerIndexPtr()[i + 1]; ++p)
+            ok = ok && (R.innerIndexPtr()[p] == i || rcOf[R.innerIndexPtr()[p]] != rcOf[i]);
+    VectorXf rb(m), rx(m);
+    for (size_t i = 0; i < m; ++i)
+        rb[i] = dis(gen);
+    const LinAlg::IterativeResult rr = LinAlg::multicolorGaussSeidel(R, rb, rx);
+    const VectorXf Rx = R * rx;
+    double rErr = 0;
+    for (size_t i = 0; i < m; ++i)
+        rErr = std::max(rErr, std::abs(Rx[i].data - rb[i].data));
+    ok = ok && rr.converged && rErr < 1e-8;
+
+    // 稠密矩阵：与 LU 求解一致
+    const size_t d = 50;
+    MatrixXf D(d, d);
+    for (size_t i = 0; i < d; ++i)
+        for (size_t j = 0; j < d; ++j)
+            D(i, j) = dis(gen) + (i == j ? 2.0 * d : 0.0);
+    VectorXf rhs(d), xd(d);
+    for (size_t i = 0; i < d; ++i)
+        rhs[i] = dis(gen);
+    const LinAlg::IterativeResult dense = LinAlg::sor(D, rhs, xd, 1.0, 1000, 1e-13);
+    const VectorXf ref = LinAlg::solve(LinAlg::luFactor(D), rhs);
+    double denseErr = 0;
+    for (size_t i = 0; i < d; ++i)
+        denseErr = std::max(denseErr, std::abs(xd[i].data - ref[i].data));
+    ok = ok && dense.converged && denseErr < 1e-12;
+
+    bool threw = false;
+    try
+    {
+        LinAlg::sor(L, b, x, 2.0);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    ok = ok && threw;
+
+    std::cout << "Sweeps GS / SOR(opt) / SSOR / red-black GS / red-black SGS / red-black SOR(opt): " << gs.iterations << " / " << sorOpt.iterations
+              << " / " << ss.iterations << " / " << mc.iterations << " / " << mcSym.iterations << " / " << mcSor.iterations << std::endl;
+    std::cout << "Relaxation test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Relaxation Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+
+void testThreadPool()
+{
+    std::cout << "=========Thread Pool Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(73);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    setParallelThreads(4);
+    ok = ok && parallelThreads() == 4;
+
+    // 每个下标恰好执行一次，嵌套的 parallelFor 不会死锁
+    const size_t n = 100000;
+    std::vector<int> hits(n, 0);
+    parallelFor(0, n, 1000, [&](size_t b, size_t e)
+                {
+                    parallelFor(b, e, 100, [&](size_t b2, size_t e2)
+                                {
+                                    for (size_t i = b2; i < e2; ++i)
+                                        ++hits[i]; }); });
+    ok = ok && std::count(hits.begin(), hits.end(), 1) == static_cast<long>(n);
+
+    // 异常在所有块结束后重新抛出
+    bool threw = false;
+    try
+    {
+        parallelFor(0, n, 10, [](size_t b, size_t)
+                    {
+                        if (b == 0)
+                            throw std::runtime_error("block failed"); });
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    ok = ok && threw;
+
+    // 并行归约：整数求和精确，浮点点积与串行结果相差在舍入范围内
+    const long long sum = parallelReduce(0, n, 1000, 0LL, [](size_t b, size_t e)
+                                         {
+                                             long long s = 0;
+                                             for (size_t i = b; i < e; ++i)
+                                                 s += static_cast<long long>(i);
+                                             return s; },
+                                         [](long long a, long long b)
+                                         { return a + b; });
+    ok = ok && sum == static_cast<long long>(n) * (n - 1) / 2;
+
+    const size_t m = 300;
+    MatrixXf A(m, m), B(m, m), C(m, m);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < m; ++j)
+        {
+            A(i, j) = dis(gen);
+            B(i, j) = dis(gen);
+            C(i, j) = dis(gen);
+        }
+    VectorXf x(200000), y(200000);
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = dis(gen);
+        y[i] = dis(gen);
+    }
+    const MatrixXf sumPar = A + B * Real(2.0) - C.transpose();
+    const MatrixXf prodPar = A * B;
+    const Real dotPar = x.dot(y);
+
+    // 单线程结果：逐元素运算与 GEMM 按行切分不改变每个元素的运算顺序，应逐位相同
+    setParallelThreads(1);
+    const MatrixXf sumSer = A + B * Real(2.0) - C.transpose();
+    const MatrixXf prodSer = A * B;
+    const Real dotSer = x.dot(y);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < m; ++j)
+            ok = ok && sumPar(i, j) == sumSer(i, j) && prodPar(i, j) == prodSer(i, j);
+    ok = ok && std::abs(dotPar.data - dotSer.data) < 1e-10;
+
+    // 行数不是 MR × 线程数的整数倍时，行块数仍不超过 A 打包缓冲区个数；结果与单线程逐位相同
+    const size_t depth = 400;
+    MatrixXf W(depth, depth);
+    MatrixXc Wc(depth, depth);
+    for (size_t i = 0; i < depth; ++i)
+        for (size_t j = 0; j < depth; ++j)
+        {
+            W(i, j) = dis(gen);
+            Wc(i, j) = Complex(dis(gen), dis(gen));
+        }
+    const SplitMatrixXc sWc(Wc);
+    for (size_t rows : {9, 13, 37, 101})
+    {
+        MatrixXf E(rows, depth);
+        MatrixXc Ec(rows, depth);
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < depth; ++j)
+            {
+                E(i, j) = dis(gen);
+                Ec(i, j) = Complex(dis(gen), dis(gen));
+            }
+        const SplitMatrixXc sEc(Ec);
+        setParallelThreads(1);
+        const MatrixXf ref = E * W;
+        const SplitMatrixXc refC = sEc * sWc;
+        for (size_t threads : {3, 4})
+        {
+            setParallelThreads(threads);
+            const MatrixXf P = E * W;
+            const SplitMatrixXc Pc = sEc * sWc;
+            for (size_t i = 0; i < rows; ++i)
+                for (size_t j = 0; j < depth; ++j)
+                    ok = ok && P(i, j) == ref(i, j) && Pc(i, j) == refC(i, j);
+        }
+    }
+    setParallelThreads(0);
+
+    std::cout << "Dot product parallel / serial: " << dotPar << " / " << dotSer << std::endl;
+    std::cout << "Thread pool test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Thread Pool Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+
+void testExpressionReductions()
+{
+    std::cout << "=========Expression Reduction Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(29);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    auto close = [](double a, double b)
+    { return std::abs(a - b) <= 1e-12 * std::max(1.0, std::abs(b)); };
+
+    // 尺寸不是数据包宽度的整数倍，覆盖向量循环的尾部
+    const size_t r = 37, c = 53;
+    MatrixXf A(r, c), B(r, c), D(r, c);
+    for (size_t i = 0; i < r; ++i)
+        for (size_t j = 0; j < c; ++j)
+        {
+            A(i, j) = dis(gen);
+            B(i, j) = dis(gen);
+            D(i, j) = dis(gen);
+        }
+
+    // 线性访问路径与逐元素定义一致
+    const MatrixXf C = A + 2.0 * B - D * Real(0.5);
+    for (size_t i = 0; i < r; ++i)
+        for (size_t j = 0; j < c; ++j)
+            ok = ok && close(C(i, j).data, A(i, j).data + 2.0 * B(i, j).data - D(i, j).data * 0.5);
+
+    // 乘积作为叶子参与融合循环
+    MatrixXf S(c, c);
+    for (size_t i = 0; i < c; ++i)
+        for (size_t j = 0; j < c; ++j)
+            S(i, j) = dis(gen);
+    const MatrixXf AS = A * S;
+    const MatrixXf fused = A * S + A;
+    for (size_t i = 0; i < r; ++i)
+        for (size_t j = 0; j < c; ++j)
+            ok = ok && close(fused(i, j).data, AS(i, j).data + A(i, j).data);
+
+    // 固定尺寸矩阵与向量
+    MatrixNM<Real, 3, 3> m3{{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {7.0, 8.0, 10.0}}};
+    const MatrixNM<Real, 3, 3> m3b = m3 + m3 * 2.0;
+    ok = ok && m3b(2, 2) == Real(30) && m3b(0, 1) == Real(6);
+    Vector3f u{1.0, -2.0, 3.0}, w{4.0, 5.0, -6.0};
+    const Vector3f uw = u - w;
+    ok = ok && uw[0] == Real(-3) && uw[2] == Real(9);
+
+    // 归约与对临时矩阵的朴素计算一致
+    const MatrixXf diff = A - D;
+    double sum = 0, sq = 0, l1 = 0, l3 = 0, linf = 0, mx = -1e300, mn = 1e300, dot = 0;
+    for (size_t i = 0; i < r; ++i)
+        for (size_t j = 0; j < c; ++j)
+        {
+            const double v = diff(i, j).data;
+            sum += v;
+            sq += v * v;
+            l1 += std::abs(v);
+            l3 += std::pow(std::abs(v), 3.0);
+            linf = std::max(linf, std::abs(v));
+            mx = std::max(mx, v);
+            mn = std::min(mn, v);
+            dot += v * B(i, j).data;
+        }
+    ok = ok && close((A - D).sum().data, sum);
+    ok = ok && close((A - D).squaredNorm().data, sq);
+    ok = ok && close((A - D).norm().data, std::sqrt(sq));
+    ok = ok && close((A - D).lpNorm(1).data, l1);
+    ok = ok && close((A - D).lpNorm(2).data, std::sqrt(sq));
+    ok = ok && close((A - D).lpNorm(3).data, std::pow(l3, 1.0 / 3.0));
+    ok = ok && (A - D).lpNorm(std::numeric_limits<double>::infinity()).data == linf;
+    ok = ok && (A - D).maxCoeff().data == mx && (A - D).minCoeff().data == mn;
+    ok = ok && close((A - D).dot(B).data, dot);
+
+    // 转置表达式不能线性访问，走逐元素路径，结果相同
+    ok = ok && close((A.transpose() - D.transpose()).sum().data, sum);
+    ok = ok && close((A - D).transpose().squaredNorm().data, sq);
+    ok = ok && (A.transpose() - D.transpose()).maxCoeff().data == mx;
+    ok = ok && close((A - D).transpose().dot(B.transpose()).data, dot);
+
+    // 向量：v.dot(表达式) 与残差范数
+    VectorXf x(1000), y(1000);
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = dis(gen);
+        y[i] = dis(gen);
+    }
+    double xy = 0, res = 0;
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        xy += x[i].data * (x[i].data - y[i].data);
+        res += (x[i].data - 3.0 * y[i].data) * (x[i].data - 3.0 * y[i].data);
+    }
+    ok = ok && close(x.dot(x - y).data, xy) && close((x - 3.0 * y).norm().data, std::sqrt(res));
+
+    // 复数元素支持求和与点积
+    MatrixXc Z(2, 2);
+    Z(0, 0) = Complex(1, 2);
+    Z(0, 1) = Complex(3, -1);
+    Z(1, 0) = Complex(0, 1);
+    Z(1, 1) = Complex(-2, 0);
+    const Complex zs = (Z + Z).sum();
+    const Complex zd = Z.dot(Z);
+    ok = ok && zs.real == 4 && zs.imag == 4 && zd.real == 8 && zd.imag == -2;
+
+    // 大规模时并行归约与单线程结果在舍入范围内一致
+    const size_t n = 400;
+    MatrixXf P(n, n), Q(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+        {
+            P(i, j) = dis(gen);
+            Q(i, j) = dis(gen);
+        }
+    setParallelThreads(4);
+    const Real normPar = (P - Q).norm(), maxPar = (P + Q).maxCoeff();
+    const MatrixXf sumPar = P + Q * 3.0;
+    setParallelThreads(1);
+    const Real normSer = (P - Q).norm(), maxSer = (P + Q).maxCoeff();
+    const MatrixXf sumSer = P + Q * 3.0;
+    setParallelThreads(0);
+    ok = ok && std::abs(normPar.data - normSer.data) < 1e-10 && maxPar == maxSer;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            ok = ok && sumPar(i, j) == sumSer(i, j);
+
+    // NaN 在数据包内、循环尾部或并行分块的任何位置，maxCoeff/minCoeff/lpNorm(∞) 都返回 NaN
+    const double qnan = std::numeric_limits<double>::quiet_NaN();
+    for (size_t len : {1, 2, 3, 5, 8, 15, 16, 17, 33, 70})
+        for (size_t pos = 0; pos < len; ++pos)
+        {
+            MatrixX<RealIEEE> v(1, len);
+            MatrixX<BasicReal<float, IEEEArithmetic>> vf(1, len);
+            for (size_t k = 0; k < len; ++k)
+            {
+                v(0, k) = RealIEEE(static_cast<double>(k) - 3.0);
+                vf(0, k) = BasicReal<float, IEEEArithmetic>(static_cast<float>(k) - 3.0f);
+            }
+            v(0, pos) = RealIEEE(qnan);
+            vf(0, pos) = BasicReal<float, IEEEArithmetic>(std::numeric_limits<float>::quiet_NaN());
+            ok = ok && std::isnan(v.maxCoeff().data) && std::isnan(v.minCoeff().data) && std::isnan((v * 2.0).maxCoeff().data);
+            ok = ok && std::isnan(v.lpNorm(std::numeric_limits<double>::infinity()).data);
+            ok = ok && std::isnan(vf.maxCoeff().data) && std::isnan(vf.minCoeff().data);
+        }
+    for (size_t pos : {size_t(0), size_t(4097), n * n - 1})
+    {
+        MatrixX<RealIEEE> big(n, n);
+        for (size_t k = 0; k < n * n; ++k)
+            big(k / n, k % n) = RealIEEE(static_cast<double>(k % 97));
+        big(pos / n, pos % n) = RealIEEE(qnan);
+        setParallelThreads(4);
+        ok = ok && std::isnan(big.maxCoeff().data) && std::isnan(big.minCoeff().data);
+        setParallelThreads(0);
+        ok = ok && std::isnan((big + big).maxCoeff().data) && std::isnan(big.transpose().minCoeff().data);
+    }
+
+    // 非法参数
+    bool threw = false;
+    try
+    {
+        MatrixXf E(0, 0);
+        (E + E).maxCoeff();
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    ok = ok && threw;
+
+    std::cout << "||A - D||_F = " << (A - D).norm() << ", max(A - D) = " << (A - D).maxCoeff() << std::endl;
+    std::cout << "Expression reduction test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Expression Reduction Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+
+void testElementwiseMath()
+{
+    std::cout << "=========Elementwise Math Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(31);
+    std::uniform_real_distribution<double> dis(-10.0, 10.0);
+    const double eps = std::numeric_limits<double>::epsilon();
+    auto near = [](double a, double b, double tol)
+    { return std::abs(a - b) <= tol * std::max(1e-300, std::abs(b)) || (std::isnan(a) && std::isnan(b)); };
+
+    // 尺寸不是数据包宽度的整数倍，覆盖尾部元素的标量路径
+    const size_t r = 29, c = 31;
+    MatrixXf A(r, c), B(r, c);
+    for (size_t i = 0; i < r; ++i)
+        for (size_t j = 0; j < c; ++j)
+        {
+            A(i, j) = dis(gen);
+            B(i, j) = dis(gen);
+        }
+    const MatrixXf eA = exp(A), sA = sin(A), cA = cos(A), tA = tanh(A), aA = abs(A);
+    const MatrixXf lA = log(abs(A)), qA = sqrt(abs(A));
+    for (size_t i = 0; i < r; ++i)
+        for (size_t j = 0; j < c; ++j)
+        {
+            const double x = A(i, j).data;
+            ok = ok && near(eA(i, j).data, std::exp(x), 2 * eps);
+            ok = ok && std::abs(sA(i, j).data - std::sin(x)) <= 2 * eps && std::abs(cA(i, j).data - std::cos(x)) <= 2 * eps;
+            ok = ok && near(tA(i, j).data, std::tanh(x), 3 * eps);
+            ok = ok && aA(i, j).data == std::abs(x) && qA(i, j).data == std::sqrt(std::abs(x));
+            ok = ok && near(lA(i, j).data, std::log(std::abs(x)), 2 * eps);
+        }
+
+    // 与其他表达式组合：融合循环、转置（逐元素路径）与归约给出相同结果
+    const MatrixXf mixed = exp(A * 0.1) * 2.0 + sin(B) - A;
+    const MatrixXf At = A.transpose(), Bt = B.transpose();
+    const MatrixXf viaTranspose = exp(At.transpose() * 0.1) * 2.0 + sin(Bt.transpose()) - At.transpose();
+    double total = 0;
+    for (size_t i = 0; i < r; ++i)
+        for (size_t j = 0; j < c; ++j)
+        {
+            ok = ok && mixed(i, j) == viaTranspose(i, j);
+            ok = ok && near(mixed(i, j).data, std::exp(A(i, j).data * 0.1) * 2.0 + std::sin(B(i, j).data) - A(i, j).data, 1e-13);
+            total += std::tanh(A(i, j).data);
+        }
+    ok = ok && near(tanh(A).sum().data, total, 1e-12);
+    ok = ok && near(abs(A - B).maxCoeff().data, (A - B).lpNorm(std::numeric_limits<double>::infinity()).data, 0);
+
+    // 特殊值
+    VectorXf s(6);
+    s[0] = 0.0;
+    s[1] = 1000.0;
+    s[2] = -1000.0;
+    s[3] = std::numeric_limits<double>::infinity();
+    s[4] = -std::numeric_limits<double>::infinity();
+    s[5] = 1e-20;
+    const VectorXf es = exp(s), ts = tanh(s);
+    ok = ok && es[0] == Real(1) && std::isinf(es[1].data) && es[2] == Real(0) && std::isinf(es[3].data) && es[4] == Real(0);
+    ok = ok && ts[1] == Real(1) && ts[2] == Real(-1) && ts[3] == Real(1) && ts[4] == Real(-1) && ts[5] == Real(1e-20);
+
+    // 大范围内的最大 ulp 误差
+    const size_t n = 1 << 14;
+    VectorXf w(n);
+    std::uniform_real_distribution<double> wide(-700.0, 700.0);
+    for (size_t i = 0; i < n; ++i)
+        w[i] = wide(gen);
+    const VectorXf ew = exp(w), lw = log(abs(w));
+    double maxExp = 0, maxLog = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        maxExp = std::max(maxExp, std::abs(ew[i].data - std::exp(w[i].data)) / std::exp(w[i].data) / eps);
+        maxLog = std::max(maxLog, std::abs(lw[i].data - std::log(std::abs(w[i].data))) / std::abs(std::log(std::abs(w[i].data))) / eps);
+    }
+    ok = ok && maxExp <= 2 && maxLog <= 2;
+
+    // sin/cos 的 ulp 误差：包括 π/2 整数倍附近（结果接近 0，区间约简相消最严重）与单精度
+    auto ulpError = [](long double value, long double ref, int digits)
+    {
+        const long double ulp = std::ldexp(1.0L, std::ilogb(static_cast<double>(ref)) - (digits - 1));
+        return static_cast<double>(std::abs(value - ref) / ulp);
+    };
+    std::vector<double> tx = {3.141592653589793, 4.6e5, 3.2e5, 1e8 + 0.5};
+    std::vector<float> fx = {3.0f * 3.14159265f, 505.8f, 4096.5f};
+    std::uniform_real_distribution<double> turns(0.0, 3e8), fturns(0.0, 5000.0);
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        double x = std::floor(turns(gen)) * 1.57079632679489661923L;
+        float f = static_cast<float>(std::floor(fturns(gen)) * 1.57079632679489661923L);
+        for (int t = 0; t < 3; ++t)
+        {
+            tx.push_back(x);
+            tx.push_back(-x);
+            fx.push_back(f);
+            x = std::nextafter(x, 1e300);
+            f = std::nextafter(f, 1e30f);
+        }
+        tx.push_back(wide(gen) * 1e5);
+        fx.push_back(static_cast<float>(wide(gen) * 10.0));
+    }
+    VectorXf tv(tx.size());
+    VectorX<Real32> fv(fx.size());
+    for (size_t i = 0; i < tx.size(); ++i)
+        tv[i] = tx[i];
+    for (size_t i = 0; i < fx.size(); ++i)
+        fv[i] = Real32(fx[i]);
+    const VectorXf st = sin(tv), ct = cos(tv);
+    const VectorX<Real32> sf = sin(fv), cf = cos(fv);
+    double ulpSin = 0, ulpCos = 0, ulpSinF = 0, ulpCosF = 0;
+    for (size_t i = 0; i < tx.size(); ++i)
+    {
+        ulpSin = std::max(ulpSin, ulpError(st[i].data, std::sin(static_cast<long double>(tx[i])), 53));
+        ulpCos = std::max(ulpCos, ulpError(ct[i].data, std::cos(static_cast<long double>(tx[i])), 53));
+    }
+    for (size_t i = 0; i < fx.size(); ++i)
+    {
+        ulpSinF = std::max(ulpSinF, ulpError(sf[i].data, std::sin(static_cast<double>(fx[i])), 24));
+        ulpCosF = std::max(ulpCosF, ulpError(cf[i].data, std::cos(static_cast<double>(fx[i])), 24));
+    }
+    ok = ok && ulpSin <= 1 && ulpCos <= 1 && ulpSinF <= 1 && ulpCosF <= 1;
+    std::cout << "Max sin/cos ulp error (double / float): " << std::max(ulpSin, ulpCos) << " / " << std::max(ulpSinF, ulpCosF) << std::endl;
+
+    // 超出约简范围的参数与标准库一致
+    VectorXf huge(3);
+    huge[0] = 1e20;
+    huge[1] = -3.5e300;
+    huge[2] = std::numeric_limits<double>::infinity();
+    const VectorXf sh = sin(huge), ch = cos(huge);
+    ok = ok && sh[0].data == std::sin(1e20) && ch[1].data == std::cos(-3.5e300) && std::isnan(sh[2].data) && std::isnan(ch[2].data);
+
+    // 单精度
+    MatrixX<Real32> F(r, c);
+    for (size_t i = 0; i < r; ++i)
+        for (size_t j = 0; j < c; ++j)
+            F(i, j) = Real32(static_cast<float>(A(i, j).data));
+    const MatrixX<Real32> eF = exp(F * 0.5f), tF = tanh(F);
+    for (size_t i = 0; i < r; ++i)
+        for (size_t j = 0; j < c; ++j)
+        {
+            const float x = F(i, j).data;
+            ok = ok && std::abs(eF(i, j).data - std::exp(x * 0.5f)) <= 3 * std::numeric_limits<float>::epsilon() * std::exp(x * 0.5f);
+            ok = ok && std::abs(tF(i, j).data - std::tanh(x)) <= 3 * std::numeric_limits<float>::epsilon();
+        }
+
+    // 检查策略：Real 对负数开方抛出异常，RealIEEE 得到 NaN
+    bool threw = false;
+    try
+    {
+        const MatrixXf bad = sqrt(A);
+    }
+    catch (const std::domain_error &)
+    {
+        threw = true;
+    }
+    ok = ok && threw;
+    MatrixX<RealIEEE> I(2, 9);
+    for (size_t j = 0; j < 9; ++j)
+    {
+        I(0, j) = RealIEEE(double(j) - 4.0);
+        I(1, j) = RealIEEE(double(j));
+    }
+    const MatrixX<RealIEEE> qI = sqrt(I), lI = log(I);
+    ok = ok && std::isnan(qI(0, 0).data) && qI(1, 4) == RealIEEE(2) && std::isinf(lI(1, 0).data) && std::isnan(lI(0, 0).data);
+
+    // 复数元素
+    MatrixXc Z(1, 2);
+    Z(0, 0) = Complex(0.5, 1.0);
+    Z(0, 1) = Complex(-1.0, 0.25);
+    const MatrixXc eZ = exp(Z);
+    const std::complex<double> ref = std::exp(std::complex<double>(-1.0, 0.25));
+    ok = ok && near(eZ(0, 1).real, ref.real(), 1e-15) && near(eZ(0, 1).imag, ref.imag(), 1e-15);
+
+    std::cout << "max ulp: exp " << maxExp << ", log " << maxLog << std::endl;
+    std::cout << "Elementwise math test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Elementwise Math Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testMatrixViews()
+{
+    std::cout << "=========Matrix View Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(37);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    const size_t n = 100;
+    MatrixXf A(n, n), B(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+        {
+            A(i, j) = dis(gen);
+            B(i, j) = dis(gen);
+        }
+
+    // 读取：子块、行、列、对角线与视图的视图指向父矩阵的对应元素
+    auto blk = A.block(10, 20, 30, 40);
+    ok = ok && blk.rows() == 30 && blk.cols() == 40 && blk(3, 5) == A(13, 25);
+    ok = ok && A.row(7)(0, 9) == A(7, 9) && A.col(8)(9, 0) == A(9, 8) && A.diagonal()(42, 0) == A(42, 42);
+    ok = ok && blk.block(1, 2, 3, 4)(2, 3) == A(13, 25) && blk.diagonal()(4, 0) == A(14, 24);
+
+    // 写入：通过视图修改父矩阵，右侧可以引用同一个矩阵
+    MatrixXf C = A;
+    C.row(0) = C.row(1) + C.row(0);
+    C.col(3).fill(Real(5));
+    C.block(50, 50, 7, 9) = B.block(0, 0, 7, 9) * 2.0;
+    C.diagonal() = exp(C.diagonal() * 0.0);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+        {
+            Real expected = A(i, j);
+            if (i == 0)
+                expected = A(1, j) + A(0, j);
+            if (i >= 50 && i < 57 && j >= 50 && j < 59)
+                expected = B(i - 50, j - 50) * 2.0;
+            if (j == 3)
+                expected = Real(5);
+            if (i == j)
+                expected = Real(1);
+            ok = ok && C(i, j) == expected;
+        }
+
+    // 逐元素表达式与归约：视图逐行以数据包求值，结果与逐元素拷贝一致
+    MatrixXf blkCopy(30, 40), otherCopy(30, 40);
+    for (size_t i = 0; i < 30; ++i)
+        for (size_t j = 0; j < 40; ++j)
+        {
+            blkCopy(i, j) = A(10 + i, 20 + j);
+            otherCopy(i, j) = B(i, j);
+        }
+    const MatrixXf fused = blk * 3.0 - tanh(B.block(0, 0, 30, 40));
+    const MatrixXf fusedCopy = blkCopy * 3.0 - tanh(otherCopy);
+    for (size_t i = 0; i < 30; ++i)
+        for (size_t j = 0; j < 40; ++j)
+            ok = ok && fused(i, j) == fusedCopy(i, j);
+    ok = ok && std::abs((blk.sum() - blkCopy.sum()).data) < 1e-12;
+    ok = ok && std::abs((blk.norm() - blkCopy.norm()).data) < 1e-12 && blk.maxCoeff() == blkCopy.maxCoeff();
+    ok = ok && std::abs((blk.dot(B.block(0, 0, 30, 40)) - blkCopy.dot(otherCopy)).data) < 1e-12;
+
+    // 乘法：视图作为操作数直接交给 GEMM，也可以作为乘积的目标
+    const MatrixXf &cA = A;
+    MatrixXf P = cA.block(3, 5, 64, 48) * B.block(7, 11, 48, 72);
+    MatrixXf Q(n, n);
+    Q.block(20, 10, 64, 72) = A.block(3, 5, 64, 48) * B.block(7, 11, 48, 72).transpose().transpose();
+    double maxErr = 0;
+    for (size_t i = 0; i < 64; ++i)
+        for (size_t j = 0; j < 72; ++j)
+        {
+            double ref = 0;
+            for (size_t k = 0; k < 48; ++k)
+                ref += A(3 + i, 5 + k).data * B(7 + k, 11 + j).data;
+            maxErr = std::max(maxErr, std::abs(P(i, j).data - ref));
+            maxErr = std::max(maxErr, std::abs(Q(20 + i, 10 + j).data - ref));
+        }
+    ok = ok && maxErr < 1e-12 && Q(19, 10) == Real(0) && Q(20, 82) == Real(0);
+
+    // 固定尺寸矩阵
+    MatrixNM<Real, 3, 3> M;
+    M.diagonal().fill(Real(2));
+    M.row(2) = M.row(0) + M.row(1);
+    ok = ok && M(0, 0) == Real(2) && M(1, 1) == Real(2) && M(2, 0) == Real(2) && M(2, 1) == Real(2) && M(2, 2) == Real(0);
+
+    // 越界与尺寸不符
+    bool threwRange = false, threwSize = false;
+    try
+    {
+        A.block(90, 0, 11, 1);
+    }
+    catch (const std::out_of_range &)
+    {
+        threwRange = true;
+    }
+    try
+    {
+        A.row(0) = A.col(0);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threwSize = true;
+    }
+    ok = ok && threwRange && threwSize;
+
+    std::cout << "Matrix view test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Matrix View Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testAliasAssignment()
+{
+    std::cout << "=========Alias Assignment Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(41);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    auto fillRandom = [&](MatrixXf &M)
+    {
+        for (size_t i = 0; i < M.rows(); ++i)
+            for (size_t j = 0; j < M.cols(); ++j)
+                M(i, j) = dis(gen);
+    };
+    auto maxDiff = [](const MatrixXf &X, const MatrixXf &Y)
+    {
+        double d = 0;
+        for (size_t i = 0; i < X.rows(); ++i)
+            for (size_t j = 0; j < X.cols(); ++j)
+                d = std::max(d, std::abs((X(i, j) - Y(i, j)).data));
+        return d;
+    };
+
+    // 尺寸超过 GEMM 与并行阈值，覆盖各条求值路径
+    const size_t n = 300;
+    MatrixXf A(n, n), B(n, n);
+    fillRandom(A);
+    fillRandom(B);
+    const MatrixXf A0 = A;
+
+    // 不引用目标的逐元素表达式直接写入现有存储，不重新分配
+    MatrixXf C(n, n);
+    const Real *before = C.data();
+    C = A + B * 2.0;
+    ok = ok && C.data() == before && C(7, 9) == A(7, 9) + B(7, 9) * 2.0;
+    C = C * 0.5 - exp(C * 0.0);
+    ok = ok && C.data() == before && C(7, 9) == (A(7, 9) + B(7, 9) * 2.0) * 0.5 - Real(1);
+
+    // 目标参与乘法或转置时结果与先求值到独立矩阵一致
+    const MatrixXf AB = A0 * B, At = A0.transpose();
+    A = A * B;
+    ok = ok && maxDiff(A, AB) == 0;
+    A = A0;
+    A = A.transpose();
+    ok = ok && maxDiff(A, At) == 0;
+    A = A0;
+    A = B * A.transpose() + A;
+    ok = ok && maxDiff(A, MatrixXf(B * At + A0)) < 1e-12;
+
+    // 复合赋值：乘积直接累加到目标
+    A = A0;
+    C = B;
+    C += A * B;
+    ok = ok && C.data() == before && maxDiff(C, MatrixXf(B + AB)) < 1e-12;
+    C -= A * B;
+    ok = ok && maxDiff(C, B) < 1e-12;
+    C += A;
+    C -= B * 2.0;
+    ok = ok && maxDiff(C, MatrixXf(A0 - B)) < 1e-12;
+    A *= B;
+    ok = ok && maxDiff(A, AB) == 0;
+    A = A0;
+    A -= A * B;
+    ok = ok && maxDiff(A, MatrixXf(A0 - AB)) < 1e-12;
+    A = A0;
+    A *= 3.0;
+    ok = ok && A(5, 6) == A0(5, 6) * 3.0;
+
+    // 视图：错位重叠时经过暂存区，复合赋值写回父矩阵
+    A = A0;
+    A.block(1, 0, n - 1, n) = A.block(0, 0, n - 1, n);
+    bool shifted = A.row(0)(0, 4) == A0(0, 4);
+    for (size_t i = 1; i < n; ++i)
+        shifted = shifted && A(i, 4) == A0(i - 1, 4) && A(i, n - 1) == A0(i - 1, n - 1);
+    ok = ok && shifted;
+    A = A0;
+    A.block(0, 0, 100, 100) += A.block(100, 0, 100, 120) * B.block(0, 10, 120, 100);
+    double viewErr = 0;
+    for (size_t i = 0; i < 100; ++i)
+        for (size_t j = 0; j < 100; ++j)
+        {
+            double ref = A0(i, j).data;
+            for (size_t k = 0; k < 120; ++k)
+                ref += A0(100 + i, k).data * B(k, 10 + j).data;
+            viewErr = std::max(viewErr, std::abs(A(i, j).data - ref));
+        }
+    ok = ok && viewErr < 1e-12 && A(0, 100) == A0(0, 100);
+    A.row(3) *= 0.0;
+    ok = ok && A.row(3).maxCoeff() == Real(0) && A.row(3).minCoeff() == Real(0);
+
+    // 定长矩阵、向量与复数元素
+    MatrixNM<Real, 3, 3> M{{{1, 2, 3}, {4, 5, 6}, {7, 8, 10}}};
+    const MatrixNM<Real, 3, 3> M0 = M;
+    M = M.transpose();
+    M *= M0;
+    ok = ok && M(0, 0) == Real(66) && M(2, 2) == Real(145);
+    VectorN<Real, 3> v{1, 1, 1};
+    v = M0 * v;
+    v += v;
+    ok = ok && v[0] == Real(12) && v[2] == Real(50);
+    VectorXf x(n);
+    for (size_t i = 0; i < n; ++i)
+        x[i] = dis(gen);
+    const VectorXf Ax = A0 * x;
+    x = A0 * x;
+    ok = ok && x[17] == Ax[17];
+    MatrixXc Z(2, 2);
+    Z(0, 0) = Complex(1, 1);
+    Z(0, 1) = Complex(0, 2);
+    Z(1, 0) = Complex(3, 0);
+    const MatrixXc ZZ = Z * Z;
+    Z += Z * Z;
+    ok = ok && Z(1, 1) == ZZ(1, 1) && Z(0, 0) == Complex(1, 1) + ZZ(0, 0);
+
+    // 尺寸不符
+    bool threw = false;
+    try
+    {
+        C += A.block(0, 0, 2, 2) * B.block(0, 0, 2, 2);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    ok = ok && threw;
+
+    std::cout << "Alias assignment test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Alias Assignment Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+void testBinaryMatrixFile()
+{
+    std::cout << "=========Binary Matrix File Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(43);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    const std::string path = "oxygenmath_test_matrix.bin";
+
+    const size_t r = 37, c = 53;
+    MatrixXf A(r, c);
+    for (size_t i = 0; i < r; ++i)
+        for (size_t j = 0; j < c; ++j)
+            A(i, j) = dis(gen);
+
+    // 写入后映射读取：视图直接指向映射页，数据逐位一致
+    saveBinary(path, A);
+    {
+        const MappedMatrixFile file(path);
+        ok = ok && file.rows() == r && file.cols() == c && file.dtype() == BinaryDType::Float64;
+        const auto V = file.view<Real>();
+        ok = ok && reinterpret_cast<uintptr_t>(V.data()) % 64 == 0;
+        for (size_t i = 0; i < r; ++i)
+            for (size_t j = 0; j < c; ++j)
+                ok = ok && V(i, j) == A(i, j);
+        // 视图参与表达式与乘法
+        const MatrixXf P = V.transpose() * A, Q = A.transpose() * A;
+        ok = ok && P(3, 7) == Q(3, 7) && V.sum() == A.sum();
+        ok = ok && file.view<RealIEEE>()(1, 2).data == A(1, 2).data;
+
+        bool threw = false;
+        try
+        {
+            file.view<Real32>();
+        }
+        catch (const std::invalid_argument &)
+        {
+            threw = true;
+        }
+        ok = ok && threw;
+    }
+    const MatrixXf B = loadBinary<Real>(path);
+    ok = ok && B.rows() == r && B.cols() == c && B(36, 52) == A(36, 52);
+
+    // 表达式逐行求值写出；流式写入单精度与复数，数据区按页对齐
+    saveBinary(path, A * 2.0 - A.transpose().transpose());
+    ok = ok && loadBinary<Real>(path)(5, 9) == A(5, 9) * 2.0 - A(5, 9);
+    {
+        BinaryMatrixWriter<Real32> writer(path, 3, 4, 4096);
+        for (size_t i = 0; i < 3; ++i)
+        {
+            Real32 row[4];
+            for (size_t j = 0; j < 4; ++j)
+                row[j] = Real32(float(i * 4 + j) + 0.5f);
+            writer.writeRow(row);
+        }
+        writer.close();
+    }
+    {
+        const MappedMatrixFile file(path);
+        const auto V = file.view<Real32>();
+        ok = ok && file.alignment() == 4096 && V(2, 3) == Real32(11.5f) && V.rows() == 3 && V.cols() == 4;
+    }
+    MatrixXc Z(2, 3);
+    Z(1, 2) = Complex(1.5, -2.5);
+    saveBinary(path, Z);
+    ok = ok && loadBinary<Complex>(path)(1, 2) == Complex(1.5, -2.5);
+
+    // 不完整或损坏的文件
+    bool threwIncomplete = false, threwTruncated = false, threwMagic = false;
+    try
+    {
+        BinaryMatrixWriter<Real> writer(path, 10, 10);
+        writer.write(A.data(), 50);
+        writer.close();
+    }
+    catch (const std::runtime_error &)
+    {
+        threwIncomplete = true;
+    }
+    try
+    {
+        MappedMatrixFile file(path);
+    }
+    catch (const std::runtime_error &)
+    {
+        threwTruncated = true;
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        const std::vector<char> junk(128, 'x');
+        out.write(junk.data(), junk.size());
+    }
+    try
+    {
+        MappedMatrixFile file(path);
+    }
+    catch (const std::runtime_error &)
+    {
+        threwMagic = true;
+    }
+    ok = ok && threwIncomplete && threwTruncated && threwMagic;
+    std::remove(path.c_str());
+
+    std::cout << "Binary matrix file test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Binary Matrix File Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}
+
+void testMatrixMarket()
+{
+    std::cout << "=========Matrix Market Test=========" << std::endl;
+    bool ok = true;
+    std::mt19937 gen(47);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    const std::string path = "oxygenmath_test_matrix.mtx";
+    auto writeText = [&](const std::string &text)
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+    };
+
+    // 稀疏矩阵写出后读回：数值逐位相同，CSR 与 CSC 结果一致
+    const size_t r = 300, c = 170;
+    std::vector<Triplet<Real>> triplets;
+    for (size_t k = 0; k < 4000; ++k)
+        triplets.push_back(Triplet<Real>(gen() % r, gen() % c, Real(dis(gen))));
+    const SparseMatrix<Real> S(r, c, triplets);
+    writeMatrixMarket(path, S);
+    const MatrixMarketInfo info = readMatrixMarketInfo(path);
+    ok = ok && info.coordinate && info.field == MatrixMarketField::Real && info.rows == r && info.cols == c && info.entries == S.nonZeros();
+    const SparseMatrix<Real> S2 = readMatrixMarketSparse<Real>(path);
+    const SparseMatrix<Real, false> S3 = readMatrixMarketSparse<Real, false>(path);
+    ok = ok && S2.nonZeros() == S.nonZeros();
+    for (size_t k = 0; k < S.nonZeros() && ok; ++k)
+        ok = S2.innerIndexPtr()[k] == S.innerIndexPtr()[k] && S2.valuePtr()[k] == S.valuePtr()[k];
+    for (const auto &t : triplets)
+        ok = ok && S3.coeff(t.row, t.col) == S.coeff(t.row, t.col);
+    const MatrixXf D = readMatrixMarketDense<Real>(path);
+    for (const auto &t : triplets)
+        ok = ok && D(t.row, t.col) == S.coeff(t.row, t.col);
+
+    // 稠密矩阵与表达式以 array 格式（列主序）写出
+    MatrixXf A(23, 19);
+    for (size_t i = 0; i < 23; ++i)
+        for (size_t j = 0; j < 19; ++j)
+            A(i, j) = dis(gen);
+    writeMatrixMarket(path, A);
+    const MatrixXf B = readMatrixMarketDense<Real>(path);
+    ok = ok && B.rows() == 23 && B.cols() == 19;
+    for (size_t i = 0; i < 23; ++i)
+        for (size_t j = 0; j < 19; ++j)
+            ok = ok && B(i, j) == A(i, j);
+    writeMatrixMarket(path, A.transpose() * 2.0);
+    ok = ok && readMatrixMarketDense<Real>(path)(18, 22) == A(22, 18) * 2.0;
+
+    // 对称、斜对称、pattern、注释、CRLF 与重复条目
+    writeText("%%MatrixMarket matrix coordinate real symmetric\n% comment\n\n3 3 4\n1 1 2.5\n3 1 -1\n2 2 4\n3 1 0.5\n");
+    const MatrixXf Sym = readMatrixMarketDense<Real>(path);
+    ok = ok && Sym(0, 0) == 2.5 && Sym(2, 0) == -0.5 && Sym(0, 2) == -0.5 && Sym(1, 1) == 4.0 && Sym(2, 2) == 0.0;
+    ok = ok && readMatrixMarketSparse<Real>(path).nonZeros() == 4;
+    writeText("%%MatrixMarket matrix array real skew-symmetric\r\n3 3\r\n1\r\n2\r\n3\r\n");
+    const MatrixXf Skew = readMatrixMarketDense<Real>(path);
+    ok = ok && Skew(1, 0) == 1.0 && Skew(0, 1) == -1.0 && Skew(2, 0) == 2.0 && Skew(2, 1) == 3.0 && Skew(1, 2) == -3.0 && Skew(1, 1) == 0.0;
+    writeText("%%MatrixMarket matrix coordinate pattern general\n2 3 2\n1 3\n2 1\n");
+    const SparseMatrix<Real> P = readMatrixMarketSparse<Real>(path);
+    ok = ok && P.nonZeros() == 2 && P.coeff(0, 2) == 1.0 && P.coeff(1, 0) == 1.0;
+
+    // 复数：Hermitian 补全时取共轭；复数写出后读回
+    writeText("%%MatrixMarket matrix coordinate complex hermitian\n2 2 2\n1 1 1 0\n2 1 1.5 -2\n");
+    const MatrixXc H = readMatrixMarketDense<Complex>(path);
+    ok = ok && H(1, 0) == Complex(1.5, -2) && H(0, 1) == Complex(1.5, 2) && H(0, 0) == Complex(1, 0);
+    bool threwComplex = false;
+    try
+    {
+        readMatrixMarketSparse<Real>(path);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threwComplex = true;
+    }
+    ok = ok && threwComplex;
+    const SparseMatrix<Complex> HS = readMatrixMarketSparse<Complex>(path);
+    writeMatrixMarket(path, HS, MatrixMarketSymmetry::Hermitian);
+    ok = ok && readMatrixMarketInfo(path).entries == 2 && readMatrixMarketDense<Complex>(path)(0, 1) == Complex(1.5, 2);
+
+    // 不合法的文件
+    const char *bad[] = {"%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1\n",
+                         "%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n",
+                         "%%MatrixMarket matrix coordinate real general\n2 2 1\n1 1\n",
+                         "%%MatrixMarket matrix coordinate real general\n2 2 1\n1 1 1\n2 2 2\n",
+                         "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n",
+                         "%%MatrixMarket vector coordinate real general\n2 2 1\n1 1 1\n",
+                         "%%MatrixMarket matrix coordinate real symmetric\n2 3 1\n1 1 1\n",
+                         "%%MatrixMarket matrix coordinate real general\n2 2 1000000000000000\n1 1 1\n",
+                         "%%MatrixMarket matrix coordinate real skew-symmetric\n2 2 2\n2 1 1\n",
+                         "%%MatrixMarket matrix coordinate real general\n1000000 1000000 100000000000\n1 1 1\n",
+                         "%%MatrixMarket matrix coordinate real general\n2 2 1\n18446744073709551617 1 1\n",
+                         "%%MatrixMarket matrix coordinate real general\n-1 2 1\n1 1 1\n"};
+    for (const char *text : bad)
+    {
+        writeText(text);
+        bool threw = false;
+        try
+        {
+            readMatrixMarketSparse<Real>(path);
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        ok = ok && threw;
+    }
+    // 稠密读取：coordinate 文件的 rows * cols 超出 size_t，或尺寸带负号
+    const char *badDense[] = {"%%MatrixMarket matrix coordinate real general\n4294967296 4294967296 1\n1 1 5\n",
+                              "%%MatrixMarket matrix coordinate real general\n18446744073709551615 2 1\n1 1 5\n",
+                              "%%MatrixMarket matrix array real general\n-1 1\n1\n"};
+    for (const char *text : badDense)
+    {
+        writeText(text);
+        bool threw = false;
+        try
+        {
+            readMatrixMarketDense<Real>(path);
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        ok = ok && threw;
+    }
+    std::remove(path.c_str());
+
+    std::cout << "Matrix Market test: " << (ok ? "PASS" : "FAIL") << std::endl;
+    std::cout << "=========Matrix Market Test End=========" << std::endl;
+    if (ok)
+        test_pass_count++;
+}